@@ -0,0 +1,575 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   Benchmark.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 6:00 PM
+ */
+
+#ifndef AXF_BENCHMARK_H
+#define AXF_BENCHMARK_H
+
+// API
+#include <Axf/API/Compiler.h>
+
+#ifndef ARTEMIS_CXX11_SUPPORTED
+#error "the benchmark harness requires a C++11 compiler"
+#endif
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * A self contained micro benchmark harness.
+ * <p>
+ * Benchmarks are functions registered with the <code>AXF_BENCHMARK</code>
+ * macro. Each one receives a <code>State</code> and runs the measured code in
+ * a <code>while (state.keepRunning())</code> loop; whatever happens before
+ * the loop is set up and is not timed. The harness calibrates the number of
+ * iterations so a sample lasts at least the minimum sample time, runs warm up
+ * samples, and then reports the median, 99th percentile, mean, standard
+ * deviation and extremes of the time per iteration over the measured samples.
+ * <p>
+ * Benchmarks that can not use the loop (multi-threaded ones, for example)
+ * run <code>state.iterations()</code> operations between
+ * <code>startTiming</code> and <code>stopTiming</code>.
+ * <p>
+ * A benchmark program ends with <code>AXF_BENCHMARK_MAIN()</code>, which
+ * understands the following options:
+ * <ul>
+ * <li><code>--format=text|json|csv</code>: the report format.</li>
+ * <li><code>--out=FILE</code>: writes the report to a file.</li>
+ * <li><code>--filter=TEXT</code>: runs only benchmarks whose name contains
+ * the text.</li>
+ * <li><code>--samples=N</code>: number of measured samples.</li>
+ * <li><code>--min-sample-ms=N</code>: minimum duration of a sample.</li>
+ * <li><code>--warmup-ms=N</code>: duration of the warm up.</li>
+ * <li><code>--list</code>: lists the benchmarks and exits.</li>
+ * </ul>
+ */
+
+namespace axf
+{
+namespace benchmark
+{
+
+/**
+ * Prevents the compiler from optimizing away the computation of
+ * <code>value</code>, by making it appear to be read by opaque code.
+ *
+ * @param value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Forces the compiler to assume that all memory may have been read and
+ * written, so pending stores are not eliminated.
+ */
+inline void clobberMemory()
+{
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+    __asm__ __volatile__("" : : : "memory");
+#endif
+}
+
+typedef std::chrono::steady_clock clock_type;
+
+/**
+ * The state of a benchmark sample. It drives the measured loop and collects
+ * the elapsed time and the user counters.
+ */
+class State
+{
+public:
+
+    explicit State(std::size_t iterations)
+    :
+    m_iterations(iterations),
+    m_remaining(iterations + 1),
+    m_elapsed(0),
+    m_running(false)
+    {
+    }
+
+    /**
+     * Returns true while there are iterations left to run. The timer starts
+     * at the first call and stops at the call that returns false.
+     *
+     * @return
+     */
+    inline bool keepRunning()
+    {
+        if (ARTEMIS_LIKELY(--m_remaining != 0))
+        {
+            if (ARTEMIS_UNLIKELY(!m_running && m_remaining == m_iterations))
+            {
+                startTiming();
+            }
+            return true;
+        }
+        stopTiming();
+        return false;
+    }
+
+    /**
+     * Returns the number of iterations of this sample.
+     *
+     * @return
+     */
+    inline std::size_t iterations() const
+    {
+        return m_iterations;
+    }
+
+    /**
+     * Starts (or resumes) the timer.
+     */
+    inline void startTiming()
+    {
+        if (!m_running)
+        {
+            m_running = true;
+            m_start = clock_type::now();
+        }
+    }
+
+    /**
+     * Stops (or pauses) the timer, accumulating the elapsed time.
+     */
+    inline void stopTiming()
+    {
+        if (m_running)
+        {
+            m_elapsed += std::chrono::duration<double, std::nano>(clock_type::now() - m_start).count();
+            m_running = false;
+        }
+    }
+
+    /**
+     * Sets a user counter, reported next to the timings. Counters keep the
+     * value set during the last measured sample.
+     *
+     * @param name
+     * @param value
+     */
+    void setCounter(const char* name, double value)
+    {
+        for (std::size_t i = 0; i < m_counters.size(); ++i)
+        {
+            if (m_counters[i].first == name)
+            {
+                m_counters[i].second = value;
+                return;
+            }
+        }
+        m_counters.push_back(std::make_pair(std::string(name), value));
+    }
+
+    inline double elapsedNanoseconds() const
+    {
+        return m_elapsed;
+    }
+
+    inline const std::vector<std::pair<std::string, double> >& counters() const
+    {
+        return m_counters;
+    }
+
+private:
+
+    std::size_t         m_iterations;
+    std::size_t         m_remaining;
+    double              m_elapsed;
+    bool                m_running;
+    clock_type::time_point m_start;
+    std::vector<std::pair<std::string, double> > m_counters;
+} ;
+
+typedef void (*BenchmarkFunction)(State&);
+
+struct Registration
+{
+    const char*         name;
+    BenchmarkFunction   function;
+} ;
+
+/**
+ * The result of a benchmark, with timings in nanoseconds per iteration.
+ */
+struct Result
+{
+    std::string name;
+    std::size_t iterations;
+    std::size_t samples;
+    double      median;
+    double      p99;
+    double      mean;
+    double      stddev;
+    double      min;
+    double      max;
+    std::vector<std::pair<std::string, double> > counters;
+} ;
+
+struct Options
+{
+    std::string format;
+    std::string out;
+    std::string filter;
+    std::size_t samples;
+    double      minSampleMs;
+    double      warmupMs;
+    bool        list;
+
+    Options() : format("text"), samples(25), minSampleMs(5), warmupMs(50), list(false) { }
+} ;
+
+inline std::vector<Registration>& registry()
+{
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+/**
+ * Registers benchmarks at static initialization time.
+ */
+struct Registrar
+{
+
+    Registrar(const char* name, BenchmarkFunction function)
+    {
+        Registration registration = {name, function};
+        registry().push_back(registration);
+    }
+} ;
+
+inline double runSample(BenchmarkFunction function, std::size_t iterations, State** last = NULL)
+{
+    State state(iterations);
+    function(state);
+    state.stopTiming();
+    if (last != NULL)
+    {
+        delete *last;
+        *last = new State(state);
+    }
+    return state.elapsedNanoseconds();
+}
+
+/**
+ * Runs a benchmark: calibration, warm up and measurement.
+ *
+ * @param registration
+ * @param options
+ * @return
+ */
+inline Result run(const Registration& registration, const Options& options)
+{
+    const double minSample = options.minSampleMs * 1e6;
+
+    // Calibration: grow the iteration count until a sample is long enough
+    std::size_t iterations = 1;
+    double elapsed = runSample(registration.function, iterations);
+    while (elapsed < minSample && iterations < 1000000000)
+    {
+        double factor = elapsed > 0 ? std::min(10.0, std::max(2.0, 1.2 * minSample / elapsed)) : 10.0;
+        iterations = (std::size_t) (iterations * factor);
+        elapsed = runSample(registration.function, iterations);
+    }
+
+    // Warm up
+    double warmup = 0;
+    while (warmup < options.warmupMs * 1e6)
+    {
+        warmup += std::max(runSample(registration.function, iterations), 1.0);
+    }
+
+    // Measurement
+    State* last = NULL;
+    std::vector<double> samples;
+    for (std::size_t i = 0; i < options.samples; ++i)
+    {
+        samples.push_back(runSample(registration.function, iterations, &last) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = registration.name;
+    result.iterations = iterations;
+    result.samples = samples.size();
+    result.min = samples.front();
+    result.max = samples.back();
+
+    std::size_t n = samples.size();
+    result.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+    std::size_t rank = (std::size_t) std::ceil(0.99 * n);
+    result.p99 = samples[rank > 0 ? rank - 1 : 0];
+
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        sum += samples[i];
+    }
+    result.mean = sum / n;
+
+    double squares = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        squares += (samples[i] - result.mean) * (samples[i] - result.mean);
+    }
+    result.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+
+    result.counters = last->counters();
+    delete last;
+    return result;
+}
+
+inline void writeJsonString(std::FILE* out, const std::string& text)
+{
+    std::fputc('"', out);
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        char c = text[i];
+        if (c == '"' || c == '\\')
+        {
+            std::fputc('\\', out);
+        }
+        std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+inline void writeTextHeader(std::FILE* out)
+{
+    std::fprintf(out, "%-44s %12s %12s %12s %10s %12s\n", "benchmark", "median ns", "p99 ns", "mean ns", "stddev", "iterations");
+}
+
+inline void writeTextRow(std::FILE* out, const Result& r)
+{
+    std::fprintf(out, "%-44s %12.2f %12.2f %12.2f %10.2f %12lu", r.name.c_str(),
+                 r.median, r.p99, r.mean, r.stddev, (unsigned long) r.iterations);
+    for (std::size_t c = 0; c < r.counters.size(); ++c)
+    {
+        std::fprintf(out, "  %s=%.4g", r.counters[c].first.c_str(), r.counters[c].second);
+    }
+    std::fprintf(out, "\n");
+    std::fflush(out);
+}
+
+inline void report(std::FILE* out, const std::vector<Result>& results, const Options& options, const char* program)
+{
+    if (options.format == "json")
+    {
+        char date[32] = {0};
+        std::time_t now = std::time(NULL);
+        std::strftime(date, sizeof (date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"program\": ");
+        writeJsonString(out, program);
+        std::fprintf(out, ",\n    \"date\": \"%s\",\n", date);
+#ifdef __VERSION__
+        std::fprintf(out, "    \"compiler\": ");
+        writeJsonString(out, __VERSION__);
+        std::fprintf(out, ",\n");
+#endif
+        std::fprintf(out, "    \"cplusplus\": %ld,\n", (long) __cplusplus);
+        std::fprintf(out, "    \"samples\": %lu\n  },\n  \"benchmarks\": [\n", (unsigned long) options.samples);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            std::fprintf(out, "    {\"name\": ");
+            writeJsonString(out, r.name);
+            std::fprintf(out, ", \"iterations\": %lu, \"samples\": %lu, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+                         "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f, \"counters\": {",
+                         (unsigned long) r.iterations, (unsigned long) r.samples,
+                         r.median, r.p99, r.mean, r.stddev, r.min, r.max);
+            for (std::size_t c = 0; c < r.counters.size(); ++c)
+            {
+                std::fprintf(out, "%s", c ? ", " : "");
+                writeJsonString(out, r.counters[c].first);
+                std::fprintf(out, ": %.6g", r.counters[c].second);
+            }
+            std::fprintf(out, "}}%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+    else if (options.format == "csv")
+    {
+        std::fprintf(out, "name,iterations,samples,median_ns,p99_ns,mean_ns,stddev_ns,min_ns,max_ns,counters\n");
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            std::fprintf(out, "\"%s\",%lu,%lu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,\"", r.name.c_str(),
+                         (unsigned long) r.iterations, (unsigned long) r.samples,
+                         r.median, r.p99, r.mean, r.stddev, r.min, r.max);
+            for (std::size_t c = 0; c < r.counters.size(); ++c)
+            {
+                std::fprintf(out, "%s%s=%.6g", c ? ";" : "", r.counters[c].first.c_str(), r.counters[c].second);
+            }
+            std::fprintf(out, "\"\n");
+        }
+    }
+    else
+    {
+        writeTextHeader(out);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            writeTextRow(out, results[i]);
+        }
+    }
+}
+
+inline bool parseOption(const char* argument, const char* name, std::string& value)
+{
+    std::size_t length = std::strlen(name);
+    if (std::strncmp(argument, name, length) == 0 && argument[length] == '=')
+    {
+        value = argument + length + 1;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Runs every registered benchmark selected by the command line options and
+ * prints the report.
+ *
+ * @param argc
+ * @param argv
+ * @return the process exit code
+ */
+inline int runAll(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (parseOption(argv[i], "--format", value))
+            options.format = value;
+        else if (parseOption(argv[i], "--out", value))
+            options.out = value;
+        else if (parseOption(argv[i], "--filter", value))
+            options.filter = value;
+        else if (parseOption(argv[i], "--samples", value))
+            options.samples = std::max(1, std::atoi(value.c_str()));
+        else if (parseOption(argv[i], "--min-sample-ms", value))
+            options.minSampleMs = std::atof(value.c_str());
+        else if (parseOption(argv[i], "--warmup-ms", value))
+            options.warmupMs = std::atof(value.c_str());
+        else if (std::strcmp(argv[i], "--list") == 0)
+            options.list = true;
+        else
+        {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Text reports to the console are printed as the results arrive
+    bool streaming = options.format == "text" && options.out.empty();
+    if (streaming && !options.list)
+    {
+        writeTextHeader(stdout);
+    }
+
+    std::vector<Result> results;
+    const std::vector<Registration>& benchmarks = registry();
+    for (std::size_t i = 0; i < benchmarks.size(); ++i)
+    {
+        if (!options.filter.empty() && std::strstr(benchmarks[i].name, options.filter.c_str()) == NULL)
+        {
+            continue;
+        }
+        if (options.list)
+        {
+            std::printf("%s\n", benchmarks[i].name);
+            continue;
+        }
+        results.push_back(run(benchmarks[i], options));
+        if (streaming)
+        {
+            writeTextRow(stdout, results.back());
+        }
+    }
+
+    if (options.list || streaming)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    std::FILE* out = options.out.empty() ? stdout : std::fopen(options.out.c_str(), "w");
+    if (out == NULL)
+    {
+        std::fprintf(stderr, "unable to open '%s' for writing\n", options.out.c_str());
+        return EXIT_FAILURE;
+    }
+    report(out, results, options, argv[0]);
+    if (out != stdout)
+    {
+        std::fclose(out);
+    }
+    return EXIT_SUCCESS;
+}
+
+}
+}
+
+#define AXF_BENCHMARK_CONCAT_(a, b) a##b
+#define AXF_BENCHMARK_CONCAT(a, b) AXF_BENCHMARK_CONCAT_(a, b)
+
+/**
+ * Defines and registers a benchmark. The body follows the macro, and has a
+ * parameter <code>state</code> of type <code>axf::benchmark::State&</code>.
+ */
+#define AXF_BENCHMARK(name) \
+    static void AXF_BENCHMARK_CONCAT(axfBenchmark_, name)(axf::benchmark::State& state); \
+    static axf::benchmark::Registrar AXF_BENCHMARK_CONCAT(axfRegistrar_, name)(#name, &AXF_BENCHMARK_CONCAT(axfBenchmark_, name)); \
+    static void AXF_BENCHMARK_CONCAT(axfBenchmark_, name)(axf::benchmark::State& state)
+
+/**
+ * Defines the main function of a benchmark program.
+ */
+#define AXF_BENCHMARK_MAIN() \
+    int main(int argc, char** argv) \
+    { \
+        return axf::benchmark::runAll(argc, argv); \
+    }
+
+#endif /* AXF_BENCHMARK_H */
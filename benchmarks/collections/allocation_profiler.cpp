@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   allocation_profiler.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 3:40 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::collections;
+using namespace axf::core;
+
+/*
+ * The cost of the allocation profiler: allocator churn and list building
+ * with the profiler stopped, sampling at the default interval, and sampling
+ * at a much shorter one.
+ */
+
+struct Record
+{
+    long    key;
+    char    payload[56];
+} ;
+
+static void churn(State& state)
+{
+    DefaultAllocator<Record> allocator;
+    while (state.keepRunning())
+    {
+        Record* record = allocator.allocate(1);
+        doNotOptimize(record);
+        allocator.deallocate(record, 1);
+    }
+}
+
+static void buildList(State& state)
+{
+    while (state.keepRunning())
+    {
+        LinkedList<long> list;
+        for (long i = 0; i < 64; ++i)
+        {
+            list.add(i);
+        }
+        doNotOptimize(list.size());
+    }
+}
+
+AXF_BENCHMARK(churn_stopped)
+{
+    AllocationProfiler::stop();
+    churn(state);
+}
+
+AXF_BENCHMARK(churn_default_interval)
+{
+    AllocationProfiler::start();
+    churn(state);
+    AllocationProfiler::stop();
+}
+
+AXF_BENCHMARK(churn_4k_interval)
+{
+    AllocationProfiler::start(4096);
+    churn(state);
+    AllocationProfiler::stop();
+}
+
+AXF_BENCHMARK(list_stopped)
+{
+    AllocationProfiler::stop();
+    buildList(state);
+}
+
+AXF_BENCHMARK(list_default_interval)
+{
+    AllocationProfiler::start();
+    buildList(state);
+    AllocationProfiler::stop();
+}
+
+AXF_BENCHMARK(list_4k_interval)
+{
+    AllocationProfiler::start(4096);
+    buildList(state);
+    AllocationProfiler::stop();
+}
+
+AXF_BENCHMARK_MAIN()
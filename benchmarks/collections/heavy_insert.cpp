@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   heavy_insert.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 10:12 AM
+ */
+
+#include <stdlib.h>
+#include <cstring>
+#include <new>
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+
+    void* memory = std::malloc(size);
+    if (memory == NULL)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+class Payload : public Object
+{
+    AXF_CLASS_TYPE(Payload, AXF_TYPE(axf::core::Object))
+public:
+
+    char m_data[64];
+} ;
+
+static const std::size_t ELEMENTS = 20000;  /// Lists are emptied when they reach this size
+static const int STRING_SIZE = 1024;
+
+static const char* text()
+{
+    static char buffer[STRING_SIZE + 1] = {0};
+    if (buffer[0] == 0)
+    {
+        std::memset(buffer, 'x', STRING_SIZE);
+    }
+    return buffer;
+}
+
+/**
+ * Counts the allocations performed while the timer runs, reported as the
+ * allocs/op counter.
+ */
+class AllocationCounter
+{
+public:
+
+    AllocationCounter(State& state) : m_state(state), m_start(g_allocations), m_excluded(0) { }
+
+    ~AllocationCounter()
+    {
+        m_state.setCounter("allocs/op", (double) (g_allocations - m_start - m_excluded) / m_state.iterations());
+    }
+
+    /**
+     * Runs a function with the timer paused, without counting its
+     * allocations.
+     */
+    template <typename F>
+    inline void untimed(F function)
+    {
+        m_state.stopTiming();
+        std::size_t before = g_allocations;
+        function();
+        m_excluded += g_allocations - before;
+        m_state.startTiming();
+    }
+
+    /**
+     * Empties a list that is full, with the timer paused.
+     */
+    template <typename List>
+    inline void recycle(List& list)
+    {
+        if (list.size() == ELEMENTS)
+        {
+            untimed([&list]() { list.clear(); });
+        }
+    }
+
+private:
+
+    State&      m_state;
+    std::size_t m_start;
+    std::size_t m_excluded;
+} ;
+
+// Strings: copy, move and in-place construction
+
+AXF_BENCHMARK(string_add_copy)
+{
+    string source(text());
+    collections::LinkedList<string> list;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        list.add(source);
+        counter.recycle(list);
+    }
+}
+
+AXF_BENCHMARK(string_add_move)
+{
+    std::vector<string> sources;
+    collections::LinkedList<string> list;
+    std::size_t next = 0;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        if (next == sources.size())
+        {
+            // Refill the moved-from sources
+            counter.untimed([&]() { sources.assign(ELEMENTS, string(text())); next = 0; });
+        }
+        list.add(std::move(sources[next++]));
+        counter.recycle(list);
+    }
+}
+
+AXF_BENCHMARK(string_add_temporary)
+{
+    collections::LinkedList<string> list;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        list.add(string(text()));
+        counter.recycle(list);
+    }
+}
+
+AXF_BENCHMARK(string_emplace)
+{
+    collections::LinkedList<string> list;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        list.emplace(text());
+        counter.recycle(list);
+    }
+}
+
+// Lists of lists: moving a list transfers its nodes
+
+AXF_BENCHMARK(list_of_lists_add_move_16_ints)
+{
+    collections::LinkedList<collections::LinkedList<int> > lists;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        collections::LinkedList<int> inner;
+        for (int j = 0; j < 16; ++j)
+            inner.add(j);
+        lists.add(std::move(inner));
+        counter.recycle(lists);
+    }
+}
+
+// Reference counted handles: moving avoids grab/release churn
+
+AXF_BENCHMARK(strong_ref_add_copy)
+{
+    strong_ref<Payload> handle = new Payload();
+    collections::LinkedList<strong_ref<Payload> > list;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        list.add(handle);
+        counter.recycle(list);
+    }
+}
+
+AXF_BENCHMARK(strong_ref_add_move)
+{
+    strong_ref<Payload> handle = new Payload();
+    std::vector<strong_ref<Payload> > handles;
+    collections::LinkedList<strong_ref<Payload> > list;
+    std::size_t next = 0;
+    AllocationCounter counter(state);
+    while (state.keepRunning())
+    {
+        if (next == handles.size())
+        {
+            counter.untimed([&]() { handles.assign(ELEMENTS, handle); next = 0; });
+        }
+        list.add(std::move(handles[next++]));
+        counter.recycle(list);
+    }
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   huge_page_traversal.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:10 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#ifndef ARTEMIS_PLATFORM_W32
+#include <unistd.h>
+#endif
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::collections;
+
+/*
+ * Pointer chasing over 1 to 8 GiB of nodes allocated from a virtual region,
+ * backed by huge pages or by regular pages. The nodes are linked in a random
+ * cycle, so nearly every hop misses the caches and, with regular pages, the
+ * TLB. Sizes that do not fit in three quarters of the available memory are
+ * skipped, and reported with the skipped counter set.
+ */
+
+struct ChaseNode
+{
+    ChaseNode*  next;
+    long        payload[7];
+} ;
+
+/**
+ * A random cycle of nodes. Building one takes seconds, so the last one is
+ * kept across the samples of a benchmark.
+ */
+struct Chain
+{
+    VirtualRegion               region;
+    RegionAllocator<ChaseNode>  allocator;
+    ChaseNode*                  cursor;
+
+    static std::size_t capacityFor(std::size_t bytes)
+    {
+        std::size_t perSlab = (VirtualRegion::SLAB_SIZE - 64) / sizeof (ChaseNode);
+        return (bytes / sizeof (ChaseNode) / perSlab + 2) * VirtualRegion::SLAB_SIZE;
+    }
+
+    Chain(std::size_t bytes, bool hugePages) : region(capacityFor(bytes), hugePages), allocator(region), cursor(NULL)
+    {
+        std::size_t count = bytes / sizeof (ChaseNode);
+        std::vector<ChaseNode*> nodes(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            nodes[i] = allocator.allocate();
+            nodes[i]->payload[0] = (long) i;
+        }
+
+        std::mt19937_64 random(42);
+        for (std::size_t i = count - 1; i > 0; --i)
+        {
+            std::swap(nodes[i], nodes[random() % (i + 1)]);
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            nodes[i]->next = nodes[(i + 1) % count];
+        }
+        cursor = nodes[0];
+    }
+} ;
+
+static std::unique_ptr<Chain> g_chain;
+static std::size_t g_bytes = 0;
+static bool g_hugePages = false;
+
+static std::size_t availableMemory()
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    return (std::size_t) -1;
+#else
+    return (std::size_t) sysconf(_SC_AVPHYS_PAGES) * (std::size_t) sysconf(_SC_PAGESIZE);
+#endif
+}
+
+/**
+ * Returns the megabytes of the process backed by transparent huge pages, or
+ * -1 if the system does not tell.
+ */
+static double hugePageMegabytes()
+{
+    double megabytes = -1;
+    std::FILE* file = std::fopen("/proc/self/smaps_rollup", "r");
+    if (file != NULL)
+    {
+        char line[256];
+        while (std::fgets(line, sizeof (line), file) != NULL)
+        {
+            long kilobytes;
+            if (std::sscanf(line, "AnonHugePages: %ld kB", &kilobytes) == 1)
+            {
+                megabytes = kilobytes / 1024.0;
+            }
+        }
+        std::fclose(file);
+    }
+    return megabytes;
+}
+
+static void chase(State& state, std::size_t gigabytes, bool hugePages)
+{
+    std::size_t bytes = gigabytes << 30;
+    if (g_chain.get() == NULL || g_bytes != bytes || g_hugePages != hugePages)
+    {
+        // Free the previous chain before building the next
+        g_chain.reset();
+        if ((bytes + bytes / 8) / 3 * 4 > availableMemory())
+        {
+            state.setCounter("skipped", 1);
+            while (state.keepRunning())
+            {
+            }
+            return;
+        }
+
+        g_chain.reset(new Chain(bytes, hugePages));
+        g_bytes = bytes;
+        g_hugePages = hugePages;
+    }
+
+    ChaseNode* cursor = g_chain->cursor;
+    while (state.keepRunning())
+    {
+        cursor = cursor->next;
+    }
+    doNotOptimize(cursor);
+    g_chain->cursor = cursor;
+
+    state.setCounter("huge_pages", g_chain->region.isHugePageBacked() ? 1 : 0);
+    state.setCounter("thp_mb", hugePageMegabytes());
+}
+
+AXF_BENCHMARK(chase_1g_regular)
+{
+    chase(state, 1, false);
+}
+
+AXF_BENCHMARK(chase_1g_huge)
+{
+    chase(state, 1, true);
+}
+
+AXF_BENCHMARK(chase_2g_regular)
+{
+    chase(state, 2, false);
+}
+
+AXF_BENCHMARK(chase_2g_huge)
+{
+    chase(state, 2, true);
+}
+
+AXF_BENCHMARK(chase_4g_regular)
+{
+    chase(state, 4, false);
+}
+
+AXF_BENCHMARK(chase_4g_huge)
+{
+    chase(state, 4, true);
+}
+
+AXF_BENCHMARK(chase_8g_regular)
+{
+    chase(state, 8, false);
+}
+
+AXF_BENCHMARK(chase_8g_huge)
+{
+    chase(state, 8, true);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   lru_move_to_front.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 12:40 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::collections;
+using namespace axf::core;
+
+/**
+ * A cache entry. Looking an entry up is modeled as an index into a table of
+ * strong references, so only the recency list maintenance is measured.
+ */
+class CacheEntry : public Object, public IntrusiveListHook<>
+{
+    AXF_CLASS_TYPE(CacheEntry, AXF_TYPE(axf::core::Object))
+public:
+
+    CacheEntry(int key) : m_key(key) { }
+
+    int m_key;
+} ;
+
+static unsigned int g_seed = 12345;
+
+static inline unsigned int nextRandom()
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 8;
+}
+
+/**
+ * Touches random entries with a skewed distribution: 90% of the accesses hit
+ * the first tenth of the keys.
+ */
+static inline int pickKey(int entries)
+{
+    unsigned int r = nextRandom();
+    return (r % 10 != 0) ? (int) ((r >> 4) % (entries / 10)) : (int) ((r >> 4) % entries);
+}
+
+static std::vector<strong_ref<CacheEntry> > makeTable(int entries)
+{
+    std::vector<strong_ref<CacheEntry> > table(entries);
+    for (int i = 0; i < entries; ++i)
+    {
+        table[i] = new CacheEntry(i);
+    }
+    return table;
+}
+
+static void runLinkedList(State& state, int entries)
+{
+    std::vector<strong_ref<CacheEntry> > table = makeTable(entries);
+    LinkedList<strong_ref<CacheEntry> > recency;
+    for (int i = 0; i < entries; ++i)
+    {
+        recency.add(table[i]);
+    }
+
+    g_seed = 12345;
+    while (state.keepRunning())
+    {
+        // Move to back (most recently used): unlink by value, relink a copy
+        const strong_ref<CacheEntry>& entry = table[pickKey(entries)];
+        recency.remove(entry);
+        recency.add(entry);
+    }
+}
+
+static void runIntrusiveList(State& state, int entries)
+{
+    std::vector<strong_ref<CacheEntry> > table = makeTable(entries);
+    IntrusiveList<CacheEntry, DefaultHookTag, true> recency;
+    for (int i = 0; i < entries; ++i)
+    {
+        recency.pushBack(*table[i]);
+    }
+
+    g_seed = 12345;
+    while (state.keepRunning())
+    {
+        recency.moveToBack(*table[pickKey(entries)]);
+    }
+}
+
+AXF_BENCHMARK(lru_linked_list_100)
+{
+    runLinkedList(state, 100);
+}
+
+AXF_BENCHMARK(lru_intrusive_list_100)
+{
+    runIntrusiveList(state, 100);
+}
+
+AXF_BENCHMARK(lru_linked_list_1000)
+{
+    runLinkedList(state, 1000);
+}
+
+AXF_BENCHMARK(lru_intrusive_list_1000)
+{
+    runIntrusiveList(state, 1000);
+}
+
+AXF_BENCHMARK(lru_linked_list_10000)
+{
+    runLinkedList(state, 10000);
+}
+
+AXF_BENCHMARK(lru_intrusive_list_10000)
+{
+    runIntrusiveList(state, 10000);
+}
+
+AXF_BENCHMARK_MAIN()
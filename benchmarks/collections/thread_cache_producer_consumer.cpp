@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   thread_cache_producer_consumer.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 3:05 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::collections;
+using namespace axf::concurrent;
+
+static const std::size_t BLOCK_SIZE = 64;
+static const std::size_t RING_SIZE = 1024;   /// Power of two
+
+/**
+ * A single producer, single consumer ring of pointers. Each producer thread
+ * is paired with one consumer thread, so every block is released by a thread
+ * other than the one that allocated it.
+ */
+struct Ring
+{
+    void*           slots[RING_SIZE];
+    volatile long   head;
+    char            padding[64];
+    volatile long   tail;
+
+    Ring() : head(0), tail(0) { }
+
+    void put(void* p)
+    {
+        long t = atomicLoad(&tail, RELAXED);
+        while (t - atomicLoad(&head, ACQUIRE) == (long) RING_SIZE)
+        {
+            std::this_thread::yield();
+        }
+        slots[t & (RING_SIZE - 1)] = p;
+        atomicStore(&tail, t + 1, RELEASE);
+    }
+
+    void* take()
+    {
+        long h = atomicLoad(&head, RELAXED);
+        while (atomicLoad(&tail, ACQUIRE) == h)
+        {
+            std::this_thread::yield();
+        }
+        void* p = slots[h & (RING_SIZE - 1)];
+        atomicStore(&head, h + 1, RELEASE);
+        return p;
+    }
+} ;
+
+struct SystemHeap
+{
+
+    static void* allocate(std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* p, std::size_t)
+    {
+        ::operator delete(p);
+    }
+} ;
+
+struct CachingHeap
+{
+
+    static void* allocate(std::size_t size)
+    {
+        return ThreadCache::allocate(size);
+    }
+
+    static void deallocate(void* p, std::size_t size)
+    {
+        ThreadCache::deallocate(p, size);
+    }
+} ;
+
+/**
+ * Producers allocate, consumers release. Both sides also churn a few private
+ * blocks per message, the common case of short lived temporaries. Each pair
+ * exchanges <code>state.iterations()</code> messages, and the time reported
+ * is per message.
+ */
+template <typename Heap>
+static void producerConsumer(State& state, int pairs)
+{
+    const long messages = (long) state.iterations();
+
+    std::vector<Ring*> rings;
+    for (int i = 0; i < pairs; ++i)
+    {
+        rings.push_back(new Ring());
+    }
+
+    state.startTiming();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < pairs; ++i)
+    {
+        Ring* ring = rings[i];
+        threads.push_back(std::thread([ring, messages]() {
+            for (long m = 0; m < messages; ++m)
+            {
+                void* temporary = Heap::allocate(BLOCK_SIZE / 2);
+                void* p = Heap::allocate(BLOCK_SIZE);
+                *static_cast<long*> (p) = m;
+                Heap::deallocate(temporary, BLOCK_SIZE / 2);
+                ring->put(p);
+            }
+        }));
+        threads.push_back(std::thread([ring, messages]() {
+            for (long m = 0; m < messages; ++m)
+            {
+                void* p = ring->take();
+                void* temporary = Heap::allocate(BLOCK_SIZE * 2);
+                *static_cast<long*> (temporary) = *static_cast<long*> (p);
+                Heap::deallocate(temporary, BLOCK_SIZE * 2);
+                Heap::deallocate(p, BLOCK_SIZE);
+            }
+        }));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+    state.stopTiming();
+
+    for (int i = 0; i < pairs; ++i)
+    {
+        delete rings[i];
+    }
+    state.setCounter("pairs", pairs);
+}
+
+AXF_BENCHMARK(producer_consumer_new_delete_1)
+{
+    producerConsumer<SystemHeap>(state, 1);
+}
+
+AXF_BENCHMARK(producer_consumer_thread_cache_1)
+{
+    producerConsumer<CachingHeap>(state, 1);
+}
+
+AXF_BENCHMARK(producer_consumer_new_delete_2)
+{
+    producerConsumer<SystemHeap>(state, 2);
+}
+
+AXF_BENCHMARK(producer_consumer_thread_cache_2)
+{
+    producerConsumer<CachingHeap>(state, 2);
+}
+
+AXF_BENCHMARK(producer_consumer_new_delete_4)
+{
+    producerConsumer<SystemHeap>(state, 4);
+}
+
+AXF_BENCHMARK(producer_consumer_thread_cache_4)
+{
+    producerConsumer<CachingHeap>(state, 4);
+}
+
+AXF_BENCHMARK_MAIN()
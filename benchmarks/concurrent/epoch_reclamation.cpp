@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   epoch_reclamation.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:10 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::concurrent;
+
+/*
+ * The overhead of epoch based reclamation per operation of a lock-free
+ * stack: against a stack that never frees its nodes during the run, which
+ * is the cost of the stack alone, and against a stack guarded by a spin
+ * lock, which may free its nodes right away.
+ */
+
+struct Node
+{
+    long    value;
+    Node*   next;
+} ;
+
+class TreiberStack
+{
+public:
+
+    TreiberStack() : m_head(NULL) { }
+
+    inline void push(Node* node)
+    {
+        node->next = atomicLoad(&m_head, RELAXED);
+        while (!atomicCompareExchange(&m_head, node->next, node, true, RELEASE, RELAXED))
+        {
+        }
+    }
+
+    inline Node* pop()
+    {
+        Node* head = atomicLoad(&m_head, ACQUIRE);
+        while (head != NULL && !atomicCompareExchange(&m_head, head, head->next, true, ACQUIRE, ACQUIRE))
+        {
+        }
+        return head;
+    }
+
+private:
+
+    Node* volatile m_head;
+} ;
+
+class LockedStack
+{
+public:
+
+    LockedStack() : m_head(NULL) { }
+
+    inline void push(Node* node)
+    {
+        ScopedLock<SpinLock> guard(m_lock);
+        node->next = m_head;
+        m_head = node;
+    }
+
+    inline bool popAndFree()
+    {
+        Node* head;
+        {
+            ScopedLock<SpinLock> guard(m_lock);
+            head = m_head;
+            if (head == NULL)
+            {
+                return false;
+            }
+            m_head = head->next;
+        }
+        delete head;
+        return true;
+    }
+
+private:
+
+    SpinLock    m_lock;
+    Node*       m_head;
+} ;
+
+enum Scheme
+{
+    NO_RECLAMATION,
+    EPOCHS,
+    LOCKED
+} ;
+
+/**
+ * Pushes a node and pops one, per iteration, from several threads; the
+ * time is per pair of operations of the measuring thread.
+ */
+static void pushPop(State& state, Scheme scheme, int otherCount)
+{
+    TreiberStack stack;
+    LockedStack locked;
+    EpochManager manager;
+    const std::size_t count = state.iterations();
+    volatile int running = 1;
+
+    std::vector<std::vector<Node*> > leaked(otherCount + 1);
+    std::vector<std::thread> others;
+
+    struct Operation
+    {
+
+        static void run(Scheme scheme, TreiberStack& stack, LockedStack& locked, EpochManager& manager,
+                        std::vector<Node*>& leaked, long value)
+        {
+            Node* node = new Node;
+            node->value = value;
+            if (scheme == LOCKED)
+            {
+                locked.push(node);
+                locked.popAndFree();
+                return;
+            }
+
+            stack.push(node);
+            if (scheme == EPOCHS)
+            {
+                EpochManager::Guard guard(manager);
+                Node* popped = stack.pop();
+                if (popped != NULL)
+                {
+                    manager.retire(popped);
+                }
+            }
+            else
+            {
+                Node* popped = stack.pop();
+                if (popped != NULL)
+                {
+                    leaked.push_back(popped);
+                }
+            }
+        }
+    } ;
+
+    for (int t = 0; t < otherCount; ++t)
+    {
+        std::vector<Node*>& mine = leaked[t + 1];
+        others.push_back(std::thread([&, scheme]() {
+            long value = 0;
+            while (atomicLoad(&running, RELAXED))
+            {
+                Operation::run(scheme, stack, locked, manager, mine, value++);
+            }
+        }));
+    }
+
+    state.startTiming();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Operation::run(scheme, stack, locked, manager, leaked[0], (long) i);
+    }
+    state.stopTiming();
+
+    atomicStore(&running, 0);
+    for (int t = 0; t < otherCount; ++t)
+    {
+        others[t].join();
+    }
+
+    for (std::size_t t = 0; t < leaked.size(); ++t)
+    {
+        for (std::size_t i = 0; i < leaked[t].size(); ++i)
+        {
+            delete leaked[t][i];
+        }
+    }
+    while (Node* node = stack.pop())
+    {
+        delete node;
+    }
+    while (locked.popAndFree())
+    {
+    }
+}
+
+AXF_BENCHMARK(pin_unpin)
+{
+    EpochManager manager;
+    while (state.keepRunning())
+    {
+        EpochManager::Guard guard(manager);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(push_pop_no_reclamation)
+{
+    pushPop(state, NO_RECLAMATION, 0);
+}
+
+AXF_BENCHMARK(push_pop_epochs)
+{
+    pushPop(state, EPOCHS, 0);
+}
+
+AXF_BENCHMARK(push_pop_locked)
+{
+    pushPop(state, LOCKED, 0);
+}
+
+AXF_BENCHMARK(push_pop_no_reclamation_3_others)
+{
+    pushPop(state, NO_RECLAMATION, 3);
+}
+
+AXF_BENCHMARK(push_pop_epochs_3_others)
+{
+    pushPop(state, EPOCHS, 3);
+}
+
+AXF_BENCHMARK(push_pop_locked_3_others)
+{
+    pushPop(state, LOCKED, 3);
+}
+
+AXF_BENCHMARK_MAIN()
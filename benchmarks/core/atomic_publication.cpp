@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   atomic_publication.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:15 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::concurrent;
+using namespace axf::core;
+
+/*
+ * Readers loading a shared configuration while a writer publishes a new
+ * version every 50 microseconds: through an atomic_strong_ref, and through a
+ * strong_ref guarded by a mutex. The time reported is per round, in which
+ * every reader loads the configuration once.
+ */
+
+class Config : public Object
+{
+    AXF_CLASS_TYPE(Config, AXF_TYPE(axf::core::Object))
+public:
+
+    long m_version;
+
+    explicit Config(long version) : m_version(version) { }
+} ;
+
+/**
+ * A strong reference published under a mutex.
+ */
+class LockedRef
+{
+public:
+
+    explicit LockedRef(const strong_ref<Config>& value) : m_value(value) { }
+
+    strong_ref<Config> load()
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        return m_value;
+    }
+
+    void store(const strong_ref<Config>& value)
+    {
+        strong_ref<Config> previous;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            previous = m_value;
+            m_value = value;
+        }
+    }
+
+private:
+
+    std::mutex          m_mutex;
+    strong_ref<Config>  m_value;
+} ;
+
+template <typename R>
+static void readPublished(State& state, R& current, int readerCount)
+{
+    const std::size_t count = state.iterations();
+    volatile int readersLeft = readerCount;
+    volatile long published = 0;
+
+    state.startTiming();
+    std::thread writer([&current, &readersLeft, &published]() {
+        long version = 1;
+        while (atomicLoad(&readersLeft, ACQUIRE) > 0)
+        {
+            current.store(strong_ref<Config>(new Config(++version)));
+            published = published + 1;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < readerCount; ++t)
+    {
+        readers.push_back(std::thread([&current, &readersLeft, count]() {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                strong_ref<Config> config = current.load();
+                doNotOptimize(config->m_version);
+            }
+            atomicFetchSub(&readersLeft, 1);
+        }));
+    }
+    for (int t = 0; t < readerCount; ++t)
+    {
+        readers[t].join();
+    }
+    writer.join();
+    state.stopTiming();
+
+    state.setCounter("readers", readerCount);
+    state.setCounter("versions", (double) published);
+}
+
+static void readAtomic(State& state, int readerCount)
+{
+    atomic_strong_ref<Config> current(strong_ref<Config>(new Config(1)));
+    readPublished(state, current, readerCount);
+}
+
+static void readLocked(State& state, int readerCount)
+{
+    LockedRef current(strong_ref<Config>(new Config(1)));
+    readPublished(state, current, readerCount);
+}
+
+AXF_BENCHMARK(atomic_strong_ref_1_reader)
+{
+    readAtomic(state, 1);
+}
+
+AXF_BENCHMARK(mutex_strong_ref_1_reader)
+{
+    readLocked(state, 1);
+}
+
+AXF_BENCHMARK(atomic_strong_ref_4_readers)
+{
+    readAtomic(state, 4);
+}
+
+AXF_BENCHMARK(mutex_strong_ref_4_readers)
+{
+    readLocked(state, 4);
+}
+
+AXF_BENCHMARK(atomic_strong_ref_16_readers)
+{
+    readAtomic(state, 16);
+}
+
+AXF_BENCHMARK(mutex_strong_ref_16_readers)
+{
+    readLocked(state, 16);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   biased_refcount.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:50 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::concurrent;
+using namespace axf::core;
+
+/*
+ * Reference counting throughput of objects biased towards a thread, against
+ * the uniformly atomic counts of plain objects: by the owner alone, and by
+ * the owner while other threads reference the same object. The library must
+ * be built with AXF_BIASED_REFERENCES defined for the two to differ.
+ */
+
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    Node() : m_value(1) { }
+} ;
+
+static strong_ref<Node> makeNode(bool biased)
+{
+    strong_ref<Node> node(new Node());
+    if (biased)
+    {
+        node->biasToCurrentThread();
+    }
+    return node;
+}
+
+static void grabRelease(State& state, bool biased)
+{
+    strong_ref<Node> node = makeNode(biased);
+    const Node* object = node.get();
+    while (state.keepRunning())
+    {
+        object->grabStrongReference();
+        clobberMemory();
+        object->releaseStrongReference();
+    }
+}
+
+AXF_BENCHMARK(grab_release_uniform)
+{
+    grabRelease(state, false);
+}
+
+AXF_BENCHMARK(grab_release_biased)
+{
+    grabRelease(state, true);
+}
+
+/**
+ * Copies strong references the way containers and arguments do: a few
+ * references taken, then dropped in reverse order.
+ */
+static void copyReferences(State& state, bool biased)
+{
+    strong_ref<Node> node = makeNode(biased);
+    while (state.keepRunning())
+    {
+        strong_ref<Node> a = node;
+        strong_ref<Node> b = a;
+        strong_ref<Node> c = b;
+        doNotOptimize(c->m_value);
+    }
+}
+
+AXF_BENCHMARK(copy_3_uniform)
+{
+    copyReferences(state, false);
+}
+
+AXF_BENCHMARK(copy_3_biased)
+{
+    copyReferences(state, true);
+}
+
+/**
+ * The owner copies references to an object while other threads copy their
+ * own references to it too, at the same rate. The time reported is per copy
+ * of the owner; the other threads stop when it is done.
+ */
+static void mixedThreads(State& state, bool biased, int otherCount)
+{
+    strong_ref<Node> node = makeNode(biased);
+    const std::size_t count = state.iterations();
+    volatile int running = 1;
+    volatile long otherCopies = 0;
+
+    std::vector<std::thread> others;
+    for (int t = 0; t < otherCount; ++t)
+    {
+        strong_ref<Node> mine = node;
+        others.push_back(std::thread([mine, &running, &otherCopies]() {
+            long copies = 0;
+            while (atomicLoad(&running, RELAXED))
+            {
+                strong_ref<Node> copy = mine;
+                doNotOptimize(copy->m_value);
+                copies++;
+            }
+            atomicFetchAdd(&otherCopies, copies);
+        }));
+    }
+
+    state.startTiming();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        strong_ref<Node> copy = node;
+        doNotOptimize(copy->m_value);
+    }
+    state.stopTiming();
+
+    atomicStore(&running, 0);
+    for (int t = 0; t < otherCount; ++t)
+    {
+        others[t].join();
+    }
+
+    state.setCounter("other threads", otherCount);
+    state.setCounter("other copies", (double) otherCopies);
+}
+
+AXF_BENCHMARK(mixed_1_other_uniform)
+{
+    mixedThreads(state, false, 1);
+}
+
+AXF_BENCHMARK(mixed_1_other_biased)
+{
+    mixedThreads(state, true, 1);
+}
+
+AXF_BENCHMARK(mixed_3_others_uniform)
+{
+    mixedThreads(state, false, 3);
+}
+
+AXF_BENCHMARK(mixed_3_others_biased)
+{
+    mixedThreads(state, true, 3);
+}
+
+/**
+ * Objects created and biased by one thread, whose last reference is dropped
+ * by another: the cost of handing the reference over and merging it.
+ */
+static void handOver(State& state, bool biased)
+{
+    const std::size_t count = state.iterations();
+    std::vector<strong_ref<Node> > nodes(count);
+
+    state.startTiming();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        strong_ref<Node> node = makeNode(biased);
+        nodes[i] = node;
+    }
+    std::thread dropper([&nodes]() {
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].reset();
+        }
+    });
+    dropper.join();
+    ReferenceCounted::mergeBiasedReferences();
+    state.stopTiming();
+}
+
+AXF_BENCHMARK(hand_over_uniform)
+{
+    handOver(state, false);
+}
+
+AXF_BENCHMARK(hand_over_biased)
+{
+    handOver(state, true);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   cached_hash.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 9:10 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::collections;
+using namespace axf::core;
+
+static const int KEY_COUNT = 4096;
+
+static const char* keyName(int i)
+{
+    static char buffer[96];
+    std::sprintf(buffer, "service.%d.connection-pool.max-idle-timeout-ms", i);
+    return buffer;
+}
+
+// String keys
+
+struct UncachedStringHasher
+{
+
+    std::size_t operator()(const string& key) const
+    {
+        return (std::size_t) hash(key.bytes(), key.size());
+    }
+} ;
+
+struct CachedStringHasher
+{
+
+    std::size_t operator()(const string& key) const
+    {
+        return (std::size_t) (unsigned) key.hashCode();
+    }
+} ;
+
+struct StringEquals
+{
+
+    bool operator()(const string& lhs, const string& rhs) const
+    {
+        return lhs.equals(rhs);
+    }
+} ;
+
+/**
+ * Looks up long lived probe strings, as a configuration or symbol table
+ * would. The probes are copies of the keys, so equality compares bytes.
+ */
+template <typename Hasher>
+static void stringLookup(State& state)
+{
+    std::unordered_map<string, int, Hasher, StringEquals> map;
+    std::vector<string> probes;
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        map[string(keyName(i))] = i;
+        probes.push_back(string(keyName(i)));
+    }
+
+    int index = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(map.find(probes[index])->second);
+        index = (index + 1) & (KEY_COUNT - 1);
+    }
+}
+
+AXF_BENCHMARK(string_map_lookup_uncached)
+{
+    stringLookup<UncachedStringHasher>(state);
+}
+
+AXF_BENCHMARK(string_map_lookup_cached)
+{
+    stringLookup<CachedStringHasher>(state);
+}
+
+// Object keys
+
+/**
+ * A composite key hashed on every call. The name is hashed from its bytes so
+ * that it does not benefit from the cache of the string either.
+ */
+class UncachedKey : public Object, public IntrusiveHashHook<>
+{
+    AXF_CLASS_TYPE(UncachedKey, AXF_TYPE(axf::core::Object))
+    AXF_HASH_FIELDS(m_name.bytes(), m_shard, m_version)
+public:
+
+    UncachedKey(const char* name, int shard) : m_name(name), m_shard(shard), m_version(1) { }
+
+    virtual bool equals(const Object& object) const
+    {
+        const UncachedKey& rhs = static_cast<const UncachedKey&> (object);
+        return m_shard == rhs.m_shard && m_version == rhs.m_version && m_name.equals(rhs.m_name);
+    }
+
+private:
+
+    string      m_name;
+    int         m_shard;
+    long long   m_version;
+} ;
+
+/**
+ * The same key, hashed once.
+ */
+class CachedKey : public Object, public CachedHash, public IntrusiveHashHook<>
+{
+    AXF_CLASS_TYPE(CachedKey, AXF_TYPE(axf::core::Object))
+    AXF_CACHED_HASH_FIELDS(m_name.bytes(), m_shard, m_version)
+public:
+
+    CachedKey(const char* name, int shard) : m_name(name), m_shard(shard), m_version(1) { }
+
+    virtual bool equals(const Object& object) const
+    {
+        const CachedKey& rhs = static_cast<const CachedKey&> (object);
+        return m_shard == rhs.m_shard && m_version == rhs.m_version && m_name.equals(rhs.m_name);
+    }
+
+private:
+
+    string      m_name;
+    int         m_shard;
+    long long   m_version;
+} ;
+
+template <typename Key>
+static void objectLookup(State& state)
+{
+    IntrusiveHashSet<Key, DefaultHookTag, true> set;
+    std::vector<Key*> probes;
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        set.insert(*new Key(keyName(i), i % 16));
+        probes.push_back(new Key(keyName(i), i % 16));
+    }
+
+    int index = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(set.find(*probes[index]));
+        index = (index + 1) & (KEY_COUNT - 1);
+    }
+
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        delete probes[i];
+    }
+}
+
+AXF_BENCHMARK(object_set_lookup_uncached)
+{
+    objectLookup<UncachedKey>(state);
+}
+
+AXF_BENCHMARK(object_set_lookup_cached)
+{
+    objectLookup<CachedKey>(state);
+}
+
+// Type names
+
+/**
+ * Compares a type against a name held in another buffer, which has to be
+ * hashed, and against the literal the type was declared with, which is
+ * recognized by address.
+ */
+AXF_BENCHMARK(type_equals_copied_name)
+{
+    const bits::Type& type = CachedKey::getCompileTimeClass();
+    std::string name(type.getName());
+    while (state.keepRunning())
+    {
+        doNotOptimize(type.equals(name.c_str()));
+    }
+}
+
+AXF_BENCHMARK(type_equals_same_literal)
+{
+    const bits::Type& type = CachedKey::getCompileTimeClass();
+    const char* name = type.getName();
+    while (state.keepRunning())
+    {
+        doNotOptimize(type.equals(name));
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   class_pools.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 11:10 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::concurrent;
+using namespace axf::core;
+
+/*
+ * Message churn with and without class pools: messages created and
+ * released right away, kept in flight for a while, and passed from a
+ * producer thread to a consumer thread.
+ */
+
+class HeapMessage : public Object
+{
+    AXF_CLASS_TYPE(HeapMessage, AXF_TYPE(axf::core::Object))
+public:
+
+    int     m_kind;
+    long    m_stamp;
+    char    m_payload[24];
+
+    explicit HeapMessage(int kind) : m_kind(kind), m_stamp(kind) { }
+} ;
+
+class PooledMessage : public Object
+{
+    AXF_CLASS_TYPE(PooledMessage, AXF_TYPE(axf::core::Object))
+    AXF_CLASS_POOL(PooledMessage)
+public:
+
+    int     m_kind;
+    long    m_stamp;
+    char    m_payload[24];
+
+    explicit PooledMessage(int kind) : m_kind(kind), m_stamp(kind) { }
+} ;
+
+template <typename M>
+static void createRelease(State& state)
+{
+    int kind = 0;
+    while (state.keepRunning())
+    {
+        strong_ref<M> message(new M(kind++));
+        doNotOptimize(message->m_stamp);
+    }
+}
+
+AXF_BENCHMARK(create_release_heap)
+{
+    createRelease<HeapMessage>(state);
+}
+
+AXF_BENCHMARK(create_release_pooled)
+{
+    createRelease<PooledMessage>(state);
+}
+
+/**
+ * Keeps the last 1024 messages alive, so each allocation gets the memory of
+ * a message released long ago.
+ */
+template <typename M>
+static void inFlight(State& state)
+{
+    std::vector<strong_ref<M> > window(1024);
+    std::size_t slot = 0;
+    while (state.keepRunning())
+    {
+        window[slot] = strong_ref<M>(new M((int) slot));
+        slot = (slot + 1) & (window.size() - 1);
+    }
+}
+
+AXF_BENCHMARK(in_flight_heap)
+{
+    inFlight<HeapMessage>(state);
+}
+
+AXF_BENCHMARK(in_flight_pooled)
+{
+    inFlight<PooledMessage>(state);
+}
+
+/**
+ * A producer creates batches of messages that a consumer thread releases;
+ * the time is per message.
+ */
+template <typename M>
+static void producerConsumer(State& state)
+{
+    const std::size_t count = state.iterations();
+    const std::size_t batchSize = 256;
+
+    state.startTiming();
+    for (std::size_t done = 0; done < count; done += batchSize)
+    {
+        std::vector<strong_ref<M> > batch;
+        batch.reserve(batchSize);
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            batch.push_back(strong_ref<M>(new M((int) i)));
+        }
+
+        std::thread consumer([&batch]() {
+            batch.clear();
+        });
+        consumer.join();
+    }
+    state.stopTiming();
+}
+
+AXF_BENCHMARK(producer_consumer_heap)
+{
+    producerConsumer<HeapMessage>(state);
+}
+
+AXF_BENCHMARK(producer_consumer_pooled)
+{
+    producerConsumer<PooledMessage>(state);
+}
+
+AXF_BENCHMARK_MAIN()
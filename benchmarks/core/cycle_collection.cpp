@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   cycle_collection.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 9:30 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/*
+ * The cycle collector on synthetic graphs: the cost of recording candidates
+ * when references are released, the throughput of collecting garbage rings
+ * and of examining live cyclic graphs, and the pauses of incremental
+ * collections with a budget. Unless the library is built with
+ * AXF_CYCLE_COLLECTION defined, nothing is ever collected, so only the
+ * releases are measured: the garbage the other benchmarks drop would pile
+ * up instead.
+ */
+
+class Vertex : public Object
+{
+    AXF_CLASS_TYPE(Vertex, AXF_TYPE(axf::core::Object))
+public:
+
+    std::vector<strong_ref<Object> > m_edges;
+
+    explicit Vertex(bool collectable)
+    {
+        if (collectable)
+        {
+            enableCycleCollection();
+        }
+    }
+
+    void connect(Vertex* to)
+    {
+        m_edges.push_back(strong_ref<Object>(to));
+    }
+
+    virtual void traverseReferences(ReferenceVisitor& visitor) const
+    {
+        for (std::size_t i = 0; i < m_edges.size(); ++i)
+        {
+            visitor.visit(m_edges[i]);
+        }
+    }
+} ;
+
+static void releaseCopies(State& state, bool collectable)
+{
+    strong_ref<Vertex> vertex(new Vertex(collectable));
+    while (state.keepRunning())
+    {
+        strong_ref<Vertex> copy = vertex;
+        doNotOptimize(copy.get());
+    }
+    CycleCollector::collect();
+}
+
+AXF_BENCHMARK(release_not_collectable)
+{
+    releaseCopies(state, false);
+}
+
+AXF_BENCHMARK(release_collectable)
+{
+    releaseCopies(state, true);
+}
+
+#ifdef AXF_CYCLE_COLLECTION
+
+static const std::size_t RING_SIZE = 16;
+
+/**
+ * Builds rings of vertices and drops them, leaving them to the collector.
+ */
+static void dropRings(std::size_t count)
+{
+    for (std::size_t r = 0; r < count; ++r)
+    {
+        strong_ref<Vertex> first(new Vertex(true));
+        Vertex* last = first.get();
+        for (std::size_t i = 1; i < RING_SIZE; ++i)
+        {
+            Vertex* vertex = new Vertex(true);
+            last->connect(vertex);
+            last = vertex;
+        }
+        last->connect(first.get());
+    }
+}
+
+/**
+ * Builds a live graph of vertices, each referencing three random others,
+ * held by one external reference per vertex.
+ */
+static std::vector<strong_ref<Vertex> > liveGraph(std::size_t size)
+{
+    std::vector<strong_ref<Vertex> > vertices;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        vertices.push_back(strong_ref<Vertex>(new Vertex(true)));
+    }
+
+    unsigned seed = 12345;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            seed = seed * 1103515245u + 12345u;
+            vertices[i]->connect(vertices[(seed >> 8) % size].get());
+        }
+    }
+    return vertices;
+}
+
+/**
+ * The time reported is per ring of 16 vertices collected.
+ */
+AXF_BENCHMARK(collect_garbage_rings)
+{
+    const std::size_t count = state.iterations();
+
+    state.stopTiming();
+    dropRings(count);
+    state.startTiming();
+
+    std::size_t collected = CycleCollector::collect();
+
+    state.setCounter("collected", (double) collected);
+}
+
+/**
+ * Examines a live graph of 65536 vertices from one candidate. The time
+ * reported is per collection, which examines the whole graph.
+ */
+AXF_BENCHMARK(collect_live_graph)
+{
+    const std::size_t count = state.iterations();
+
+    state.stopTiming();
+    std::vector<strong_ref<Vertex> > vertices = liveGraph(65536);
+    state.startTiming();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Releasing a copy records the vertex as a candidate again
+        strong_ref<Vertex> copy = vertices[0];
+        copy.reset();
+        CycleCollector::collect();
+    }
+
+    state.stopTiming();
+    vertices.clear();
+    CycleCollector::collect();
+    state.startTiming();
+}
+
+/**
+ * Collects garbage rings in increments of a given budget. The time reported
+ * is per ring; the counters report the pause of each increment.
+ */
+static void incrementalPauses(State& state, std::size_t budget)
+{
+    const std::size_t count = state.iterations();
+    std::vector<double> pauses;
+
+    state.stopTiming();
+    dropRings(count);
+    state.startTiming();
+
+    while (CycleCollector::candidates() > 0)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        CycleCollector::collect(budget);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        pauses.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    std::sort(pauses.begin(), pauses.end());
+    state.setCounter("pauses", (double) pauses.size());
+    state.setCounter("p50 us", pauses[pauses.size() / 2]);
+    state.setCounter("p99 us", pauses[(pauses.size() * 99) / 100]);
+    state.setCounter("max us", pauses.back());
+}
+
+AXF_BENCHMARK(incremental_budget_256)
+{
+    incrementalPauses(state, 256);
+}
+
+AXF_BENCHMARK(incremental_budget_4096)
+{
+    incrementalPauses(state, 4096);
+}
+
+AXF_BENCHMARK(incremental_unbounded)
+{
+    incrementalPauses(state, (std::size_t) -1);
+}
+#endif
+
+AXF_BENCHMARK_MAIN()
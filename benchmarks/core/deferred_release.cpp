@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   deferred_release.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 7:40 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/*
+ * Request latency when large object graphs are released: inline, deferred
+ * and drained in bounded batches at the end of each request, and handed over
+ * to a background reclaimer. Every request builds a tree of 1024 nodes and
+ * attaches it to the current session; every 64 requests the session, about
+ * 65000 nodes, is dropped and a new one starts. An iteration is a whole
+ * session; the counters report the latency of single requests, over every
+ * session served by the benchmark.
+ */
+
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+public:
+
+    strong_ref<Object> m_left;
+    strong_ref<Object> m_right;
+    long               m_value;
+
+    explicit Node(long value) : m_value(value) { }
+} ;
+
+class Session : public Object
+{
+    AXF_CLASS_TYPE(Session, AXF_TYPE(axf::core::Object))
+public:
+
+    std::vector<strong_ref<Object> > m_trees;
+} ;
+
+static const int TREE_DEPTH = 10;           /// 1023 nodes per tree
+static const int SESSION_LENGTH = 64;       /// Requests per session
+static const std::size_t DRAIN_BUDGET = 4096;
+
+static strong_ref<Object> tree(int depth, long value)
+{
+    Node* node = new Node(value);
+    if (depth > 1)
+    {
+        node->m_left = tree(depth - 1, value * 2);
+        node->m_right = tree(depth - 1, value * 2 + 1);
+    }
+    return strong_ref<Object>(node);
+}
+
+typedef enum Mode
+{
+    MODE_INLINE,
+    MODE_DEFERRED,
+    MODE_RECLAIMER
+} Mode;
+
+static void serve(State& state, Mode mode, std::vector<double>& latencies)
+{
+    const std::size_t count = state.iterations() * SESSION_LENGTH;
+
+    Reclaimer reclaimer;
+    if (mode == MODE_DEFERRED)
+    {
+        DeferredRelease::enable();
+    }
+    else if (mode == MODE_RECLAIMER)
+    {
+        DeferredRelease::enable(reclaimer);
+    }
+
+    strong_ref<Session> session(new Session());
+    state.startTiming();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        session->m_trees.push_back(tree(TREE_DEPTH, (long) i));
+        if ((i + 1) % SESSION_LENGTH == 0)
+        {
+            session = strong_ref<Session>(new Session());
+        }
+        if (mode == MODE_DEFERRED)
+        {
+            // The safe point at the end of the request
+            DeferredRelease::drain(DRAIN_BUDGET);
+        }
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    state.stopTiming();
+
+    session.reset();
+    DeferredRelease::disable();
+    reclaimer.flush();
+
+    std::vector<double> sorted(latencies);
+    std::sort(sorted.begin(), sorted.end());
+    state.setCounter("requests", (double) sorted.size());
+    state.setCounter("p50 us", sorted[sorted.size() / 2]);
+    state.setCounter("p99 us", sorted[(sorted.size() * 99) / 100]);
+    state.setCounter("max us", sorted.back());
+}
+
+AXF_BENCHMARK(release_inline)
+{
+    static std::vector<double> latencies;
+    serve(state, MODE_INLINE, latencies);
+}
+
+AXF_BENCHMARK(release_deferred)
+{
+    static std::vector<double> latencies;
+    serve(state, MODE_DEFERRED, latencies);
+}
+
+AXF_BENCHMARK(release_reclaimer)
+{
+    static std::vector<double> latencies;
+    serve(state, MODE_RECLAIMER, latencies);
+}
+
+AXF_BENCHMARK_MAIN()
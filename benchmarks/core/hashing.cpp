@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   hashing.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 8:20 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/**
+ * Byte-at-a-time FNV-1a, the hash Object and Class used before.
+ */
+static hash_t fnv1a(const void* data, std::size_t length)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*> (data);
+    hash_t h = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        h = (h ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+struct AxfHasher
+{
+
+    static hash_t apply(const std::string& key)
+    {
+        return hash(key.data(), key.size());
+    }
+} ;
+
+struct FnvHasher
+{
+
+    static hash_t apply(const std::string& key)
+    {
+        return fnv1a(key.data(), key.size());
+    }
+} ;
+
+struct StdHasher
+{
+
+    static hash_t apply(const std::string& key)
+    {
+        return std::hash<std::string>()(key);
+    }
+} ;
+
+// Throughput
+
+template <typename Hasher>
+static void throughput(State& state, std::size_t length)
+{
+    std::string buffer(length, '\0');
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        buffer[i] = (char) (i * 31 + 17);
+    }
+
+    while (state.keepRunning())
+    {
+        doNotOptimize(Hasher::apply(buffer));
+        clobberMemory();
+    }
+    state.setCounter("GB/s", (double) length * state.iterations() / state.elapsedNanoseconds());
+}
+
+#define AXF_HASH_THROUGHPUT(hasher, length) \
+    AXF_BENCHMARK(hasher##_##length) { throughput<hasher##Hasher>(state, length); }
+
+#define AXF_HASH_THROUGHPUT_ALL(hasher) \
+    AXF_HASH_THROUGHPUT(hasher, 8) \
+    AXF_HASH_THROUGHPUT(hasher, 16) \
+    AXF_HASH_THROUGHPUT(hasher, 64) \
+    AXF_HASH_THROUGHPUT(hasher, 256) \
+    AXF_HASH_THROUGHPUT(hasher, 4096) \
+    AXF_HASH_THROUGHPUT(hasher, 65536)
+
+AXF_HASH_THROUGHPUT_ALL(Axf)
+AXF_HASH_THROUGHPUT_ALL(Fnv)
+AXF_HASH_THROUGHPUT_ALL(Std)
+
+// Realistic keys
+
+static const std::vector<std::string>& keys()
+{
+    static std::vector<std::string> result;
+    if (result.empty())
+    {
+        static const char* typeNames[] = {
+            "axf::core::Object", "axf::core::Class", "axf::core::string", "axf::collections::ArrayList",
+            "axf::collections::LinkedList", "axf::collections::HashSet", "axf::core::Exception",
+        };
+
+        char buffer[128];
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::sprintf(buffer, "user:%d", i);
+            result.push_back(buffer);
+            std::sprintf(buffer, "https://example.com/api/v1/items/%d?page=%d", i / 10, i % 10);
+            result.push_back(buffer);
+            std::sprintf(buffer, "%s<%d>", typeNames[i % 7], i);
+            result.push_back(buffer);
+
+            // Sequential integers, as raw little words
+            result.push_back(std::string(reinterpret_cast<const char*> (&i), sizeof (i)));
+        }
+    }
+    return result;
+}
+
+/**
+ * Hashes the realistic key set, then reports how evenly the keys fall into
+ * 2^16 buckets (low bits of the folded hash, as a power-of-two table would
+ * use them). The chi-squared ratio is close to 1 for a uniform hash.
+ */
+template <typename Hasher>
+static void keyset(State& state)
+{
+    const std::vector<std::string>& set = keys();
+    std::size_t index = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(Hasher::apply(set[index]));
+        if (++index == set.size())
+        {
+            index = 0;
+        }
+    }
+
+    state.stopTiming();
+    const std::size_t bucketCount = 1 << 16;
+    std::vector<unsigned> buckets(bucketCount, 0);
+    for (std::size_t i = 0; i < set.size(); ++i)
+    {
+        buckets[foldHash(Hasher::apply(set[i])) & (bucketCount - 1)]++;
+    }
+
+    double expected = (double) set.size() / bucketCount;
+    double chiSquared = 0;
+    std::size_t collisions = 0;
+    for (std::size_t b = 0; b < bucketCount; ++b)
+    {
+        double delta = buckets[b] - expected;
+        chiSquared += delta * delta / expected;
+        if (buckets[b] > 1)
+        {
+            collisions += buckets[b] - 1;
+        }
+    }
+
+    // A uniform hash gives n - m(1 - (1 - 1/m)^n) collisions on average
+    double uniform = set.size() - bucketCount * (1 - std::pow(1 - 1.0 / bucketCount, (double) set.size()));
+    state.setCounter("collisions", (double) collisions);
+    state.setCounter("collisions/uniform", collisions / uniform);
+    state.setCounter("chi2/dof", chiSquared / (bucketCount - 1));
+}
+
+AXF_BENCHMARK(Axf_keys)
+{
+    keyset<AxfHasher>(state);
+}
+
+AXF_BENCHMARK(Fnv_keys)
+{
+    keyset<FnvHasher>(state);
+}
+
+AXF_BENCHMARK(Std_keys)
+{
+    keyset<StdHasher>(state);
+}
+
+AXF_BENCHMARK_MAIN()
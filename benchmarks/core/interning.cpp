@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   interning.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 10:40 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+static const std::size_t NAME_COUNT = 1 << 16;     /// Power of two
+
+static const std::vector<std::string>& names()
+{
+    static std::vector<std::string> result;
+    if (result.empty())
+    {
+        char buffer[96];
+        for (std::size_t i = 0; i < NAME_COUNT; ++i)
+        {
+            std::sprintf(buffer, "protocol.message.header.field_%zu", i);
+            result.push_back(buffer);
+        }
+    }
+    return result;
+}
+
+class Shape : public Object
+{
+    AXF_CLASS_TYPE(Shape, AXF_TYPE(axf::core::Object))
+} ;
+
+class Polygon : public Shape
+{
+    AXF_CLASS_TYPE(Polygon, AXF_TYPE(Shape))
+} ;
+
+class Square : public Polygon
+{
+    AXF_CLASS_TYPE(Square, AXF_TYPE(Polygon))
+} ;
+
+// Intern throughput
+
+/**
+ * Interns strings that are already in the pool: a hash, a locked bucket scan
+ * and one byte comparison.
+ */
+AXF_BENCHMARK(intern_existing)
+{
+    const std::vector<std::string>& set = names();
+    InternPool pool;
+    for (std::size_t i = 0; i < NAME_COUNT; ++i)
+    {
+        pool.intern(set[i].c_str(), set[i].size());
+    }
+
+    std::size_t index = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(pool.intern(set[index].c_str(), set[index].size()));
+        index = (index + 1) & (NAME_COUNT - 1);
+    }
+}
+
+/**
+ * Interns strings never seen before. The pool is replaced, untimed, whenever
+ * the names run out.
+ */
+AXF_BENCHMARK(intern_new)
+{
+    const std::vector<std::string>& set = names();
+    InternPool* pool = new InternPool();
+
+    std::size_t index = 0;
+    while (state.keepRunning())
+    {
+        doNotOptimize(pool->intern(set[index].c_str(), set[index].size()));
+        if (ARTEMIS_UNLIKELY(++index == NAME_COUNT))
+        {
+            state.stopTiming();
+            delete pool;
+            pool = new InternPool();
+            index = 0;
+            state.startTiming();
+        }
+    }
+    delete pool;
+}
+
+/**
+ * Several threads interning existing strings. The time reported is per
+ * round, in which every thread interns one string.
+ */
+static void internConcurrently(State& state, int threadCount)
+{
+    const std::vector<std::string>& set = names();
+    InternPool pool;
+    for (std::size_t i = 0; i < NAME_COUNT; ++i)
+    {
+        pool.intern(set[i].c_str(), set[i].size());
+    }
+
+    const std::size_t count = state.iterations();
+    state.startTiming();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([&pool, &set, count, t]() {
+            std::size_t index = t * (NAME_COUNT / 4);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                doNotOptimize(pool.intern(set[index].c_str(), set[index].size()));
+                index = (index + 1) & (NAME_COUNT - 1);
+            }
+        }));
+    }
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t].join();
+    }
+    state.stopTiming();
+    state.setCounter("threads", threadCount);
+}
+
+AXF_BENCHMARK(intern_existing_2_threads)
+{
+    internConcurrently(state, 2);
+}
+
+AXF_BENCHMARK(intern_existing_4_threads)
+{
+    internConcurrently(state, 4);
+}
+
+// Comparison
+
+/**
+ * Compares two equal names held in different buffers, the cost every string
+ * comparison pays when the strings are equal.
+ */
+AXF_BENCHMARK(compare_strcmp_equal)
+{
+    std::string lhs = names()[42];
+    std::string rhs = names()[42];
+    while (state.keepRunning())
+    {
+        doNotOptimize(std::strcmp(lhs.c_str(), rhs.c_str()) == 0);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(compare_hash_equal)
+{
+    std::string lhs = names()[42];
+    std::string rhs = names()[42];
+    while (state.keepRunning())
+    {
+        doNotOptimize(hash(lhs.c_str(), lhs.size()) == hash(rhs.c_str(), rhs.size()));
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(compare_interned_equal)
+{
+    InternedString lhs = InternPool::global().intern(names()[42].c_str());
+    InternedString rhs = InternPool::global().intern(names()[42].c_str());
+    while (state.keepRunning())
+    {
+        doNotOptimize(lhs == rhs);
+        clobberMemory();
+    }
+}
+
+// Type look-ups
+
+/**
+ * Walks two levels of the inheritance graph looking for a type by name. The
+ * name is looked up once in the pool, then every step is a pointer compare.
+ */
+AXF_BENCHMARK(type_super_class_by_name)
+{
+    const Class<Square>& square = Square::getCompileTimeClass();
+    std::string name("Shape");
+    while (state.keepRunning())
+    {
+        doNotOptimize(&square.getSuperClass(name.c_str()));
+    }
+}
+
+AXF_BENCHMARK(type_super_class_by_interned_name)
+{
+    const Class<Square>& square = Square::getCompileTimeClass();
+    InternedString name = Shape::getCompileTimeClass().getInternedName();
+    while (state.keepRunning())
+    {
+        doNotOptimize(&square.getSuperClass(name));
+    }
+}
+
+AXF_BENCHMARK(type_is_kind_of)
+{
+    const Class<Square>& square = Square::getCompileTimeClass();
+    const Class<Shape>& shape = Shape::getCompileTimeClass();
+    while (state.keepRunning())
+    {
+        doNotOptimize(square.isKindOf(shape));
+    }
+}
+
+AXF_BENCHMARK_MAIN()
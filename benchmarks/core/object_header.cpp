@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   object_header.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 8:40 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define AXF_BENCHMARK_HEAP_USAGE
+#endif
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/*
+ * The footprint and allocation throughput of small objects, whose size is
+ * dominated by the header every object carries. Build the library and this
+ * benchmark once as they are and once with -DAXF_COMPACT_OBJECT_HEADER to
+ * compare standard and compact headers, for instance with
+ *
+ *   make benchmark BENCHMARK_DIR=build/compact \
+ *        BENCHMARK_CXXFLAGS="-std=c++11 -O2 -DNDEBUG -pthread -DAXF_COMPACT_OBJECT_HEADER"
+ *
+ * The footprint counters report the sizes, and the heap taken per object.
+ */
+
+/**
+ * A small object, a list cell holding an integer.
+ */
+class Cell : public Object
+{
+    AXF_CLASS_TYPE(Cell, AXF_TYPE(axf::core::Object))
+public:
+
+    int                 m_value;
+    strong_ref<Object>  m_next;
+
+    explicit Cell(int value) : m_value(value) { }
+} ;
+
+/**
+ * A boxed integer, the smallest useful object.
+ */
+class Box : public Object
+{
+    AXF_CLASS_TYPE(Box, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    explicit Box(int value) : m_value(value) { }
+} ;
+
+static const std::size_t LIST_LENGTH = 1 << 20;
+
+/**
+ * Returns the bytes currently allocated from the heap, if known.
+ *
+ * @return
+ */
+static double heapInUse()
+{
+#ifdef AXF_BENCHMARK_HEAP_USAGE
+    return (double) mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static strong_ref<Object> buildList(std::size_t length)
+{
+    strong_ref<Object> head;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        Cell* cell = new Cell((int) i);
+        cell->m_next = head;
+        head = strong_ref<Object>(cell);
+    }
+    return head;
+}
+
+/**
+ * Releases a list iteratively, since releasing the head would destroy the
+ * cells recursively.
+ */
+static void dropList(strong_ref<Object>& head)
+{
+    while (head.get() != NULL)
+    {
+        strong_ref<Object> next = static_cast<Cell*> (head.get())->m_next;
+        head = next;
+    }
+}
+
+AXF_BENCHMARK(footprint)
+{
+    std::vector<strong_ref<Box> > boxes;
+    boxes.reserve(LIST_LENGTH);
+
+    double boxHeap = 0;
+    double cellHeap = 0;
+    while (state.keepRunning())
+    {
+        double before = heapInUse();
+        for (std::size_t i = 0; i < LIST_LENGTH; ++i)
+        {
+            boxes.push_back(strong_ref<Box>(new Box((int) i)));
+        }
+        boxHeap = heapInUse() - before;
+        boxes.clear();
+
+        before = heapInUse();
+        strong_ref<Object> head = buildList(LIST_LENGTH);
+        cellHeap = heapInUse() - before;
+        dropList(head);
+    }
+
+    state.setCounter("header bytes", (double) sizeof (ReferenceCounted));
+    state.setCounter("box bytes", (double) sizeof (Box));
+    state.setCounter("cell bytes", (double) sizeof (Cell));
+#ifdef AXF_BENCHMARK_HEAP_USAGE
+    state.setCounter("heap per box", boxHeap / LIST_LENGTH);
+    state.setCounter("heap per cell", cellHeap / LIST_LENGTH);
+#else
+    (void) boxHeap;
+    (void) cellHeap;
+#endif
+}
+
+/**
+ * Allocates boxes into a ring of references, releasing the box each slot
+ * held before: one allocation and one destruction per iteration.
+ */
+AXF_BENCHMARK(allocate_release_boxes)
+{
+    std::vector<strong_ref<Box> > ring(4096);
+    std::size_t slot = 0;
+    while (state.keepRunning())
+    {
+        ring[slot] = strong_ref<Box>(new Box((int) slot));
+        slot = (slot + 1) & (ring.size() - 1);
+    }
+}
+
+/**
+ * Builds a list of 65536 cells and releases it.
+ */
+AXF_BENCHMARK(build_drop_list)
+{
+    while (state.keepRunning())
+    {
+        strong_ref<Object> head = buildList(LIST_LENGTH / 16);
+        dropList(head);
+    }
+    state.setCounter("cells per iteration", (double) (LIST_LENGTH / 16));
+}
+
+/**
+ * Walks a list of a million cells, allocated in order: with smaller cells
+ * more of them fit in each cache line.
+ */
+AXF_BENCHMARK(walk_list)
+{
+    strong_ref<Object> head = buildList(LIST_LENGTH);
+    while (state.keepRunning())
+    {
+        long sum = 0;
+        for (const Object* cell = head.get(); cell != NULL;)
+        {
+            const Cell* current = static_cast<const Cell*> (cell);
+            sum += current->m_value;
+            cell = current->m_next.get();
+        }
+        doNotOptimize(sum);
+    }
+    dropList(head);
+    state.setCounter("cells per iteration", (double) LIST_LENGTH);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   primitives.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 6:40 PM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+class Base : public Object
+{
+    AXF_CLASS_TYPE(Base, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    Base() : m_value(42) { }
+} ;
+
+class Middle : public Base
+{
+    AXF_CLASS_TYPE(Middle, AXF_TYPE(Base))
+} ;
+
+class Derived : public Middle
+{
+    AXF_CLASS_TYPE(Derived, AXF_TYPE(Middle))
+} ;
+
+class Unrelated : public Object
+{
+    AXF_CLASS_TYPE(Unrelated, AXF_TYPE(axf::core::Object))
+} ;
+
+// Reference counting
+
+AXF_BENCHMARK(refcount_grab_release)
+{
+    Base* object = new Base();
+    object->grabStrongReference();
+    while (state.keepRunning())
+    {
+        object->grabStrongReference();
+        object->releaseStrongReference();
+        doNotOptimize(object);
+    }
+    object->releaseStrongReference();
+}
+
+AXF_BENCHMARK(strong_ref_copy)
+{
+    strong_ref<Base> reference = new Base();
+    while (state.keepRunning())
+    {
+        strong_ref<Base> copy = reference;
+        doNotOptimize(copy);
+    }
+}
+
+AXF_BENCHMARK(strong_ref_move)
+{
+    strong_ref<Base> a = new Base();
+    strong_ref<Base> b;
+    while (state.keepRunning())
+    {
+        b = std::move(a);
+        a = std::move(b);
+        doNotOptimize(a);
+    }
+}
+
+AXF_BENCHMARK(strong_ref_dereference)
+{
+    strong_ref<Base> reference = new Base();
+    int sum = 0;
+    while (state.keepRunning())
+    {
+        sum += (*reference).m_value;
+        doNotOptimize(sum);
+    }
+}
+
+AXF_BENCHMARK(strong_ref_arrow)
+{
+    strong_ref<Base> reference = new Base();
+    int sum = 0;
+    while (state.keepRunning())
+    {
+        sum += reference->m_value;
+        doNotOptimize(sum);
+    }
+}
+
+// Reflection
+
+AXF_BENCHMARK(runtime_cast_downcast)
+{
+    Derived object;
+    Object& reference = object;
+    while (state.keepRunning())
+    {
+        Middle& middle = reflection::runtime_cast<Middle>(reference);
+        doNotOptimize(middle);
+    }
+}
+
+AXF_BENCHMARK(runtime_cast_to_base)
+{
+    Derived object;
+    Object& reference = object;
+    while (state.keepRunning())
+    {
+        Base& base = reflection::runtime_cast<Base>(reference);
+        doNotOptimize(base);
+    }
+}
+
+AXF_BENCHMARK(runtime_cast_failure)
+{
+    Derived object;
+    Object& reference = object;
+    while (state.keepRunning())
+    {
+        try
+        {
+            Unrelated& wrong = reflection::runtime_cast<Unrelated>(reference);
+            doNotOptimize(wrong);
+        }
+        catch (ClassCastException& ex)
+        {
+            doNotOptimize(ex);
+        }
+    }
+}
+
+AXF_BENCHMARK(object_hashCode)
+{
+    Derived object;
+    Object& reference = object;
+    while (state.keepRunning())
+    {
+        int hash = reference.hashCode();
+        doNotOptimize(hash);
+    }
+}
+
+// Exceptions
+
+AXF_BENCHMARK(exception_throw_catch)
+{
+    while (state.keepRunning())
+    {
+        try
+        {
+            throw IllegalStateException("benchmark");
+        }
+        catch (Exception& ex)
+        {
+            doNotOptimize(ex);
+        }
+    }
+}
+
+// Linked lists
+
+AXF_BENCHMARK(linked_list_add)
+{
+    collections::LinkedList<int> list;
+    int i = 0;
+    while (state.keepRunning())
+    {
+        list.add(i++);
+    }
+    doNotOptimize(list);
+}
+
+AXF_BENCHMARK(linked_list_add_remove_front)
+{
+    collections::LinkedList<int> list;
+    for (int i = 0; i < 64; ++i)
+    {
+        list.add(i);
+    }
+    while (state.keepRunning())
+    {
+        list.add(7);
+        list.removeAt(0);
+    }
+    doNotOptimize(list);
+}
+
+AXF_BENCHMARK(linked_list_get_middle_of_64)
+{
+    collections::LinkedList<int> list;
+    for (int i = 0; i < 64; ++i)
+    {
+        list.add(i);
+    }
+    while (state.keepRunning())
+    {
+        int value = list.get(32);
+        doNotOptimize(value);
+    }
+}
+
+AXF_BENCHMARK(linked_list_indexed_scan_1024)
+{
+    collections::LinkedList<int> list;
+    for (int i = 0; i < 1024; ++i)
+    {
+        list.add(i);
+    }
+    while (state.keepRunning())
+    {
+        long sum = 0;
+        for (std::size_t i = 0; i < 1024; i += 64)
+        {
+            sum += list.get(i);
+        }
+        doNotOptimize(sum);
+    }
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   runtime_cast.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:30 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/*
+ * Casts from Object to Node, a base two levels above the dynamic classes, at
+ * call sites seeing one class (monomorphic), three classes (polymorphic) and
+ * twelve classes (megamorphic, more than a call site remembers). Each site
+ * is measured with the uncached inheritance walk, runtime_cast with its
+ * global cache, AXF_RUNTIME_CAST with its inline cache and dynamic_cast.
+ */
+
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    Node() : m_value(7) { }
+} ;
+
+class Branch : public Node
+{
+    AXF_CLASS_TYPE(Branch, AXF_TYPE(Node))
+} ;
+
+#define LEAF(_name) \
+    class _name : public Branch \
+    { \
+        AXF_CLASS_TYPE(_name, AXF_TYPE(Branch)) \
+    }
+
+LEAF(Leaf0);
+LEAF(Leaf1);
+LEAF(Leaf2);
+LEAF(Leaf3);
+LEAF(Leaf4);
+LEAF(Leaf5);
+LEAF(Leaf6);
+LEAF(Leaf7);
+LEAF(Leaf8);
+LEAF(Leaf9);
+LEAF(Leaf10);
+LEAF(Leaf11);
+
+static const int OBJECT_COUNT = 1024;   /// A power of two
+
+/**
+ * The objects a call site sees, of <code>classes</code> distinct classes in
+ * a pseudo random order.
+ */
+class Population
+{
+public:
+
+    explicit Population(int classes)
+    {
+        Object* kinds[] = {&m_leaf0, &m_leaf1, &m_leaf2, &m_leaf3, &m_leaf4, &m_leaf5,
+                           &m_leaf6, &m_leaf7, &m_leaf8, &m_leaf9, &m_leaf10, &m_leaf11};
+        unsigned seed = 12345;
+        for (int i = 0; i < OBJECT_COUNT; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            m_objects.push_back(kinds[(seed >> 16) % classes]);
+        }
+    }
+
+    inline Object& at(long long i)
+    {
+        return *m_objects[i & (OBJECT_COUNT - 1)];
+    }
+
+private:
+
+    Leaf0 m_leaf0;
+    Leaf1 m_leaf1;
+    Leaf2 m_leaf2;
+    Leaf3 m_leaf3;
+    Leaf4 m_leaf4;
+    Leaf5 m_leaf5;
+    Leaf6 m_leaf6;
+    Leaf7 m_leaf7;
+    Leaf8 m_leaf8;
+    Leaf9 m_leaf9;
+    Leaf10 m_leaf10;
+    Leaf11 m_leaf11;
+    std::vector<Object*> m_objects;
+} ;
+
+static void walkCasts(State& state, int classes)
+{
+    Population population(classes);
+    long long i = 0;
+    while (state.keepRunning())
+    {
+        Object& object = population.at(i++);
+        if (!reflection::getClass(object).isKindOf(Node::getCompileTimeClass()))
+            throw ClassCastException("not a node");
+
+        Node& node = static_cast<Node&> (object);
+        doNotOptimize(node);
+    }
+}
+
+static void runtimeCasts(State& state, int classes)
+{
+    Population population(classes);
+    long long i = 0;
+    while (state.keepRunning())
+    {
+        Node& node = reflection::runtime_cast<Node>(population.at(i++));
+        doNotOptimize(node);
+    }
+}
+
+static void siteCasts(State& state, int classes)
+{
+    Population population(classes);
+    long long i = 0;
+    while (state.keepRunning())
+    {
+        Node& node = AXF_RUNTIME_CAST(Node, population.at(i++));
+        doNotOptimize(node);
+    }
+}
+
+static void dynamicCasts(State& state, int classes)
+{
+    Population population(classes);
+    long long i = 0;
+    while (state.keepRunning())
+    {
+        Node& node = dynamic_cast<Node&> (population.at(i++));
+        doNotOptimize(node);
+    }
+}
+
+// Monomorphic sites
+
+AXF_BENCHMARK(monomorphic_uncached_walk)
+{
+    walkCasts(state, 1);
+}
+
+AXF_BENCHMARK(monomorphic_runtime_cast)
+{
+    runtimeCasts(state, 1);
+}
+
+AXF_BENCHMARK(monomorphic_call_site)
+{
+    siteCasts(state, 1);
+}
+
+AXF_BENCHMARK(monomorphic_dynamic_cast)
+{
+    dynamicCasts(state, 1);
+}
+
+// Polymorphic sites
+
+AXF_BENCHMARK(polymorphic_uncached_walk)
+{
+    walkCasts(state, 3);
+}
+
+AXF_BENCHMARK(polymorphic_runtime_cast)
+{
+    runtimeCasts(state, 3);
+}
+
+AXF_BENCHMARK(polymorphic_call_site)
+{
+    siteCasts(state, 3);
+}
+
+AXF_BENCHMARK(polymorphic_dynamic_cast)
+{
+    dynamicCasts(state, 3);
+}
+
+// Megamorphic sites
+
+AXF_BENCHMARK(megamorphic_uncached_walk)
+{
+    walkCasts(state, 12);
+}
+
+AXF_BENCHMARK(megamorphic_runtime_cast)
+{
+    runtimeCasts(state, 12);
+}
+
+AXF_BENCHMARK(megamorphic_call_site)
+{
+    siteCasts(state, 12);
+}
+
+AXF_BENCHMARK(megamorphic_dynamic_cast)
+{
+    dynamicCasts(state, 12);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   type_descriptors.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 3:00 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+
+/*
+ * The steady state cost of reaching a type descriptor once it has been
+ * initialized: through the lazy statics behind AXF_CLASS_TYPE and
+ * AXF_EXCEPTION_TYPE, against a function local static (guarded by the
+ * compiler under C++11) and a plain global.
+ */
+
+class Shape : public Object
+{
+    AXF_CLASS_TYPE(Shape, AXF_TYPE(axf::core::Object))
+} ;
+
+class Circle : public Shape
+{
+    AXF_CLASS_TYPE(Circle, AXF_TYPE(Shape))
+} ;
+
+class ShapeException : public IllegalStateException
+{
+    AXF_EXCEPTION_TYPE(ShapeException, IllegalStateException)
+} ;
+
+static const Class<Circle>& guardedClass()
+{
+    static Class<Circle> classVariable("Circle", &Shape::getCompileTimeClass(), NULL);
+    return classVariable;
+}
+
+static const Class<Circle>* g_globalClass = NULL;
+
+AXF_BENCHMARK(class_lazy_static)
+{
+    while (state.keepRunning())
+    {
+        const Class<Circle>& type = Circle::getCompileTimeClass();
+        doNotOptimize(type);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(class_function_local_static)
+{
+    while (state.keepRunning())
+    {
+        const Class<Circle>& type = guardedClass();
+        doNotOptimize(type);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(class_global_pointer)
+{
+    g_globalClass = &guardedClass();
+    while (state.keepRunning())
+    {
+        const Class<Circle>& type = *g_globalClass;
+        doNotOptimize(type);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(object_getClass)
+{
+    Circle circle;
+    Object& object = circle;
+    while (state.keepRunning())
+    {
+        const Class<Object>& type = reflection::getClass(object);
+        doNotOptimize(type);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK(exception_lazy_static)
+{
+    while (state.keepRunning())
+    {
+        const bits::ExceptionTypeDescriptor& type = ShapeException::getCompileTimeClass();
+        doNotOptimize(type);
+        clobberMemory();
+    }
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   weak_cache.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:40 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::concurrent;
+using namespace axf::core;
+
+/*
+ * The cost of upgrading weak references, alone and in a cache whose readers
+ * upgrade the weak references of its slots while a writer drops the owners
+ * of the entries and replaces them, one every 20 microseconds.
+ */
+
+class Entry : public Object
+{
+    AXF_CLASS_TYPE(Entry, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    explicit Entry(int value) : m_value(value) { }
+} ;
+
+static const int SLOT_COUNT = 256;  /// A power of two
+
+/**
+ * A cache slot. The slot lock only guards the weak reference object itself;
+ * upgrading does not need it to be held while the entry is released.
+ */
+struct Slot
+{
+    SpinLock            lock;
+    weak_ref<Entry>     entry;
+    char                padding[64];
+} ;
+
+AXF_BENCHMARK(weak_lock_live)
+{
+    strong_ref<Entry> owner(new Entry(1));
+    weak_ref<Entry> weak = owner;
+    while (state.keepRunning())
+    {
+        strong_ref<Entry> entry = weak.lock();
+        doNotOptimize(entry.get());
+    }
+}
+
+AXF_BENCHMARK(weak_lock_expired)
+{
+    weak_ref<Entry> weak;
+    {
+        strong_ref<Entry> owner(new Entry(1));
+        weak = owner;
+    }
+    while (state.keepRunning())
+    {
+        strong_ref<Entry> entry = weak.lock();
+        doNotOptimize(entry.get());
+    }
+}
+
+AXF_BENCHMARK(strong_ref_copy)
+{
+    strong_ref<Entry> owner(new Entry(1));
+    while (state.keepRunning())
+    {
+        strong_ref<Entry> entry = owner;
+        doNotOptimize(entry.get());
+    }
+}
+
+/**
+ * Readers look entries up in the cache and upgrade them, while one writer
+ * drops the owner of an entry, which then cannot be upgraded anymore, and
+ * installs a new one. The time reported is per round, in which every reader
+ * performs one look-up.
+ */
+static void readCache(State& state, int readerCount)
+{
+    std::vector<Slot> slots(SLOT_COUNT);
+    std::vector<strong_ref<Entry> > owners(SLOT_COUNT);
+    for (int i = 0; i < SLOT_COUNT; ++i)
+    {
+        owners[i] = strong_ref<Entry>(new Entry(i));
+        slots[i].entry = owners[i];
+    }
+
+    const std::size_t count = state.iterations();
+    volatile int readersLeft = readerCount;
+    volatile long hits = 0;
+    volatile long replaced = 0;
+
+    state.startTiming();
+    std::thread writer([&slots, &owners, &readersLeft, &replaced]() {
+        int slot = 0;
+        while (atomicLoad(&readersLeft, ACQUIRE) > 0)
+        {
+            // Until the slot is refreshed, readers find a dead entry
+            owners[slot].reset();
+            strong_ref<Entry> fresh(new Entry(slot));
+            {
+                ScopedLock<SpinLock> guard(slots[slot].lock);
+                slots[slot].entry = fresh;
+            }
+            owners[slot] = fresh;
+            slot = (slot + 1) & (SLOT_COUNT - 1);
+            replaced = replaced + 1;
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < readerCount; ++t)
+    {
+        readers.push_back(std::thread([&slots, &readersLeft, &hits, count, t]() {
+            unsigned index = t * 97;
+            long found = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Slot& slot = slots[index & (SLOT_COUNT - 1)];
+                strong_ref<Entry> entry;
+                {
+                    ScopedLock<SpinLock> guard(slot.lock);
+                    entry = slot.entry.lock();
+                }
+                if (!entry.isNull())
+                {
+                    doNotOptimize(entry->m_value);
+                    found++;
+                }
+                index = index * 1103515245u + 12345u;
+            }
+            atomicFetchAdd(&hits, found);
+            atomicFetchSub(&readersLeft, 1);
+        }));
+    }
+    for (int t = 0; t < readerCount; ++t)
+    {
+        readers[t].join();
+    }
+    writer.join();
+    state.stopTiming();
+
+    state.setCounter("readers", readerCount);
+    state.setCounter("hit rate", (double) hits / ((double) count * readerCount));
+    state.setCounter("replaced", (double) replaced);
+}
+
+AXF_BENCHMARK(cache_1_reader_1_writer)
+{
+    readCache(state, 1);
+}
+
+AXF_BENCHMARK(cache_4_readers_1_writer)
+{
+    readCache(state, 4);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   async_random_read.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 3:50 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+using namespace axf::io;
+
+/*
+ * Every iteration performs a batch of random, page aligned 4 KiB reads, either
+ * one after the other with pread or through an AsyncFile that keeps a given
+ * number of reads in flight: each completion handler issues the next read.
+ * The file is created on first use; its path and size may be set with the
+ * AXF_BENCHMARK_FILE and AXF_BENCHMARK_FILE_MB environment variables (by
+ * default 256 MiB under /tmp, removed at exit).
+ * <p>
+ * Warm runs find the file in the page cache, so they measure the cost of
+ * issuing and completing requests. Cold runs drop the file from the cache,
+ * untimed, before every batch, so the reads go to the device, where keeping
+ * many of them in flight pays off.
+ */
+
+static const std::size_t PAGE = 4096;
+static const std::size_t BATCH = 1024;
+
+static bool g_created = false;
+static std::size_t g_pages = 0;
+
+static void removeFile();
+
+static const std::string& filePath()
+{
+    static std::string path;
+    if (path.empty())
+    {
+        const char* variable = std::getenv("AXF_BENCHMARK_FILE");
+        path = variable != NULL ? variable : "/tmp/axf_async_random_read_benchmark.dat";
+
+        const char* megabytes = std::getenv("AXF_BENCHMARK_FILE_MB");
+        std::size_t size = (std::size_t) (megabytes != NULL ? std::atoi(megabytes) : 256) << 20;
+        g_pages = size / PAGE;
+
+        struct stat status;
+        if (stat(path.c_str(), &status) != 0 || (std::size_t) status.st_size != size)
+        {
+            std::vector<unsigned char> block(1 << 20);
+            for (std::size_t i = 0; i < block.size(); ++i)
+                block[i] = (unsigned char) (i * 131);
+
+            int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            for (std::size_t written = 0; fd >= 0 && written < size; written += block.size())
+            {
+                if (write(fd, &block[0], block.size()) != (ssize_t) block.size())
+                {
+                    std::fprintf(stderr, "unable to write '%s'\n", path.c_str());
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+            fsync(fd);
+            close(fd);
+
+            g_created = true;
+            std::atexit(removeFile);
+        }
+    }
+    return path;
+}
+
+static void removeFile()
+{
+    if (g_created)
+    {
+        std::remove(filePath().c_str());
+    }
+}
+
+/**
+ * Drops the pages of the file from the page cache.
+ */
+static void evict()
+{
+    int fd = open(filePath().c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+/**
+ * Returns the offset of a random page of the file.
+ */
+static inline unsigned long long randomOffset(unsigned long long& seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return (seed % g_pages) * PAGE;
+}
+
+static void reportRate(State& state)
+{
+    double reads = (double) BATCH * state.iterations();
+    state.setCounter("kIOPS", reads * 1e6 / state.elapsedNanoseconds());
+    state.setCounter("MB/s", reads * PAGE * 1e3 / state.elapsedNanoseconds());
+}
+
+static void syncRead(State& state, bool cold)
+{
+    int fd = open(filePath().c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+    strong_ref<ByteBuffer> buffer = new ByteBuffer(PAGE, PAGE);
+    unsigned long long seed = 88172645463325252ULL;
+
+    while (state.keepRunning())
+    {
+        if (cold)
+        {
+            state.stopTiming();
+            evict();
+            state.startTiming();
+        }
+        for (std::size_t i = 0; i < BATCH; ++i)
+        {
+            doNotOptimize(pread(fd, buffer->data(), PAGE, (off_t) randomOffset(seed)));
+        }
+    }
+    close(fd);
+    reportRate(state);
+}
+
+/**
+ * Keeps reads in flight until a batch is issued.
+ */
+struct Reader
+{
+    AsyncFile*          file;
+    unsigned long long  seed;
+    std::size_t         issued;
+    std::size_t         bytes;
+} ;
+
+static void reissue(AsyncRequest& request, void* context)
+{
+    Reader* reader = static_cast<Reader*> (context);
+    reader->bytes += request.getBytesTransferred();
+    if (reader->issued < BATCH)
+    {
+        reader->issued++;
+        reader->file->read(randomOffset(reader->seed), PAGE, reissue, reader);
+    }
+}
+
+static void asyncRead(State& state, AsyncFile::Backend backend, unsigned depth, bool cold)
+{
+    strong_ref<AsyncFile> file = new AsyncFile(filePath().c_str(), AsyncFile::READ_ONLY, backend, depth);
+    Reader reader = { file.get(), 88172645463325252ULL, 0, 0 };
+
+    while (state.keepRunning())
+    {
+        if (cold)
+        {
+            state.stopTiming();
+            evict();
+            state.startTiming();
+        }
+
+        reader.issued = depth;
+        for (unsigned i = 0; i < depth; ++i)
+            file->read(randomOffset(reader.seed), PAGE, reissue, &reader);
+        while (file->pending() != 0)
+            file->wait();
+    }
+    doNotOptimize(reader.bytes);
+    reportRate(state);
+}
+
+AXF_BENCHMARK(warm_pread)
+{
+    syncRead(state, false);
+}
+
+#define ASYNC_READ_BENCHMARK(temperature, backend, depth, cold) \
+    AXF_BENCHMARK(temperature##_##backend##_qd##depth) \
+    { \
+        asyncRead(state, AsyncFile::backend, depth, cold); \
+    }
+
+ASYNC_READ_BENCHMARK(warm, IO_URING, 1, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 2, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 4, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 8, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 16, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 32, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 64, false)
+ASYNC_READ_BENCHMARK(warm, IO_URING, 128, false)
+ASYNC_READ_BENCHMARK(warm, THREAD_POOL, 1, false)
+ASYNC_READ_BENCHMARK(warm, THREAD_POOL, 8, false)
+ASYNC_READ_BENCHMARK(warm, THREAD_POOL, 32, false)
+ASYNC_READ_BENCHMARK(warm, THREAD_POOL, 128, false)
+
+AXF_BENCHMARK(cold_pread)
+{
+    syncRead(state, true);
+}
+
+ASYNC_READ_BENCHMARK(cold, IO_URING, 1, true)
+ASYNC_READ_BENCHMARK(cold, IO_URING, 8, true)
+ASYNC_READ_BENCHMARK(cold, IO_URING, 32, true)
+ASYNC_READ_BENCHMARK(cold, IO_URING, 128, true)
+ASYNC_READ_BENCHMARK(cold, THREAD_POOL, 8, true)
+ASYNC_READ_BENCHMARK(cold, THREAD_POOL, 128, true)
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   flat_table.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 7:50 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+using namespace axf::io;
+
+/*
+ * Measures the time to make a lookup table usable at start up, and to look up
+ * a few hundred keys in it: once from a flat file that is mapped and read in
+ * place, and once from the same table serialized with AXF_FIELDS and
+ * deserialized into heap objects. The files are created on first use, under
+ * /tmp or the directory in AXF_BENCHMARK_DIR, and removed at exit; the flat
+ * file holds about AXF_BENCHMARK_TABLE_MB MiB (1024 by default), and the
+ * serialized one about two thirds of that.
+ * <p>
+ * Warm runs find the files in the page cache; cold runs drop them first,
+ * untimed. A deserialization takes seconds at the default size, so a few
+ * samples (--samples=3) are enough.
+ */
+
+static const std::size_t LOOKUPS = 256;
+
+// The flat schema
+
+struct FlatCity
+{
+    unsigned long long      id;
+    double                  latitude;
+    double                  longitude;
+    unsigned                population;
+    FlatString              name;
+    FlatString              country;
+    FlatArray<FlatString>   aliases;
+
+    AXF_FLAT_REFERENCES(name, country, aliases)
+} ;
+
+struct FlatTable
+{
+    FlatArray<FlatCity>     cities;     /// Sorted by id
+
+    AXF_FLAT_REFERENCES(cities)
+} ;
+
+// The same table, as objects
+
+class City
+{
+    AXF_FIELDS(id, latitude, longitude, population, name, country, aliases)
+public:
+
+    unsigned long long          id;
+    double                      latitude;
+    double                      longitude;
+    unsigned                    population;
+    std::string                 name;
+    std::string                 country;
+    std::vector<std::string>    aliases;
+
+    City() : id(0), latitude(0), longitude(0), population(0) { }
+    virtual ~City() { }
+} ;
+
+static std::vector<std::string> g_created;
+
+static void removeFiles()
+{
+    for (std::size_t i = 0; i < g_created.size(); ++i)
+        std::remove(g_created[i].c_str());
+}
+
+static std::string directory()
+{
+    const char* variable = std::getenv("AXF_BENCHMARK_DIR");
+    return variable != NULL ? variable : "/tmp";
+}
+
+static std::size_t cityCount()
+{
+    // About 128 bytes per city in the flat file
+    const char* megabytes = std::getenv("AXF_BENCHMARK_TABLE_MB");
+    return ((std::size_t) (megabytes != NULL ? std::atoi(megabytes) : 1024) << 20) / 128;
+}
+
+static void makeCity(std::size_t i, City& city)
+{
+    static const char* syllables[] = { "san", "ta", "ma", "ri", "ho", "lu", "ca", "ve", "do", "nia", "bel", "or" };
+    static const char* countries[] = { "CUB", "ESP", "MEX", "ARG", "CHL", "PER", "COL", "URY" };
+
+    unsigned long long seed = i * 0x9e3779b97f4a7c15ULL + 1;
+    city.id = i * 3 + 1;
+    city.latitude = (double) (seed % 18000) / 100 - 90;
+    city.longitude = (double) (seed / 18000 % 36000) / 100 - 180;
+    city.population = (unsigned) (seed % 5000000);
+    city.name.clear();
+    for (unsigned s = 0; s < 7; ++s)
+        city.name += syllables[(seed >> (s * 4)) % 12];
+    city.country = countries[i % 8];
+    city.aliases.resize(2);
+    city.aliases[0] = "old " + city.name;
+    city.aliases[1] = city.name.substr(0, 8) + " city";
+}
+
+static void writeFile(const std::string& path, const ByteSlice& bytes)
+{
+    strong_ref<FileOutputStream> out = new FileOutputStream(path.c_str(), false);
+    out->write(bytes.data(), bytes.size());
+    out->flush();
+}
+
+static const std::string& flatPath()
+{
+    static std::string path;
+    if (path.empty())
+    {
+        path = directory() + "/axf_flat_table_benchmark.flat";
+        std::size_t count = cityCount();
+
+        FlatBuilder builder(count * 136 + (1 << 20));
+        std::vector<std::size_t> names(count), countries(count), aliases(count);
+        City city;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            makeCity(i, city);
+            names[i] = builder.addString(city.name.data(), city.name.size());
+            countries[i] = builder.addString(city.country.data(), city.country.size());
+
+            std::size_t first = builder.addString(city.aliases[0].data(), city.aliases[0].size());
+            std::size_t second = builder.addString(city.aliases[1].data(), city.aliases[1].size());
+            FlatString* list = builder.addArray<FlatString>(2, aliases[i]);
+            builder.link(list[0], first);
+            builder.link(list[1], second);
+        }
+
+        std::size_t cities;
+        FlatCity* flat = builder.addArray<FlatCity>(count, cities);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            makeCity(i, city);
+            flat[i].id = city.id;
+            flat[i].latitude = city.latitude;
+            flat[i].longitude = city.longitude;
+            flat[i].population = city.population;
+            builder.link(flat[i].name, names[i]);
+            builder.link(flat[i].country, countries[i]);
+            builder.link(flat[i].aliases, aliases[i]);
+        }
+
+        std::size_t root;
+        FlatTable* table = builder.addRecord<FlatTable>(root);
+        builder.link(table->cities, cities);
+
+        writeFile(path, builder.finish(root));
+        g_created.push_back(path);
+        if (g_created.size() == 1)
+            std::atexit(removeFiles);
+    }
+    return path;
+}
+
+static const std::string& serializedPath()
+{
+    static std::string path;
+    if (path.empty())
+    {
+        path = directory() + "/axf_flat_table_benchmark.bin";
+        std::size_t count = cityCount();
+
+        Serializer out(count * 96 + (1 << 20));
+        out.writeVarint(count);
+        City city;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            makeCity(i, city);
+            out.write(city);
+        }
+
+        writeFile(path, out.data());
+        g_created.push_back(path);
+        if (g_created.size() == 1)
+            std::atexit(removeFiles);
+    }
+    return path;
+}
+
+static void evict(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static double fileMegabytes(const std::string& path)
+{
+    struct stat status;
+    stat(path.c_str(), &status);
+    return (double) status.st_size / (1 << 20);
+}
+
+/**
+ * Looks cities up by id, with a binary search, and sums their population.
+ */
+template <typename Cities>
+static unsigned long long lookUp(const Cities& cities, std::size_t count)
+{
+    unsigned long long sum = 0;
+    unsigned long long seed = 12345;
+    for (std::size_t i = 0; i < LOOKUPS; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned long long id = (seed >> 20) % count * 3 + 1;
+
+        std::size_t low = 0;
+        std::size_t high = count;
+        while (low < high)
+        {
+            std::size_t middle = low + (high - low) / 2;
+            if (cities[middle].id < id)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        sum += cities[low].population + cities[low].name.size() + cities[low].aliases[1].size();
+    }
+    return sum;
+}
+
+static void openFlat(State& state, bool verify, bool cold)
+{
+    const std::string& path = flatPath();
+    while (state.keepRunning())
+    {
+        if (cold)
+        {
+            state.stopTiming();
+            evict(path);
+            state.startTiming();
+        }
+
+        strong_ref<FlatReader> reader = new FlatReader(path.c_str());
+        if (verify)
+            reader->verify<FlatTable>();
+
+        const FlatArray<FlatCity>& cities = reader->root<FlatTable>().cities;
+        doNotOptimize(lookUp(cities.data(), cities.size()));
+    }
+    state.setCounter("file MB", fileMegabytes(path));
+}
+
+static void loadDeserialized(State& state, bool cold)
+{
+    const std::string& path = serializedPath();
+    while (state.keepRunning())
+    {
+        if (cold)
+        {
+            state.stopTiming();
+            evict(path);
+            state.startTiming();
+        }
+
+        std::vector<City> cities;
+        {
+            strong_ref<MappedFile> file = new MappedFile(path.c_str(), MappedFile::READ_ONLY, MappedFile::SEQUENTIAL);
+            Deserializer in(file->slice());
+            cities.resize((std::size_t) in.readVarint());
+            for (std::size_t i = 0; i < cities.size(); ++i)
+                in.read(cities[i]);
+        }
+        doNotOptimize(lookUp(&cities[0], cities.size()));
+
+        // Freeing the objects is part of their cost, but not of start up
+        state.stopTiming();
+        std::vector<City>().swap(cities);
+        state.startTiming();
+    }
+    state.setCounter("file MB", fileMegabytes(path));
+}
+
+AXF_BENCHMARK(warm_open_flat)
+{
+    openFlat(state, false, false);
+}
+
+AXF_BENCHMARK(warm_open_flat_verified)
+{
+    openFlat(state, true, false);
+}
+
+AXF_BENCHMARK(warm_deserialize)
+{
+    loadDeserialized(state, false);
+}
+
+AXF_BENCHMARK(cold_open_flat)
+{
+    openFlat(state, false, true);
+}
+
+AXF_BENCHMARK(cold_open_flat_verified)
+{
+    openFlat(state, true, true);
+}
+
+AXF_BENCHMARK(cold_deserialize)
+{
+    loadDeserialized(state, true);
+}
+
+AXF_BENCHMARK_MAIN()
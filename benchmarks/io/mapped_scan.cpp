@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   mapped_scan.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:10 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+using namespace axf::io;
+
+/*
+ * Every iteration scans a whole file, counting its lines. The file is created
+ * on first use; its path and size may be set with the AXF_BENCHMARK_FILE and
+ * AXF_BENCHMARK_FILE_MB environment variables (by default 256 MiB under
+ * /tmp, removed at exit).
+ * <p>
+ * Warm runs find the file in the page cache. Cold runs drop it from the
+ * cache, untimed, before every scan, so the scan reads from the device;
+ * they need a file larger than the device cache to be meaningful.
+ */
+
+static const std::size_t READ_BUFFER = 1 << 20;
+
+static bool g_created = false;
+
+static void removeFile();
+
+static const std::string& filePath()
+{
+    static std::string path;
+    if (path.empty())
+    {
+        const char* variable = std::getenv("AXF_BENCHMARK_FILE");
+        path = variable != NULL ? variable : "/tmp/axf_mapped_scan_benchmark.dat";
+
+        const char* megabytes = std::getenv("AXF_BENCHMARK_FILE_MB");
+        std::size_t size = (std::size_t) (megabytes != NULL ? std::atoi(megabytes) : 256) << 20;
+
+        struct stat status;
+        if (stat(path.c_str(), &status) != 0 || (std::size_t) status.st_size != size)
+        {
+            // Lines of varying length, as in a log or CSV file
+            std::vector<char> block(READ_BUFFER);
+            std::size_t column = 0;
+            for (std::size_t i = 0; i < block.size(); ++i)
+            {
+                bool newline = ++column > 40 + (i * 7919) % 80;
+                block[i] = newline ? '\n' : (char) ('a' + i % 26);
+                column = newline ? 0 : column;
+            }
+
+            int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            for (std::size_t written = 0; fd >= 0 && written < size; written += block.size())
+            {
+                if (write(fd, &block[0], block.size()) != (ssize_t) block.size())
+                {
+                    std::fprintf(stderr, "unable to write '%s'\n", path.c_str());
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+            fsync(fd);
+            close(fd);
+
+            g_created = true;
+            std::atexit(removeFile);
+        }
+    }
+    return path;
+}
+
+static void removeFile()
+{
+    if (g_created)
+    {
+        std::remove(filePath().c_str());
+    }
+}
+
+/**
+ * Drops the pages of the file from the page cache.
+ */
+static void evict()
+{
+    int fd = open(filePath().c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static inline std::size_t countLines(const void* data, std::size_t size)
+{
+    std::size_t lines = 0;
+    const char* current = static_cast<const char*> (data);
+    const char* end = current + size;
+    while ((current = static_cast<const char*> (std::memchr(current, '\n', end - current))) != NULL)
+    {
+        ++lines;
+        ++current;
+    }
+    return lines;
+}
+
+static std::size_t scanRead()
+{
+    std::vector<char> buffer(READ_BUFFER);
+    int fd = open(filePath().c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::size_t lines = 0;
+    ssize_t count;
+    while ((count = read(fd, &buffer[0], buffer.size())) > 0)
+    {
+        lines += countLines(&buffer[0], (std::size_t) count);
+    }
+    close(fd);
+    return lines;
+}
+
+static std::size_t scanFread()
+{
+    char buffer[65536];
+    std::FILE* file = std::fopen(filePath().c_str(), "rb");
+
+    std::size_t lines = 0;
+    std::size_t count;
+    while ((count = std::fread(buffer, 1, sizeof (buffer), file)) > 0)
+    {
+        lines += countLines(buffer, count);
+    }
+    std::fclose(file);
+    return lines;
+}
+
+static std::size_t scanMapped(MappedFile::Advice advice)
+{
+    strong_ref<MappedFile> file = new MappedFile(filePath().c_str(), MappedFile::READ_ONLY, advice);
+    return countLines(file->data(), file->size());
+}
+
+static std::size_t scanMappedSequential()
+{
+    return scanMapped(MappedFile::SEQUENTIAL);
+}
+
+static std::size_t scanMappedNormal()
+{
+    return scanMapped(MappedFile::NORMAL);
+}
+
+static void scan(State& state, std::size_t (*function)(), bool cold)
+{
+    struct stat status;
+    stat(filePath().c_str(), &status);
+
+    while (state.keepRunning())
+    {
+        if (cold)
+        {
+            state.stopTiming();
+            evict();
+            state.startTiming();
+        }
+        doNotOptimize(function());
+    }
+    state.setCounter("GB/s", (double) status.st_size * state.iterations() / state.elapsedNanoseconds());
+}
+
+AXF_BENCHMARK(warm_read)
+{
+    scan(state, scanRead, false);
+}
+
+AXF_BENCHMARK(warm_fread)
+{
+    scan(state, scanFread, false);
+}
+
+AXF_BENCHMARK(warm_mmap_normal)
+{
+    scan(state, scanMappedNormal, false);
+}
+
+AXF_BENCHMARK(warm_mmap_sequential)
+{
+    scan(state, scanMappedSequential, false);
+}
+
+AXF_BENCHMARK(cold_read)
+{
+    scan(state, scanRead, true);
+}
+
+AXF_BENCHMARK(cold_fread)
+{
+    scan(state, scanFread, true);
+}
+
+AXF_BENCHMARK(cold_mmap_normal)
+{
+    scan(state, scanMappedNormal, true);
+}
+
+AXF_BENCHMARK(cold_mmap_sequential)
+{
+    scan(state, scanMappedSequential, true);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   serialization.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:40 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+using namespace axf::io;
+
+/*
+ * Encodes and decodes batches of records with the AXF_FIELDS serializer and
+ * with a hand written serializer of the kind classes used to carry, which
+ * writes fixed width integers and 32 bit length prefixes with memcpy. Both
+ * write into a ByteBuffer that is reused across iterations. Every iteration
+ * handles a whole batch; MB/s counts encoded bytes.
+ * <p>
+ * The polymorphic benchmarks encode portfolios whose positions are held by
+ * strong_ref fields of a base class, so every position carries a type hash.
+ */
+
+static const std::size_t BATCH = 1024;
+
+class Trade : public Object
+{
+    AXF_CLASS_TYPE(Trade, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(id, timestamp, account, symbol, price, quantity, side, flags)
+public:
+
+    unsigned long long  id;
+    long long           timestamp;
+    std::string         account;
+    std::string         symbol;
+    double              price;
+    int                 quantity;
+    unsigned char       side;
+    unsigned            flags;
+
+    Trade() : id(0), timestamp(0), price(0), quantity(0), side(0), flags(0) { }
+} ;
+
+// The bespoke serializer, for comparison
+
+static inline unsigned char* putString(unsigned char* out, const std::string& value)
+{
+    unsigned size = (unsigned) value.size();
+    std::memcpy(out, &size, 4);
+    std::memcpy(out + 4, value.data(), size);
+    return out + 4 + size;
+}
+
+static inline const unsigned char* getString(const unsigned char* in, std::string& value)
+{
+    unsigned size;
+    std::memcpy(&size, in, 4);
+    value.assign(reinterpret_cast<const char*> (in + 4), size);
+    return in + 4 + size;
+}
+
+static std::size_t encodeByHand(const std::vector<Trade>& trades, strong_ref<ByteBuffer>& buffer)
+{
+    unsigned char* out = buffer->data();
+    for (std::size_t i = 0; i < trades.size(); ++i)
+    {
+        const Trade& trade = trades[i];
+        std::size_t needed = 37 + trade.account.size() + trade.symbol.size();
+        if ((std::size_t) (out - buffer->data()) + needed > buffer->size())
+        {
+            std::size_t used = (std::size_t) (out - buffer->data());
+            strong_ref<ByteBuffer> grown = new ByteBuffer(buffer->size() * 2 + needed);
+            std::memcpy(grown->data(), buffer->data(), used);
+            buffer = grown;
+            out = buffer->data() + used;
+        }
+
+        std::memcpy(out, &trade.id, 8);
+        std::memcpy(out + 8, &trade.timestamp, 8);
+        out = putString(out + 16, trade.account);
+        out = putString(out, trade.symbol);
+        std::memcpy(out, &trade.price, 8);
+        std::memcpy(out + 8, &trade.quantity, 4);
+        out[12] = trade.side;
+        std::memcpy(out + 13, &trade.flags, 4);
+        out += 17;
+    }
+    return (std::size_t) (out - buffer->data());
+}
+
+static void decodeByHand(const unsigned char* in, std::vector<Trade>& trades)
+{
+    for (std::size_t i = 0; i < trades.size(); ++i)
+    {
+        Trade& trade = trades[i];
+        std::memcpy(&trade.id, in, 8);
+        std::memcpy(&trade.timestamp, in + 8, 8);
+        in = getString(in + 16, trade.account);
+        in = getString(in, trade.symbol);
+        std::memcpy(&trade.price, in, 8);
+        std::memcpy(&trade.quantity, in + 8, 4);
+        trade.side = in[12];
+        std::memcpy(&trade.flags, in + 13, 4);
+        in += 17;
+    }
+}
+
+static const std::vector<Trade>& trades()
+{
+    static std::vector<Trade> batch;
+    if (batch.empty())
+    {
+        static const char* symbols[] = { "AAPL", "MSFT", "GOOGL", "BRK.B", "TSM", "NVDA", "ASML", "SAP" };
+        batch.resize(BATCH);
+        for (std::size_t i = 0; i < BATCH; ++i)
+        {
+            char account[32];
+            std::sprintf(account, "ACC-%06u", (unsigned) (i * 7919 % 1000000));
+
+            batch[i].id = 1000000 + i;
+            batch[i].timestamp = 1790000000000LL + (long long) i * 37;
+            batch[i].account = account;
+            batch[i].symbol = symbols[i % 8];
+            batch[i].price = 100.0 + (double) (i % 977) / 8;
+            batch[i].quantity = (int) (i % 13 == 0 ? -(int) (i % 500) : (int) (i % 500));
+            batch[i].side = (unsigned char) (i & 1);
+            batch[i].flags = (unsigned) (i % 3);
+        }
+    }
+    return batch;
+}
+
+static void reportRate(State& state, std::size_t bytes)
+{
+    state.setCounter("MB/s", (double) bytes * state.iterations() * 1e3 / state.elapsedNanoseconds());
+    state.setCounter("bytes/object", (double) bytes / BATCH);
+}
+
+AXF_BENCHMARK(encode_fields)
+{
+    const std::vector<Trade>& batch = trades();
+    Serializer out(64 * 1024);
+    while (state.keepRunning())
+    {
+        out.reset();
+        for (std::size_t i = 0; i < batch.size(); ++i)
+            out.write(batch[i]);
+        clobberMemory();
+    }
+    reportRate(state, out.size());
+}
+
+AXF_BENCHMARK(encode_by_hand)
+{
+    const std::vector<Trade>& batch = trades();
+    strong_ref<ByteBuffer> buffer = new ByteBuffer(64 * 1024);
+    std::size_t size = 0;
+    while (state.keepRunning())
+    {
+        size = encodeByHand(batch, buffer);
+        clobberMemory();
+    }
+    reportRate(state, size);
+}
+
+AXF_BENCHMARK(decode_fields)
+{
+    Serializer out(64 * 1024);
+    for (std::size_t i = 0; i < trades().size(); ++i)
+        out.write(trades()[i]);
+    ByteSlice bytes = out.data();
+
+    std::vector<Trade> decoded(BATCH);
+    while (state.keepRunning())
+    {
+        Deserializer in(bytes);
+        for (std::size_t i = 0; i < decoded.size(); ++i)
+            in.read(decoded[i]);
+        doNotOptimize(decoded[BATCH - 1].flags);
+    }
+    reportRate(state, bytes.size());
+}
+
+AXF_BENCHMARK(decode_by_hand)
+{
+    strong_ref<ByteBuffer> buffer = new ByteBuffer(64 * 1024);
+    std::size_t size = encodeByHand(trades(), buffer);
+
+    std::vector<Trade> decoded(BATCH);
+    while (state.keepRunning())
+    {
+        decodeByHand(buffer->data(), decoded);
+        doNotOptimize(decoded[BATCH - 1].flags);
+    }
+    reportRate(state, size);
+}
+
+// Polymorphic references
+
+class Position : public Object
+{
+    AXF_CLASS_TYPE(Position, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(symbol, quantity)
+public:
+
+    std::string symbol;
+    long long   quantity;
+
+    Position() : quantity(0) { }
+} ;
+
+class Equity : public Position
+{
+    AXF_CLASS_TYPE(Equity, AXF_TYPE(Position))
+    AXF_DERIVED_FIELDS(Position, exchange)
+public:
+
+    unsigned exchange;
+
+    Equity() : exchange(0) { }
+} ;
+
+class Option : public Position
+{
+    AXF_CLASS_TYPE(Option, AXF_TYPE(Position))
+    AXF_DERIVED_FIELDS(Position, strike, expiry, call)
+public:
+
+    double      strike;
+    unsigned    expiry;
+    bool        call;
+
+    Option() : strike(0), expiry(0), call(false) { }
+} ;
+
+class Portfolio : public Object
+{
+    AXF_CLASS_TYPE(Portfolio, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(owner, positions)
+public:
+
+    std::string                         owner;
+    std::vector<strong_ref<Position> >  positions;
+} ;
+
+AXF_SERIALIZABLE(Equity);
+AXF_SERIALIZABLE(Option);
+
+static const Portfolio& portfolio()
+{
+    static Portfolio value;
+    if (value.positions.empty())
+    {
+        value.owner = "pension fund";
+        for (std::size_t i = 0; i < BATCH; ++i)
+        {
+            if (i % 4 == 0)
+            {
+                Option* option = new Option();
+                option->symbol = "SPX";
+                option->quantity = (long long) (i % 50) - 25;
+                option->strike = 4000 + (double) (i % 40) * 25;
+                option->expiry = 20270000 + (unsigned) (i % 12) * 100 + 15;
+                option->call = (i & 4) != 0;
+                value.positions.push_back(strong_ref<Position>(option));
+            }
+            else
+            {
+                Equity* equity = new Equity();
+                equity->symbol = i % 3 == 0 ? "VTI" : "VXUS";
+                equity->quantity = (long long) (i * 13);
+                equity->exchange = (unsigned) (i % 5);
+                value.positions.push_back(strong_ref<Position>(equity));
+            }
+        }
+    }
+    return value;
+}
+
+AXF_BENCHMARK(encode_fields_polymorphic)
+{
+    const Portfolio& value = portfolio();
+    Serializer out(64 * 1024);
+    while (state.keepRunning())
+    {
+        out.reset();
+        out.write(value);
+        clobberMemory();
+    }
+    reportRate(state, out.size());
+}
+
+AXF_BENCHMARK(decode_fields_polymorphic)
+{
+    Serializer out(64 * 1024);
+    out.write(portfolio());
+    ByteSlice bytes = out.data();
+
+    while (state.keepRunning())
+    {
+        Portfolio decoded;
+        Deserializer in(bytes);
+        in.read(decoded);
+        doNotOptimize(decoded.positions.size());
+    }
+    reportRate(state, bytes.size());
+}
+
+AXF_BENCHMARK_MAIN()
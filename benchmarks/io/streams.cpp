@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   streams.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:00 AM
+ */
+
+#include <Axf.h>
+#include <benchmarks/Benchmark.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace axf;
+using namespace axf::benchmark;
+using namespace axf::core;
+using namespace axf::io;
+
+/*
+ * Line reading scans a 64 MiB file of short records, warm in the page cache;
+ * each iteration reads the whole file. Bulk writing appends 100 byte records
+ * to a file that is recreated by every sample; each iteration writes one
+ * record.
+ */
+
+static const std::size_t FILE_SIZE = 64 << 20;
+static const std::size_t RECORD_SIZE = 100;
+
+static const char* READ_PATH = "/tmp/axf_streams_benchmark_read.dat";
+static const char* WRITE_PATH = "/tmp/axf_streams_benchmark_write.dat";
+
+static void removeFiles()
+{
+    std::remove(READ_PATH);
+    std::remove(WRITE_PATH);
+}
+
+static const char* readPath()
+{
+    static bool created = false;
+    if (!created)
+    {
+        std::FILE* file = std::fopen(READ_PATH, "wb");
+        char line[128];
+        for (std::size_t size = 0, i = 0; size < FILE_SIZE; ++i)
+        {
+            int length = std::sprintf(line, "%zu,sensor-%zu,%zu.%02zu,ok\n", i, i % 97, (i * 7919) % 1000, i % 100);
+            std::fwrite(line, 1, length, file);
+            size += length;
+        }
+        std::fclose(file);
+
+        created = true;
+        std::atexit(removeFiles);
+    }
+    return READ_PATH;
+}
+
+static const std::string& record()
+{
+    static std::string result;
+    if (result.empty())
+    {
+        for (std::size_t i = 0; i < RECORD_SIZE - 1; ++i)
+        {
+            result += (char) ('a' + i % 26);
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+// Line reading
+
+static void readLines(State& state, std::size_t (*function)(const char*))
+{
+    const char* path = readPath();
+    std::size_t lines = 0;
+    while (state.keepRunning())
+    {
+        lines = function(path);
+        doNotOptimize(lines);
+    }
+    state.setCounter("GB/s", (double) FILE_SIZE * state.iterations() / state.elapsedNanoseconds());
+    state.setCounter("lines", (double) lines);
+}
+
+static std::size_t readAxf(const char* path)
+{
+    strong_ref<FileInputStream> in = new FileInputStream(path);
+
+    std::size_t lines = 0;
+    ByteSlice line;
+    while (in->readLine(line))
+    {
+        lines += line.size() != 0;
+    }
+    return lines;
+}
+
+static std::size_t readFgets(const char* path)
+{
+    std::FILE* file = std::fopen(path, "rb");
+    char line[4096];
+    std::size_t lines = 0;
+    while (std::fgets(line, sizeof (line), file) != NULL)
+    {
+        lines += line[0] != '\n';
+    }
+    std::fclose(file);
+    return lines;
+}
+
+static std::size_t readGetline(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    std::size_t lines = 0;
+    while (std::getline(file, line))
+    {
+        lines += !line.empty();
+    }
+    return lines;
+}
+
+AXF_BENCHMARK(read_lines_axf)
+{
+    readLines(state, readAxf);
+}
+
+AXF_BENCHMARK(read_lines_fgets)
+{
+    readLines(state, readFgets);
+}
+
+AXF_BENCHMARK(read_lines_getline)
+{
+    readLines(state, readGetline);
+}
+
+// Bulk writing
+
+static void wroteRecords(State& state)
+{
+    state.setCounter("GB/s", (double) RECORD_SIZE * state.iterations() / state.elapsedNanoseconds());
+}
+
+AXF_BENCHMARK(write_records_axf)
+{
+    const std::string& data = record();
+    {
+        strong_ref<FileOutputStream> out = new FileOutputStream(WRITE_PATH);
+        while (state.keepRunning())
+        {
+            out->write(data.data(), data.size());
+        }
+        state.startTiming();
+        out->close();
+        state.stopTiming();
+    }
+    wroteRecords(state);
+}
+
+AXF_BENCHMARK(write_records_fwrite)
+{
+    const std::string& data = record();
+    std::FILE* file = std::fopen(WRITE_PATH, "wb");
+    while (state.keepRunning())
+    {
+        std::fwrite(data.data(), 1, data.size(), file);
+    }
+    state.startTiming();
+    std::fclose(file);
+    state.stopTiming();
+    wroteRecords(state);
+}
+
+AXF_BENCHMARK(write_records_ofstream)
+{
+    const std::string& data = record();
+    std::ofstream* file = new std::ofstream(WRITE_PATH, std::ios::binary);
+    while (state.keepRunning())
+    {
+        file->write(data.data(), data.size());
+    }
+    state.startTiming();
+    delete file;
+    state.stopTiming();
+    wroteRecords(state);
+}
+
+/**
+ * Writes messages made of a small header and a 16 KiB payload held in a
+ * buffer, as a serializer would. Gathering hands both to a single writev,
+ * the alternative copies the payload through the stream buffer.
+ */
+static void writeMessages(State& state, bool gather)
+{
+    strong_ref<ByteBuffer> payload = new ByteBuffer(16384);
+    std::memset(payload->data(), 'p', payload->size());
+    strong_ref<ByteBuffer> header = new ByteBuffer(16);
+    std::memset(header->data(), 'h', header->size());
+
+    ByteSlice message[2] = {header->slice(), payload->slice()};
+    {
+        strong_ref<FileOutputStream> out = new FileOutputStream(WRITE_PATH);
+        while (state.keepRunning())
+        {
+            if (gather)
+            {
+                out->write(message, 2);
+            }
+            else
+            {
+                out->write(message[0]);
+                out->write(message[1]);
+            }
+        }
+        state.startTiming();
+        out->close();
+        state.stopTiming();
+    }
+    state.setCounter("GB/s", (double) (16 + 16384) * state.iterations() / state.elapsedNanoseconds());
+}
+
+AXF_BENCHMARK(write_messages_copy)
+{
+    writeMessages(state, false);
+}
+
+AXF_BENCHMARK(write_messages_gather)
+{
+    writeMessages(state, true);
+}
+
+AXF_BENCHMARK_MAIN()
@@ -38,22 +38,40 @@
 #include <Axf/Core/Lang-C++/traits.h>
 
 #include <Axf/Collections/Algorithms.h>
+#include <Axf/Collections/AllocationProfiler.h>
+#include <Axf/Collections/AllocationRegistry.h>
 #include <Axf/Collections/Allocator.h>
 #include <Axf/Collections/Collection.h>
 #include <Axf/Collections/DefaultAllocator.h>
+#include <Axf/Collections/InstrumentedAllocator.h>
+#include <Axf/Collections/IntrusiveHashSet.h>
+#include <Axf/Collections/IntrusiveList.h>
 #include <Axf/Collections/Iterable.h>
 #include <Axf/Collections/Iterator.h>
 #include <Axf/Collections/LinkedList.h>
 #include <Axf/Collections/List.h>
 #include <Axf/Collections/Queue.h>
+#include <Axf/Collections/RegionAllocator.h>
 #include <Axf/Collections/Stack.h>
+#include <Axf/Collections/ThreadCachingAllocator.h>
+#include <Axf/Collections/VirtualRegion.h>
+
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Concurrent/EpochManager.h>
+#include <Axf/Concurrent/LazyStatic.h>
+#include <Axf/Concurrent/SpinLock.h>
 
 #include <Axf/Core/Array.h>
 #include <Axf/Core/Class.h>
 #include <Axf/Core/ClassCastException.h>
+#include <Axf/Core/ClassPool.h>
+#include <Axf/Core/CycleCollector.h>
+#include <Axf/Core/DeferredRelease.h>
 #include <Axf/Core/Exception.h>
+#include <Axf/Core/Hash.h>
 #include <Axf/Core/IllegalStateException.h>
 #include <Axf/Core/IndexOutOfBoundsException.h>
+#include <Axf/Core/InternPool.h>
 #include <Axf/Core/Memory.h>
 #include <Axf/Core/NullPointerException.h>
 #include <Axf/Core/Number.h>
@@ -61,6 +79,16 @@
 #include <Axf/Core/ReferenceCounted.h>
 #include <Axf/Core/String.h>
 
+#include <Axf/IO/AsyncFile.h>
+#include <Axf/IO/ByteBuffer.h>
+#include <Axf/IO/FileStream.h>
+#include <Axf/IO/FlatFormat.h>
+#include <Axf/IO/InputStream.h>
+#include <Axf/IO/IOException.h>
+#include <Axf/IO/MappedFile.h>
+#include <Axf/IO/OutputStream.h>
+#include <Axf/IO/Serialization.h>
+
 #include <Axf/Logging/Logger.h>
 
 #include <Axf/Utils/Pair.h>
@@ -45,5 +45,39 @@
 #define ARTEMIS_CXX11_SUPPORTED    1
 #endif
 
+/* Constant expressions, used for objects that must be statically initialized */
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+#define ARTEMIS_CONSTEXPR           constexpr
+#else
+#define ARTEMIS_CONSTEXPR
+#endif
+
+/* Thread local storage for plain old data */
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+#define ARTEMIS_THREAD_LOCAL        thread_local
+#elif defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+#define ARTEMIS_THREAD_LOCAL        __thread
+#elif defined(_MSC_VER)
+#define ARTEMIS_THREAD_LOCAL        __declspec(thread)
+#endif
+
+/* Branch prediction hints */
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+#define ARTEMIS_LIKELY(x)           __builtin_expect(!!(x), 1)
+#define ARTEMIS_UNLIKELY(x)         __builtin_expect(!!(x), 0)
+#else
+#define ARTEMIS_LIKELY(x)           (x)
+#define ARTEMIS_UNLIKELY(x)         (x)
+#endif
+
+/* Keeps cold paths out of their inlined callers */
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+#define ARTEMIS_NOINLINE            __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ARTEMIS_NOINLINE            __declspec(noinline)
+#else
+#define ARTEMIS_NOINLINE
+#endif
+
 #endif /* COMPILER_H */
 
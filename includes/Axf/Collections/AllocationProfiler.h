@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   AllocationProfiler.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:00 PM
+ */
+
+#ifndef ALLOCATIONPROFILER_H
+#define ALLOCATIONPROFILER_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
+
+// C++
+#include <cstddef>
+#include <cstdio>
+#include <typeinfo>
+#include <vector>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * The samples taken from one call stack, for one type.
+ * <p>
+ * The frames are raw return addresses, innermost first. The estimates scale
+ * the samples back to the whole allocation traffic of the stack, given the
+ * sampling interval.
+ *
+ * @author J. Marrero
+ */
+struct AllocationSample
+{
+    static const int MAX_DEPTH = 32;
+
+    const char* typeName;           /// The name of the type allocated
+    int         depth;              /// The number of frames
+    void*       frames[MAX_DEPTH];  /// The call stack, innermost first
+    long long   samples;            /// Allocations sampled
+    long long   sampledBytes;       /// Bytes of the allocations sampled
+    long long   inUseSamples;       /// Allocations sampled and not released yet
+    long long   inUseBytes;         /// Bytes of the allocations sampled and not released yet
+    long long   estimatedCount;     /// Estimated allocations
+    long long   estimatedBytes;     /// Estimated bytes allocated
+} ;
+
+/**
+ * A sampling profiler of the allocations made through the allocators of the
+ * library and the class pools.
+ * <p>
+ * Rather than recording every allocation, the profiler samples about one
+ * allocation every <i>sampling interval</i> bytes: each thread counts down
+ * the bytes it allocates from a distance drawn from an exponential
+ * distribution, and samples the allocation that takes it past zero. Sampling
+ * is then a Poisson process over the allocated bytes, so large allocations
+ * are sampled more often than small ones and every byte has the same chance
+ * to be picked. A sample captures the call stack of the allocation, and is
+ * added to a fixed size table keyed by stack and type, updated with atomic
+ * operations only. Profiles may be written in the legacy heap format read by
+ * <code>pprof</code>, or as folded stacks for flame graphs.
+ * <p>
+ * An allocation that is not sampled costs a thread local subtraction and a
+ * branch, whether the profiler runs or not. When it is stopped, a thread
+ * checks whether it was started every megabyte it allocates.
+ * <p>
+ * Sampled allocations are tracked until they are released, so profiles show
+ * where memory is held as well as where it is allocated. Allocators report
+ * releases with <code>recordDeallocation</code>; releasing memory that was
+ * not sampled costs a load from a small table of counts and a branch. Up to
+ * <code>LIVE_TABLE_SIZE</code> sampled allocations are tracked at a time,
+ * the ones past that count as released. Releases are only tracked while the
+ * profiler runs.
+ * <p>
+ * Every reference counted object is accounted for by the class level
+ * <code>operator new</code> of <code>ReferenceCounted</code>, which cannot
+ * tell the type it allocates. Its samples wait in a small table until the
+ * object is first strongly referenced, and are then attributed to its
+ * dynamic type; classes in a <code>ClassPool</code> are attributed by their
+ * pool instead.
+ *
+ * @author J. Marrero
+ */
+class AllocationProfiler
+{
+public:
+
+    static const std::size_t DEFAULT_SAMPLING_INTERVAL = 512 * 1024;   /// Mean bytes between samples
+    static const std::size_t TABLE_SIZE = 4096;                         /// Distinct stacks kept
+    static const std::size_t LIVE_TABLE_SIZE = 16384;                   /// Sampled allocations tracked
+
+    /**
+     * Accounts for an allocation of <code>bytes</code> bytes of objects of
+     * the given type, sampling it if its turn has come. Allocators call this
+     * method right after allocating; it never throws.
+     *
+     * @param memory the memory allocated, or <code>NULL</code> if the
+     *        allocation failed
+     * @param bytes
+     * @param type
+     */
+    static inline void recordAllocation(void* memory, std::size_t bytes, const std::type_info& type)
+    {
+        if (ARTEMIS_UNLIKELY((bytesUntilSample -= (long long) bytes) < 0))
+        {
+            sample(memory, bytes, type);
+        }
+    }
+
+    /**
+     * Accounts for the release of memory whose allocation was recorded,
+     * which stops counting as in use if it was sampled. Allocators call this
+     * method right before releasing; it never throws.
+     *
+     * @param memory
+     */
+    static inline void recordDeallocation(void* memory)
+    {
+        if (ARTEMIS_UNLIKELY(concurrent::atomicLoad(&liveFilter[filterSlot(memory)], concurrent::RELAXED) != 0))
+        {
+            forget(memory);
+        }
+    }
+
+    /**
+     * Accounts for the allocation of a reference counted object whose type
+     * is not known yet, as <code>ReferenceCounted::operator new</code> does.
+     * A sampled object waits for its first strong reference to tell its
+     * type; objects released before that are attributed to
+     * <code>ReferenceCounted</code>. It never throws.
+     *
+     * @param memory the memory allocated, or <code>NULL</code> if the
+     *        allocation failed
+     * @param bytes
+     */
+    static inline void recordObjectAllocation(void* memory, std::size_t bytes)
+    {
+        if (ARTEMIS_UNLIKELY((bytesUntilSample -= (long long) bytes) < 0))
+        {
+            sampleObject(memory, bytes);
+        }
+    }
+
+    /**
+     * Tells the type of an object whose allocation is waiting for it, so
+     * that its sample is attributed to it. Objects call this method when
+     * they are strongly referenced for the first time while samples are
+     * waiting; it never throws.
+     *
+     * @param memory the memory of the object, its most derived address
+     * @param type its dynamic type
+     */
+    static void recordObjectType(const void* memory, const std::type_info& type);
+
+    /**
+     * Starts a new profile, discarding the samples of the previous one.
+     * Threads pick up the new interval on their next sample, or within a
+     * megabyte of allocations if the profiler was stopped.
+     *
+     * @param interval the mean bytes between samples
+     */
+    static void start(std::size_t interval = DEFAULT_SAMPLING_INTERVAL);
+
+    /**
+     * Stops sampling. Samples being recorded by other threads are completed
+     * before this method returns, and the profile is kept until the next
+     * start.
+     */
+    static void stop();
+
+    /**
+     * Returns true if the profiler is sampling.
+     *
+     * @return
+     */
+    static bool isRunning();
+
+    /**
+     * Returns the sampling interval of the current, or last, profile.
+     *
+     * @return
+     */
+    static std::size_t getSamplingInterval();
+
+    /**
+     * Returns the number of samples dropped because the table was full.
+     *
+     * @return
+     */
+    static long long getDroppedSamples();
+
+    /**
+     * Returns the samples of the current, or last, profile, one entry per
+     * call stack and type.
+     *
+     * @return
+     */
+    static std::vector<AllocationSample> snapshot();
+
+    /**
+     * Writes the profile as folded stacks: one line per stack, with the
+     * frames from the outermost to the innermost separated by semicolons,
+     * then the type as a last frame, and the estimated bytes. This is the
+     * input of flame graph tools. Frames are symbolized when the platform
+     * allows it, and written as addresses otherwise.
+     *
+     * @param out
+     */
+    static void dumpFolded(std::FILE* out = stdout);
+
+    /**
+     * Writes the profile in the legacy heap profile format, which
+     * <code>pprof</code> symbolizes against the binary. The in use columns
+     * count the sampled allocations not released yet, the others every
+     * sampled allocation.
+     *
+     * @param out
+     */
+    static void dumpHeapProfile(std::FILE* out);
+
+private:
+
+    static const std::size_t FILTER_SIZE = 4096;
+
+    static ARTEMIS_THREAD_LOCAL long long bytesUntilSample;
+
+    /**
+     * The count of tracked allocations whose address falls in each slot, so
+     * that releasing memory that was not sampled needs no lookup.
+     */
+    static volatile unsigned short liveFilter[FILTER_SIZE];
+
+    static inline std::size_t filterSlot(const void* memory)
+    {
+        std::size_t address = (std::size_t) memory;
+        return ((address >> 4) ^ (address >> 16)) & (FILTER_SIZE - 1);
+    }
+
+    static bool beginSample(std::size_t& interval);
+    static void sample(void* memory, std::size_t bytes, const std::type_info& type);
+    static void sampleObject(void* memory, std::size_t bytes);
+    static void forget(void* memory);
+
+    AllocationProfiler();
+} ;
+
+}
+}
+
+#endif /* ALLOCATIONPROFILER_H */
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   AllocationRegistry.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 4:10 PM
+ */
+
+#ifndef ALLOCATIONREGISTRY_H
+#define ALLOCATIONREGISTRY_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
+
+// C++
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * A point in time copy of the counters of one allocation site.
+ * <p>
+ * Sizes are classified in <code>HISTOGRAM_BUCKETS</code> power of two
+ * buckets: bucket zero counts requests of up to 16 bytes, bucket
+ * <code>i</code> requests of up to <code>16 << i</code> bytes, and the last
+ * bucket every larger request.
+ *
+ * @author J. Marrero
+ */
+struct AllocationSnapshot
+{
+    static const int HISTOGRAM_BUCKETS = 16;
+
+    const char* typeName;           /// The name of the type allocated
+    long long   liveBytes;          /// Bytes currently allocated
+    long long   liveObjects;        /// Objects currently allocated
+    long long   sampledPeakBytes;   /// Highest sampled value of liveBytes, see AllocationSite
+    long long   allocations;        /// Allocation requests since registration
+    long long   deallocations;      /// Deallocation requests since registration
+    long long   allocatedBytes;     /// Bytes requested since registration
+    double      allocationRate;     /// Allocations per second since registration
+    long long   histogram[HISTOGRAM_BUCKETS];
+} ;
+
+/**
+ * The counters of the allocations of a single type.
+ * <p>
+ * Counters are sharded: each thread is assigned one of
+ * <code>SHARD_COUNT</code> shards, each on its own cache line, and only
+ * updates its shard with relaxed atomic operations. Threads therefore do not
+ * contend on a shared counter, and the cost of recording an allocation is a
+ * handful of uncontended additions. Shards are summed when a snapshot is
+ * taken.
+ * <p>
+ * The peak of live bytes is sampled, hence its name: it is refreshed every
+ * <code>PEAK_SAMPLE_PERIOD</code> allocations of a shard and on every
+ * snapshot, so very short spikes may be missed. An exact peak would need a
+ * shared live byte counter, which is the contention the shards avoid.
+ * <p>
+ * Sites are created by <code>AllocationRegistry</code> and live for the
+ * whole execution of the program.
+ *
+ * @author J. Marrero
+ */
+class AllocationSite
+{
+public:
+
+    static const int SHARD_COUNT = 16;
+    static const int PEAK_SAMPLE_PERIOD = 256;
+
+    /**
+     * Records the allocation of <code>objects</code> objects spanning
+     * <code>bytes</code> bytes.
+     *
+     * @param objects
+     * @param bytes
+     */
+    inline void recordAllocation(std::size_t objects, std::size_t bytes)
+    {
+        Shard& shard = m_shards[shardIndex()];
+        concurrent::atomicFetchAdd(&shard.liveBytes, (long long) bytes, concurrent::RELAXED);
+        concurrent::atomicFetchAdd(&shard.liveObjects, (long long) objects, concurrent::RELAXED);
+        concurrent::atomicFetchAdd(&shard.allocatedBytes, (long long) bytes, concurrent::RELAXED);
+        concurrent::atomicFetchAdd(&shard.histogram[bucketOf(bytes)], 1LL, concurrent::RELAXED);
+
+        long long count = concurrent::atomicFetchAdd(&shard.allocations, 1LL, concurrent::RELAXED);
+        if (ARTEMIS_UNLIKELY(count % PEAK_SAMPLE_PERIOD == 0))
+        {
+            samplePeak();
+        }
+    }
+
+    /**
+     * Records the release of <code>objects</code> objects spanning
+     * <code>bytes</code> bytes.
+     *
+     * @param objects
+     * @param bytes
+     */
+    inline void recordDeallocation(std::size_t objects, std::size_t bytes)
+    {
+        Shard& shard = m_shards[shardIndex()];
+        concurrent::atomicFetchSub(&shard.liveBytes, (long long) bytes, concurrent::RELAXED);
+        concurrent::atomicFetchSub(&shard.liveObjects, (long long) objects, concurrent::RELAXED);
+        concurrent::atomicFetchAdd(&shard.deallocations, 1LL, concurrent::RELAXED);
+    }
+
+    /**
+     * Returns the name of the type whose allocations are tracked by this
+     * site.
+     *
+     * @return
+     */
+    inline const char* getTypeName() const
+    {
+        return m_typeName;
+    }
+
+    /**
+     * Sums the shards of this site into a snapshot.
+     *
+     * @param snapshot
+     */
+    void snapshot(AllocationSnapshot& snapshot);
+
+private:
+
+    struct Shard
+    {
+        volatile long long liveBytes;
+        volatile long long liveObjects;
+        volatile long long allocations;
+        volatile long long deallocations;
+        volatile long long allocatedBytes;
+        volatile long long histogram[AllocationSnapshot::HISTOGRAM_BUCKETS];
+        char               padding[64 - ((5 + AllocationSnapshot::HISTOGRAM_BUCKETS) * sizeof (long long)) % 64];
+    } ;
+
+    Shard           m_shards[SHARD_COUNT];
+    char*           m_typeName;
+    double          m_created;
+    volatile long long m_sampledPeakBytes;
+    AllocationSite* m_next;
+
+    AllocationSite(const char* typeName);
+    ~AllocationSite();
+
+    AllocationSite(const AllocationSite&);
+    AllocationSite& operator=(const AllocationSite&);
+
+    static int shardIndex();
+
+    static inline int bucketOf(std::size_t bytes)
+    {
+        int bucket = 0;
+        for (std::size_t limit = 16; bytes > limit && bucket < AllocationSnapshot::HISTOGRAM_BUCKETS - 1; limit <<= 1)
+        {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    long long sumLiveBytes() const;
+    void samplePeak();
+
+    friend class AllocationRegistry;
+} ;
+
+/**
+ * The global registry of allocation sites, keyed by type name.
+ * <p>
+ * The registry is the reporting end of <code>InstrumentedAllocator</code>:
+ * every instrumented allocator records its traffic in the site of its
+ * value type, and the registry exposes the sites as snapshots or as a text
+ * report. It allows finding the memory hot spots of a long running process
+ * without an external profiler, and objects that are never released show up
+ * as live objects at exit.
+ *
+ * @author J. Marrero
+ */
+class AllocationRegistry
+{
+public:
+
+    /**
+     * Returns the allocation site of the named type, creating it if it does
+     * not exist. The returned site is valid for the whole execution of the
+     * program, so callers should look it up once and keep the pointer.
+     * <p>
+     * Names produced by <code>typeid</code> may be passed with
+     * <code>mangled</code> set, and will be demangled when the compiler
+     * supports it.
+     *
+     * @param typeName
+     * @param mangled
+     * @return
+     */
+    static AllocationSite* getSite(const char* typeName, bool mangled = false);
+
+    /**
+     * Takes a snapshot of every registered site, in registration order.
+     *
+     * @return
+     */
+    static std::vector<AllocationSnapshot> snapshot();
+
+    /**
+     * Writes a report of every registered site to <code>out</code>, one line
+     * per type, sorted by live bytes. When <code>histograms</code> is set,
+     * the size histogram of each type is printed after its line.
+     *
+     * @param out
+     * @param histograms
+     */
+    static void dump(std::FILE* out = stdout, bool histograms = false);
+
+    /**
+     * Registers a handler that reports, at program exit, the types that still
+     * have live objects.
+     */
+    static void reportLeaksAtExit();
+
+private:
+
+    AllocationRegistry();
+} ;
+
+}
+}
+
+#endif /* ALLOCATIONREGISTRY_H */
@@ -35,6 +35,10 @@
 // C++
 #include <cstddef>
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <utility>
+#endif
+
 namespace axf
 {
 namespace collections
@@ -101,6 +105,19 @@ public:
      */
     virtual Allocator<T>::pointer construct(Allocator<T>::pointer p, Allocator<T>::const_reference args) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Constructs an object of type <code>T</code> in previously allocated
+     * storage at address pointed to by <code>p</code>, moving the contents
+     * of <code>args</code> into the new object.
+     *
+     * @param p
+     * @param args
+     */
+    virtual Allocator<T>::pointer construct(Allocator<T>::pointer p, T&& args) = 0;
+#endif
+
     /**
      * Releases storage pointed to <code>p</code>. <code>p</code> must be
      * a pointer obtained by a previous call to <code>allocate</code> that
@@ -142,6 +159,39 @@ public:
      */
     virtual void destroy(Allocator<T>::pointer p) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Allocates storage for a single object and constructs it in place,
+     * forwarding <code>args</code> to the constructor of <code>T</code>. No
+     * temporary object is created.
+     * <p>
+     * Construction bypasses the virtual <code>construct</code> methods, since
+     * those can not be templated. If the constructor throws, the storage is
+     * returned to the allocator before the exception is propagated.
+     * <p>
+     * This method throws an <code>OutOfMemoryError</code> exception if the
+     * system (or the allocator if it is not system-wide) runs out of memory.
+     *
+     * @param args
+     * @return
+     */
+    template <typename... Args>
+    T* emplaceObject(Args&&... args)
+    {
+        T* memory = allocateChecked();
+        try
+        {
+            return new (memory) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(memory);
+            throw;
+        }
+    }
+#endif
+
     /**
      * Returns the max size that can allocate this allocator within a single
      * allocation request.
@@ -161,13 +211,61 @@ public:
      * @return
      */
     T* newObject(Allocator<T>::const_reference args)
+    {
+        T* memory = allocateChecked();
+        try
+        {
+            return construct(memory, args);
+        }
+        catch (...)
+        {
+            deallocate(memory);
+            throw;
+        }
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Constructs a new object by moving <code>args</code> into freshly
+     * allocated storage. The object must be move constructible. If the move
+     * constructor throws, the storage is returned to the allocator before
+     * the exception is propagated.
+     *
+     * @param args
+     * @return
+     */
+    T* newObject(T&& args)
+    {
+        T* memory = allocateChecked();
+        try
+        {
+            return construct(memory, std::move(args));
+        }
+        catch (...)
+        {
+            deallocate(memory);
+            throw;
+        }
+    }
+#endif
+
+private:
+
+    /**
+     * Allocates storage for a single object, throwing an
+     * <code>OutOfMemoryError</code> if the request can not be satisfied.
+     *
+     * @return
+     */
+    inline T* allocateChecked()
     {
         T* memory = allocate();
         if (memory == NULL)
         {
             throw axf::core::OutOfMemoryError("unable to satisfy allocation request because of memory exhaustion.");
         }
-        return construct(memory, args);
+        return memory;
     }
 
 } ;
@@ -61,6 +61,17 @@ public:
      */
     virtual bool add(const E& element) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Adds the element to the collection, moving it instead of copying it.
+     *
+     * @param element
+     * @return
+     */
+    virtual bool add(E&& element) = 0;
+#endif
+
     /**
      * Returns an iterator to the beginning of this sequence.
      *
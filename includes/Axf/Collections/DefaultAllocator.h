@@ -28,10 +28,16 @@
 #define DEFAULTALLOCATOR_H
 
 // API
+#include <Axf/Collections/AllocationProfiler.h>
 #include <Axf/Collections/Allocator.h>
 
 // C++
 #include <climits>
+#include <new>
+
+#ifndef SIZE_MAX
+#define SIZE_MAX    ((std::size_t) -1)
+#endif
 
 namespace axf
 {
@@ -41,7 +47,9 @@ namespace collections
 /**
  * A default allocator object implementation using <code>operator ::new</code>.
  * <p>
- * This allocator is the default memory allocator for the library.
+ * This allocator is the default memory allocator for the library. Its
+ * allocations and releases are accounted for by the
+ * <code>AllocationProfiler</code>.
  *
  * @author J. Marrero
  */
@@ -55,7 +63,9 @@ public:
 
     T* allocate(typename Allocator<T>::size_type n = 1)
     {
-        return reinterpret_cast<T*> (new char[n * sizeof (T)]);
+        T* p = reinterpret_cast<T*> (new char[n * sizeof (T)]);
+        AllocationProfiler::recordAllocation(p, n * sizeof (T), typeid (T));
+        return p;
     }
 
     T* construct(T* p, const T& args)
@@ -63,6 +73,14 @@ public:
         return new (p) T(args);
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    T* construct(T* p, T&& args)
+    {
+        return new (p) T(std::move(args));
+    }
+#endif
+
     void destroy(T* p)
     {
         ((T*) (p))->~T();
@@ -70,6 +88,7 @@ public:
 
     void deallocate(T* p, typename Allocator<T>::size_type n)
     {
+        AllocationProfiler::recordDeallocation(p);
         delete[] reinterpret_cast<char*> (p);
     }
 
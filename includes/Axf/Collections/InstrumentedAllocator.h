@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   InstrumentedAllocator.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 5:02 PM
+ */
+
+#ifndef INSTRUMENTEDALLOCATOR_H
+#define INSTRUMENTEDALLOCATOR_H
+
+// API
+#include <Axf/Collections/AllocationRegistry.h>
+#include <Axf/Collections/DefaultAllocator.h>
+
+// C++
+#include <typeinfo>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * An allocator decorator that records every allocation and deallocation in
+ * the <code>AllocationRegistry</code>, and forwards the requests to another
+ * allocator.
+ * <p>
+ * Allocations are recorded in the site named after the value type: the
+ * reflection name for library objects, or the (demangled) name reported by
+ * <code>typeid</code> for any other type. A site name may also be given
+ * explicitly, to tell apart the allocations of different containers of the
+ * same type.
+ * <p>
+ * The site is resolved when the allocator is created, so recording an
+ * allocation costs only a few uncontended atomic additions.
+ *
+ * @author J. Marrero
+ */
+template <class T, class Inner = DefaultAllocator<T> >
+class InstrumentedAllocator : public Allocator<T>
+{
+
+    AXF_CLASS_TYPE(AXF_TEMPLATE_CLASS(axf::collections::InstrumentedAllocator<T, Inner>),
+               AXF_TYPE(axf::collections::Allocator<T>))
+public:
+
+    /**
+     * Creates an allocator that records its traffic in the site of its value
+     * type.
+     */
+    InstrumentedAllocator() : m_site(defaultSite()) { }
+
+    /**
+     * Creates an allocator that records its traffic in the named site.
+     *
+     * @param siteName
+     */
+    explicit InstrumentedAllocator(const char* siteName) : m_site(AllocationRegistry::getSite(siteName)) { }
+
+    T* allocate(typename Allocator<T>::size_type n = 1)
+    {
+        T* p = m_allocator.allocate(n);
+        if (p != NULL)
+        {
+            m_site->recordAllocation(n, n * sizeof (T));
+        }
+        return p;
+    }
+
+    T* construct(T* p, const T& args)
+    {
+        return m_allocator.construct(p, args);
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    T* construct(T* p, T&& args)
+    {
+        return m_allocator.construct(p, std::move(args));
+    }
+#endif
+
+    void destroy(T* p)
+    {
+        m_allocator.destroy(p);
+    }
+
+    void deallocate(T* p, typename Allocator<T>::size_type n = 1)
+    {
+        if (p != NULL)
+        {
+            m_site->recordDeallocation(n, n * sizeof (T));
+            m_allocator.deallocate(p, n);
+        }
+    }
+
+    virtual typename Allocator<T>::size_type maxSize() const
+    {
+        return m_allocator.maxSize();
+    }
+
+    /**
+     * Returns the site where this allocator records its traffic.
+     *
+     * @return
+     */
+    inline AllocationSite* getSite() const
+    {
+        return m_site;
+    }
+
+private:
+
+    AllocationSite* m_site;
+    Inner           m_allocator;
+
+    static AllocationSite* defaultSite()
+    {
+        static AllocationSite* site = defaultSite(typename traits::is_base_of<core::Object, T>::type());
+        return site;
+    }
+
+    static AllocationSite* defaultSite(traits::true_type)
+    {
+        return AllocationRegistry::getSite(T::getCompileTimeClass().getName());
+    }
+
+    static AllocationSite* defaultSite(traits::false_type)
+    {
+        return AllocationRegistry::getSite(typeid (T).name(), true);
+    }
+} ;
+
+}
+}
+
+#endif /* INSTRUMENTEDALLOCATOR_H */
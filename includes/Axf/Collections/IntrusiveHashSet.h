@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   IntrusiveHashSet.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:40 AM
+ */
+
+#ifndef INTRUSIVEHASHSET_H
+#define INTRUSIVEHASHSET_H
+
+// API
+#include <Axf/Collections/IntrusiveList.h>
+#include <Axf/Core/Lang-C++/traits.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/Object.h>
+
+// C++
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * The link hook embedded into elements of an <code>IntrusiveHashSet</code>.
+ * <p>
+ * Besides the link to the next element of the bucket, the hook caches the
+ * hash code of the element, so re-hashing and bucket scans never call
+ * <code>hashCode</code> again. The element must not change its hash code
+ * while it is linked.
+ *
+ * @author J. Marrero
+ */
+template <typename Tag = DefaultHookTag>
+class IntrusiveHashHook
+{
+    template <typename, typename, bool>
+    friend class IntrusiveHashSet;
+
+public:
+
+    IntrusiveHashHook() : m_next(NULL), m_hash(0), m_linked(false) { }
+
+    IntrusiveHashHook(const IntrusiveHashHook<Tag>&) : m_next(NULL), m_hash(0), m_linked(false) { }
+
+    /**
+     * An element must be unlinked before it is destroyed; otherwise its set
+     * is left holding a dangling hook.
+     */
+    ~IntrusiveHashHook()
+    {
+        assert(!m_linked && "intrusive element destroyed while linked into a set");
+    }
+
+    /**
+     * Returns true if this hook is currently linked into a set.
+     *
+     * @return
+     */
+    inline bool isLinked() const
+    {
+        return m_linked;
+    }
+
+    inline IntrusiveHashHook<Tag>& operator=(const IntrusiveHashHook<Tag>&)
+    {
+        return *this;
+    }
+
+private:
+
+    IntrusiveHashHook<Tag>* m_next;     /// The next hook in the bucket
+    int                     m_hash;     /// The cached hash code of the element
+    bool                    m_linked;   /// True while linked into a set
+} ;
+
+/**
+ * A hash set whose elements carry their own links.
+ * <p>
+ * Elements are <code>Object</code> descendants that inherit an
+ * <code>IntrusiveHashHook</code>. Equality and hashing are defined by the
+ * element's <code>equals</code> and <code>hashCode</code> methods. Inserting
+ * an element never allocates memory for the element itself; the only
+ * allocation is the bucket array, which grows geometrically, so insertion is
+ * allocation free in the amortized sense.
+ * <p>
+ * As with <code>IntrusiveList</code>, when <code>strongReferences</code> is
+ * true the set holds a strong reference to every linked element.
+ *
+ * @author J. Marrero
+ */
+template <typename T, typename Tag = DefaultHookTag, bool strongReferences = false>
+class IntrusiveHashSet : public core::Object
+{
+    AXF_CLASS_TYPE(AXF_TEMPLATE_CLASS(axf::collections::IntrusiveHashSet<T, Tag, strongReferences>),
+                   AXF_TYPE(axf::core::Object))
+public:
+
+    typedef IntrusiveHashHook<Tag> hook_type;  /// The hook type linked by this set
+
+    /**
+     * Constructs a new empty set. The bucket array is allocated lazily, on
+     * the first insertion, with at least <code>initialBuckets</code> buckets.
+     *
+     * @param initialBuckets
+     */
+    IntrusiveHashSet(std::size_t initialBuckets = 16)
+    :
+    m_buckets(NULL),
+    m_bucketCount(0),
+    m_initialBuckets(roundUp(initialBuckets)),
+    m_size(0)
+    {
+    }
+
+    /**
+     * Destroys this set, unlinking (and releasing, if references are held)
+     * every element.
+     */
+    virtual ~IntrusiveHashSet()
+    {
+        clear();
+        delete[] m_buckets;
+    }
+
+    /**
+     * Unlinks every element of this set. The bucket array is kept.
+     */
+    void clear()
+    {
+        for (std::size_t i = 0; i < m_bucketCount; ++i)
+        {
+            hook_type* current = m_buckets[i];
+            while (current != NULL)
+            {
+                hook_type* next = current->m_next;
+
+                current->m_next = NULL;
+                current->m_linked = false;
+                release(toElement(current), ownership());
+
+                current = next;
+            }
+            m_buckets[i] = NULL;
+        }
+        m_size = 0;
+    }
+
+    /**
+     * Returns true if an element equal to <code>key</code> is linked into
+     * this set.
+     *
+     * @param key
+     * @return
+     */
+    inline bool contains(const T& key) const
+    {
+        return find(key) != NULL;
+    }
+
+    /**
+     * Returns the linked element equal to <code>key</code>, or
+     * <code>NULL</code> if there is none. The key does not need to be linked;
+     * it is typically a stack allocated probe.
+     *
+     * @param key
+     * @return
+     */
+    inline T* find(const T& key) const
+    {
+        return (m_size == 0) ? NULL : findHashed(key, key.hashCode());
+    }
+
+    /**
+     * Links an element into this set. Returns false, and leaves the element
+     * unlinked, if an equal element is already present.
+     *
+     * @param element
+     * @return
+     */
+    bool insert(T& element)
+    {
+        hook_type* hook = toHook(&element);
+        if (hook->m_linked)
+        {
+            throw core::IllegalStateException("attempted to link an element that is already linked.");
+        }
+        int hash = element.hashCode();
+        if (m_size != 0 && findHashed(element, hash) != NULL)
+        {
+            return false;
+        }
+
+        if (m_size + 1 > m_bucketCount)
+        {
+            rehash((m_bucketCount == 0) ? m_initialBuckets : m_bucketCount * 2);
+        }
+
+        hook->m_hash = hash;
+        hook->m_linked = true;
+        linkHook(hook);
+
+        grab(&element, ownership());
+        ++m_size;
+        return true;
+    }
+
+    /**
+     * Returns true if this set has no elements.
+     *
+     * @return
+     */
+    inline bool isEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * Unlinks an element from this set. Returns false if the element is not
+     * linked into this set. If references are held, the element is released
+     * and may be destroyed.
+     *
+     * @param element
+     * @return
+     */
+    bool remove(T& element)
+    {
+        hook_type* hook = toHook(&element);
+        if (!hook->m_linked || m_bucketCount == 0)
+            return false;
+
+        hook_type** link = &m_buckets[indexOf(hook->m_hash)];
+        while (*link != NULL && *link != hook)
+        {
+            link = &(*link)->m_next;
+        }
+        if (*link == NULL)
+            return false;
+
+        *link = hook->m_next;
+        hook->m_next = NULL;
+        hook->m_linked = false;
+        --m_size;
+
+        release(&element, ownership());
+        return true;
+    }
+
+    /**
+     * Returns the number of linked elements.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+
+    hook_type**     m_buckets;          /// The bucket array, each bucket is a singly linked chain
+    std::size_t     m_bucketCount;      /// The number of buckets, always a power of two
+    std::size_t     m_initialBuckets;   /// The bucket count of the first allocation
+    std::size_t     m_size;             /// The number of linked elements
+
+    IntrusiveHashSet(const IntrusiveHashSet<T, Tag, strongReferences>&);
+    IntrusiveHashSet<T, Tag, strongReferences>& operator=(const IntrusiveHashSet<T, Tag, strongReferences>&);
+
+    typedef traits::integral_constant<bool, strongReferences> ownership;
+
+    static inline std::size_t roundUp(std::size_t count)
+    {
+        std::size_t result = 1;
+        while (result < count)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static inline hook_type* toHook(T* element)
+    {
+        return static_cast<hook_type*> (element);
+    }
+
+    static inline T* toElement(hook_type* hook)
+    {
+        return static_cast<T*> (hook);
+    }
+
+    inline std::size_t indexOf(int hash) const
+    {
+        // Fold the high bits in, since weak hash codes vary mostly there
+        unsigned int h = (unsigned int) hash;
+        h ^= h >> 16;
+        return h & (m_bucketCount - 1);
+    }
+
+    /**
+     * Looks up an element equal to <code>key</code>, whose hash code has
+     * already been computed. The set must not be empty.
+     */
+    T* findHashed(const T& key, int hash) const
+    {
+        for (hook_type* current = m_buckets[indexOf(hash)]; current != NULL; current = current->m_next)
+        {
+            if (current->m_hash == hash && toElement(current)->equals(key))
+            {
+                return toElement(current);
+            }
+        }
+        return NULL;
+    }
+
+    inline void linkHook(hook_type* hook)
+    {
+        hook_type** bucket = &m_buckets[indexOf(hook->m_hash)];
+        hook->m_next = *bucket;
+        *bucket = hook;
+    }
+
+    /**
+     * Allocates a new bucket array and relinks every element using the cached
+     * hash codes.
+     */
+    void rehash(std::size_t bucketCount)
+    {
+        hook_type** previous = m_buckets;
+        std::size_t previousCount = m_bucketCount;
+
+        m_buckets = new hook_type*[bucketCount];
+        std::memset(m_buckets, 0, bucketCount * sizeof (hook_type*));
+        m_bucketCount = bucketCount;
+
+        for (std::size_t i = 0; i < previousCount; ++i)
+        {
+            hook_type* current = previous[i];
+            while (current != NULL)
+            {
+                hook_type* next = current->m_next;
+                linkHook(current);
+                current = next;
+            }
+        }
+        delete[] previous;
+    }
+
+    static inline void grab(T* element, traits::true_type)
+    {
+        element->grabStrongReference();
+    }
+
+    static inline void grab(T*, traits::false_type) { }
+
+    static inline void release(T* element, traits::true_type)
+    {
+        element->releaseStrongReference();
+    }
+
+    static inline void release(T*, traits::false_type) { }
+} ;
+
+}
+}
+
+#endif /* INTRUSIVEHASHSET_H */
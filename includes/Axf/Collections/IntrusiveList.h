@@ -0,0 +1,456 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   IntrusiveList.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:02 AM
+ */
+
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+// API
+#include <Axf/Core/Lang-C++/traits.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/Object.h>
+#include <Axf/Core/ReferenceCounted.h>
+
+// C++
+#include <cassert>
+#include <cstddef>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * Default tag for intrusive hooks. Elements that must be linked into several
+ * intrusive containers at once embed one hook per container, each one with a
+ * different tag type.
+ */
+struct DefaultHookTag
+{
+} ;
+
+/**
+ * The link hook embedded into elements of an <code>IntrusiveList</code>.
+ * <p>
+ * Elements become linkable by inheriting this class. The hook stores the
+ * previous and next pointers that a <code>LinkedList</code> would store in
+ * a separately allocated node, so linking an element never allocates memory.
+ * <p>
+ * Copying an element does not copy its links: the copy starts unlinked, and
+ * assigning an element does not modify the links of the target.
+ *
+ * @author J. Marrero
+ */
+template <typename Tag = DefaultHookTag>
+class IntrusiveListHook
+{
+    template <typename, typename, bool>
+    friend class IntrusiveList;
+
+public:
+
+    IntrusiveListHook() : m_next(NULL), m_previous(NULL) { }
+
+    IntrusiveListHook(const IntrusiveListHook<Tag>&) : m_next(NULL), m_previous(NULL) { }
+
+    /**
+     * An element must be unlinked before it is destroyed; otherwise its list
+     * is left holding a dangling hook.
+     */
+    ~IntrusiveListHook()
+    {
+        assert(!isLinked() && "intrusive element destroyed while linked into a list");
+    }
+
+    /**
+     * Returns true if this hook is currently linked into a list.
+     *
+     * @return
+     */
+    inline bool isLinked() const
+    {
+        return m_next != NULL;
+    }
+
+    inline IntrusiveListHook<Tag>& operator=(const IntrusiveListHook<Tag>&)
+    {
+        return *this;
+    }
+
+private:
+
+    IntrusiveListHook<Tag>* m_next;         /// The next hook, or the list sentinel
+    IntrusiveListHook<Tag>* m_previous;     /// The previous hook, or the list sentinel
+} ;
+
+/**
+ * A doubly-linked list whose elements carry their own links.
+ * <p>
+ * Unlike <code>LinkedList</code>, this list does not own copies of the
+ * elements. It links the elements themselves through the
+ * <code>IntrusiveListHook</code> they inherit. As a consequence:
+ * <ul>
+ *  <li>insertion never allocates memory</li>
+ *  <li>an element can be unlinked in O(1) from any position, given just a
+ *      reference to it</li>
+ *  <li>an element may be linked into one list per hook at any given time</li>
+ * </ul>
+ * <p>
+ * When <code>strongReferences</code> is true the list holds a strong reference
+ * to each linked element, grabbing it on insertion and releasing it on
+ * removal, so elements kept alive by <code>strong_ref</code> stay alive while
+ * they are linked. In that mode the element type must derive from
+ * <code>ReferenceCounted</code> and must be heap allocated, since the last
+ * release deletes the element.
+ * <p>
+ * The list is circular around a sentinel hook, so there are no special cases
+ * for the head or the tail.
+ *
+ * @author J. Marrero
+ */
+template <typename T, typename Tag = DefaultHookTag, bool strongReferences = false>
+class IntrusiveList : public core::Object
+{
+    AXF_CLASS_TYPE(AXF_TEMPLATE_CLASS(axf::collections::IntrusiveList<T, Tag, strongReferences>),
+                   AXF_TYPE(axf::core::Object))
+public:
+
+    typedef IntrusiveListHook<Tag> hook_type;  /// The hook type linked by this list
+
+    /**
+     * Constructs a new, empty list.
+     */
+    IntrusiveList() : m_size(0)
+    {
+        m_sentinel.m_next = &m_sentinel;
+        m_sentinel.m_previous = &m_sentinel;
+    }
+
+    /**
+     * Destroys this list. Every element is unlinked (and released, if the
+     * list holds strong references) but no element is destroyed otherwise.
+     */
+    virtual ~IntrusiveList()
+    {
+        clear();
+
+        // The sentinel links to itself; detach it so its hook destructor
+        // does not mistake it for a linked element
+        m_sentinel.m_next = NULL;
+        m_sentinel.m_previous = NULL;
+    }
+
+    /**
+     * Returns the last element of this list, or <code>NULL</code> if the list
+     * is empty.
+     *
+     * @return
+     */
+    inline T* back() const
+    {
+        return isEmpty() ? NULL : toElement(m_sentinel.m_previous);
+    }
+
+    /**
+     * Unlinks every element of this list.
+     */
+    void clear()
+    {
+        while (!isEmpty())
+        {
+            remove(*toElement(m_sentinel.m_next));
+        }
+    }
+
+    /**
+     * Returns true if the element is linked into this list. This is an O(n)
+     * operation; use <code>isLinked</code> on the hook when it is known that
+     * the element can only be in this list.
+     *
+     * @param element
+     * @return
+     */
+    bool contains(const T& element) const
+    {
+        const hook_type* hook = toHook(&element);
+        for (const hook_type* current = m_sentinel.m_next; current != &m_sentinel; current = current->m_next)
+        {
+            if (current == hook)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Returns the first element of this list, or <code>NULL</code> if the
+     * list is empty.
+     *
+     * @return
+     */
+    inline T* front() const
+    {
+        return isEmpty() ? NULL : toElement(m_sentinel.m_next);
+    }
+
+    /**
+     * Links <code>element</code> immediately before <code>position</code>,
+     * which must be linked into this list.
+     *
+     * @param position
+     * @param element
+     */
+    inline void insertBefore(T& position, T& element)
+    {
+        link(toHook(&position), toHook(&element));
+    }
+
+    /**
+     * Returns true if this list has no elements.
+     *
+     * @return
+     */
+    inline bool isEmpty() const
+    {
+        return m_sentinel.m_next == &m_sentinel;
+    }
+
+    /**
+     * Moves an element already linked into this list to its back. This is
+     * the typical "touch" operation of an LRU list, and it neither allocates
+     * nor changes reference counts.
+     *
+     * @param element
+     */
+    inline void moveToBack(T& element)
+    {
+        hook_type* hook = toHook(&element);
+        unlinkHook(hook);
+        linkHook(&m_sentinel, hook);
+    }
+
+    /**
+     * Moves an element already linked into this list to its front.
+     *
+     * @param element
+     */
+    inline void moveToFront(T& element)
+    {
+        hook_type* hook = toHook(&element);
+        unlinkHook(hook);
+        linkHook(m_sentinel.m_next, hook);
+    }
+
+    /**
+     * Returns the element following <code>element</code>, or
+     * <code>NULL</code> if it is the last one.
+     *
+     * @param element
+     * @return
+     */
+    inline T* next(const T& element) const
+    {
+        const hook_type* hook = toHook(&element)->m_next;
+        return (hook == &m_sentinel) ? NULL : toElement(hook);
+    }
+
+    /**
+     * Unlinks and returns the last element of this list, or <code>NULL</code>
+     * if the list is empty.
+     * <p>
+     * If the list holds strong references, the reference is handed to the
+     * caller: it is not released.
+     *
+     * @return
+     */
+    T* popBack()
+    {
+        T* element = back();
+        if (element != NULL)
+        {
+            unlink(toHook(element));
+        }
+        return element;
+    }
+
+    /**
+     * Unlinks and returns the first element of this list, or <code>NULL</code>
+     * if the list is empty.
+     * <p>
+     * If the list holds strong references, the reference is handed to the
+     * caller: it is not released.
+     *
+     * @return
+     */
+    T* popFront()
+    {
+        T* element = front();
+        if (element != NULL)
+        {
+            unlink(toHook(element));
+        }
+        return element;
+    }
+
+    /**
+     * Returns the element preceding <code>element</code>, or
+     * <code>NULL</code> if it is the first one.
+     *
+     * @param element
+     * @return
+     */
+    inline T* previous(const T& element) const
+    {
+        const hook_type* hook = toHook(&element)->m_previous;
+        return (hook == &m_sentinel) ? NULL : toElement(hook);
+    }
+
+    /**
+     * Links an element at the back of this list.
+     *
+     * @param element
+     */
+    inline void pushBack(T& element)
+    {
+        link(&m_sentinel, toHook(&element));
+    }
+
+    /**
+     * Links an element at the front of this list.
+     *
+     * @param element
+     */
+    inline void pushFront(T& element)
+    {
+        link(m_sentinel.m_next, toHook(&element));
+    }
+
+    /**
+     * Unlinks an element from this list in constant time. The element must be
+     * linked into this list. If the list holds strong references, the
+     * reference is released and the element may be destroyed.
+     *
+     * @param element
+     */
+    inline void remove(T& element)
+    {
+        unlink(toHook(&element));
+        release(&element, ownership());
+    }
+
+    /**
+     * Returns the number of linked elements.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+
+    hook_type   m_sentinel;     /// The sentinel closing the circular list
+    std::size_t m_size;         /// The number of linked elements
+
+    IntrusiveList(const IntrusiveList<T, Tag, strongReferences>&);
+    IntrusiveList<T, Tag, strongReferences>& operator=(const IntrusiveList<T, Tag, strongReferences>&);
+
+    static inline hook_type* toHook(T* element)
+    {
+        return static_cast<hook_type*> (element);
+    }
+
+    static inline const hook_type* toHook(const T* element)
+    {
+        return static_cast<const hook_type*> (element);
+    }
+
+    static inline T* toElement(const hook_type* hook)
+    {
+        return static_cast<T*> (const_cast<hook_type*> (hook));
+    }
+
+    /**
+     * Grabs a reference (if needed) and links the hook before the position.
+     */
+    inline void link(hook_type* position, hook_type* hook)
+    {
+        if (hook->isLinked())
+        {
+            throw core::IllegalStateException("attempted to link an element that is already linked.");
+        }
+        grab(toElement(hook), ownership());
+        linkHook(position, hook);
+        ++m_size;
+    }
+
+    static inline void linkHook(hook_type* position, hook_type* hook)
+    {
+        hook->m_next = position;
+        hook->m_previous = position->m_previous;
+        position->m_previous->m_next = hook;
+        position->m_previous = hook;
+    }
+
+    inline void unlink(hook_type* hook)
+    {
+        unlinkHook(hook);
+        hook->m_next = NULL;
+        hook->m_previous = NULL;
+        --m_size;
+    }
+
+    static inline void unlinkHook(hook_type* hook)
+    {
+        hook->m_previous->m_next = hook->m_next;
+        hook->m_next->m_previous = hook->m_previous;
+    }
+
+    /**
+     * Compile time selector for the reference holding policy. The strong
+     * overloads are only instantiated when used, so they only require
+     * <code>T</code> to be reference counted when references are held.
+     */
+    typedef traits::integral_constant<bool, strongReferences> ownership;
+
+    static inline void grab(T* element, traits::true_type)
+    {
+        element->grabStrongReference();
+    }
+
+    static inline void grab(T*, traits::false_type) { }
+
+    static inline void release(T* element, traits::true_type)
+    {
+        element->releaseStrongReference();
+    }
+
+    static inline void release(T*, traits::false_type) { }
+} ;
+
+}
+}
+
+#endif /* INTRUSIVELIST_H */
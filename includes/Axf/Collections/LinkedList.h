@@ -33,6 +33,9 @@
 #include <Axf/Collections/Iterator.h>
 #include <Axf/Core/IndexOutOfBoundsException.h>
 #include <Axf/Core/Memory.h>
+
+// C++
+#include <utility>
 namespace axf
 {
 namespace collections
@@ -41,6 +44,13 @@ namespace collections
 namespace
 {
 
+/**
+ * Tag type used to select the in-place constructor of a node.
+ */
+struct EmplaceTag
+{
+} ;
+
 /**
  * A node within a linked list.
  */
@@ -59,6 +69,25 @@ struct Node : public axf::core::ReferenceCounted
      */
     Node(const E& data) : m_data(data), m_next(NULL), m_previous(NULL) { }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Constructs a new node, moving the data into it.
+     *
+     * @param data
+     */
+    Node(E&& data) : m_data(std::move(data)), m_next(NULL), m_previous(NULL) { }
+
+    /**
+     * Constructs a new node, building the data in place from the given
+     * constructor arguments.
+     *
+     * @param args
+     */
+    template <typename... Args>
+    Node(EmplaceTag, Args&&... args) : m_data(std::forward<Args>(args)...), m_next(NULL), m_previous(NULL) { }
+#endif
+
     /**
      * Destructs a node
      */
@@ -137,19 +166,88 @@ public:
      */
     LinkedList() : m_head(NULL), m_size(0), m_tail(NULL) { }
 
+    /**
+     * Constructs a new <code>LinkedList</code> object holding a copy of every
+     * element of <code>rhs</code>, in the same order.
+     *
+     * @param rhs
+     */
+    LinkedList(const LinkedList<E, allocator>& rhs) : List<E>(), m_head(NULL), m_size(0), m_tail(NULL)
+    {
+        copyNodes(rhs);
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Constructs a new <code>LinkedList</code> object by taking ownership of
+     * the nodes of <code>rhs</code>. The moved-from list is left empty.
+     *
+     * @param rhs
+     */
+    LinkedList(LinkedList<E, allocator>&& rhs)
+    :
+    m_allocator(std::move(rhs.m_allocator)),
+    m_head(rhs.m_head),
+    m_size(rhs.m_size),
+    m_tail(rhs.m_tail)
+    {
+        rhs.m_head = NULL;
+        rhs.m_size = 0;
+        rhs.m_tail = NULL;
+    }
+#endif
+
     /**
      * Destroys the linked list, releasing all allocated memory.
      */
     virtual ~LinkedList()
     {
-        while (m_head != NULL)
+        disposeNodes();
+    }
+
+    /**
+     * Copy assignment operator. The elements of this list are released and
+     * replaced by copies of the elements of <code>rhs</code>.
+     *
+     * @param rhs
+     * @return
+     */
+    LinkedList<E, allocator>& operator=(const LinkedList<E, allocator>& rhs)
+    {
+        if (this != &rhs)
         {
-            Node<E>* deletable = m_head;
-            m_head = m_head->m_next;
+            disposeNodes();
+            copyNodes(rhs);
+        }
+        return *this;
+    }
 
-            m_allocator.deleteObject(deletable);
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The nodes of <code>rhs</code> are taken over
+     * without copying, and only then are the nodes held by this list
+     * released, since <code>rhs</code> may be reachable from them.
+     *
+     * @param rhs
+     * @return
+     */
+    LinkedList<E, allocator>& operator=(LinkedList<E, allocator>&& rhs)
+    {
+        if (this != &rhs)
+        {
+            // The previous nodes go with their allocator
+            LinkedList<E, allocator> previous(std::move(rhs));
+
+            std::swap(m_allocator, previous.m_allocator);
+            std::swap(m_head, previous.m_head);
+            std::swap(m_size, previous.m_size);
+            std::swap(m_tail, previous.m_tail);
         }
+        return *this;
     }
+#endif
 
     /**
      * Adds the element to the end of this linked list.
@@ -159,17 +257,7 @@ public:
      */
     virtual bool add(const E& element)
     {
-        // Create the node
-        Node<E>* node = allocateNode(element);
-        if (node)
-        {
-            // Add the node to the end
-            insertEnd(node);
-
-            // Increment the size
-            ++m_size;
-        }
-        return node != NULL;
+        return linkEnd(allocateNode(element));
     }
 
     /**
@@ -184,26 +272,74 @@ public:
     virtual bool add(std::size_t index, const E& data)
     {
         checkIndexOutOfBounds(index);
+        return linkAt(index, allocateNode(data));
+    }
 
-        // Node pointer
-        Node<E>* node = allocateNode(data);
-        if (node)
-        {
-            Node<E>* current = m_head;
+#ifdef ARTEMIS_CXX11_SUPPORTED
 
-            size_t i = 0;
-            while (i++ < index)
-            {
-                // Iterate
-                current = current->m_next;
-            }
+    /**
+     * Adds the element to the end of this linked list, moving it into the
+     * newly allocated node.
+     *
+     * @param element
+     * @return
+     */
+    virtual bool add(E&& element)
+    {
+        return linkEnd(m_allocator.emplaceObject(std::move(element)));
+    }
 
-            insertAfter(current, node);
-        }
+    /**
+     * Adds the element at the specified index on the list, moving it into the
+     * newly allocated node.
+     *
+     * @param index
+     * @param data
+     * @return
+     */
+    virtual bool add(std::size_t index, E&& data)
+    {
+        checkIndexOutOfBounds(index);
+        return linkAt(index, m_allocator.emplaceObject(std::move(data)));
+    }
 
-        // Augment the size
-        m_size++;
-        return node != NULL;
+    /**
+     * Constructs a new element in place at the end of this linked list. The
+     * arguments are forwarded to the constructor of the element type, so no
+     * temporary element is built nor copied.
+     *
+     * @param args
+     * @return
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        return linkEnd(m_allocator.emplaceObject(EmplaceTag(), std::forward<Args>(args)...));
+    }
+
+    /**
+     * Constructs a new element in place at the specified index on the list.
+     *
+     * @see axf::collections::LinkedList::add(std::size_t, const E&)
+     *
+     * @param index
+     * @param args
+     * @return
+     */
+    template <typename... Args>
+    bool emplaceAt(std::size_t index, Args&&... args)
+    {
+        checkIndexOutOfBounds(index);
+        return linkAt(index, m_allocator.emplaceObject(EmplaceTag(), std::forward<Args>(args)...));
+    }
+#endif
+
+    /**
+     * Removes every element of this list.
+     */
+    void clear()
+    {
+        disposeNodes();
     }
 
     /**
@@ -260,20 +396,19 @@ public:
             {
                 result = true;
 
-                // Store
-                Node<E>* nextCurrent = current->m_next;
-
                 // Remove
                 removeNode(current);
-
+            }
+            else
+            {
                 // Iterate
-                current = nextCurrent;
+                current = current->m_next;
             }
-            current = current->m_next;
         }
 
         // Reduce the size
-        m_size--;
+        if (result)
+            m_size--;
         return result;
     }
 
@@ -300,6 +435,42 @@ public:
         return m_size;
     }
 
+    /**
+     * Two lists are equals if they hold the same number of elements and every
+     * pair of elements at the same position compares equal.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const LinkedList<E, allocator>& rhs) const
+    {
+        if (m_size != rhs.m_size)
+            return false;
+
+        const Node<E>* left = m_head;
+        const Node<E>* right = rhs.m_head;
+        while (left != NULL && right != NULL)
+        {
+            if (!(left->m_data == right->m_data))
+                return false;
+
+            left = left->m_next;
+            right = right->m_next;
+        }
+        return left == right;
+    }
+
+    /**
+     * Negation of the equality operator.
+     *
+     * @param rhs
+     * @return
+     */
+    inline bool operator!=(const LinkedList<E, allocator>& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
 private:
 
     allocator   m_allocator;    /// The default allocator for linked lists
@@ -315,7 +486,12 @@ private:
      */
     inline Node<E>* allocateNode(const E& data)
     {
+#ifdef ARTEMIS_CXX11_SUPPORTED
+        // Build the node straight from the element, avoiding a temporary node
+        return m_allocator.emplaceObject(data);
+#else
         return m_allocator.newObject(data);
+#endif
     }
 
     /**
@@ -330,6 +506,35 @@ private:
         }
     }
 
+    /**
+     * Appends a copy of every element of <code>rhs</code> to this list.
+     *
+     * @param rhs
+     */
+    inline void copyNodes(const LinkedList<E, allocator>& rhs)
+    {
+        for (const Node<E>* current = rhs.m_head; current != NULL; current = current->m_next)
+        {
+            linkEnd(allocateNode(current->m_data));
+        }
+    }
+
+    /**
+     * Releases every node of this list, leaving it empty.
+     */
+    inline void disposeNodes()
+    {
+        while (m_head != NULL)
+        {
+            Node<E>* deletable = m_head;
+            m_head = m_head->m_next;
+
+            m_allocator.deleteObject(deletable);
+        }
+        m_size = 0;
+        m_tail = NULL;
+    }
+
     /**
      * Inserts a node after the specified node.
      *
@@ -409,6 +614,54 @@ private:
         }
     }
 
+    /**
+     * Links a newly allocated node after the node at the given position. The
+     * index must have been checked by the caller.
+     *
+     * @param index
+     * @param node
+     * @return
+     */
+    inline bool linkAt(std::size_t index, Node<E>* node)
+    {
+        if (node)
+        {
+            Node<E>* current = m_head;
+
+            size_t i = 0;
+            while (i++ < index)
+            {
+                // Iterate
+                current = current->m_next;
+            }
+
+            insertAfter(current, node);
+        }
+
+        // Augment the size
+        m_size++;
+        return node != NULL;
+    }
+
+    /**
+     * Links a newly allocated node at the end of this list.
+     *
+     * @param node
+     * @return
+     */
+    inline bool linkEnd(Node<E>* node)
+    {
+        if (node)
+        {
+            // Add the node to the end
+            insertEnd(node);
+
+            // Increment the size
+            ++m_size;
+        }
+        return node != NULL;
+    }
+
     inline void removeNode(Node<E>* node)
     {
         if (node->m_previous == NULL)
@@ -51,6 +51,19 @@ public:
      */
     virtual bool add(std::size_t index, const E& data) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Adds the element at the specified index, moving it instead of copying
+     * it.
+     *
+     * @param index
+     * @param data
+     * @return
+     */
+    virtual bool add(std::size_t index, E&& data) = 0;
+#endif
+
     /**
      * Const version of the get by index method.
      *
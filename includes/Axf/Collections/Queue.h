@@ -69,6 +69,17 @@ public:
      */
     virtual bool offer(const E& element) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Offers an element to the queue, moving it instead of copying it.
+     *
+     * @param element
+     * @return
+     */
+    virtual bool offer(E&& element) = 0;
+#endif
+
     /**
      * Peeks the element on top of this queue.
      *
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   RegionAllocator.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:10 PM
+ */
+
+#ifndef REGIONALLOCATOR_H
+#define REGIONALLOCATOR_H
+
+// API
+#include <Axf/Collections/DefaultAllocator.h>
+#include <Axf/Collections/VirtualRegion.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * A pool allocator that carves its objects from the slabs of a
+ * <code>VirtualRegion</code>.
+ * <p>
+ * Objects are packed back to back in slabs of two megabytes, so that large
+ * collections of small nodes are backed by huge pages when the region is,
+ * and a traversal touches few page translations. Released objects are kept
+ * in a free list and reused first. Every slab goes back to the region when
+ * the allocator is destroyed, so the allocator must outlive the objects it
+ * allocated; the collections, which own their allocator, guarantee it.
+ * <p>
+ * Allocators built without a region use the global one. A copy of an
+ * allocator shares its region but none of its storage; moving an allocator
+ * moves its storage.
+ * <p>
+ * Objects are aligned as their type requires, up to 64 bytes. A request
+ * may not exceed a slab; the storage of arrays is reused for single objects
+ * once they are released.
+ *
+ * @author J. Marrero
+ */
+template <class T>
+class RegionAllocator : public Allocator<T>
+{
+
+    AXF_CLASS_TYPE(axf::collections::RegionAllocator<T>,
+               AXF_TYPE(axf::collections::Allocator<T>))
+public:
+
+    RegionAllocator() : m_region(&VirtualRegion::global()), m_slabs(NULL), m_cursor(NULL), m_end(NULL), m_free(NULL) { }
+
+    explicit RegionAllocator(VirtualRegion& region) : m_region(&region), m_slabs(NULL), m_cursor(NULL), m_end(NULL), m_free(NULL) { }
+
+    RegionAllocator(const RegionAllocator<T>& rhs)
+    :
+    Allocator<T>(),
+    m_region(rhs.m_region),
+    m_slabs(NULL),
+    m_cursor(NULL),
+    m_end(NULL),
+    m_free(NULL)
+    {
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    RegionAllocator(RegionAllocator<T>&& rhs)
+    :
+    Allocator<T>(),
+    m_region(rhs.m_region),
+    m_slabs(rhs.m_slabs),
+    m_cursor(rhs.m_cursor),
+    m_end(rhs.m_end),
+    m_free(rhs.m_free)
+    {
+        rhs.forget();
+    }
+#endif
+
+    ~RegionAllocator()
+    {
+        releaseSlabs();
+    }
+
+    /**
+     * Assigning an allocator keeps the storage of each side where it is.
+     *
+     * @param rhs
+     * @return
+     */
+    RegionAllocator<T>& operator=(const RegionAllocator<T>&)
+    {
+        return *this;
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment releases the storage of this allocator, which must not
+     * hold any object, and takes that of <code>rhs</code>.
+     *
+     * @param rhs
+     * @return
+     */
+    RegionAllocator<T>& operator=(RegionAllocator<T>&& rhs)
+    {
+        if (this != &rhs)
+        {
+            releaseSlabs();
+
+            m_region = rhs.m_region;
+            m_slabs = rhs.m_slabs;
+            m_cursor = rhs.m_cursor;
+            m_end = rhs.m_end;
+            m_free = rhs.m_free;
+            rhs.forget();
+        }
+        return *this;
+    }
+#endif
+
+    T* allocate(typename Allocator<T>::size_type n = 1)
+    {
+        if (n == 1 && m_free != NULL)
+        {
+            FreeBlock* block = m_free;
+            m_free = block->next;
+            AllocationProfiler::recordAllocation(block, sizeof (T), typeid (T));
+            return reinterpret_cast<T*> (block);
+        }
+
+        if (n > maxSize())
+        {
+            throw axf::core::OutOfMemoryError("allocation request exceeds the slab size of the region allocator.");
+        }
+
+        std::size_t bytes = n * BLOCK_SIZE;
+        if (bytes > (std::size_t) (m_end - m_cursor))
+        {
+            refill();
+        }
+
+        T* p = reinterpret_cast<T*> (m_cursor);
+        m_cursor += bytes;
+        AllocationProfiler::recordAllocation(p, n * sizeof (T), typeid (T));
+        return p;
+    }
+
+    T* construct(T* p, const T& args)
+    {
+        return new (p) T(args);
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    T* construct(T* p, T&& args)
+    {
+        return new (p) T(std::move(args));
+    }
+#endif
+
+    void destroy(T* p)
+    {
+        p->~T();
+    }
+
+    void deallocate(T* p, typename Allocator<T>::size_type n = 1)
+    {
+        if (p != NULL)
+        {
+            AllocationProfiler::recordDeallocation(p);
+            char* block = reinterpret_cast<char*> (p);
+            for (typename Allocator<T>::size_type i = 0; i < n; ++i, block += BLOCK_SIZE)
+            {
+                push(block);
+            }
+        }
+    }
+
+    virtual typename Allocator<T>::size_type maxSize() const
+    {
+        return (VirtualRegion::SLAB_SIZE - SLAB_HEADER) / BLOCK_SIZE;
+    }
+
+    /**
+     * Returns the region this allocator takes its slabs from.
+     *
+     * @return
+     */
+    inline VirtualRegion& getRegion() const
+    {
+        return *m_region;
+    }
+
+private:
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    } ;
+
+    static const std::size_t SLAB_HEADER = 64;  /// Links the slabs of an allocator, keeps the blocks aligned
+    static const std::size_t BLOCK_SIZE = sizeof (T) > sizeof (FreeBlock) ? sizeof (T) : sizeof (FreeBlock);
+
+    VirtualRegion*  m_region;
+    void*           m_slabs;    /// The slabs taken, linked through their first word
+    char*           m_cursor;   /// The next block never handed out
+    char*           m_end;      /// The end of the last slab
+    FreeBlock*      m_free;     /// The released blocks
+
+    inline void push(char* block)
+    {
+        FreeBlock* free = reinterpret_cast<FreeBlock*> (block);
+        free->next = m_free;
+        m_free = free;
+    }
+
+    /**
+     * Takes a new slab. The tail of the last one goes to the free list.
+     */
+    void refill()
+    {
+        char* slab = static_cast<char*> (m_region->allocateSlab());
+        for (; m_cursor != NULL && (std::size_t) (m_end - m_cursor) >= BLOCK_SIZE; m_cursor += BLOCK_SIZE)
+        {
+            push(m_cursor);
+        }
+
+        *reinterpret_cast<void**> (slab) = m_slabs;
+        m_slabs = slab;
+        m_cursor = slab + SLAB_HEADER;
+        m_end = slab + VirtualRegion::SLAB_SIZE;
+    }
+
+    void releaseSlabs()
+    {
+        while (m_slabs != NULL)
+        {
+            void* slab = m_slabs;
+            m_slabs = *static_cast<void**> (slab);
+            m_region->releaseSlab(slab);
+        }
+        forget();
+    }
+
+    inline void forget()
+    {
+        m_slabs = NULL;
+        m_cursor = NULL;
+        m_end = NULL;
+        m_free = NULL;
+    }
+} ;
+
+}
+}
+
+#endif /* REGIONALLOCATOR_H */
@@ -64,6 +64,17 @@ public:
      */
     virtual bool push(const E& element) = 0;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Pushes an object to the stack, moving it instead of copying it.
+     *
+     * @param element
+     * @return
+     */
+    virtual bool push(E&& element) = 0;
+#endif
+
     /**
      * Peeks the last value inserted to this stack.
      *
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   ThreadCachingAllocator.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 1:52 PM
+ */
+
+#ifndef THREADCACHINGALLOCATOR_H
+#define THREADCACHINGALLOCATOR_H
+
+// API
+#include <Axf/Collections/DefaultAllocator.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace collections
+{
+
+class VirtualRegion;
+
+/**
+ * The engine behind <code>ThreadCachingAllocator</code>.
+ * <p>
+ * Small requests (up to <code>MAX_CACHED_SIZE</code> bytes) are rounded up to
+ * one of a fixed set of size classes. Each thread keeps a private free list
+ * per size class, so the common allocation and deallocation paths touch no
+ * shared state and take no locks. Free lists are bounded: when a list grows
+ * past two magazines (a magazine being a chain of <code>MAGAZINE_SIZE</code>
+ * blocks) one magazine is detached and handed to a global depot, from which
+ * other threads refill their empty lists. A whole magazine moves with a
+ * single lock acquisition.
+ * <p>
+ * Blocks carry no owner, only a size class, so a block may be released from
+ * any thread. This is what makes producer/consumer patterns work: the
+ * consumer's list fills up and spills to the depot, and the producer refills
+ * from it.
+ * <p>
+ * When a thread exits, its cached blocks are returned to the depot. Larger
+ * requests are forwarded to the global <code>operator new</code>.
+ * <p>
+ * Blocks come from the global <code>operator new</code> as well, unless the
+ * caches are given a backing <code>VirtualRegion</code>. Empty caches then
+ * refill with whole magazines carved from its slabs, so that small objects
+ * are packed on huge pages. Blocks of the region are never returned to the
+ * system: the depot retains them for later refills.
+ *
+ * @author J. Marrero
+ */
+class ThreadCache
+{
+public:
+
+    static const std::size_t MAX_CACHED_SIZE = 1024;    /// Largest size served by the caches
+    static const std::size_t MAGAZINE_SIZE   = 32;      /// Blocks moved per depot transfer
+
+    /**
+     * Allocates <code>size</code> bytes of storage. Throws
+     * <code>std::bad_alloc</code> if the system is out of memory.
+     *
+     * @param size
+     * @return
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * Releases storage obtained from <code>allocate</code>. The
+     * <code>size</code> must match the size of the request. Storage may be
+     * released from any thread.
+     *
+     * @param p
+     * @param size
+     */
+    static void deallocate(void* p, std::size_t size);
+
+    /**
+     * Moves every block cached by the calling thread to the global depot.
+     */
+    static void flush();
+
+    /**
+     * Returns the blocks cached by the calling thread and by the global depot
+     * to the system, except those of the backing region, which the depot
+     * retains.
+     */
+    static void trim();
+
+    /**
+     * Makes the caches carve the blocks they need from the slabs of a
+     * region, rather than allocating them from the heap. Blocks allocated
+     * before keep coming from the heap as they are recycled. The region
+     * must outlive every block carved from it, and is only taken once; if
+     * it is exhausted, blocks come from the heap again.
+     *
+     * @param region
+     * @throws IllegalStateException if the caches are backed by another
+     *         region
+     */
+    static void setBackingRegion(VirtualRegion& region);
+
+    /**
+     * Returns the region backing the caches, or <code>NULL</code> if they
+     * are backed by the heap.
+     *
+     * @return
+     */
+    static VirtualRegion* getBackingRegion();
+
+private:
+
+    ThreadCache();
+} ;
+
+/**
+ * An allocator that keeps per-thread caches of free blocks, reducing the
+ * contention on the global heap when several threads allocate and release
+ * small objects at a high rate.
+ * <p>
+ * It is a drop-in replacement for <code>DefaultAllocator</code>, and can be
+ * selected through the allocator parameter of the collections. Since every
+ * instance shares the same caches, instances are interchangeable and storage
+ * allocated by one of them may be released by another.
+ *
+ * @author J. Marrero
+ */
+template <class T>
+class ThreadCachingAllocator : public Allocator<T>
+{
+
+    AXF_CLASS_TYPE(axf::collections::ThreadCachingAllocator<T>,
+               AXF_TYPE(axf::collections::Allocator<T>))
+public:
+
+    T* allocate(typename Allocator<T>::size_type n = 1)
+    {
+        if (n > maxSize())
+        {
+            throw axf::core::OutOfMemoryError("allocation request exceeds the maximum size of the allocator.");
+        }
+        T* p = static_cast<T*> (ThreadCache::allocate(n * sizeof (T)));
+        AllocationProfiler::recordAllocation(p, n * sizeof (T), typeid (T));
+        return p;
+    }
+
+    T* construct(T* p, const T& args)
+    {
+        return new (p) T(args);
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    T* construct(T* p, T&& args)
+    {
+        return new (p) T(std::move(args));
+    }
+#endif
+
+    void destroy(T* p)
+    {
+        p->~T();
+    }
+
+    void deallocate(T* p, typename Allocator<T>::size_type n = 1)
+    {
+        if (p != NULL)
+        {
+            AllocationProfiler::recordDeallocation(p);
+            ThreadCache::deallocate(p, n * sizeof (T));
+        }
+    }
+
+    virtual typename Allocator<T>::size_type maxSize() const
+    {
+        return SIZE_MAX / sizeof (T);
+    }
+
+} ;
+
+}
+}
+
+#endif /* THREADCACHINGALLOCATOR_H */
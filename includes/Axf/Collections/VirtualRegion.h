@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   VirtualRegion.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:20 PM
+ */
+
+#ifndef VIRTUALREGION_H
+#define VIRTUALREGION_H
+
+// API
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Concurrent/SpinLock.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace collections
+{
+
+/**
+ * A large range of virtual memory, handed out in slabs.
+ * <p>
+ * Programs that keep gigabytes of small nodes spend much of the time of a
+ * traversal on TLB misses: with 4 KiB pages, nearly every hop to a node lands
+ * on a page whose translation is not cached. A region reserves its whole range
+ * of addresses up front, without backing it with memory, and asks the system
+ * to back it with transparent huge pages, so that one translation covers two
+ * megabytes. Where huge pages are not available the region works the same
+ * with regular pages.
+ * <p>
+ * The range is carved into slabs of <code>SLAB_SIZE</code> bytes, aligned
+ * to a huge page, which pools and arenas take as their storage. Memory is
+ * committed in chunks of several slabs as the region grows. Released slabs
+ * are kept for reuse; past two chunks of them, and whenever
+ * <code>trim</code> is called, they are decommitted, giving their memory
+ * back to the system while keeping their addresses.
+ * <p>
+ * Slabs may be taken and released from any thread. The addresses of a
+ * region are given back when it is destroyed, so it must outlive every slab
+ * taken from it.
+ *
+ * @author J. Marrero
+ */
+class VirtualRegion
+{
+public:
+
+    static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;          /// The huge page size requested
+    static const std::size_t SLAB_SIZE = HUGE_PAGE_SIZE;                /// The unit handed out
+    static const std::size_t DEFAULT_COMMIT_CHUNK = 32 * SLAB_SIZE;     /// The unit of commitment
+
+    /**
+     * Reserves a region of <code>capacity</code> bytes, rounded up to whole
+     * slabs. No memory is committed yet.
+     *
+     * @param capacity
+     * @param hugePages whether to ask for transparent huge pages; if not set,
+     *        the region asks for regular pages
+     * @param commitChunk the bytes committed at once, rounded up to slabs
+     * @throws OutOfMemoryError if the addresses can not be reserved
+     */
+    explicit VirtualRegion(std::size_t capacity, bool hugePages = true, std::size_t commitChunk = DEFAULT_COMMIT_CHUNK);
+
+    /**
+     * Releases the whole region, including the slabs still in use.
+     */
+    ~VirtualRegion();
+
+    /**
+     * Returns the region shared by the allocators that are not given one. It
+     * reserves 64 GiB of addresses (512 MiB on 32 bit systems), backed by
+     * huge pages, and is never destroyed.
+     *
+     * @return
+     */
+    static VirtualRegion& global();
+
+    /**
+     * Takes a slab of <code>SLAB_SIZE</code> bytes, aligned to its size. Its
+     * contents are unspecified.
+     *
+     * @return
+     * @throws OutOfMemoryError if the region is exhausted, or memory can not
+     *         be committed
+     */
+    void* allocateSlab();
+
+    /**
+     * Gives a slab back to the region.
+     *
+     * @param slab
+     */
+    void releaseSlab(void* slab);
+
+    /**
+     * Decommits every free slab.
+     */
+    void trim();
+
+    /**
+     * Returns true if the address lies within this region.
+     *
+     * @param address
+     * @return
+     */
+    inline bool contains(const void* address) const
+    {
+        return static_cast<const char*> (address) >= m_base && static_cast<const char*> (address) < m_base + m_capacity;
+    }
+
+    /**
+     * Returns the bytes reserved by this region.
+     *
+     * @return
+     */
+    inline std::size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Returns the bytes of this region currently backed by memory.
+     *
+     * @return
+     */
+    inline std::size_t getCommittedBytes() const
+    {
+        return concurrent::atomicLoad(&m_committed, concurrent::RELAXED);
+    }
+
+    /**
+     * Returns the number of slabs taken and not released.
+     *
+     * @return
+     */
+    inline std::size_t getSlabsInUse() const
+    {
+        return concurrent::atomicLoad(&m_slabsInUse, concurrent::RELAXED);
+    }
+
+    /**
+     * Returns true if the system accepted to back this region with huge
+     * pages.
+     *
+     * @return
+     */
+    inline bool isHugePageBacked() const
+    {
+        return m_hugePages;
+    }
+
+private:
+
+    concurrent::SpinLock    m_lock;
+    void*                   m_reservation;  /// The range reserved, before alignment
+    std::size_t             m_reserved;     /// The size of the range reserved
+    char*                   m_base;         /// The first slab
+    std::size_t             m_capacity;     /// The bytes available from the base
+    std::size_t             m_commitChunk;
+    char*                   m_cursor;       /// The first slab never handed out
+    char*                   m_committedEnd; /// The end of the committed slabs never handed out
+    unsigned*               m_released;     /// The released slabs: committed from the bottom, decommitted from the top
+    std::size_t             m_freeCount;    /// Committed released slabs
+    std::size_t             m_trimmedCount; /// Decommitted released slabs
+    volatile std::size_t    m_committed;
+    volatile std::size_t    m_slabsInUse;
+    bool                    m_hugePages;
+
+    void decommitFree(std::size_t keep);
+
+    VirtualRegion(const VirtualRegion&);
+    VirtualRegion& operator=(const VirtualRegion&);
+} ;
+
+}
+}
+
+#endif /* VIRTUALREGION_H */
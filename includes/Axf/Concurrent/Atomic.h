@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   Atomic.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 1:20 PM
+ */
+
+#ifndef AXF_ATOMIC_H
+#define AXF_ATOMIC_H
+
+// API
+#include <Axf/API/Compiler.h>
+
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+// GCC and Clang provide the __atomic builtins
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#include <cstring>
+#else
+#error "atomic operations are only implemented for GCC compatible compilers and MSVC"
+#endif
+
+namespace axf
+{
+namespace concurrent
+{
+
+/**
+ * Memory ordering constraints for the atomic operations. They map directly
+ * to the C++11 memory model, and are usable under C++98 since the
+ * implementation relies on compiler intrinsics rather than on
+ * <code>std::atomic</code>.
+ */
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+typedef enum MemoryOrder
+{
+    RELAXED = __ATOMIC_RELAXED,
+    ACQUIRE = __ATOMIC_ACQUIRE,
+    RELEASE = __ATOMIC_RELEASE,
+    ACQ_REL = __ATOMIC_ACQ_REL,
+    SEQ_CST = __ATOMIC_SEQ_CST
+} MemoryOrder;
+#else
+typedef enum MemoryOrder
+{
+    RELAXED,
+    ACQUIRE,
+    RELEASE,
+    ACQ_REL,
+    SEQ_CST
+} MemoryOrder;
+
+/**
+ * The <code>_Interlocked</code> intrinsics of a given operand width. MSVC
+ * only offers them for integral operands, so values are moved in and out
+ * bit by bit. Every interlocked operation is a full barrier, so all memory
+ * orders are honoured by the strongest one.
+ */
+template <int width>
+struct Interlocked;
+
+template <>
+struct Interlocked<1>
+{
+    typedef char value_type;
+
+    static inline value_type exchange(volatile value_type* address, value_type value)
+    {
+        return _InterlockedExchange8(address, value);
+    }
+
+    static inline value_type compareExchange(volatile value_type* address, value_type desired, value_type expected)
+    {
+        return _InterlockedCompareExchange8(address, desired, expected);
+    }
+
+    static inline value_type fetchAdd(volatile value_type* address, value_type delta)
+    {
+        return _InterlockedExchangeAdd8(address, delta);
+    }
+} ;
+
+template <>
+struct Interlocked<2>
+{
+    typedef short value_type;
+
+    static inline value_type exchange(volatile value_type* address, value_type value)
+    {
+        return _InterlockedExchange16(address, value);
+    }
+
+    static inline value_type compareExchange(volatile value_type* address, value_type desired, value_type expected)
+    {
+        return _InterlockedCompareExchange16(address, desired, expected);
+    }
+
+    static inline value_type fetchAdd(volatile value_type* address, value_type delta)
+    {
+        return _InterlockedExchangeAdd16(address, delta);
+    }
+} ;
+
+template <>
+struct Interlocked<4>
+{
+    typedef long value_type;
+
+    static inline value_type exchange(volatile value_type* address, value_type value)
+    {
+        return _InterlockedExchange(address, value);
+    }
+
+    static inline value_type compareExchange(volatile value_type* address, value_type desired, value_type expected)
+    {
+        return _InterlockedCompareExchange(address, desired, expected);
+    }
+
+    static inline value_type fetchAdd(volatile value_type* address, value_type delta)
+    {
+        return _InterlockedExchangeAdd(address, delta);
+    }
+} ;
+
+template <>
+struct Interlocked<8>
+{
+    typedef __int64 value_type;
+
+    static inline value_type exchange(volatile value_type* address, value_type value)
+    {
+#if defined(_M_IX86)
+        // 32 bit x86 only has the 64 bit compare exchange
+        value_type current = *address;
+        value_type seen;
+        while ((seen = _InterlockedCompareExchange64(address, value, current)) != current)
+        {
+            current = seen;
+        }
+        return current;
+#else
+        return _InterlockedExchange64(address, value);
+#endif
+    }
+
+    static inline value_type compareExchange(volatile value_type* address, value_type desired, value_type expected)
+    {
+        return _InterlockedCompareExchange64(address, desired, expected);
+    }
+
+    static inline value_type fetchAdd(volatile value_type* address, value_type delta)
+    {
+#if defined(_M_IX86)
+        value_type current = *address;
+        value_type seen;
+        while ((seen = _InterlockedCompareExchange64(address, current + delta, current)) != current)
+        {
+            current = seen;
+        }
+        return current;
+#else
+        return _InterlockedExchangeAdd64(address, delta);
+#endif
+    }
+} ;
+
+/**
+ * Reinterprets the bits of a value as another type of the same size.
+ */
+template <typename To, typename From>
+inline To interlockedCast(From value)
+{
+    To result;
+    std::memcpy(&result, &value, sizeof (result));
+    return result;
+}
+
+/**
+ * Orders the surrounding memory operations. On x86 the hardware already
+ * orders everything but stores followed by loads, so only sequentially
+ * consistent fences emit an instruction.
+ */
+inline void interlockedFence(MemoryOrder order)
+{
+    if (order == RELAXED)
+        return;
+
+#if defined(_M_IX86) || defined(_M_X64)
+    _ReadWriteBarrier();
+    if (order == SEQ_CST)
+    {
+        _mm_mfence();
+    }
+#elif defined(_M_ARM64)
+    __dmb(_ARM64_BARRIER_ISH);
+#else
+    __dmb(_ARM_BARRIER_ISH);
+#endif
+}
+#endif
+
+/**
+ * Atomically loads the value stored at <code>address</code>.
+ *
+ * @param address
+ * @param order
+ * @return
+ */
+template <typename T>
+inline T atomicLoad(const volatile T* address, MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    return __atomic_load_n(address, order);
+#else
+#if defined(_M_IX86)
+    if (sizeof (T) == 8)
+    {
+        typedef Interlocked<sizeof (T)> ops;
+        typedef typename ops::value_type value_type;
+
+        // Plain 64 bit loads may tear on 32 bit x86
+        volatile value_type* word = const_cast<volatile value_type*> (reinterpret_cast<const volatile value_type*> (address));
+        return interlockedCast<T> (ops::compareExchange(word, 0, 0));
+    }
+#endif
+    T value = *address;
+    interlockedFence(order == SEQ_CST ? ACQUIRE : order);
+    return value;
+#endif
+}
+
+/**
+ * Atomically stores <code>value</code> at <code>address</code>.
+ *
+ * @param address
+ * @param value
+ * @param order
+ */
+template <typename T>
+inline void atomicStore(volatile T* address, T value, MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    __atomic_store_n(address, value, order);
+#else
+    typedef Interlocked<sizeof (T)> ops;
+    typedef typename ops::value_type value_type;
+    ops::exchange(reinterpret_cast<volatile value_type*> (address), interlockedCast<value_type> (value));
+    (void) order;
+#endif
+}
+
+/**
+ * Atomically replaces the value at <code>address</code>, returning the
+ * previous value.
+ *
+ * @param address
+ * @param value
+ * @param order
+ * @return
+ */
+template <typename T>
+inline T atomicExchange(volatile T* address, T value, MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    return __atomic_exchange_n(address, value, order);
+#else
+    typedef Interlocked<sizeof (T)> ops;
+    typedef typename ops::value_type value_type;
+    (void) order;
+    return interlockedCast<T> (ops::exchange(reinterpret_cast<volatile value_type*> (address),
+                                             interlockedCast<value_type> (value)));
+#endif
+}
+
+/**
+ * Atomically compares the value at <code>address</code> with
+ * <code>expected</code> and, if equal, replaces it with <code>desired</code>.
+ * On failure, <code>expected</code> is updated with the current value.
+ * <p>
+ * The weak form may fail spuriously and is meant to be used in loops.
+ *
+ * @param address
+ * @param expected
+ * @param desired
+ * @param weak
+ * @param success
+ * @param failure
+ * @return true if the value was replaced
+ */
+template <typename T>
+inline bool atomicCompareExchange(volatile T* address, T& expected, T desired, bool weak = false,
+                                  MemoryOrder success = SEQ_CST, MemoryOrder failure = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    return __atomic_compare_exchange_n(address, &expected, desired, weak, success, failure);
+#else
+    typedef Interlocked<sizeof (T)> ops;
+    typedef typename ops::value_type value_type;
+    (void) weak;
+    (void) success;
+    (void) failure;
+
+    value_type comparand = interlockedCast<value_type> (expected);
+    value_type previous = ops::compareExchange(reinterpret_cast<volatile value_type*> (address),
+                                               interlockedCast<value_type> (desired), comparand);
+    if (previous == comparand)
+        return true;
+
+    expected = interlockedCast<T> (previous);
+    return false;
+#endif
+}
+
+/**
+ * Atomically adds <code>delta</code> to the value at <code>address</code>,
+ * returning the previous value.
+ *
+ * @param address
+ * @param delta
+ * @param order
+ * @return
+ */
+template <typename T, typename D>
+inline T atomicFetchAdd(volatile T* address, D delta, MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    return __atomic_fetch_add(address, delta, order);
+#else
+    typedef Interlocked<sizeof (T)> ops;
+    typedef typename ops::value_type value_type;
+    (void) order;
+    return interlockedCast<T> (ops::fetchAdd(reinterpret_cast<volatile value_type*> (address), (value_type) delta));
+#endif
+}
+
+/**
+ * Atomically subtracts <code>delta</code> from the value at
+ * <code>address</code>, returning the previous value.
+ *
+ * @param address
+ * @param delta
+ * @param order
+ * @return
+ */
+template <typename T, typename D>
+inline T atomicFetchSub(volatile T* address, D delta, MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    return __atomic_fetch_sub(address, delta, order);
+#else
+    typedef Interlocked<sizeof (T)> ops;
+    typedef typename ops::value_type value_type;
+    (void) order;
+    return interlockedCast<T> (ops::fetchAdd(reinterpret_cast<volatile value_type*> (address), (value_type) (0 - (value_type) delta)));
+#endif
+}
+
+/**
+ * Issues a memory fence with the given ordering.
+ *
+ * @param order
+ */
+inline void atomicThreadFence(MemoryOrder order = SEQ_CST)
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+    __atomic_thread_fence(order);
+#else
+    interlockedFence(order);
+#endif
+}
+
+/**
+ * Hints the processor that the caller is busy waiting. Used in spin loops to
+ * reduce power consumption and the penalty of leaving the loop.
+ */
+inline void cpuRelax()
+{
+#if defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+#else
+#if defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#else
+    __yield();
+#endif
+#endif
+}
+
+}
+}
+
+#endif /* AXF_ATOMIC_H */
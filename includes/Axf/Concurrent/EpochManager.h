@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   EpochManager.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:00 PM
+ */
+
+#ifndef AXF_EPOCHMANAGER_H
+#define AXF_EPOCHMANAGER_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Concurrent/SpinLock.h>
+#include <Axf/Core/Bits/memory-dtors.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace concurrent
+{
+
+/**
+ * The state of a thread with respect to a manager, a batch of pointers
+ * retired by a thread, and what releases them when the thread finishes.
+ */
+struct EpochRecord;
+struct RetiredBag;
+struct EpochReaper;
+
+/**
+ * Safe memory reclamation for lock-free data structures, by epochs.
+ * <p>
+ * A thread that removes a node from a lock-free structure cannot free it
+ * right away, since other threads may still be reading it. Instead, threads
+ * <i>pin</i> the manager while they access the structure, and
+ * <i>retire</i> the nodes they remove. The manager keeps a global epoch,
+ * which advances once every pinned thread has observed the current one;
+ * nodes retired during an epoch are disposed of two epochs later, when no
+ * thread can still be reading them.
+ * <p>
+ * Pinning is cheap: a thread local lookup, a store and a fence, and nested
+ * pins only count. Retired pointers are collected in per thread bags of a
+ * few dozen; a full bag is handed to the manager, which then disposes of
+ * every bag old enough, so reclamation is amortized over retirements.
+ * Threads that must not pay for it may leave it to a background thread
+ * calling <code>collect</code> from time to time. A thread that stays
+ * pinned holds back the reclamation of everything retired meanwhile, so
+ * pins must be short.
+ * <p>
+ * Pointers are disposed of with a stateless deleter functor, such as those
+ * of the <code>core::bits::default_delete</code> family, possibly from
+ * another thread.
+ * <p>
+ * A manager must outlive the pins of every thread. Destroying it disposes
+ * of everything retired through it.
+ *
+ * @author J. Marrero
+ */
+class EpochManager
+{
+public:
+
+    /**
+     * Pins a manager for the lifetime of the guard object.
+     */
+    class Guard
+    {
+    public:
+
+        explicit Guard(EpochManager& manager) : m_record(manager.enter()) { }
+
+        ~Guard()
+        {
+            EpochManager::leave(m_record);
+        }
+
+    private:
+
+        EpochRecord* m_record;
+
+        Guard(const Guard&);
+        Guard& operator=(const Guard&);
+    } ;
+
+    EpochManager();
+    ~EpochManager();
+
+    /**
+     * Returns the global manager, which is never destroyed.
+     *
+     * @return
+     */
+    static EpochManager& global();
+
+    /**
+     * Pins the calling thread: pointers it reads from now on are not
+     * disposed of until it unpins. Pins nest.
+     */
+    inline void pin()
+    {
+        enter();
+    }
+
+    /**
+     * Drops a pin of the calling thread.
+     */
+    void unpin();
+
+    /**
+     * Retires a pointer, which is disposed of with <code>delete</code> once
+     * no pinned thread can be reading it.
+     *
+     * @param pointer
+     * @throws std::bad_alloc if a new bag cannot be allocated
+     */
+    template <typename T>
+    inline void retire(T* pointer)
+    {
+        retire(pointer, core::bits::default_delete<T>());
+    }
+
+    /**
+     * Retires a pointer, which is disposed of with a deleter functor once no
+     * pinned thread can be reading it. The functor is stateless: a new one
+     * is built to dispose of the pointer.
+     *
+     * @param pointer
+     * @param deleter
+     * @throws std::bad_alloc if a new bag cannot be allocated
+     */
+    template <typename T, typename D>
+    inline void retire(T* pointer, const D&)
+    {
+        retireErased(static_cast<void*> (pointer), &disposeWith<T, D>);
+    }
+
+    /**
+     * Attempts to advance the global epoch, and disposes of the pointers
+     * retired long enough ago.
+     *
+     * @return the count of pointers disposed of
+     */
+    std::size_t collect();
+
+    /**
+     * Hands the bag of the calling thread to the manager even if it is not
+     * full, and collects.
+     *
+     * @return the count of pointers disposed of
+     */
+    std::size_t flush();
+
+    /**
+     * Returns the current global epoch.
+     *
+     * @return
+     */
+    inline unsigned long epoch() const
+    {
+        return atomicLoad(&m_epoch, RELAXED);
+    }
+
+    /**
+     * Returns the count of pointers retired but not disposed of yet, not
+     * counting those in the bags threads are filling.
+     *
+     * @return
+     */
+    inline std::size_t pending() const
+    {
+        return atomicLoad(&m_pending, RELAXED);
+    }
+
+private:
+
+    volatile unsigned long          m_epoch;        /// The global epoch
+    RetiredBag* volatile      m_garbage;      /// Sealed bags, newest first
+    volatile std::size_t            m_pending;      /// Pointers in sealed bags
+    EpochRecord* volatile     m_records;      /// Every record joined to this manager
+    unsigned long long              m_id;           /// The serial number of this manager
+
+    EpochRecord* enter();
+    static void leave(EpochRecord* record);
+
+    EpochRecord* localRecord();
+    EpochRecord* joinRecord();
+    void retireErased(void* pointer, void (*dispose)(void*));
+    void seal(EpochRecord* record);
+    bool tryAdvance();
+
+    /**
+     * Disposes of a pointer with a stateless deleter functor.
+     */
+    template <typename T, typename D>
+    static void disposeWith(void* pointer)
+    {
+        D deleter;
+        deleter(static_cast<T*> (pointer));
+    }
+
+    friend struct EpochReaper;
+
+    EpochManager(const EpochManager&);
+    EpochManager& operator=(const EpochManager&);
+} ;
+
+}
+}
+
+#endif /* AXF_EPOCHMANAGER_H */
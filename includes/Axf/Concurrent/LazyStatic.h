@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   LazyStatic.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:05 AM
+ */
+
+#ifndef AXF_LAZYSTATIC_H
+#define AXF_LAZYSTATIC_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/API/Platform.h>
+#include <Axf/Concurrent/Atomic.h>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+namespace axf
+{
+namespace concurrent
+{
+
+/**
+ * An object with static storage duration that is constructed exactly once,
+ * on first use, even when several threads race on that first use.
+ * <p>
+ * Function local statics are only guaranteed to be initialized safely from
+ * C++11 onwards, and compilers may still guard them with a lock. A lazy
+ * static has no constructor, so it is zero initialized before any code runs.
+ * After initialization an access costs a single acquire load. The first
+ * thread to arrive constructs the object through the given factory, while
+ * late comers wait for it. If the factory throws, the static returns to the
+ * uninitialized state and the next access tries again.
+ * <p>
+ * The object is built in storage inside the lazy static and is never
+ * destroyed, so it stays usable during static destruction.
+ * <p>
+ * A factory receives the raw storage and returns the object it placement
+ * constructed there. It must not access the lazy static it initializes.
+ *
+ * @author J. Marrero
+ */
+template <typename T>
+class LazyStatic
+{
+public:
+
+    typedef void* (*Factory)(void* storage);
+
+    /**
+     * Returns the object, constructing it with <code>factory</code> if this
+     * is the first access.
+     *
+     * @param factory
+     * @return
+     */
+    inline T& get(Factory factory)
+    {
+        void* instance = atomicLoad(&m_instance, ACQUIRE);
+        if (ARTEMIS_LIKELY(instance != NULL))
+            return *static_cast<T*> (instance);
+
+        return initialize(factory);
+    }
+
+    /**
+     * Returns true if the object has been constructed.
+     *
+     * @return
+     */
+    inline bool isInitialized() const
+    {
+        return atomicLoad(&m_instance, ACQUIRE) != NULL;
+    }
+
+private:
+
+    enum
+    {
+        UNINITIALIZED = 0,
+        RUNNING,
+        DONE
+    } ;
+
+    void* volatile  m_instance;     /// The constructed object, published last
+    volatile int    m_state;        /// Whether a thread is constructing the object
+
+    union
+    {
+        char        bytes[sizeof (T)];
+        double      alignDouble;
+        long long   alignInteger;
+        void*       alignPointer;
+    } m_storage;
+
+    ARTEMIS_NOINLINE T& initialize(Factory factory)
+    {
+        for (;;)
+        {
+            int expected = UNINITIALIZED;
+            if (atomicCompareExchange(&m_state, expected, (int) RUNNING, false, ACQUIRE, ACQUIRE))
+            {
+                void* instance;
+                try
+                {
+                    instance = factory(m_storage.bytes);
+                }
+                catch (...)
+                {
+                    atomicStore(&m_state, (int) UNINITIALIZED, RELEASE);
+                    throw;
+                }
+
+                atomicStore(&m_instance, instance, RELEASE);
+                atomicStore(&m_state, (int) DONE, RELEASE);
+                return *static_cast<T*> (instance);
+            }
+
+            // Another thread is constructing the object; wait for it to
+            // publish the object or to give up
+            unsigned spins = 0;
+            while (atomicLoad(&m_state, ACQUIRE) == RUNNING)
+            {
+                if (++spins < 64)
+                {
+                    cpuRelax();
+                }
+                else
+                {
+                    yield();
+                    spins = 0;
+                }
+            }
+
+            void* instance = atomicLoad(&m_instance, ACQUIRE);
+            if (instance != NULL)
+                return *static_cast<T*> (instance);
+        }
+    }
+
+    static inline void yield()
+    {
+#ifdef ARTEMIS_PLATFORM_W32
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+} ;
+
+}
+}
+
+#endif /* AXF_LAZYSTATIC_H */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   SpinLock.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 1:34 PM
+ */
+
+#ifndef AXF_SPINLOCK_H
+#define AXF_SPINLOCK_H
+
+// API
+#include <Axf/API/Platform.h>
+#include <Axf/Concurrent/Atomic.h>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+namespace axf
+{
+namespace concurrent
+{
+
+/**
+ * A test-and-test-and-set spin lock.
+ * <p>
+ * Spin locks are meant to protect very short critical sections that are
+ * rarely contended, such as the refill paths of per-thread caches. Waiting
+ * threads spin on a plain load, so the cache line is not bounced while the
+ * lock is held.
+ * <p>
+ * The constructor is a constant expression, so spin locks with static
+ * storage duration are initialized before any code runs and may be used
+ * from static constructors.
+ *
+ * @author J. Marrero
+ */
+class SpinLock
+{
+public:
+
+    ARTEMIS_CONSTEXPR SpinLock() : m_state(0) { }
+
+    /**
+     * Acquires the lock, spinning until it becomes available. After a short
+     * burst of spinning the thread yields the processor, so a holder that has
+     * been preempted can make progress.
+     */
+    inline void lock()
+    {
+        while (atomicExchange(&m_state, 1, ACQUIRE) != 0)
+        {
+            unsigned spins = 0;
+            while (atomicLoad(&m_state, RELAXED) != 0)
+            {
+                if (++spins < 64)
+                {
+                    cpuRelax();
+                }
+                else
+                {
+                    yield();
+                    spins = 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * Attempts to acquire the lock without waiting.
+     *
+     * @return true if the lock was acquired
+     */
+    inline bool tryLock()
+    {
+        return atomicLoad(&m_state, RELAXED) == 0 && atomicExchange(&m_state, 1, ACQUIRE) == 0;
+    }
+
+    /**
+     * Releases the lock.
+     */
+    inline void unlock()
+    {
+        atomicStore(&m_state, 0, RELEASE);
+    }
+
+private:
+
+    volatile int m_state;   /// Zero when unlocked
+
+    static inline void yield()
+    {
+#ifdef ARTEMIS_PLATFORM_W32
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+
+    SpinLock(const SpinLock&);
+    SpinLock& operator=(const SpinLock&);
+} ;
+
+/**
+ * Acquires a lock for the lifetime of the guard object.
+ *
+ * @author J. Marrero
+ */
+template <typename L>
+class ScopedLock
+{
+public:
+
+    explicit ScopedLock(L& lock) : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+
+    ~ScopedLock()
+    {
+        m_lock.unlock();
+    }
+
+private:
+
+    L& m_lock;
+
+    ScopedLock(const ScopedLock<L>&);
+    ScopedLock<L>& operator=(const ScopedLock<L>&);
+} ;
+
+}
+}
+
+#endif /* AXF_SPINLOCK_H */
@@ -34,6 +34,10 @@
 // C++
 #include <cstring>
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <utility>
+#endif
+
 namespace axf
 {
 namespace core
@@ -105,6 +109,54 @@ public:
         }
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Moves the contents of the array 'rhs' into this array, element by
+     * element. The elements of <code>rhs</code> are left in a moved-from
+     * state.
+     *
+     * @param rhs
+     */
+    Array(Array<T, SIZE>&& rhs)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            m_primitive[i] = std::move(rhs.m_primitive[i]);
+        }
+    }
+
+    /**
+     * Copy assignment operator.
+     *
+     * @param rhs
+     * @return
+     */
+    Array<T, SIZE>& operator=(const Array<T, SIZE>& rhs)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            m_primitive[i] = rhs.m_primitive[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param rhs
+     * @return
+     */
+    Array<T, SIZE>& operator=(Array<T, SIZE>&& rhs)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            m_primitive[i] = std::move(rhs.m_primitive[i]);
+        }
+        return *this;
+    }
+#endif
+
     /**
      * Default destructor
      */
@@ -32,6 +32,7 @@
 #include <cstdio>
 
 // API
+#include <Axf/API/Compiler.h>
 #include <Axf/Core/NullPointerException.h>
 
 // Private API
@@ -44,6 +45,14 @@ namespace core
 namespace bits
 {
 
+/**
+ * Selects the constructors of smart references that take over a reference
+ * already counted for them, instead of counting a new one.
+ */
+struct adopt_ref_tag
+{
+} ;
+
 /**
  * This is the abstract base class for all the smart reference types. It provides a default data field of a generic type
  * <code>T*</code> representing the type of the reference. It also provides some common operator overloading and utility
@@ -153,6 +162,30 @@ public:
         return m_pointer == rhs;
     }
 
+    /**
+     * Two references are deemed equals if they point to the same memory
+     * location.
+     *
+     * @param rhs
+     * @return
+     */
+    inline bool operator==(const abstract_ref<T, deleter_functor>& rhs) const
+    {
+        return m_pointer == rhs.m_pointer;
+    }
+
+    /**
+     * Two references are deemed different if they don't point to the same
+     * memory location.
+     *
+     * @param rhs
+     * @return
+     */
+    inline bool operator!=(const abstract_ref<T, deleter_functor>& rhs) const
+    {
+        return m_pointer != rhs.m_pointer;
+    }
+
     /**
      * Two pointers are deemed different if they don't point to the same memory
      * location.
@@ -212,19 +245,31 @@ protected:
 
     /**
      * Essentially checks if a pointer is null or any other invalid value, and
-     * if so, throws a <code>NullPointerException</code>. The message is built
-     * on the heap.
-     *
-     * TODO: Check if it would be suitable to statically assign a message buffer.
-     * UPDATE: Seems that it is possible
+     * if so, throws a <code>NullPointerException</code>. The check is inlined
+     * into every dereference, so the exception message is only formatted on
+     * the failure path.
+     */
+    inline void checkDereferencingCapability() const
+    {
+        if (ARTEMIS_UNLIKELY(m_pointer == NULL))
+            throwNullDereference();
+    }
+
+private:
+
+    /**
+     * Throws the <code>NullPointerException</code> for a failed dereference.
+     * Kept out of line so the formatting code does not bloat the callers.
      */
-    inline void checkDereferencingCapability()
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+    __attribute__((noinline, cold))
+#endif
+    void throwNullDereference() const
     {
         char message[64] = {0};
-        std::sprintf(message, "null dereferencing from pointer at 0x%p", this);
+        std::sprintf(message, "null dereferencing from pointer at 0x%p", (const void*) this);
 
-        if (m_pointer == NULL)
-            throw NullPointerException(message);
+        throw NullPointerException(message);
     }
 
 } ;
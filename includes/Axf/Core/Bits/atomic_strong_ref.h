@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   atomic_strong_ref.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:20 AM
+ */
+
+#ifndef ATOMIC_STRONG_REF_H
+#define ATOMIC_STRONG_REF_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Core/ReferenceCounted.h>
+
+#include "strong_ref.h"
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace core
+{
+
+/**
+ * A strong reference that may be loaded and replaced by several threads at
+ * once without locks, to publish objects such as configurations that readers
+ * use while a writer swaps in new versions.
+ * <p>
+ * The reference uses split reference counts. Next to the pointer, in the
+ * same word, it keeps a count of the loads in flight. A load increments that
+ * count and takes the pointer in a single atomic step, then takes a strong
+ * reference on the object and gives the count back. A writer that replaces the
+ * pointer turns the loads still in flight into strong references of the old
+ * object before releasing its own, so the object stays alive until every
+ * reader holds a proper strong reference. Readers never see a freed object,
+ * and neither side ever waits for the other.
+ * <p>
+ * The pointed type must be intrusively reference counted. Pointers are packed
+ * with the count in their unused high bits, which leaves room for 65535 loads
+ * in flight on 64-bit platforms.
+ *
+ * @author J. Marrero
+ */
+template <typename T>
+class atomic_strong_ref
+{
+public:
+
+    /**
+     * Creates a null reference.
+     */
+    atomic_strong_ref() : m_word(0) { }
+
+    /**
+     * Creates a reference to the same object as <code>value</code>.
+     *
+     * @param value
+     */
+    explicit atomic_strong_ref(const strong_ref<T>& value) : m_word(pack(grab(value.m_pointer))) { }
+
+    /**
+     * Releases the referenced object. No other thread may access the
+     * reference anymore.
+     */
+    ~atomic_strong_ref()
+    {
+        release(pointerOf(m_word));
+    }
+
+    /**
+     * Returns a strong reference to the current object.
+     *
+     * @return
+     */
+    strong_ref<T> load() const
+    {
+        word_t previous = concurrent::atomicFetchAdd(&m_word, ONE, concurrent::ACQUIRE);
+        T* pointer = pointerOf(previous);
+        if (pointer == NULL)
+        {
+            giveBack(previous);
+            return strong_ref<T>();
+        }
+
+        pointer->grabStrongReference();
+        giveBack(previous);
+        return strong_ref<T>(pointer, bits::adopt_ref_tag());
+    }
+
+    /**
+     * Replaces the current object.
+     *
+     * @param value
+     */
+    inline void store(const strong_ref<T>& value)
+    {
+        exchange(value);
+    }
+
+    /**
+     * Replaces the current object, returning it.
+     *
+     * @param value
+     * @return
+     */
+    strong_ref<T> exchange(const strong_ref<T>& value)
+    {
+        word_t previous = concurrent::atomicExchange(&m_word, pack(grab(value.m_pointer)), concurrent::ACQ_REL);
+        return retire(previous);
+    }
+
+    /**
+     * Replaces the current object with <code>desired</code> if it is
+     * <code>expected</code>. Otherwise <code>expected</code> is set to the
+     * current object.
+     *
+     * @param expected
+     * @param desired
+     * @return true if the object was replaced
+     */
+    bool compareExchange(strong_ref<T>& expected, const strong_ref<T>& desired)
+    {
+        word_t next = pack(grab(desired.m_pointer));
+        word_t current = concurrent::atomicLoad(&m_word, concurrent::RELAXED);
+        while (pointerOf(current) == expected.m_pointer)
+        {
+            if (concurrent::atomicCompareExchange(&m_word, current, next, true,
+                                                  concurrent::ACQ_REL, concurrent::RELAXED))
+            {
+                retire(current);
+                return true;
+            }
+        }
+
+        release(pointerOf(next));
+        expected = load();
+        return false;
+    }
+
+    /**
+     * Returns true if operations never take locks, which is always the case.
+     *
+     * @return
+     */
+    inline bool isLockFree() const
+    {
+        return true;
+    }
+
+private:
+
+    typedef unsigned long long word_t;
+
+    /**
+     * The count of loads in flight takes the high bits of the word. 64-bit
+     * platforms use 48 bits of address.
+     */
+    static const unsigned COUNT_SHIFT = sizeof (void*) >= 8 ? 48 : 32;
+    static const word_t ONE = 1ULL << COUNT_SHIFT;
+    static const word_t POINTER_MASK = ONE - 1;
+
+    mutable volatile word_t m_word;     /// The pointer and the loads in flight
+
+    static inline word_t pack(T* pointer)
+    {
+        return (word_t) (std::size_t) pointer;
+    }
+
+    static inline T* pointerOf(word_t word)
+    {
+        return (T*) (std::size_t) (word & POINTER_MASK);
+    }
+
+    static inline T* grab(T* pointer)
+    {
+        if (pointer != NULL)
+            pointer->grabStrongReference();
+        return pointer;
+    }
+
+    static inline void release(T* pointer)
+    {
+        if (pointer != NULL)
+            pointer->releaseStrongReference();
+    }
+
+    /**
+     * Gives back the count taken by a load. If the pointer has been replaced
+     * meanwhile, the writer turned the count into a strong reference, which
+     * is released instead.
+     *
+     * @param taken the word the load incremented
+     */
+    inline void giveBack(word_t taken) const
+    {
+        word_t current = concurrent::atomicLoad(&m_word, concurrent::RELAXED);
+        while (pointerOf(current) == pointerOf(taken) && current >= ONE)
+        {
+            if (concurrent::atomicCompareExchange(&m_word, current, current - ONE, true,
+                                                  concurrent::RELEASE, concurrent::RELAXED))
+                return;
+        }
+        release(pointerOf(taken));
+    }
+
+    /**
+     * Turns the loads in flight of a replaced word into strong references,
+     * and returns the reference the word held.
+     *
+     * @param word
+     * @return
+     */
+    static strong_ref<T> retire(word_t word)
+    {
+        T* pointer = pointerOf(word);
+        if (pointer != NULL)
+        {
+            for (word_t inFlight = word >> COUNT_SHIFT; inFlight > 0; --inFlight)
+                pointer->grabStrongReference();
+        }
+        return strong_ref<T>(pointer, bits::adopt_ref_tag());
+    }
+
+    atomic_strong_ref(const atomic_strong_ref&);
+    atomic_strong_ref& operator=(const atomic_strong_ref&);
+} ;
+
+}
+}
+
+#endif /* ATOMIC_STRONG_REF_H */
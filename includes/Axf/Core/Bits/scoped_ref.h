@@ -72,6 +72,20 @@ public:
      */
     scoped_ref(T* pointer = NULL) : bits::abstract_ref<T>(pointer) { }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move constructor. Ownership of the pointed object is transferred from
+     * <code>rhs</code>, which is left null.
+     *
+     * @param rhs
+     */
+    scoped_ref(scoped_ref<T, deleter_functor>&& rhs) : bits::abstract_ref<T, deleter_functor>(rhs.m_pointer)
+    {
+        rhs.m_pointer = NULL;
+    }
+#endif
+
     /**
      * Destroys this object, invoking the destructor of the pointed object.
      */
@@ -115,6 +129,20 @@ public:
         return *this;
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. Transfers ownership from <code>rhs</code>.
+     *
+     * @param rhs
+     * @return
+     */
+    inline scoped_ref<T, deleter_functor>& operator=(scoped_ref<T, deleter_functor>&& rhs)
+    {
+        return operator=(rhs);
+    }
+#endif
+
 } ;
 
 }
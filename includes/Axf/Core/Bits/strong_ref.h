@@ -42,6 +42,9 @@ namespace core
 template <typename, typename, typename>
 class weak_ref;
 
+template <typename>
+class atomic_strong_ref;
+
 /**
  * A <b>strong reference</b> is a smart pointer type that implements reference
  * counting and strong reference owning model.
@@ -62,9 +65,10 @@ class weak_ref;
  * is associated to the owning object by the pointer, and it is released upon
  * destruction of the shared object.
  * <p>
- * <b>Note</b>: This operation is not synchronized nor atomic, and therefore,
- * special care must be had if smart pointers are being used in a multi-threaded
- * environment.
+ * <b>Note</b>: Reference counts are updated atomically, so distinct smart
+ * references to one object may be used from different threads. A single smart
+ * reference object is not synchronized, and must not be modified while other
+ * threads access it.
  *
  * @author J. Marrero
  */
@@ -108,6 +112,23 @@ public:
         grab();
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move constructor. The reference held by <code>rhs</code> is transferred
+     * to the new object without touching the reference count.
+     *
+     * @param rhs
+     */
+    strong_ref(strong_ref<T, deleter_functor>&& rhs)
+    :
+    bits::abstract_ref<T, deleter_functor>(rhs.m_pointer), m_refCount(rhs.m_refCount)
+    {
+        rhs.m_pointer = NULL;
+        rhs.m_refCount = NULL;
+    }
+#endif
+
     /**
      * Releases a reference to the pointed object.
      */
@@ -140,11 +161,12 @@ public:
      */
     inline size_t users() const
     {
-        return (m_refCount != NULL) ? m_refCount->m_strong : 0;
+        return (m_refCount != NULL) ? concurrent::atomicLoad(&m_refCount->m_strong, concurrent::RELAXED) : 0;
     }
 
     /**
-     * Assignment operator overload.
+     * Assignment operator overload. The new object is grabbed before the old
+     * one is released, so self-assignment through aliases is safe.
      *
      * @param rhs
      * @return
@@ -153,23 +175,58 @@ public:
     {
         if (this != &rhs)
         {
-            if (rhs.m_pointer != this->m_pointer)
-            {
-                release();
-            }
+            strong_ref<T, deleter_functor> previous(this->m_pointer, m_refCount, bits::adopt_ref_tag());
 
             this->m_pointer = rhs.m_pointer;
             this->m_refCount = rhs.m_refCount;
-
             grab();
         }
         return *this;
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The reference held by <code>rhs</code> is
+     * taken over before the one held by this object is released, since
+     * <code>rhs</code> may live in the object released.
+     *
+     * @param rhs
+     * @return
+     */
+    strong_ref<T, deleter_functor>& operator=(strong_ref<T, deleter_functor>&& rhs)
+    {
+        if (this != &rhs)
+        {
+            strong_ref<T, deleter_functor> previous(this->m_pointer, m_refCount, bits::adopt_ref_tag());
+
+            this->m_pointer = rhs.m_pointer;
+            this->m_refCount = rhs.m_refCount;
+
+            rhs.m_pointer = NULL;
+            rhs.m_refCount = NULL;
+        }
+        return *this;
+    }
+#endif
+
 private:
 
     refcount_t* m_refCount;     ///< The reference count structure
 
+    /**
+     * Takes over a strong reference already counted, as weak references do
+     * when they are upgraded.
+     *
+     * @param pointer
+     * @param refCount
+     */
+    strong_ref(T* pointer, refcount_t* refCount, const bits::adopt_ref_tag&)
+    :
+    bits::abstract_ref<T, deleter_functor>(pointer), m_refCount(refCount)
+    {
+    }
+
     /**
      * Grabs a reference to this object.
      */
@@ -177,22 +234,26 @@ private:
     {
         if (m_refCount != NULL)
         {
-            m_refCount->m_strong++;
+            refcount_grab_strong(*m_refCount);
         }
     }
 
     /**
-     * Releases a reference to this object.
+     * Releases a reference to this object. The last strong reference disposes
+     * of the object and marks it as such, so that weak references can no
+     * longer upgrade, then drops the weak reference held on behalf of strong
+     * references.
      */
     inline void release()
     {
-        if (m_refCount != NULL)
+        if (m_refCount != NULL && refcount_release_strong(*m_refCount))
         {
-            if (this->m_pointer != NULL && (--m_refCount->m_strong <= 0))
+            if (this->m_pointer != NULL)
             {
                 this->m_disposer(this->m_pointer);
             }
-            if (m_refCount->m_strong <= 0 && m_refCount->m_weak <= 0)
+            concurrent::atomicStore(&m_refCount->m_strong, (refcount_value_t) -1, concurrent::RELEASE);
+            if (refcount_release_weak(*m_refCount))
             {
                 delete m_refCount;
             }
@@ -211,6 +272,9 @@ public bits::abstract_ref<T, bits::default_delete<T> >
     template <typename, typename, typename>
     friend class weak_ref;
 
+    template <typename>
+    friend class atomic_strong_ref;
+
 public:
 
     /**
@@ -235,6 +299,22 @@ public:
         grab();
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move constructor. The reference held by <code>rhs</code> is transferred
+     * to the new object without touching the reference count.
+     *
+     * @param rhs
+     */
+    strong_ref(strong_ref<T, bits::default_delete<T> >&& rhs)
+    :
+    bits::abstract_ref<T, bits::default_delete<T> >(rhs.m_pointer)
+    {
+        rhs.m_pointer = NULL;
+    }
+#endif
+
     /**
      * Default destructor.
      */
@@ -263,8 +343,68 @@ public:
         return this->m_pointer->queryStrongReferences();
     }
 
+    /**
+     * Assignment operator overload. The new object is grabbed before the old
+     * one is released, so self-assignment through aliases is safe.
+     *
+     * @param rhs
+     * @return
+     */
+    strong_ref<T, bits::default_delete<T> >& operator=(const strong_ref<T, bits::default_delete<T> >& rhs)
+    {
+        if (this != &rhs)
+        {
+            T* previous = this->m_pointer;
+
+            this->m_pointer = rhs.m_pointer;
+            grab();
+
+            if (previous != NULL)
+            {
+                previous->releaseStrongReference();
+            }
+        }
+        return *this;
+    }
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The reference held by <code>rhs</code> is
+     * taken over before the one held by this object is released, since
+     * <code>rhs</code> may live in the object released.
+     *
+     * @param rhs
+     * @return
+     */
+    strong_ref<T, bits::default_delete<T> >& operator=(strong_ref<T, bits::default_delete<T> >&& rhs)
+    {
+        if (this != &rhs)
+        {
+            T* previous = this->m_pointer;
+
+            this->m_pointer = rhs.m_pointer;
+            rhs.m_pointer = NULL;
+
+            if (previous != NULL)
+            {
+                previous->releaseStrongReference();
+            }
+        }
+        return *this;
+    }
+#endif
+
 private:
 
+    /**
+     * Takes over a strong reference already counted, as weak references do
+     * when they are upgraded.
+     *
+     * @param pointer
+     */
+    strong_ref(T* pointer, const bits::adopt_ref_tag&) : bits::abstract_ref<T, bits::default_delete<T> >(pointer) { }
+
     /**
      * Grabs a reference to the pointed object.
      */
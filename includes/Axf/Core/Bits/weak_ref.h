@@ -56,6 +56,11 @@ class strong_ref;
  * <p>
  * There are two classes of <code>weak_ref</code> objects: intrusive and
  * non-intrusive.
+ * <p>
+ * The pointed object may only be used through a strong reference obtained
+ * with <code>lock</code>, which fails once the object has been disposed of.
+ * Upgrading is lock free and safe while other threads release the last
+ * strong reference.
  *
  * @author J. Marrero
  */
@@ -113,6 +118,24 @@ public:
         grab();
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move constructor. The weak reference held by <code>rhs</code> is
+     * transferred without touching the reference count.
+     *
+     * @param rhs
+     */
+    weak_ref(weak_ref<T, deleter_functor>&& rhs)
+    :
+    bits::abstract_ref<T, deleter_functor>(rhs.m_pointer),
+    m_refCount(rhs.m_refCount)
+    {
+        rhs.m_pointer = NULL;
+        rhs.m_refCount = NULL;
+    }
+#endif
+
     /**
      * Default destructor.
      */
@@ -142,11 +165,40 @@ public:
      */
     inline size_t users() const
     {
-        return m_refCount != NULL ? m_refCount->m_weak : 0;
+        return m_refCount != NULL ? refcount_weak_users(*m_refCount) : 0;
+    }
+
+    /**
+     * Returns true if the pointed object has been disposed of, or if this
+     * reference is null.
+     *
+     * @return
+     */
+    inline bool expired() const
+    {
+        return m_refCount == NULL || concurrent::atomicLoad(&m_refCount->m_strong, concurrent::ACQUIRE) <= 0;
+    }
+
+    /**
+     * Upgrades this reference. The strong count is incremented only if it is
+     * not zero, so an object that is being disposed of is never revived.
+     *
+     * @return a strong reference to the object, or a null reference if it
+     *         has been disposed of
+     */
+    inline strong_ref<T, deleter_functor> lock() const
+    {
+        if (m_refCount != NULL && refcount_try_grab_strong(*m_refCount))
+        {
+            return strong_ref<T, deleter_functor>(this->m_pointer, m_refCount, bits::adopt_ref_tag());
+        }
+        return strong_ref<T, deleter_functor>();
     }
 
     /**
-     * Assignment operator overload.
+     * Assignment operator overload. The new reference is taken before the
+     * old one is released, since <code>rhs</code> may live in the object
+     * released.
      *
      * @param rhs
      * @return
@@ -155,16 +207,46 @@ public:
     {
         if (this != &rhs)
         {
-            release();
+            T* previous = this->m_pointer;
+            refcount_t* previousCount = m_refCount;
 
             this->m_pointer = rhs.m_pointer;
             this->m_refCount = rhs.m_refCount;
-
             grab();
+
+            release(previous, previousCount);
         }
         return *this;
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The reference held by <code>rhs</code> is
+     * taken over before the one held by this object is released.
+     *
+     * @param rhs
+     * @return
+     */
+    inline weak_ref<T, deleter_functor>& operator=(weak_ref<T, deleter_functor>&& rhs)
+    {
+        if (this != &rhs)
+        {
+            T* previous = this->m_pointer;
+            refcount_t* previousCount = m_refCount;
+
+            this->m_pointer = rhs.m_pointer;
+            this->m_refCount = rhs.m_refCount;
+
+            rhs.m_pointer = NULL;
+            rhs.m_refCount = NULL;
+
+            release(previous, previousCount);
+        }
+        return *this;
+    }
+#endif
+
 private:
 
     refcount_t* m_refCount;     /// the reference counting variable
@@ -175,24 +257,33 @@ private:
     inline void grab()
     {
         if (m_refCount != NULL)
-            ++(m_refCount->m_weak);
+            refcount_grab_weak(*m_refCount);
     }
 
     /**
-     * Releases a reference
+     * Releases a reference. The last reference frees the block, and disposes
+     * of the object if it was never strongly referenced.
      */
     inline void release()
     {
-        if (m_refCount != NULL)
+        release(this->m_pointer, m_refCount);
+    }
+
+    /**
+     * Releases a reference this object no longer holds.
+     *
+     * @param pointer
+     * @param refCount
+     */
+    inline void release(T* pointer, refcount_t* refCount)
+    {
+        if (refCount != NULL && refcount_release_weak(*refCount))
         {
-            if (this->m_pointer != NULL && (--m_refCount->m_weak <= 0) && (m_refCount->m_strong == 0))
-            {
-                this->m_disposer(this->m_pointer);
-            }
-            if (m_refCount->m_strong <= 0 && m_refCount->m_weak <= 0)
+            if (pointer != NULL && concurrent::atomicLoad(&refCount->m_strong, concurrent::ACQUIRE) == 0)
             {
-                delete m_refCount;
+                this->m_disposer(pointer);
             }
+            delete refCount;
         }
     }
 } ;
@@ -213,17 +304,18 @@ public:
     /**
      * Default constructor
      */
-    weak_ref() : bits::abstract_ref<T>(NULL) { }
+    weak_ref() : bits::abstract_ref<T>(NULL), m_control(NULL) { }
 
     /**
-     * Default parametric constructor.
+     * Default parametric constructor. Intrusive objects carry their own
+     * counts, so the block parameter is ignored.
      *
      * @param pointer
-     * @param refCount
      */
-    weak_ref(T* pointer, refcount_t* refCount = new refcount_t())
+    weak_ref(T* pointer, refcount_t* = NULL)
     :
-    bits::abstract_ref<T>(pointer)
+    bits::abstract_ref<T>(pointer),
+    m_control(controlOf(pointer))
     {
         grab();
     }
@@ -235,11 +327,29 @@ public:
      */
     weak_ref(const weak_ref<T>& rhs)
     :
-    bits::abstract_ref<T>(rhs.m_pointer)
+    bits::abstract_ref<T>(rhs.m_pointer),
+    m_control(rhs.m_control)
     {
         grab();
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move constructor.
+     *
+     * @param rhs
+     */
+    weak_ref(weak_ref<T>&& rhs)
+    :
+    bits::abstract_ref<T>(rhs.m_pointer),
+    m_control(rhs.m_control)
+    {
+        rhs.m_pointer = NULL;
+        rhs.m_control = NULL;
+    }
+#endif
+
     /**
      * Default converting constructor for intrusive strong references.
      * 
@@ -247,7 +357,8 @@ public:
      */
     weak_ref(const strong_ref<T>& rhs)
     :
-    bits::abstract_ref<T>(rhs.m_pointer)
+    bits::abstract_ref<T>(rhs.m_pointer),
+    m_control(controlOf(rhs.m_pointer))
     {
         grab();
     }
@@ -271,6 +382,7 @@ public:
 
         // Make everything null
         this->m_pointer = NULL;
+        m_control = NULL;
     }
 
     /**
@@ -280,11 +392,40 @@ public:
      */
     inline size_t users() const
     {
-        return this->m_pointer != NULL ? this->m_pointer->queryWeakReferences() : 0;
+        return m_control != NULL ? m_control->users() : 0;
+    }
+
+    /**
+     * Returns true if the pointed object has been destroyed, or if this
+     * reference is null.
+     *
+     * @return
+     */
+    inline bool expired() const
+    {
+        return m_control == NULL || m_control->expired();
     }
 
     /**
-     * Assignment operator overload.
+     * Upgrades this reference. The strong count is incremented only if it is
+     * not zero, so an object that is being destroyed is never revived.
+     *
+     * @return a strong reference to the object, or a null reference if it
+     *         has been destroyed
+     */
+    inline strong_ref<T> lock() const
+    {
+        if (m_control != NULL && m_control->tryUpgrade())
+        {
+            return strong_ref<T>(this->m_pointer, bits::adopt_ref_tag());
+        }
+        return strong_ref<T>();
+    }
+
+    /**
+     * Assignment operator overload. The new reference is taken before the
+     * old one is released, since <code>rhs</code> may live in the object
+     * released.
      *
      * @param rhs
      * @return
@@ -293,27 +434,69 @@ public:
     {
         if (this != &rhs)
         {
-            release();
+            bits::WeakControl* previous = m_control;
 
             this->m_pointer = rhs.m_pointer;
-
+            m_control = rhs.m_control;
             grab();
+
+            if (previous != NULL)
+                previous->release();
         }
         return *this;
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The reference held by <code>rhs</code> is
+     * taken over before the one held by this object is released.
+     *
+     * @param rhs
+     * @return
+     */
+    inline weak_ref<T>& operator=(weak_ref<T>&& rhs)
+    {
+        if (this != &rhs)
+        {
+            bits::WeakControl* previous = m_control;
+
+            this->m_pointer = rhs.m_pointer;
+            m_control = rhs.m_control;
+
+            rhs.m_pointer = NULL;
+            rhs.m_control = NULL;
+
+            if (previous != NULL)
+                previous->release();
+        }
+        return *this;
+    }
+#endif
+
 private:
 
+    /**
+     * The weak references of the pointed object. They outlive the object, so
+     * this reference never touches the object once it has been destroyed.
+     */
+    bits::WeakControl* m_control;
+
+    static inline bits::WeakControl* controlOf(const T* pointer)
+    {
+        return pointer != NULL ? pointer->queryWeakControl() : NULL;
+    }
+
     inline void grab()
     {
-        if (this->m_pointer != NULL)
-            this->m_pointer->grabWeakReference();
+        if (m_control != NULL)
+            m_control->grab();
     }
 
     inline void release()
     {
-        if (this->m_pointer != NULL)
-            this->m_pointer->releaseWeakReference();
+        if (m_control != NULL)
+            m_control->release();
     }
 } ;
 
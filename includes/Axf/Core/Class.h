@@ -28,9 +28,12 @@
 #define AXF_CLASS_H
 
 // API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
 #include <Axf/Core/ReferenceCounted.h>
 #include <Axf/Core/ClassCastException.h>
 #include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/InternPool.h>
 
 // C++
 #include <exception>
@@ -73,10 +76,17 @@ struct Type : public ReferenceCounted
 protected:
 
     const char* m_className;    /// The class name that identifies this type
+    InternedString m_name;      /// The class name, interned in the global pool
     int m_hash;
 
     /** Creates a new type object */
-    Type(const char* className) : m_className(className), m_hash(encodeTypeName(className)) { }
+    Type(const char* className)
+    :
+    m_className(className),
+    m_name(InternPool::global().intern(className)),
+    m_hash(encodeTypeName(className))
+    {
+    }
 
 public:
 
@@ -91,8 +101,8 @@ public:
     static int encodeTypeName(const char* str);
 
     /**
-     * Return true if two types are equals. Two types are equals if their hash
-     * code matches exactly.
+     * Return true if two types are equals. Two types are equals if their
+     * names are equal, which, names being interned, is a pointer compare.
      * <p>
      * The equality relationship is symmetric, reflexive and transitive.
      * 
@@ -101,19 +111,32 @@ public:
      */
     inline bool equals(const Type& type) const
     {
-        return m_hash == type.m_hash;
+        return m_name == type.m_name;
+    }
+
+    /**
+     * Returns true if an interned type name matches this type's.
+     *
+     * @param className
+     * @return
+     */
+    inline bool equals(const InternedString& className) const
+    {
+        return m_name == className;
     }
 
     /**
      * Returns true if a type name matches this type's. Comparison is performed
-     * using the hash codes for performance reasons.
+     * using the hash codes for performance reasons. Names usually come from
+     * the same string literal as this type's, in which case the name is not
+     * hashed at all.
      * 
      * @param className
      * @return
      */
     inline bool equals(const char* className) const
     {
-        return m_hash == encodeTypeName(className);
+        return className == m_className || m_hash == encodeTypeName(className);
     }
 
     /**
@@ -136,6 +159,16 @@ public:
         return m_className;
     }
 
+    /**
+     * Returns the name of this type as interned in the global pool.
+     *
+     * @return
+     */
+    inline const InternedString& getInternedName() const
+    {
+        return m_name;
+    }
+
     /**
      * Returns the unqualified name of this class. The unqualified name of a
      * class is the class name without any name-space specifiers, <i>i.e</i>
@@ -280,6 +313,25 @@ public:
      * @return
      */
     inline const bits::Type& getSuperClass(const char* className) const
+    {
+        // A name that was never interned cannot belong to any type
+        InternedString name = InternPool::global().find(className);
+        if (name.isNull())
+        {
+            throwNotASuperClass(className);
+        }
+        return getSuperClass(name);
+    }
+
+    /**
+     * Returns the superclass of this class with the specified interned
+     * fully qualified name. Names are compared by identity while walking the
+     * inheritance graph.
+     *
+     * @param className
+     * @return
+     */
+    inline const bits::Type& getSuperClass(const InternedString& className) const
     {
         const bits::Type* currentWalker = NULL;
         for (unsigned i = 0; i < m_superTypes.size() && currentWalker == NULL; ++i)
@@ -291,12 +343,7 @@ public:
         // If no given super-type is found
         if (currentWalker == NULL)
         {
-            char exceptionMessage[1024] = {0};
-            std::sprintf(exceptionMessage, "invalid super-type look-out, '%s' is not a valid '%s' subtype",
-                         m_className,
-                         className);
-
-            throw IllegalStateException(exceptionMessage);
+            throwNotASuperClass(className.bytes());
         }
 
         // Returns a reference to the current walker
@@ -338,7 +385,7 @@ public:
     template <typename _T>
     inline bool isInstanceOf(const Class<_T>& rhs) const
     {
-        return m_hash == rhs.getTypeHash();
+        return m_name == rhs.getInternedName();
     }
 
     /**
@@ -358,7 +405,7 @@ public:
         for (unsigned i = 0; i < m_superTypes.size() && result == false; ++i)
         {
             if (m_superTypes.at(i) != NULL)
-                result = (walkInheritanceGraph(rhs.getName(), (const Class<T>*) m_superTypes.at(i)) != NULL);
+                result = (walkInheritanceGraph(rhs.getInternedName(), (const Class<T>*) m_superTypes.at(i)) != NULL);
         }
         return result;
     }
@@ -367,19 +414,35 @@ private:
 
     std::vector<const bits::Type*> m_superTypes;
 
+    /**
+     * Throws the exception reporting a failed super class look-up.
+     *
+     * @param className
+     */
+    void throwNotASuperClass(const char* className) const
+    {
+        char exceptionMessage[1024] = {0};
+        std::sprintf(exceptionMessage, "invalid super-type look-out, '%s' is not a valid '%s' subtype",
+                     m_className,
+                     className);
+
+        throw IllegalStateException(exceptionMessage);
+    }
+
     /**
      * This recursive function searches within the inheritance graph for a given
      * class descriptor reference. It returns a pointer to the polymorphic type.
+     * The searched type is given by its interned name, so every step of the
+     * walk is a pointer compare.
      * 
      * @param className
      * @return
      */
-    inline const bits::Type* walkInheritanceGraph(const char* className,
+    inline const bits::Type* walkInheritanceGraph(const InternedString& className,
                                                   const Class<T>* current) const
     {
         // Base case: the current walked class is the same type we're looking for
-        int typeHash = encodeTypeName(className);
-        const bits::Type* result = (typeHash == current->getTypeHash()) ? current : NULL;
+        const bits::Type* result = current->equals(className) ? current : NULL;
 
         // Recursive case: walk this function for every super class
         for (unsigned i = 0; i < current->m_superTypes.size() && result == NULL; ++i)
@@ -448,6 +511,20 @@ const Class<_T>& getClass(const _T& rhs)
 namespace bits
 {
 
+/**
+ * Returns true if objects of class <code>source</code> can be cast to
+ * <code>target</code>, that is, if <code>source</code> is
+ * <code>target</code> or one of its subclasses.
+ * <p>
+ * Answers are memoized in a global, lock free table keyed by the pair of
+ * interned class names, so the inheritance graph is walked once per pair.
+ *
+ * @param source
+ * @param target
+ * @return
+ */
+bool isCastable(const core::bits::Type& source, const core::bits::Type& target);
+
 /**
  * Returns true whether an object can be casted into the target type.
  *
@@ -457,9 +534,17 @@ namespace bits
 template <typename _T, typename _E>
 bool _is_casteable(const _E& object)
 {
-    return (getClass(object).isKindOf(_T::getCompileTimeClass()));
+    return isCastable(getClass(object), _T::getCompileTimeClass());
 }
 
+/**
+ * Throws the exception of a failed cast.
+ *
+ * @param source
+ * @param target
+ */
+void throwInvalidCast(const core::bits::Type& source, const core::bits::Type& target);
+
 }
 
 /**
@@ -475,21 +560,113 @@ bool _is_casteable(const _E& object)
 template <typename _T, typename _E>
 _T& runtime_cast(_E& object)
 {
-    if (bits::_is_casteable<_T>(object) == false)
-    {
-        char exceptionMessage[1024] = {0};
-        std::sprintf(exceptionMessage, "invalid dynamic cast, '%s' is not a polymorphic covariant of '%s'.",
-                     _E::getCompileTimeClass().getName(),
-                     _T::getCompileTimeClass().getName());
+    if (ARTEMIS_UNLIKELY(bits::_is_casteable<_T>(object) == false))
+        bits::throwInvalidCast(getClass(object), _T::getCompileTimeClass());
 
-        throw ClassCastException(exceptionMessage);
-    }
     return static_cast<_T&> (object);
 }
 
+/**
+ * An inline cache for the casts of one call site.
+ * <p>
+ * A site remembers the last few dynamic classes it cast successfully, so a
+ * site that always sees the same class (a monomorphic site) checks a cast
+ * with a single pointer compare, and a site that sees a handful of classes
+ * with a few. Other classes go through the global cache of
+ * <code>runtime_cast</code>, and replace the oldest remembered class; once a
+ * site has missed often enough to be deemed megamorphic it stops replacing
+ * classes, since rewriting the cache on every cast costs more than it saves.
+ * <p>
+ * Sites must have static storage duration: they have no constructor and rely
+ * on being zero initialized, so they cost nothing to set up. Use a static
+ * local, or let <code>AXF_RUNTIME_CAST</code> declare one.
+ *
+ * @author J. Marrero
+ */
+template <typename _T>
+class CastSite
+{
+public:
+
+    static const unsigned ENTRIES = 4;              /// Classes remembered by a site
+    static const unsigned MEGAMORPHIC_MISSES = 64;  /// Misses after which a site stops learning
+
+    /**
+     * Casts an object as <code>runtime_cast</code> does.
+     *
+     * @param object
+     * @return
+     */
+    template <typename _E>
+    inline _T& cast(_E& object)
+    {
+        const core::bits::Type* type = &getClass(object);
+        if (ARTEMIS_LIKELY(concurrent::atomicLoad(&m_types[0], concurrent::RELAXED) == type))
+            return static_cast<_T&> (object);
+
+        check(type);
+        return static_cast<_T&> (object);
+    }
+
+private:
+
+    const core::bits::Type* m_types[ENTRIES];   /// The remembered classes, the latest first
+    unsigned                m_misses;           /// Classes missing from the cache so far
+
+    /**
+     * Checks a class missing from the first entry. The entries are only
+     * written with classes that are known to be castable, and a racing thread
+     * may at worst lose an entry, so relaxed accesses suffice.
+     *
+     * @param type
+     */
+    void check(const core::bits::Type* type)
+    {
+        for (unsigned i = 1; i < ENTRIES; ++i)
+        {
+            if (concurrent::atomicLoad(&m_types[i], concurrent::RELAXED) == type)
+                return;
+        }
+
+        const core::bits::Type& target = _T::getCompileTimeClass();
+        if (!bits::isCastable(*type, target))
+            bits::throwInvalidCast(*type, target);
+
+        unsigned misses = concurrent::atomicLoad(&m_misses, concurrent::RELAXED);
+        if (misses >= MEGAMORPHIC_MISSES)
+            return;
+
+        concurrent::atomicStore(&m_misses, misses + 1, concurrent::RELAXED);
+        for (unsigned i = ENTRIES - 1; i > 0; --i)
+            concurrent::atomicStore(&m_types[i], concurrent::atomicLoad(&m_types[i - 1], concurrent::RELAXED),
+                                    concurrent::RELAXED);
+        concurrent::atomicStore(&m_types[0], type, concurrent::RELAXED);
+    }
+} ;
+
 }
 }
 }
 
+/**
+ * Casts an object like <code>axf::core::reflection::runtime_cast</code>,
+ * through an inline cache private to the call site. Without lambdas or
+ * statement expressions to hold the cache, it is a plain
+ * <code>runtime_cast</code>.
+ */
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+#define AXF_RUNTIME_CAST(_T, _object) \
+    ([]() -> axf::core::reflection::CastSite<_T >& \
+    { \
+        static axf::core::reflection::CastSite<_T > site; \
+        return site; \
+    }().cast(_object))
+#elif defined(ARTEMIS_COMPILER_GCC_COMPATIBLE)
+#define AXF_RUNTIME_CAST(_T, _object) \
+    (__extension__ ({ static axf::core::reflection::CastSite<_T > site; &site; })->cast(_object))
+#else
+#define AXF_RUNTIME_CAST(_T, _object) axf::core::reflection::runtime_cast<_T >(_object)
+#endif
+
 #endif /* CLASS_H */
 
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   ClassPool.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 10:20 AM
+ */
+
+#ifndef AXF_CLASSPOOL_H
+#define AXF_CLASSPOOL_H
+
+// API
+#include <Axf/Collections/ThreadCachingAllocator.h>
+#include <Axf/Core/Object.h>
+
+// C++
+#include <cstddef>
+#include <new>
+
+namespace axf
+{
+namespace core
+{
+
+/**
+ * This macro gives a class its own <code>operator new</code> and
+ * <code>operator delete</code>, which recycle the memory of its instances
+ * through the <code>ClassPool</code> of the class instead of the heap.
+ * <p>
+ * This macro goes right below <code>AXF_CLASS_TYPE</code>, and takes the
+ * class itself. Subclasses share the pool of the class, unless they declare
+ * their own; every instance is allocated with its own size either way.
+ * Placement and non throwing <code>new</code> keep working, and the memory
+ * of an instance whose constructor throws goes back to the pool as well.
+ */
+#define AXF_CLASS_POOL(_Type) \
+    public: \
+    \
+    static void* operator new(std::size_t size) \
+    { \
+        return axf::core::ClassPool<_Type >::allocate(size); \
+    } \
+    \
+    static void* operator new(std::size_t size, const std::nothrow_t&) throw() \
+    { \
+        return axf::core::ClassPool<_Type >::tryAllocate(size); \
+    } \
+    \
+    static void* operator new(std::size_t, void* storage) throw() \
+    { \
+        return storage; \
+    } \
+    \
+    static void operator delete(void* memory, std::size_t size) \
+    { \
+        axf::core::ClassPool<_Type >::deallocate(memory, size); \
+    } \
+    \
+    static void operator delete(void* memory, const std::nothrow_t&) throw() \
+    { \
+        axf::core::ClassPool<_Type >::deallocateUnsized(memory); \
+    } \
+    \
+    static void operator delete(void*, void*) throw() \
+    { \
+    } \
+    \
+    private:
+
+namespace bits
+{
+
+/**
+ * The untyped engine of every class pool.
+ */
+class ClassPoolEngine
+{
+public:
+
+    /**
+     * Allocates the memory of an instance. If the heap is exhausted, the
+     * free blocks cached by the calling thread and by the depots are
+     * returned to the system, and the allocation is attempted once more.
+     *
+     * @param size
+     * @return
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * Allocates the memory of an instance, or returns <code>NULL</code>.
+     * The calling thread remembers the size of the last few blocks, for
+     * <code>takeAttemptSize</code>.
+     *
+     * @param size
+     * @return
+     */
+    static void* tryAllocate(std::size_t size);
+
+    /**
+     * Returns the size of a block recently allocated by
+     * <code>tryAllocate</code> on the calling thread, and forgets it; zero
+     * if the block is not among the last few. Non throwing
+     * <code>new</code> has no size to give back to
+     * <code>operator delete</code> when a constructor throws, so it is
+     * looked up here.
+     *
+     * @param memory
+     * @return
+     */
+    static std::size_t takeAttemptSize(void* memory);
+
+    /**
+     * Fills the cache of the calling thread with free blocks.
+     *
+     * @param size
+     * @param count
+     */
+    static void reserve(std::size_t size, std::size_t count);
+} ;
+
+}
+
+/**
+ * The free blocks that recycle the memory of the instances of a class.
+ * <p>
+ * Classes whose instances are created and destroyed at a high rate, such as
+ * messages, events or list nodes, pay for a call to the heap on either end of
+ * the life of every instance. A class that declares
+ * <code>AXF_CLASS_POOL</code> gets its memory from here instead: each thread
+ * keeps free blocks of the size of the class, taken and returned without
+ * locks, as <code>collections::ThreadCache</code> does for the collections.
+ * Instances may be destroyed by any thread.
+ * <p>
+ * Pools hold on to a bounded amount of memory. They give it back to the
+ * system when the heap runs out, before failing an allocation, and whenever
+ * <code>trim</code> is called.
+ * <p>
+ * Instances are accounted for by the <code>AllocationProfiler</code>, under
+ * the class of the pool, from their allocation to their release. The memory
+ * of an instance is ordinary heap memory, or comes from the slabs of a
+ * <code>VirtualRegion</code> given to <code>setBackingRegion</code>, and
+ * goes back to the pool even if weak references to the instance remain.
+ *
+ * @author J. Marrero
+ */
+template <typename T>
+class ClassPool
+{
+public:
+
+    /**
+     * Allocates the memory of an instance of the class, or of a subclass.
+     *
+     * @param size
+     * @return
+     * @throws std::bad_alloc if the system is out of memory
+     */
+    static inline void* allocate(std::size_t size)
+    {
+        void* memory = bits::ClassPoolEngine::allocate(size);
+        collections::AllocationProfiler::recordAllocation(memory, size, typeid (T));
+        return memory;
+    }
+
+    /**
+     * Allocates the memory of an instance, or returns <code>NULL</code> if
+     * the system is out of memory.
+     *
+     * @param size
+     * @return
+     */
+    static inline void* tryAllocate(std::size_t size)
+    {
+        void* memory = bits::ClassPoolEngine::tryAllocate(size);
+        collections::AllocationProfiler::recordAllocation(memory, size, typeid (T));
+        return memory;
+    }
+
+    /**
+     * Returns the memory of an instance to the pool.
+     *
+     * @param memory
+     * @param size the size it was allocated with
+     */
+    static inline void deallocate(void* memory, std::size_t size)
+    {
+        collections::AllocationProfiler::recordDeallocation(memory);
+        collections::ThreadCache::deallocate(memory, size);
+    }
+
+    /**
+     * Returns the memory of an instance to the pool, when its size is not
+     * known: the constructor of an instance created with non throwing
+     * <code>new</code> threw. The memory is looked up among the last blocks
+     * the calling thread allocated that way; if it is not found, the block
+     * is leaked rather than returned with a wrong size.
+     *
+     * @param memory
+     */
+    static inline void deallocateUnsized(void* memory)
+    {
+        std::size_t size = bits::ClassPoolEngine::takeAttemptSize(memory);
+        if (size != 0)
+        {
+            deallocate(memory, size);
+        }
+    }
+
+    /**
+     * Caches free blocks for <code>count</code> instances of the class in
+     * the calling thread, ahead of a burst of allocations. Blocks past the
+     * bound of the cache go to the depot.
+     *
+     * @param count
+     */
+    static inline void reserve(std::size_t count)
+    {
+        bits::ClassPoolEngine::reserve(Class<T>::sizeOf, count);
+    }
+
+    /**
+     * Returns the free blocks cached by the calling thread and by the depots
+     * to the system. Blocks of the same size are shared by every pool, so
+     * this trims them all.
+     */
+    static inline void trim()
+    {
+        collections::ThreadCache::trim();
+    }
+
+    /**
+     * Makes the pools carve their free blocks from the slabs of a region,
+     * which packs their instances on huge pages when the region is backed
+     * by them. Blocks of the same size are shared by every pool, so this
+     * backs them all; see <code>ThreadCache::setBackingRegion</code>.
+     *
+     * @param region
+     * @throws IllegalStateException if the pools are backed by another
+     *         region
+     */
+    static inline void setBackingRegion(collections::VirtualRegion& region)
+    {
+        collections::ThreadCache::setBackingRegion(region);
+    }
+
+    /**
+     * Returns true if the instances of the class are small enough to be
+     * recycled; larger ones come from the heap.
+     *
+     * @return
+     */
+    static inline bool isPooled()
+    {
+        return Class<T>::sizeOf <= collections::ThreadCache::MAX_CACHED_SIZE;
+    }
+
+private:
+
+    ClassPool();
+} ;
+
+}
+}
+
+#endif /* AXF_CLASSPOOL_H */
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   CycleCollector.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 8:20 AM
+ */
+
+#ifndef AXF_CYCLECOLLECTOR_H
+#define AXF_CYCLECOLLECTOR_H
+
+// API
+#include <Axf/Core/Memory.h>
+#include <Axf/Core/Object.h>
+#include <Axf/Core/ReferenceCounted.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace core
+{
+
+/**
+ * Receives the references reported by <code>Object::traverseReferences</code>.
+ * <p>
+ * Implementations of <code>traverseReferences</code> pass every strong
+ * reference they hold to <code>visit</code>. The cycle collector visits the
+ * references of an object to examine the graph, and, once it finds the
+ * object to be garbage, to clear them: in that case <code>visit</code>
+ * resets the reference it is given.
+ *
+ * @author J. Marrero
+ */
+class ReferenceVisitor
+{
+public:
+
+    virtual ~ReferenceVisitor() { }
+
+    /**
+     * Reports a strong reference to an object.
+     *
+     * @param reference
+     */
+    template <typename T>
+    inline void visit(const strong_ref<T>& reference)
+    {
+        if (m_clearing)
+        {
+            const_cast<strong_ref<T>&> (reference).reset();
+        }
+        else if (reference.get() != NULL)
+        {
+            visitObject(reference.get());
+        }
+    }
+
+protected:
+
+    explicit ReferenceVisitor(bool clearing) : m_clearing(clearing) { }
+
+    /**
+     * Receives each object referenced, unless this visitor clears references.
+     *
+     * @param object
+     */
+    virtual void visitObject(const Object* object) = 0;
+
+private:
+
+    bool m_clearing;
+} ;
+
+/**
+ * A synchronous cycle collector for reference counted objects, by trial
+ * deletion (Bacon and Rajan).
+ * <p>
+ * Reference counting alone never frees objects that reference each other.
+ * Objects that may form such cycles call <code>enableCycleCollection</code>
+ * and report their strong references with
+ * <code>Object::traverseReferences</code>. Whenever a release leaves one of
+ * them still referenced, it is recorded as a possible root of a garbage
+ * cycle, once until it is examined. A collection then subtracts from each
+ * object reachable from the roots the references it gets from inside that
+ * subgraph: the objects left without references are only referenced by
+ * garbage, so their references are cleared and they are released.
+ * <p>
+ * Collections are incremental: they take roots until they have examined
+ * <code>budget</code> objects, and leave the remaining roots for the next
+ * collection. Each root taken is examined along with everything reachable
+ * from it, so a single collection may exceed the budget.
+ * <p>
+ * The collector is synchronous: no other thread may reference or release
+ * the objects a collection examines while it runs. Objects biased towards a
+ * thread are never collected, and neither are objects that did not enable
+ * cycle collection; references from them count as references from outside.
+ * <p>
+ * The collector is only built in if the library is built with
+ * <code>AXF_CYCLE_COLLECTION</code> defined. Otherwise no object records
+ * roots, and collections find nothing.
+ *
+ * @author J. Marrero
+ */
+class CycleCollector
+{
+    friend class ReferenceCounted;
+
+public:
+
+    /**
+     * Examines the roots recorded so far, until at least
+     * <code>budget</code> objects have been examined, and releases the
+     * garbage cycles found.
+     *
+     * @param budget
+     * @return the count of objects released
+     */
+    static std::size_t collect(std::size_t budget = (std::size_t) -1);
+
+    /**
+     * Returns the count of possible roots waiting to be examined.
+     *
+     * @return
+     */
+    static std::size_t candidates();
+
+private:
+
+    class Tracer;
+
+    /**
+     * Records an object as a possible root of a garbage cycle.
+     *
+     * @param object
+     */
+    static void addCandidate(const ReferenceCounted* object);
+
+#ifdef AXF_CYCLE_COLLECTION
+    static inline volatile unsigned& stateOf(const ReferenceCounted* object)
+    {
+        return object->m_cycle;
+    }
+#endif
+} ;
+
+}
+}
+
+#endif /* AXF_CYCLECOLLECTOR_H */
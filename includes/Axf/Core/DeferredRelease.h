@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   DeferredRelease.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#ifndef AXF_DEFERREDRELEASE_H
+#define AXF_DEFERREDRELEASE_H
+
+// API
+#include <Axf/Core/ReferenceCounted.h>
+
+// C++
+#include <cstddef>
+
+namespace axf
+{
+namespace core
+{
+
+namespace bits
+{
+
+/**
+ * The shared state of a reclaimer, defined along with its thread.
+ */
+struct ReclaimerState;
+
+}
+
+/**
+ * A background thread that destroys the objects other threads release.
+ * <p>
+ * Threads hand objects over with <code>DeferredRelease::enable(Reclaimer&)</code>.
+ * Handing an object over costs one atomic operation; the reclaimer then runs
+ * its destructor, and the releases that cascade from it, with deferred
+ * releases enabled, so destroying a large structure never recurses.
+ * <p>
+ * Destroying a reclaimer waits until every object handed over to it has been
+ * destroyed. Threads must stop handing objects over to a reclaimer before
+ * destroying it.
+ *
+ * @author J. Marrero
+ */
+class Reclaimer
+{
+    friend class DeferredRelease;
+
+public:
+
+    /**
+     * Starts the thread of a reclaimer.
+     *
+     * @throws IllegalStateException if the thread cannot be started
+     */
+    Reclaimer();
+    ~Reclaimer();
+
+    /**
+     * Waits until every object handed over so far has been destroyed.
+     */
+    void flush();
+
+    /**
+     * Returns the count of objects destroyed by this reclaimer.
+     *
+     * @return
+     */
+    std::size_t reclaimed() const;
+
+private:
+
+    bits::ReclaimerState* m_state;
+
+    void handOver(const ReferenceCounted* object);
+
+    Reclaimer(const Reclaimer&);
+    Reclaimer& operator=(const Reclaimer&);
+} ;
+
+/**
+ * Deferred release of reference counted objects.
+ * <p>
+ * Releasing the last strong reference of an object normally destroys it
+ * right away, along with everything only it referenced: dropping the head of
+ * a large structure destroys the whole structure on the releasing thread,
+ * and long chains of references recurse as deep as they are long. A thread
+ * that enables deferred releases queues the objects whose last strong
+ * reference it drops instead, and destroys them later with
+ * <code>drain</code>, from a point where the pause is acceptable and in
+ * batches as small as needed. Destroying a queued object only queues the
+ * objects it was the last to reference, so draining is iterative.
+ * <p>
+ * Objects waiting to be destroyed are dead: weak references cannot upgrade
+ * them. Releases are deferred per thread, and only for objects with
+ * intrusive reference counts. Objects queued when a thread finishes are
+ * destroyed then.
+ *
+ * @author J. Marrero
+ */
+class DeferredRelease
+{
+    friend class ReferenceCounted;
+    friend class Reclaimer;
+    friend struct bits::ReclaimerState;
+
+public:
+
+    /**
+     * Defers the releases of the calling thread until it drains them.
+     */
+    static void enable();
+
+    /**
+     * Hands the releases of the calling thread over to a reclaimer, which
+     * must outlive this setting.
+     *
+     * @param reclaimer
+     */
+    static void enable(Reclaimer& reclaimer);
+
+    /**
+     * Destroys the objects queued by the calling thread, and releases
+     * objects right away from then on.
+     */
+    static void disable();
+
+    /**
+     * Returns true if the releases of the calling thread are deferred.
+     *
+     * @return
+     */
+    static bool isEnabled();
+
+    /**
+     * Destroys at most <code>budget</code> of the objects queued by the
+     * calling thread, in the reverse order of their release. Objects whose
+     * last reference is released meanwhile are queued too, and count against
+     * the budget when they are destroyed.
+     *
+     * @param budget
+     * @return the count of objects destroyed
+     */
+    static std::size_t drain(std::size_t budget = (std::size_t) -1);
+
+    /**
+     * Returns the count of objects queued by the calling thread.
+     *
+     * @return
+     */
+    static std::size_t pending();
+
+private:
+
+    /**
+     * Queues an object whose last strong reference is gone, if the calling
+     * thread defers its releases.
+     *
+     * @param object
+     * @return true if the object was queued
+     */
+    static bool defer(const ReferenceCounted* object);
+
+    static const ReferenceCounted* next(const ReferenceCounted* object);
+    static void link(const ReferenceCounted* object, const ReferenceCounted* next);
+    static void destroy(const ReferenceCounted* object);
+} ;
+
+}
+}
+
+#endif /* AXF_DEFERREDRELEASE_H */
@@ -28,8 +28,12 @@
 #define EXCEPTION_H
 
 // API
+#include <Axf/Concurrent/LazyStatic.h>
 #include <Axf/Core/ReferenceCounted.h>
 
+// C++
+#include <new>
+
 namespace axf
 {
 namespace core
@@ -133,9 +137,17 @@ private:
     public: \
         static const axf::core::bits::ExceptionTypeDescriptor& getCompileTimeClass() \
         { \
-            static axf::core::bits::ExceptionTypeDescriptor exceptionType(#Type, &Throwable::getCompileTimeClass()); \
+            struct Factory \
+            { \
+                static void* create(void* storage) \
+                { \
+                    return new (storage) axf::core::bits::ExceptionTypeDescriptor(#Type, \
+                                                                               &Throwable::getCompileTimeClass()); \
+                } \
+            } ; \
+            static axf::concurrent::LazyStatic<axf::core::bits::ExceptionTypeDescriptor> exceptionType; \
             \
-            return exceptionType; \
+            return exceptionType.get(&Factory::create); \
         } \
         \
         inline virtual const char* getClassName() const { return #Type; } \
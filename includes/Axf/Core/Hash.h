@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   Hash.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 7:30 PM
+ */
+
+#ifndef AXF_HASH_H
+#define AXF_HASH_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Core/String.h>
+
+// C++
+#include <cstddef>
+#include <cstring>
+
+namespace axf
+{
+namespace core
+{
+
+typedef unsigned long long hash_t;  /// A 64-bit hash value
+
+namespace bits
+{
+
+/**
+ * Multiplies two 64-bit numbers, leaving the low half of the 128-bit product
+ * in <code>a</code> and the high half in <code>b</code>.
+ *
+ * @param a
+ * @param b
+ */
+inline void multiplyFull(hash_t& a, hash_t& b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = a;
+    r *= b;
+    a = (hash_t) r;
+    b = (hash_t) (r >> 64);
+#else
+    hash_t ha = a >> 32, hb = b >> 32, la = (unsigned) a, lb = (unsigned) b;
+    hash_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    hash_t t = rl + (rm0 << 32);
+    hash_t c = t < rl;
+    hash_t lo = t + (rm1 << 32);
+    c += lo < t;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    a = lo;
+#endif
+}
+
+/**
+ * Folds the 128-bit product of two numbers into 64 bits.
+ *
+ * @param a
+ * @param b
+ * @return
+ */
+inline hash_t multiplyFold(hash_t a, hash_t b)
+{
+    multiplyFull(a, b);
+    return a ^ b;
+}
+
+}
+
+/**
+ * Hashes a block of memory into a 64-bit value.
+ * <p>
+ * The function belongs to the wyhash family: the input is consumed in 48 byte
+ * blocks by three independent multiply-fold lanes, which keeps the multiplier
+ * busy and reaches several bytes per cycle on 64-bit processors, while short
+ * keys take a couple of multiplications. The result is not stable between
+ * library versions and must not be persisted.
+ *
+ * @param bytes
+ * @param length
+ * @param seed
+ * @return
+ */
+hash_t hash(const void* bytes, std::size_t length, hash_t seed = 0);
+
+/**
+ * Hashes a null terminated string.
+ *
+ * @param cstr
+ * @return
+ */
+inline hash_t hash(const char* cstr)
+{
+    return hash(cstr, std::strlen(cstr));
+}
+
+/**
+ * Scrambles a 64-bit integer, so that keys differing in few bits produce
+ * unrelated hashes.
+ *
+ * @param value
+ * @return
+ */
+inline hash_t hashMix(hash_t value)
+{
+    return bits::multiplyFold(value ^ 0xe7037ed1a0b428dbULL, 0xa0761d6478bd642fULL);
+}
+
+/**
+ * Combines a hash with the hash of another value. The combination depends on
+ * the order of the values.
+ *
+ * @param seed
+ * @param value
+ * @return
+ */
+inline hash_t hashCombine(hash_t seed, hash_t value)
+{
+    return bits::multiplyFold(seed ^ 0x8ebc6af09c88c6e3ULL, value ^ 0x589965cc75374cc3ULL);
+}
+
+/**
+ * Reduces a 64-bit hash to the 32 bits returned by <code>hashCode</code>.
+ *
+ * @param value
+ * @return
+ */
+inline int foldHash(hash_t value)
+{
+    return (int) (value ^ (value >> 32));
+}
+
+/*
+ * Hashes of single values, used to hash the fields of an object. Objects are
+ * hashed with their hashCode method.
+ */
+
+inline hash_t hashValue(bool value)                 { return hashMix(value); }
+inline hash_t hashValue(char value)                 { return hashMix((hash_t) value); }
+inline hash_t hashValue(signed char value)          { return hashMix((hash_t) value); }
+inline hash_t hashValue(unsigned char value)        { return hashMix(value); }
+inline hash_t hashValue(short value)                { return hashMix((hash_t) value); }
+inline hash_t hashValue(unsigned short value)       { return hashMix(value); }
+inline hash_t hashValue(int value)                  { return hashMix((hash_t) value); }
+inline hash_t hashValue(unsigned value)             { return hashMix(value); }
+inline hash_t hashValue(long value)                 { return hashMix((hash_t) value); }
+inline hash_t hashValue(unsigned long value)        { return hashMix(value); }
+inline hash_t hashValue(long long value)            { return hashMix((hash_t) value); }
+inline hash_t hashValue(unsigned long long value)   { return hashMix(value); }
+
+inline hash_t hashValue(float value)
+{
+    // Positive and negative zero compare equal, so they must hash equal
+    if (value == 0.0f)
+        value = 0.0f;
+    return hash(&value, sizeof (value));
+}
+
+inline hash_t hashValue(double value)
+{
+    if (value == 0.0)
+        value = 0.0;
+    return hash(&value, sizeof (value));
+}
+
+inline hash_t hashValue(const char* cstr)
+{
+    return cstr != NULL ? hash(cstr) : 0;
+}
+
+inline hash_t hashValue(char* cstr)
+{
+    return hashValue(const_cast<const char*> (cstr));
+}
+
+inline hash_t hashValue(const string& str)
+{
+    // Reuses the hash cached by the string
+    return (hash_t) (unsigned) str.hashCode();
+}
+
+template <typename T>
+inline hash_t hashValue(T* const pointer)
+{
+    return hashMix((hash_t) (std::size_t) pointer);
+}
+
+template <typename T>
+inline hash_t hashValue(const T& object)
+{
+    return (hash_t) (unsigned) object.hashCode();
+}
+
+namespace bits
+{
+
+/**
+ * Accumulates the hashes of a sequence of fields. Fields are fed with the
+ * comma operator, which lets <code>AXF_HASH_FIELDS</code> take any number of
+ * fields without variadic templates.
+ */
+class FieldHasher
+{
+public:
+
+    explicit FieldHasher(hash_t seed) : m_state(seed) { }
+
+    template <typename T>
+    inline FieldHasher& operator,(const T& field)
+    {
+        m_state = hashCombine(m_state, hashValue(field));
+        return *this;
+    }
+
+    inline hash_t result() const
+    {
+        return m_state;
+    }
+
+private:
+
+    hash_t m_state;
+} ;
+
+}
+
+/**
+ * Defines <code>hashCode</code> for a class from the listed fields. It must be
+ * placed after <code>AXF_CLASS_TYPE</code>: the hash is seeded with the type
+ * hash of the class, so objects of different classes with equal fields do not
+ * collide.
+ * <p>
+ * Classes using this macro must override <code>equals</code> to compare the
+ * same fields, so that equal objects have equal hash codes.
+ */
+#define AXF_HASH_FIELDS(...) \
+    public: \
+    \
+    virtual int hashCode() const \
+    { \
+        return axf::core::foldHash((axf::core::bits::FieldHasher( \
+                (axf::core::hash_t) (unsigned) getCompileTimeClass().getTypeHash()), __VA_ARGS__).result()); \
+    } \
+    \
+    private:
+
+/**
+ * Mixin that caches the hash code of an immutable value object.
+ * <p>
+ * Classes that are used as keys and never change after construction inherit
+ * from <code>CachedHash</code> besides <code>Object</code>, and either use
+ * <code>AXF_CACHED_HASH_FIELDS</code> or call <code>cacheHashCode</code> from
+ * their own <code>hashCode</code>. A class whose fields do change must call
+ * <code>invalidateHashCode</code> after every mutation.
+ * <p>
+ * The cache is read and written with relaxed atomics: threads racing on the
+ * first call compute the same value, so any of the stores is correct.
+ *
+ * @author J. Marrero
+ */
+class CachedHash
+{
+protected:
+
+    CachedHash() : m_cachedHash(0) { }
+
+    CachedHash(const CachedHash& rhs) : m_cachedHash(rhs.getCachedHashCode()) { }
+
+    ~CachedHash() { }
+
+    inline CachedHash& operator=(const CachedHash& rhs)
+    {
+        concurrent::atomicStore(&m_cachedHash, rhs.getCachedHashCode(), concurrent::RELAXED);
+        return *this;
+    }
+
+    /**
+     * Stores a freshly computed hash code and returns it. Zero is reserved
+     * for the empty cache, so a zero hash is stored (and returned) as one.
+     *
+     * @param hash
+     * @return
+     */
+    inline int cacheHashCode(int hash) const
+    {
+        if (hash == 0)
+            hash = 1;
+        concurrent::atomicStore(&m_cachedHash, hash, concurrent::RELAXED);
+        return hash;
+    }
+
+    /**
+     * Returns the cached hash code, or zero if it was not computed yet.
+     *
+     * @return
+     */
+    inline int getCachedHashCode() const
+    {
+        return concurrent::atomicLoad(&m_cachedHash, concurrent::RELAXED);
+    }
+
+    /**
+     * Discards the cached hash code.
+     */
+    inline void invalidateHashCode()
+    {
+        concurrent::atomicStore(&m_cachedHash, 0, concurrent::RELAXED);
+    }
+
+private:
+
+    mutable int m_cachedHash;   /// The cached hash code, zero if not computed
+} ;
+
+/**
+ * Same as <code>AXF_HASH_FIELDS</code>, but the hash code is computed once
+ * and kept in the <code>CachedHash</code> base of the class.
+ */
+#define AXF_CACHED_HASH_FIELDS(...) \
+    public: \
+    \
+    virtual int hashCode() const \
+    { \
+        int hash = getCachedHashCode(); \
+        if (ARTEMIS_UNLIKELY(hash == 0)) \
+        { \
+            hash = cacheHashCode(axf::core::foldHash((axf::core::bits::FieldHasher( \
+                    (axf::core::hash_t) (unsigned) getCompileTimeClass().getTypeHash()), __VA_ARGS__).result())); \
+        } \
+        return hash; \
+    } \
+    \
+    private:
+
+}
+}
+
+#endif /* AXF_HASH_H */
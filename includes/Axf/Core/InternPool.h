@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   InternPool.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 9:40 PM
+ */
+
+#ifndef AXF_INTERNPOOL_H
+#define AXF_INTERNPOOL_H
+
+// API
+#include <Axf/Concurrent/SpinLock.h>
+#include <Axf/Core/Hash.h>
+#include <Axf/Core/String.h>
+
+// C++
+#include <cstddef>
+#include <cstring>
+
+namespace axf
+{
+namespace core
+{
+
+namespace bits
+{
+
+/**
+ * The storage of an interned string. Entries are allocated once, with the
+ * bytes following the header, and live as long as their pool.
+ */
+struct InternEntry
+{
+    InternEntry*    next;       /// The next entry of the hash bucket
+    hash_t          hash;       /// The full hash of the bytes
+    std::size_t     size;       /// The size in bytes, without the null
+    int             hashCode;   /// The hash code, as string would compute it
+    char            bytes[1];   /// The null terminated bytes
+} ;
+
+}
+
+class InternPool;
+
+/**
+ * A handle to a string stored in an <code>InternPool</code>.
+ * <p>
+ * A pool stores each distinct string once, so two interned strings are equal
+ * if and only if they are the same handle: comparison is a pointer compare
+ * and the hash code is a stored field. Handles are plain pointers, they are
+ * not reference counted and are freely copyable; the strings they point to
+ * are immutable and live as long as the pool (forever, for the global pool).
+ * <p>
+ * The hash code of an interned string equals the hash code of an
+ * <code>axf::core::string</code> with the same contents.
+ *
+ * @author J. Marrero
+ */
+class InternedString
+{
+    friend class InternPool;
+
+public:
+
+    /**
+     * Constructs the null handle, which is different from every interned
+     * string, including the empty one.
+     */
+    InternedString() : m_entry(NULL) { }
+
+    /**
+     * Returns the bytes of the interned string, null terminated. The null
+     * handle returns <code>NULL</code>.
+     *
+     * @return
+     */
+    inline const char* bytes() const
+    {
+        return m_entry != NULL ? m_entry->bytes : NULL;
+    }
+
+    /**
+     * Returns the stored hash code.
+     *
+     * @return
+     */
+    inline int hashCode() const
+    {
+        return m_entry != NULL ? m_entry->hashCode : 0;
+    }
+
+    /**
+     * Returns true if this is the null handle.
+     *
+     * @return
+     */
+    inline bool isNull() const
+    {
+        return m_entry == NULL;
+    }
+
+    /**
+     * Returns the size of the string in bytes, not counting the terminating
+     * null.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_entry != NULL ? m_entry->size : 0;
+    }
+
+    inline bool operator==(const InternedString& rhs) const
+    {
+        return m_entry == rhs.m_entry;
+    }
+
+    inline bool operator!=(const InternedString& rhs) const
+    {
+        return m_entry != rhs.m_entry;
+    }
+
+    /**
+     * Orders handles by address. The order is arbitrary but stable, which is
+     * enough for sorted containers.
+     *
+     * @param rhs
+     * @return
+     */
+    inline bool operator<(const InternedString& rhs) const
+    {
+        return m_entry < rhs.m_entry;
+    }
+
+private:
+
+    const bits::InternEntry* m_entry;   /// The entry in the pool
+
+    explicit InternedString(const bits::InternEntry* entry) : m_entry(entry) { }
+} ;
+
+/**
+ * A thread safe set of unique strings.
+ * <p>
+ * Strings are distributed among a fixed number of shards by their hash, and
+ * each shard is an independent chained hash table guarded by its own spin
+ * lock, so threads interning different strings rarely contend. Entries are
+ * carved from per shard memory chunks and are never removed: a pool only
+ * grows, and releases its memory when it is destroyed.
+ * <p>
+ * Most code uses the global pool, which is never destroyed; its handles
+ * remain valid during static destruction. The type system interns the names
+ * of every class there.
+ *
+ * @author J. Marrero
+ */
+class InternPool
+{
+public:
+
+    static const unsigned SHARD_COUNT = 16;     /// Number of independent shards
+
+    InternPool();
+    ~InternPool();
+
+    /**
+     * Returns the global pool.
+     *
+     * @return
+     */
+    static InternPool& global();
+
+    /**
+     * Returns the interned string with the given contents, or the null handle
+     * if it was never interned. This method never allocates.
+     *
+     * @param bytes
+     * @param size
+     * @return
+     */
+    InternedString find(const char* bytes, std::size_t size) const;
+
+    inline InternedString find(const char* cstr) const
+    {
+        return find(cstr, std::strlen(cstr));
+    }
+
+    /**
+     * Interns a sequence of bytes. The bytes may contain nulls.
+     *
+     * @param bytes
+     * @param size
+     * @return
+     */
+    InternedString intern(const char* bytes, std::size_t size);
+
+    inline InternedString intern(const char* cstr)
+    {
+        return intern(cstr, std::strlen(cstr));
+    }
+
+    inline InternedString intern(const string& str)
+    {
+        return intern(str.bytes() != NULL ? str.bytes() : "", str.size());
+    }
+
+    /**
+     * Returns the number of distinct strings in this pool.
+     *
+     * @return
+     */
+    std::size_t size() const;
+
+private:
+
+    /**
+     * A shard of the pool. Shards are padded to a cache line, so that the
+     * locks of neighbouring shards do not share one.
+     */
+    struct Shard
+    {
+        mutable concurrent::SpinLock lock;
+        bits::InternEntry** buckets;        /// The bucket array
+        std::size_t         bucketCount;    /// A power of two
+        std::size_t         count;          /// Number of entries
+        void*               chunks;         /// The allocated chunks, linked
+        char*               cursor;         /// The next free byte of the last chunk
+        std::size_t         chunkLeft;      /// Bytes left after the cursor
+        char                padding[64];
+    } ;
+
+    Shard m_shards[SHARD_COUNT];
+
+    static inline std::size_t shardOf(hash_t hash)
+    {
+        return (std::size_t) (hash >> 60) & (SHARD_COUNT - 1);
+    }
+
+    static const bits::InternEntry* lookup(const Shard& shard, hash_t hash, const char* bytes, std::size_t size);
+    static void* allocate(Shard& shard, std::size_t size);
+    static void rehash(Shard& shard);
+
+    InternPool(const InternPool&);
+    InternPool& operator=(const InternPool&);
+} ;
+
+}
+}
+
+#endif /* AXF_INTERNPOOL_H */
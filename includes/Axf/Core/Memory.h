@@ -28,6 +28,7 @@
 #define SMARTPOINTERS_H
 
 // Include the private API
+#include "./Bits/atomic_strong_ref.h"
 #include "./Bits/scoped_ref.h"
 #include "./Bits/strong_ref.h"
 #include "./Bits/weak_ref.h"
@@ -28,15 +28,22 @@
 #define OBJECT_H
 
 // API
+#include <Axf/Concurrent/LazyStatic.h>
 #include <Axf/Core/Class.h>
+#include <Axf/Core/Hash.h>
 #include <Axf/Core/ReferenceCounted.h>
 #include <Axf/Core/String.h>
 
+// C++
+#include <new>
+
 namespace axf
 {
 namespace core
 {
 
+class ReferenceVisitor;
+
 /**
  * Returns a pointer to the <code>Class</code> object that encapsulates this
  * object's type.
@@ -57,15 +64,25 @@ namespace core
  * opening curly brace. The first argument is the class itself, and the super
  * types goes next in a comma separated list. One must use the macro
  * <code>AXF_TYPE</code> to pass the super types.
+ * <p>
+ * The class object is built on first use, once, even if several threads race
+ * on it, and is never destroyed.
  */
 #define AXF_CLASS_TYPE(_Type, ...) \
     public: \
     \
     static const axf::core::Class<_Type >& getCompileTimeClass() \
     { \
-        static axf::core::Class<_Type > classVariable(#_Type, __VA_ARGS__, NULL); \
+        struct Factory \
+        { \
+            static void* create(void* storage) \
+            { \
+                return new (storage) axf::core::Class<_Type >(#_Type, __VA_ARGS__, NULL); \
+            } \
+        } ; \
+        static axf::concurrent::LazyStatic<axf::core::Class<_Type > > classVariable; \
         \
-        return classVariable; \
+        return classVariable.get(&Factory::create); \
     } \
     \
     private: \
@@ -136,7 +153,13 @@ public:
     }
 
     /**
-     * Returns a unique 32-bit integer identifying this object.
+     * Returns a 32-bit hash code for this object. Objects that are equal
+     * according to <code>equals</code> must return the same hash code.
+     * <p>
+     * The default implementation hashes the identity of the object, matching
+     * the default <code>equals</code>. Classes that compare by value should
+     * override both; <code>AXF_HASH_FIELDS</code> generates this method from
+     * a list of fields.
      * 
      * @return
      */
@@ -152,6 +175,19 @@ public:
      */
     virtual string toString() const;
 
+    /**
+     * Reports the strong references this object holds to other objects, by
+     * passing each of them to <code>visitor.visit</code>. The cycle collector
+     * relies on it to find garbage cycles among objects that called
+     * <code>enableCycleCollection</code>; every strong reference that may
+     * close a cycle must be reported, once per reference held.
+     * <p>
+     * The default implementation reports nothing.
+     *
+     * @param visitor
+     */
+    virtual void traverseReferences(ReferenceVisitor& visitor) const;
+
 private:
 
     /**
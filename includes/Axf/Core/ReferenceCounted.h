@@ -28,8 +28,14 @@
 #define REFERENCECOUNTED_H
 
 // API
+#include <Axf/API/Compiler.h>
+#include <Axf/Concurrent/Atomic.h>
 #include <Axf/Core/Lang-C++/traits.h>
 
+// C++
+#include <cstddef>
+#include <new>
+
 namespace axf
 {
 namespace core
@@ -55,24 +61,44 @@ namespace core
  * a check for strong references is made. If the strong references are null,
  * then the object is destroyed.
  * <p>
- * One could ask why are references implemented as signed integers. Though
- * negative reference counting should <b>not</b> happen, it can actually
- * happen (in multi-threaded applications for example, since reference increase
- * or decrease is not protected by any synchronization mechanism, in order to
- * squeeze performance). The most reliable way to check for these kind of errors
- * is manual probing (done by the smart pointers). Therefore, references are
- * implemented as 32-bit long signed integer numbers, yielding a total of
- * 2147483647 references. This should be enough for most use cases.
+ * Counts are updated atomically, so references to one object may be taken
+ * and dropped from several threads. While an object has strong references,
+ * they collectively hold one extra weak reference, taken by the first strong
+ * reference and dropped after the last one disposed of the object. This keeps
+ * the block alive while a weak reference is being upgraded concurrently with
+ * the final release. Intrusive counts keep their weak references in a
+ * separate block instead, so their weak count names that block; see
+ * <code>ReferenceCounted</code>.
+ * <p>
+ * References are implemented as signed integers. Negative strong counts mark
+ * objects that have been disposed of, so a weak reference can never upgrade
+ * them.
  * <p>
- * In some architectures, long values are 64-bit long, therefore, the number of
- * available references is increased exponentially. 
+ * Counts are <code>long</code> integers, unless the library is built with
+ * <code>AXF_COMPACT_OBJECT_HEADER</code> defined, which makes them 32-bit
+ * integers. Compact counts may overflow, so taking a reference that would
+ * bring a count to <code>REFCOUNT_LIMIT</code> throws an
+ * <code>IllegalStateException</code> instead. The whole library and its
+ * users must be built with the same setting.
  */
+#ifdef AXF_COMPACT_OBJECT_HEADER
+typedef int refcount_value_t;
+#else
+typedef long refcount_value_t;
+#endif
+
 typedef struct refcount
 {
-    volatile long m_strong;  /// The count of strong references
-    volatile long m_weak;    /// The count of weak references
+    volatile refcount_value_t m_strong;  /// The count of strong references
+    volatile refcount_value_t m_weak;    /// The count of weak references
 } refcount_t;
 
+/**
+ * The limit of every count. Intrusive counts of objects biased towards a
+ * thread are offset by twice as much.
+ */
+const refcount_value_t REFCOUNT_LIMIT = ((refcount_value_t) 1 << (sizeof (refcount_value_t) * 8 - 5)) - 1;
+
 /**
  * Initializes a reference count block structure to zero.
  * 
@@ -81,6 +107,289 @@ typedef struct refcount
  */
 refcount_t& init_refcount(refcount_t& rc);
 
+/**
+ * Gives back the references taken from a count that reached
+ * <code>REFCOUNT_LIMIT</code>, and throws an
+ * <code>IllegalStateException</code>.
+ *
+ * @param count
+ * @param taken
+ */
+void refcount_overflow(volatile refcount_value_t& count, refcount_value_t taken);
+
+/**
+ * Adds a weak reference.
+ *
+ * @param rc
+ */
+inline void refcount_grab_weak(refcount_t& rc)
+{
+#ifdef AXF_COMPACT_OBJECT_HEADER
+    if (ARTEMIS_UNLIKELY(concurrent::atomicFetchAdd(&rc.m_weak, 1, concurrent::RELAXED) >= REFCOUNT_LIMIT - 1))
+        refcount_overflow(rc.m_weak, 1);
+#else
+    concurrent::atomicFetchAdd(&rc.m_weak, 1, concurrent::RELAXED);
+#endif
+}
+
+/**
+ * Adds a strong reference, and nothing else.
+ * <p>
+ * A count biased towards a thread is offset by a multiple of
+ * <code>REFCOUNT_LIMIT + 1</code>, so compact counts overflow whenever
+ * their low bits are all set.
+ *
+ * @param rc
+ * @return the count of strong references before this one
+ */
+inline refcount_value_t refcount_add_strong(refcount_t& rc)
+{
+    refcount_value_t previous = concurrent::atomicFetchAdd(&rc.m_strong, 1, concurrent::RELAXED);
+#ifdef AXF_COMPACT_OBJECT_HEADER
+    if (ARTEMIS_UNLIKELY(((previous + 1) & REFCOUNT_LIMIT) == REFCOUNT_LIMIT))
+        refcount_overflow(rc.m_strong, 1);
+#endif
+    return previous;
+}
+
+/**
+ * Adds a strong reference. The first strong reference also takes the weak
+ * reference held on behalf of all strong references.
+ *
+ * @param rc
+ */
+inline void refcount_grab_strong(refcount_t& rc)
+{
+    if (refcount_add_strong(rc) == 0)
+        refcount_grab_weak(rc);
+}
+
+/**
+ * Adds a strong reference only if there is at least one already, that is,
+ * only if the object has not been disposed of.
+ *
+ * @param rc
+ * @return true if a strong reference was added
+ */
+inline bool refcount_try_grab_strong(refcount_t& rc)
+{
+    refcount_value_t strong = concurrent::atomicLoad(&rc.m_strong, concurrent::RELAXED);
+    while (strong > 0)
+    {
+#ifdef AXF_COMPACT_OBJECT_HEADER
+        if (ARTEMIS_UNLIKELY(((strong + 1) & REFCOUNT_LIMIT) == REFCOUNT_LIMIT))
+            refcount_overflow(rc.m_strong, 0);
+#endif
+        if (concurrent::atomicCompareExchange(&rc.m_strong, strong, strong + 1, true,
+                                              concurrent::ACQUIRE, concurrent::RELAXED))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Drops a strong reference.
+ *
+ * @param rc
+ * @return true if it was the last one, and the object must be disposed of
+ */
+inline bool refcount_release_strong(refcount_t& rc)
+{
+    return concurrent::atomicFetchSub(&rc.m_strong, 1, concurrent::ACQ_REL) == 1;
+}
+
+/**
+ * Drops a weak reference.
+ *
+ * @param rc
+ * @return true if it was the last one, including the one held by strong
+ *         references
+ */
+inline bool refcount_release_weak(refcount_t& rc)
+{
+    return concurrent::atomicFetchSub(&rc.m_weak, 1, concurrent::ACQ_REL) == 1;
+}
+
+/**
+ * Returns the count of weak references, without the one held on behalf of
+ * strong references.
+ *
+ * @param rc
+ * @return
+ */
+inline long refcount_weak_users(const refcount_t& rc)
+{
+    refcount_value_t weak = concurrent::atomicLoad(&rc.m_weak, concurrent::RELAXED);
+    return concurrent::atomicLoad(&rc.m_strong, concurrent::RELAXED) > 0 ? weak - 1 : weak;
+}
+
+class CycleCollector;
+class DeferredRelease;
+class ReferenceCounted;
+
+template <typename, typename, typename>
+class weak_ref;
+
+namespace bits
+{
+
+/**
+ * The count of sampled object allocations waiting for their first strong
+ * reference to tell their type to the <code>AllocationProfiler</code>.
+ */
+extern volatile int untypedObjectSamples;
+
+/**
+ * The weak references of an object with intrusive counts.
+ * <p>
+ * A block is allocated the first time an object is weakly referenced, and
+ * outlives the object until its last weak reference is released, so weak
+ * references never touch an object that has been destroyed. While it lives,
+ * the object holds one reference to its block, and names it by index in its
+ * weak count.
+ * <p>
+ * A weak reference upgrades by announcing itself in <code>upgrading</code>,
+ * and only then reading <code>object</code>. Disposing of the object clears
+ * <code>object</code> first, and then waits for the upgrades announced, so an
+ * upgrade either finds no object or is over before the object is destroyed.
+ */
+struct WeakControl
+{
+    const ReferenceCounted* volatile    object;     /// The object, until it is disposed of
+    volatile refcount_value_t           references; /// The weak references, and the one held by the object
+    volatile refcount_value_t           upgrading;  /// The upgrades under way
+    refcount_value_t                    index;      /// This block, as the weak count of its object names it
+    WeakControl*                        nextFree;   /// The next free block, while this one is free
+
+    /**
+     * Adds a weak reference.
+     */
+    inline void grab()
+    {
+#ifdef AXF_COMPACT_OBJECT_HEADER
+        if (ARTEMIS_UNLIKELY(concurrent::atomicFetchAdd(&references, 1, concurrent::RELAXED) >= REFCOUNT_LIMIT - 1))
+            refcount_overflow(references, 1);
+#else
+        concurrent::atomicFetchAdd(&references, 1, concurrent::RELAXED);
+#endif
+    }
+
+    /**
+     * Drops a weak reference. The last one frees this block, and destroys the
+     * object if it was never strongly referenced.
+     */
+    void release();
+
+    /**
+     * Takes a strong reference to the object, unless it has been disposed of.
+     *
+     * @return true if a strong reference was taken
+     */
+    inline bool tryUpgrade();
+
+    /**
+     * Returns true if the object has been disposed of, or has no strong
+     * references.
+     *
+     * @return
+     */
+    bool expired();
+
+    /**
+     * Returns the count of weak references, without the one held by the
+     * object.
+     *
+     * @return
+     */
+    inline long users() const
+    {
+        long weak = concurrent::atomicLoad(&references, concurrent::RELAXED);
+        return concurrent::atomicLoad(&object, concurrent::RELAXED) != NULL ? weak - 1 : weak;
+    }
+
+    /**
+     * Clears the object of this block, unless somebody else did. The thread
+     * that clears it disposes of the object.
+     *
+     * @param owner
+     * @return true if the object was cleared by this call
+     */
+    bool claim(const ReferenceCounted* owner);
+
+    /**
+     * Waits for the upgrades under way to be over, detaches this block from
+     * the object it was claimed from, and drops the reference it held.
+     *
+     * @param owner
+     */
+    void retire(const ReferenceCounted* owner);
+} ;
+
+#ifdef AXF_BIASED_REFERENCES
+
+/**
+ * The bias word of an object: the owner in the low bits, the count of its
+ * local references in the high ones. Standard headers name the owner by the
+ * address of its record; compact headers, by an index of at most 12 bits.
+ */
+#ifdef AXF_COMPACT_OBJECT_HEADER
+typedef unsigned bias_t;
+#else
+typedef unsigned long long bias_t;
+#endif
+
+/**
+ * Hands references to biased objects over to their owners.
+ */
+struct BiasedHandoff;
+
+/**
+ * A thread that owns biased objects. Other threads may hand references over
+ * to an owner even after its thread has finished, so its record is recycled
+ * only once no object is biased towards it anymore, and never freed.
+ */
+struct BiasedOwner
+{
+    const ReferenceCounted* volatile    handoffs;   /// Objects handed over by other threads, linked through themselves
+    volatile int                        finished;   /// Set while no thread owns this record
+    volatile long                       biased;     /// The objects biased towards this owner, plus one while its thread runs
+    BiasedOwner*                        nextFree;   /// The next record to recycle
+    bias_t                              token;      /// The owner, as bias words name it
+} ;
+
+/**
+ * The owner of the calling thread, or <code>NULL</code> if it never biased an
+ * object or has finished.
+ */
+extern ARTEMIS_THREAD_LOCAL BiasedOwner* currentBiasedOwner;
+
+/**
+ * The token of the owner of the calling thread, or zero.
+ */
+extern ARTEMIS_THREAD_LOCAL bias_t currentBiasedToken;
+
+#endif
+
+/**
+ * The bits of the state of an object for the cycle collector: its color, in
+ * the terms of the trial deletion algorithm, some flags, and its index in the
+ * collection under way, if any.
+ */
+enum CycleState
+{
+    CYCLE_BLACK         = 0,    /// In use, or not examined
+    CYCLE_GRAY          = 1,    /// Possible member of a garbage cycle
+    CYCLE_WHITE         = 2,    /// Member of a garbage cycle
+    CYCLE_PURPLE        = 3,    /// Possible root of a garbage cycle
+    CYCLE_COLOR         = 3,
+    CYCLE_BUFFERED      = 4,    /// Recorded as a possible root
+    CYCLE_COLLECTABLE   = 8,    /// Examined by the cycle collector at all
+    CYCLE_TRACED        = 16,   /// Examined by the collection under way
+    CYCLE_INDEX_SHIFT   = 5
+} ;
+
+}
+
 /**
  * Intrusive reference counting for objects and users of the public API.
  * <p>
@@ -93,34 +402,190 @@ refcount_t& init_refcount(refcount_t& rc);
  * and strong. However, holding the actual values is responsibility of the
  * reference counting block structure. However, this class exposes a interface
  * that enforces the existence of at least strong and weak references.
+ * <p>
+ * An object is destroyed when its last strong reference is released, and its
+ * memory goes back through the <code>operator delete</code> of its class.
+ * Unless a class declares its own, objects are allocated by the class level
+ * operators of this class, which report them to the
+ * <code>AllocationProfiler</code>. The type of a sampled object is told by
+ * its first strong reference.
+ * Weak references are counted apart, in a <code>bits::WeakControl</code>
+ * block allocated the first time the object is weakly referenced. The block
+ * outlives the object, so weak references may safely attempt to upgrade
+ * after it is gone. An object that was never strongly referenced belongs to
+ * its weak references, and the last one destroys it.
+ * <p>
+ * Objects that are mostly referenced from one thread may be biased towards it
+ * with <code>biasToCurrentThread</code>, if the library is built with
+ * <code>AXF_BIASED_REFERENCES</code> defined. The owning thread then counts its
+ * references in a local, non atomic counter, while other threads keep using
+ * the atomic strong count, which becomes a shared count that is offset by a
+ * large constant while the object is biased. When the local count drops to
+ * zero the owner merges it into the shared count and the object goes back to
+ * plain atomic counting for good. A thread releasing the last reference the
+ * shared count knows about cannot tell whether the object is still alive, so
+ * it hands the reference over to the owner, by linking the object into a
+ * list of the owner. The owner merges it the next time it releases a
+ * reference or calls <code>mergeBiasedReferences</code>, and always when it
+ * finishes; until then, other threads release their references straight
+ * into the shared count. Owners must be told when their thread finishes, so
+ * Windows builds without C++11 never bias objects.
+ * <p>
+ * Biasing adds a bias word and a link to every object, which is why it is
+ * left out unless asked for; without it, <code>biasToCurrentThread</code>
+ * always returns false. As with compact headers, the library and its users
+ * must be built with the same setting.
+ * <p>
+ * The cycle collector keeps some state in every object too, so it is only
+ * built in with <code>AXF_CYCLE_COLLECTION</code> defined; without it,
+ * <code>enableCycleCollection</code> does nothing. Without either option
+ * the header every object carries is a pointer to its virtual table and the
+ * counts: 24 bytes on 64-bit platforms.
+ * <p>
+ * With <code>AXF_COMPACT_OBJECT_HEADER</code> defined, the counts and the
+ * bias word are 32 bits wide, and the header takes 16 bytes. Bias words then
+ * name owners by index, so at most 4095 threads may own biased objects at a
+ * time.
  *
  * @author J. Marrero
  */
 class ReferenceCounted
 {
+#ifdef AXF_BIASED_REFERENCES
+    friend struct bits::BiasedHandoff;
+#endif
+    friend struct bits::WeakControl;
+    friend class CycleCollector;
+    friend class DeferredRelease;
+
+    template <typename, typename, typename>
+    friend class weak_ref;
+
 public:
 
-    ReferenceCounted() : m_references(init_refcount(m_references)) { }
+    ReferenceCounted()
+    :
+#ifdef AXF_BIASED_REFERENCES
+    m_bias(0),
+    m_handoff(NULL),
+#endif
+#ifdef AXF_CYCLE_COLLECTION
+    m_cycle(0),
+#endif
+    m_references(init_refcount(m_references)) { }
     virtual ~ReferenceCounted();
 
+    /**
+     * Allocates an object from the heap, and reports it to the allocation
+     * profiler.
+     *
+     * @param size
+     * @return
+     * @throws std::bad_alloc if there is no memory left
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Allocates an object from the heap, and reports it to the allocation
+     * profiler.
+     *
+     * @param size
+     * @return the memory, or <code>NULL</code> if there is no memory left
+     */
+    static void* operator new(std::size_t size, const std::nothrow_t&) throw();
+
+    static void* operator new(std::size_t, void* storage) throw()
+    {
+        return storage;
+    }
+
+    /**
+     * Gives the memory of an object back to the heap.
+     *
+     * @param memory
+     */
+    static void operator delete(void* memory);
+
+    static void operator delete(void* memory, const std::nothrow_t&) throw();
+
+    static void operator delete(void*, void*) throw() { }
+
+    /**
+     * Copies of an object are new objects, nobody references them yet.
+     *
+     * @param rhs
+     */
+#ifdef AXF_CYCLE_COLLECTION
+    ReferenceCounted(const ReferenceCounted& rhs)
+    :
+#ifdef AXF_BIASED_REFERENCES
+    m_bias(0),
+    m_handoff(NULL),
+#endif
+    m_cycle(rhs.m_cycle & bits::CYCLE_COLLECTABLE),
+    m_references(init_refcount(m_references)) { }
+#else
+    ReferenceCounted(const ReferenceCounted&)
+    :
+#ifdef AXF_BIASED_REFERENCES
+    m_bias(0),
+    m_handoff(NULL),
+#endif
+    m_references(init_refcount(m_references)) { }
+#endif
+
+    /**
+     * Assignment copies the state of an object, never its references.
+     *
+     * @param rhs
+     * @return
+     */
+    inline ReferenceCounted& operator=(const ReferenceCounted&)
+    {
+        return *this;
+    }
+
     /**
      * Increases the strong reference counting of this object by one.
      */
     inline void grabStrongReference() const
     {
-        m_references.m_strong++;
+#ifdef AXF_BIASED_REFERENCES
+        bits::bias_t bias = concurrent::atomicLoad(&m_bias, concurrent::RELAXED);
+        if (ARTEMIS_UNLIKELY(bias != 0) && isOwnedLocally(bias) && (bias >> BIAS_SHIFT) < BIAS_LOCAL_MAX)
+        {
+            concurrent::atomicStore(&m_bias, bias + BIAS_LOCAL_ONE, concurrent::RELAXED);
+            return;
+        }
+#endif
+        if (refcount_add_strong(m_references) == 0
+            && ARTEMIS_UNLIKELY(concurrent::atomicLoad(&bits::untypedObjectSamples, concurrent::RELAXED) != 0))
+        {
+            typeAllocation();
+        }
     }
 
     /**
-     * Increases the weak reference counting of this object by one.
+     * Increases the strong reference counting of this object by one, unless
+     * it has no strong references left. An object whose last strong
+     * reference has been released is dead, even if it is still weakly
+     * referenced, and cannot be revived.
+     *
+     * @return true if a strong reference was taken
      */
-    inline void grabWeakReference() const
+    inline bool tryGrabStrongReference() const
     {
-        m_references.m_weak++;
+        return refcount_try_grab_strong(m_references);
     }
 
     /**
-     * Returns a constant reference to the reference counting structure.
+     * Increases the weak reference counting of this object by one.
+     */
+    void grabWeakReference() const;
+
+    /**
+     * Returns a constant reference to the reference counting structure. Its
+     * weak count names the block of the weak references of this object.
      * 
      * @return a refcount_t const reference
      */
@@ -136,7 +601,14 @@ public:
      */
     inline long queryStrongReferences() const
     {
-        return m_references.m_strong;
+        long strong = concurrent::atomicLoad(&m_references.m_strong, concurrent::RELAXED);
+#ifdef AXF_BIASED_REFERENCES
+        if (strong >= BIASED_SHARED / 2)
+        {
+            strong += (long) (concurrent::atomicLoad(&m_bias, concurrent::RELAXED) >> BIAS_SHIFT) - BIASED_SHARED;
+        }
+#endif
+        return strong;
     }
 
     /**
@@ -144,24 +616,87 @@ public:
      * 
      * @return a long integer representing the value of the weak reference.
      */
-    inline long queryWeakReferences() const
-    {
-        return m_references.m_weak;
-    }
+    long queryWeakReferences() const;
 
     /**
      * Releases a strong reference of this object. If the strong reference
      * count reaches zero, the object deletes itself.
      */
-    void releaseStrongReference() const;
+    inline void releaseStrongReference() const
+    {
+#ifdef AXF_BIASED_REFERENCES
+        bits::bias_t bias = concurrent::atomicLoad(&m_bias, concurrent::RELAXED);
+        if (ARTEMIS_UNLIKELY(bias != 0) && isOwnedLocally(bias) && (bias >> BIAS_SHIFT) > 1)
+        {
+            concurrent::atomicStore(&m_bias, bias - BIAS_LOCAL_ONE, concurrent::RELAXED);
+            if (ARTEMIS_UNLIKELY(bits::currentBiasedOwner->handoffs != NULL))
+                mergeBiasedReferences();
+            return;
+        }
+#endif
+        releaseSharedReference();
+    }
 
     /**
-     * Releases a weak reference from this object.
+     * Releases a weak reference from this object, which must not have been
+     * destroyed yet. Weak references that may outlive the object release
+     * their block instead.
      */
     void releaseWeakReference() const;
 
+    /**
+     * Biases the reference counts of this object towards the calling thread,
+     * which must hold its only strong reference; typically right after
+     * creating it. From then on, references taken and dropped by this thread
+     * are counted without atomic operations, until they are all gone.
+     *
+     * @return true if the object is now biased, false if it was already
+     *         biased or strongly referenced elsewhere, or if this build or
+     *         thread does not bias objects
+     */
+    bool biasToCurrentThread() const;
+
+    /**
+     * Returns true if the references of this object are biased towards a
+     * thread.
+     *
+     * @return
+     */
+    inline bool isBiased() const
+    {
+#ifdef AXF_BIASED_REFERENCES
+        return concurrent::atomicLoad(&m_references.m_strong, concurrent::RELAXED) >= BIASED_SHARED / 2;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Merges the references that other threads handed over to the calling
+     * thread, releasing the objects nobody references anymore. This happens
+     * anyway whenever the thread releases a reference to an object biased
+     * towards it, and when it finishes; threads that hold on to their
+     * objects for long may call it from time to time.
+     */
+    static void mergeBiasedReferences();
+
 protected:
 
+    /**
+     * Lets the cycle collector examine this object. Classes whose instances
+     * may end up in reference cycles call it from their constructors, and
+     * report their references with <code>Object::traverseReferences</code>.
+     * A release that leaves such an object still referenced records it as a
+     * possible root of a garbage cycle. Unless the library is built with
+     * <code>AXF_CYCLE_COLLECTION</code> defined, this does nothing.
+     */
+    inline void enableCycleCollection()
+    {
+#ifdef AXF_CYCLE_COLLECTION
+        m_cycle = m_cycle | bits::CYCLE_COLLECTABLE;
+#endif
+    }
+
     /**
      * Queries and returns a reference to the "reference counting block" structure
      * that actually holds this object's reference count.
@@ -173,11 +708,125 @@ protected:
         return m_references;
     }
 
+    /**
+     * Returns the block that counts the weak references of this object,
+     * allocating it if the object has none yet.
+     *
+     * @return
+     * @throws OutOfMemoryError if no block can be allocated
+     */
+    bits::WeakControl* queryWeakControl() const;
+
 private:
 
+#ifdef AXF_BIASED_REFERENCES
+#ifdef AXF_COMPACT_OBJECT_HEADER
+    static const unsigned           BIAS_SHIFT = 12;
+#else
+    static const unsigned           BIAS_SHIFT = 48;
+#endif
+    static const bits::bias_t       BIAS_LOCAL_ONE = (bits::bias_t) 1 << BIAS_SHIFT;
+    static const bits::bias_t       BIAS_LOCAL_MAX = ~(bits::bias_t) 0 >> BIAS_SHIFT;
+    static const bits::bias_t       BIAS_OWNER_MASK = BIAS_LOCAL_ONE - 1;
+    static const refcount_value_t   BIASED_SHARED = 2 * (REFCOUNT_LIMIT + 1);
+#endif
+
+#ifdef AXF_BIASED_REFERENCES
+    /**
+     * The owner of a biased object, in the low bits, and its count of local
+     * references, in the high ones. Only the owner writes it while the
+     * object is biased, and it is zero otherwise.
+     */
+    mutable volatile bits::bias_t m_bias;
+
+    /**
+     * The next object handed over to the same owner while this one waits
+     * for it, or this object itself for the last one; <code>NULL</code> if
+     * this object is not waiting.
+     */
+    mutable const ReferenceCounted* volatile m_handoff;
+#endif
+
+#ifdef AXF_CYCLE_COLLECTION
+    /**
+     * The state of this object for the cycle collector, made of
+     * <code>bits::CycleState</code> bits.
+     */
+    mutable volatile unsigned m_cycle;
+#endif
+
     mutable refcount_t m_references;    /// This field is mutable since it may be used with const objects
+
+#ifdef AXF_BIASED_REFERENCES
+    /**
+     * Returns true if the owner in a bias word is the calling thread.
+     *
+     * @param bias
+     * @return
+     */
+    static inline bool isOwnedLocally(bits::bias_t bias)
+    {
+        return (bias & BIAS_OWNER_MASK) == bits::currentBiasedToken;
+    }
+#endif
+
+    /**
+     * Tells the allocation profiler the type of this object, in case its
+     * allocation was sampled.
+     */
+    void typeAllocation() const;
+
+    /**
+     * Releases a reference through the shared count, or the last local one
+     * of the owner.
+     */
+    void releaseSharedReference() const;
+
+
+    /**
+     * Disposes of this object once its last strong reference is gone: weak
+     * references can no longer reach it, and it is destroyed right away
+     * unless the calling thread defers its releases.
+     */
+    void dispose() const;
+
+    /**
+     * Destroys this object now, or later if the calling thread defers its
+     * releases. Weak references must not reach it anymore.
+     */
+    void reclaim() const;
+
+    /**
+     * Destroys this object and frees its memory.
+     */
+    void destroy() const;
 } ;
 
+namespace bits
+{
+
+inline bool WeakControl::tryUpgrade()
+{
+    concurrent::atomicFetchAdd(&upgrading, 1);
+    const ReferenceCounted* owner = concurrent::atomicLoad(&object);
+
+    bool upgraded;
+    try
+    {
+        upgraded = owner != NULL && owner->tryGrabStrongReference();
+    }
+    catch (...)
+    {
+        // Compact counts refuse to overflow
+        concurrent::atomicFetchSub(&upgrading, 1, concurrent::RELEASE);
+        throw;
+    }
+    concurrent::atomicFetchSub(&upgrading, 1, concurrent::RELEASE);
+    return upgraded;
+}
+
+}
+
 /**
  * This type trait allows to determinate whether a determined data type is an instance
  * of ReferenceCounted. This is used in several contexts to determine whether
@@ -31,6 +31,7 @@
 #include <cstddef>
 
 // API
+#include <Axf/Concurrent/Atomic.h>
 #include <Axf/Core/ReferenceCounted.h>
 
 namespace axf
@@ -65,6 +66,10 @@ namespace core
  * <p>
  * This class extends the <code>ReferenceCounted</code> class, so this class
  * is suitable for intrusive reference counting.
+ * <p>
+ * Strings are frequently used as keys, so the hash code is computed lazily
+ * on the first call to <code>hashCode</code> and remembered until the string
+ * is mutated.
  *
  * @author J. Marrero
  */
@@ -83,7 +88,13 @@ public:
     ~string();                      /// This class' destructor is not marked virtual on purpose
 
     string(const char* cstr);       /// Constructs a string via a pointer to a c string
+    string(const char* bytes, size_t size); /// Constructs a string from a sequence of bytes
     string(const wchar_t* wstr);    /// Constructs a string via a wide character array
+    string(const string& rhs);      /// Copy constructor, performs a deep copy of the buffer
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    string(string&& rhs);           /// Move constructor, steals the buffer of rhs
+#endif
 
     /**
      * Appends 'str' to this string. This is a mutator method and the reference
@@ -95,6 +106,21 @@ public:
      */
     string& append(const string& str);
 
+    /**
+     * Replaces the contents of this string with <code>size</code> bytes
+     * starting at <code>bytes</code>, reusing the current buffer if it is
+     * large enough.
+     *
+     * @param bytes
+     * @param size
+     * @return a reference to "this"
+     */
+    inline string& assign(const char* bytes, size_t size)
+    {
+        assign(reinterpret_cast<const utf8_char*> (bytes), size);
+        return *this;
+    }
+
     /**
      * Returns the bytes of this string as a pointer to char.
      * 
@@ -112,6 +138,32 @@ public:
      */
     void clear();
 
+    /**
+     * Returns true if this string holds the same bytes as <code>rhs</code>.
+     *
+     * @param rhs
+     * @return
+     */
+    bool equals(const string& rhs) const;
+
+    /**
+     * Returns the hash code of this string. The hash is computed on the first
+     * call and cached; every mutator discards the cached value. Concurrent
+     * readers may compute it more than once, but always store the same value.
+     *
+     * @return
+     */
+    inline int hashCode() const
+    {
+        int hash = concurrent::atomicLoad(&m_hash, concurrent::RELAXED);
+        if (ARTEMIS_UNLIKELY(hash == 0))
+        {
+            hash = computeHashCode();
+            concurrent::atomicStore(&m_hash, hash, concurrent::RELAXED);
+        }
+        return hash;
+    }
+
     /**
      * Returns the length of this string in characters, not counting the
      * terminating null.
@@ -123,6 +175,17 @@ public:
         return m_length;
     }
 
+    /**
+     * Returns the size of this string in bytes, not counting the terminating
+     * null.
+     *
+     * @return
+     */
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
     /**
      * This class is implicitly usable where a const char pointer is requested.
      * Notice how the buffer is not encoded in the default C locale or any
@@ -135,6 +198,38 @@ public:
         return bytes();
     }
 
+    /**
+     * Copy assignment operator. The contents of <code>rhs</code> are copied
+     * into this string, reusing the current buffer if it is large enough.
+     *
+     * @param rhs
+     * @return a reference to "this"
+     */
+    string& operator=(const string& rhs);
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Move assignment operator. The buffer of this string is released and the
+     * buffer of <code>rhs</code> is taken over; <code>rhs</code> is left
+     * empty.
+     *
+     * @param rhs
+     * @return a reference to "this"
+     */
+    string& operator=(string&& rhs);
+#endif
+
+    inline bool operator==(const string& rhs) const
+    {
+        return equals(rhs);
+    }
+
+    inline bool operator!=(const string& rhs) const
+    {
+        return !equals(rhs);
+    }
+
 private:
 
     typedef unsigned char utf8_char;
@@ -143,6 +238,7 @@ private:
     size_t      m_capacity;     /// The capacity of the buffer
     size_t      m_length;       /// The length in characters of the buffer
     size_t      m_size;         /// The actual size of the string in bytes
+    mutable int m_hash;         /// The cached hash code, zero if not computed
 
     /**
      * Copies the contents of this string's buffer to the newly specified array.
@@ -163,6 +259,16 @@ private:
      */
     utf8_char* arrayCopy(int startIndex, int endIndex, utf8_char* newArray) const;
 
+    /**
+     * Replaces the contents of this string with <code>size</code> bytes
+     * starting at <code>bytes</code>. The buffer is only reallocated if the
+     * current capacity does not suffice.
+     *
+     * @param bytes
+     * @param size
+     */
+    void assign(const utf8_char* bytes, size_t size);
+
     /**
      * Checks that the index is a value between 0 (inclusive) and size (exclusive).
      * If the value is not between 0 and size then an IndexOutOfBoundsException
@@ -172,6 +278,14 @@ private:
      */
     void checkIndexExclusive(int index);
 
+    /**
+     * Hashes the contents of this string. Never returns zero, which marks
+     * the cached hash as not computed.
+     *
+     * @return
+     */
+    int computeHashCode() const;
+
     /**
      * Resizes the string to a new capacity. If the string had content copies
      * the content into the newly allocated buffer. The provided integer is
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   AsyncFile.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:30 AM
+ */
+
+#ifndef AXF_ASYNCFILE_H
+#define AXF_ASYNCFILE_H
+
+// API
+#include <Axf/Core/String.h>
+#include <Axf/IO/ByteBuffer.h>
+
+// C++
+#include <vector>
+
+namespace axf
+{
+namespace io
+{
+
+class AsyncFile;
+class AsyncRequest;
+
+namespace bits
+{
+
+/**
+ * The part of a request seen by the backends. Backends may run on other
+ * threads, so they only touch this structure, never the reference counted
+ * request around it.
+ */
+struct AsyncOperation
+{
+    AsyncOperation*     next;       /// Link of the backend queues
+    AsyncRequest*       request;    /// The request owning this operation
+    int                 descriptor; /// The file descriptor
+    bool                write;      /// True for a write, false for a read
+    unsigned char*      data;       /// The bytes to read into or write from
+    std::size_t         length;     /// The size of the transfer
+    unsigned long long  offset;     /// The offset in the file
+    long                result;     /// Bytes transferred, or minus the error code
+} ;
+
+class AsyncEngine;
+
+}
+
+/**
+ * Called on completion of an asynchronous request, with the context given
+ * when the request was issued.
+ */
+typedef void (*CompletionHandler)(AsyncRequest& request, void* context);
+
+/**
+ * An asynchronous read or write, and the handle to its result.
+ * <p>
+ * Requests are created by <code>AsyncFile</code>. They complete in the
+ * background, but completion is only observed (and handlers only run) on the
+ * thread that owns the file, when it calls <code>poll</code> or
+ * <code>wait</code> on the file or <code>wait</code> on a request.
+ *
+ * @author J. Marrero
+ */
+class AsyncRequest : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::AsyncRequest, AXF_TYPE(axf::core::Object))
+
+    friend class AsyncFile;
+
+public:
+
+    typedef enum Operation
+    {
+        READ,
+        WRITE
+    } Operation;
+
+    virtual ~AsyncRequest();
+
+    /**
+     * Returns the number of bytes transferred. Reads transfer fewer bytes
+     * than requested at the end of the file. Throws
+     * <code>IOException</code> if the request failed.
+     *
+     * @return
+     */
+    std::size_t getBytesTransferred() const;
+
+    /**
+     * Returns the operating system error code of a failed request, or zero.
+     *
+     * @return
+     */
+    inline int getErrorCode() const
+    {
+        return m_operation.result < 0 ? (int) -m_operation.result : 0;
+    }
+
+    inline unsigned long long getOffset() const
+    {
+        return m_operation.offset;
+    }
+
+    inline Operation getOperation() const
+    {
+        return m_operation.write ? WRITE : READ;
+    }
+
+    /**
+     * Returns the bytes read by a read request, as a slice of the buffer
+     * they were read into. Throws <code>IOException</code> if the request
+     * failed.
+     *
+     * @return
+     */
+    ByteSlice getResult() const;
+
+    /**
+     * Returns true once the request has completed, successfully or not.
+     *
+     * @return
+     */
+    inline bool isDone() const
+    {
+        return m_done;
+    }
+
+    /**
+     * Waits for this request to complete, processing the completions of the
+     * file (and running their handlers) in the meantime.
+     */
+    void wait();
+
+private:
+
+    bits::AsyncOperation            m_operation;    /// The transfer, as seen by the backend
+    AsyncFile*                      m_file;         /// The file, while the request is pending
+    core::strong_ref<ByteBuffer>    m_buffer;       /// The buffer of the transfer
+    CompletionHandler               m_handler;      /// The completion handler, or NULL
+    void*                           m_context;      /// The context of the handler
+    bool                            m_done;         /// True once completed
+
+    AsyncRequest(AsyncFile* file, bool write, unsigned long long offset, ByteBuffer* buffer,
+                 unsigned char* data, std::size_t length, CompletionHandler handler, void* context);
+
+    AsyncRequest(const AsyncRequest&);
+    AsyncRequest& operator=(const AsyncRequest&);
+} ;
+
+/**
+ * A file read and written asynchronously.
+ * <p>
+ * Reads and writes are queued and handed to the operating system in batches,
+ * when <code>submit</code> is called, when the file waits for completions, or
+ * as soon as enough requests are queued to fill the depth of the file. The
+ * depth bounds the number of requests in flight; requests issued beyond it
+ * stay queued until earlier ones complete, so issuing never blocks. On Linux
+ * kernels that support it, requests go through an <code>io_uring</code>
+ * instance, so a batch costs a single system call; elsewhere, a pool of
+ * threads carries them out with <code>pread</code> and <code>pwrite</code>.
+ * <p>
+ * The file, its requests and their buffers belong to one thread: completions
+ * are delivered there (by <code>poll</code> and <code>wait</code>), so
+ * handlers may freely use reference counted objects. Destroying the file
+ * waits for every pending request.
+ *
+ * @author J. Marrero
+ */
+class AsyncFile : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::AsyncFile, AXF_TYPE(axf::core::Object))
+
+    friend class AsyncRequest;
+
+public:
+
+    /**
+     * The mechanism carrying out the requests.
+     */
+    typedef enum Backend
+    {
+        AUTOMATIC,      /// io_uring if available, the thread pool otherwise
+        IO_URING,       /// Linux io_uring
+        THREAD_POOL     /// Blocking calls on a pool of threads
+    } Backend;
+
+    typedef enum Mode
+    {
+        READ_ONLY,      /// The file must exist and is only read
+        READ_WRITE      /// The file is created if needed
+    } Mode;
+
+    static const unsigned DEFAULT_QUEUE_DEPTH = 64; /// Default maximum of requests in flight
+
+    /**
+     * Opens a file. Throws <code>IOException</code> if the file can not be
+     * opened, or if the requested backend is not available.
+     *
+     * @param path
+     * @param mode
+     * @param backend
+     * @param queueDepth maximum number of requests in flight
+     */
+    AsyncFile(const char* path, Mode mode = READ_ONLY, Backend backend = AUTOMATIC,
+              unsigned queueDepth = DEFAULT_QUEUE_DEPTH);
+
+    /**
+     * Waits for the pending requests and closes the file.
+     */
+    virtual ~AsyncFile();
+
+    /**
+     * Returns the backend in use.
+     *
+     * @return
+     */
+    inline Backend getBackend() const
+    {
+        return m_backend;
+    }
+
+    /**
+     * Returns the number of requests issued and not completed yet.
+     *
+     * @return
+     */
+    inline std::size_t pending() const
+    {
+        return m_queued.size() + m_inFlight;
+    }
+
+    /**
+     * Delivers the completions that are ready, without waiting.
+     *
+     * @return the number of completed requests
+     */
+    std::size_t poll();
+
+    /**
+     * Queues a read of <code>length</code> bytes at <code>offset</code> into
+     * a new page aligned buffer.
+     *
+     * @param offset
+     * @param length
+     * @param handler called on completion, may be NULL
+     * @param context passed to the handler
+     * @return
+     */
+    core::strong_ref<AsyncRequest> read(unsigned long long offset, std::size_t length,
+                                        CompletionHandler handler = NULL, void* context = NULL);
+
+    /**
+     * Queues a read into an existing buffer, which is kept alive until the
+     * read completes.
+     *
+     * @param offset
+     * @param buffer
+     * @param bufferOffset
+     * @param length
+     * @param handler
+     * @param context
+     * @return
+     */
+    core::strong_ref<AsyncRequest> read(unsigned long long offset, ByteBuffer* buffer, std::size_t bufferOffset,
+                                        std::size_t length, CompletionHandler handler = NULL, void* context = NULL);
+
+    /**
+     * Hands the queued requests to the backend.
+     */
+    void submit();
+
+    /**
+     * Submits the queued requests and waits until at least
+     * <code>minimum</code> requests complete (or none is pending).
+     *
+     * @param minimum
+     * @return the number of completed requests
+     */
+    std::size_t wait(std::size_t minimum = 1);
+
+    /**
+     * Queues a write of the bytes of a slice at <code>offset</code>. The
+     * slice keeps its buffer alive until the write completes.
+     *
+     * @param offset
+     * @param data
+     * @param handler
+     * @param context
+     * @return
+     */
+    core::strong_ref<AsyncRequest> write(unsigned long long offset, const ByteSlice& data,
+                                         CompletionHandler handler = NULL, void* context = NULL);
+
+private:
+
+    core::string                m_path;         /// The path of the file
+    int                         m_descriptor;   /// The file descriptor
+    Backend                     m_backend;      /// The backend in use
+    unsigned                    m_queueDepth;   /// Maximum of requests in flight
+    bits::AsyncEngine*          m_engine;       /// The backend
+    std::vector<bits::AsyncOperation*> m_queued;    /// Requests not submitted yet
+    std::size_t                 m_inFlight;     /// Requests submitted and not delivered
+    std::vector<bits::AsyncOperation*> m_completed; /// Scratch list of completions
+
+    core::strong_ref<AsyncRequest> enqueue(AsyncRequest* request);
+    std::size_t complete();
+
+    AsyncFile(const AsyncFile&);
+    AsyncFile& operator=(const AsyncFile&);
+} ;
+
+}
+}
+
+#endif /* AXF_ASYNCFILE_H */
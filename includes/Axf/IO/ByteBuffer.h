@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   ByteBuffer.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:10 PM
+ */
+
+#ifndef AXF_BYTEBUFFER_H
+#define AXF_BYTEBUFFER_H
+
+// API
+#include <Axf/Core/IndexOutOfBoundsException.h>
+#include <Axf/Core/Memory.h>
+#include <Axf/Core/Object.h>
+
+// C++
+#include <cstddef>
+#include <cstring>
+
+namespace axf
+{
+namespace io
+{
+
+class ByteSlice;
+
+/**
+ * A contiguous block of memory.
+ * <p>
+ * A byte buffer owns its memory, which is either allocated from the heap,
+ * aligned as requested, or provided by a subclass such as
+ * <code>MappedFile</code>. Buffers are reference counted and are shared by
+ * the <code>ByteSlice</code> views taken from them: the memory is released
+ * when the last slice and the last strong reference go away. Hence buffers
+ * must be allocated with <code>new</code> and handed to a
+ * <code>strong_ref</code>.
+ * <p>
+ * Reference counts are atomic, so slices and references to a buffer may be
+ * taken and dropped from several threads. Only the contents of the buffer
+ * need external synchronization when one thread writes what another reads.
+ *
+ * @author J. Marrero
+ */
+class ByteBuffer : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::ByteBuffer, AXF_TYPE(axf::core::Object))
+public:
+
+    static const std::size_t DEFAULT_ALIGNMENT = 64;    /// A cache line
+
+    /**
+     * Allocates a buffer of <code>size</code> bytes from the heap. The
+     * contents are not initialized.
+     *
+     * @param size
+     * @param alignment a power of two
+     */
+    explicit ByteBuffer(std::size_t size, std::size_t alignment = DEFAULT_ALIGNMENT);
+
+    virtual ~ByteBuffer();
+
+    /**
+     * Returns a pointer to the first byte of this buffer.
+     *
+     * @return
+     */
+    inline unsigned char* data()
+    {
+        return m_data;
+    }
+
+    inline const unsigned char* data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Returns the size of this buffer in bytes.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns a slice covering the whole buffer.
+     *
+     * @return
+     */
+    ByteSlice slice();
+
+    /**
+     * Returns a slice of <code>length</code> bytes starting at
+     * <code>offset</code>. The slice shares this buffer; no bytes are copied.
+     *
+     * @param offset
+     * @param length
+     * @return
+     */
+    ByteSlice slice(std::size_t offset, std::size_t length);
+
+protected:
+
+    unsigned char*  m_data;     /// The first byte of the buffer
+    std::size_t     m_size;     /// The size of the buffer in bytes
+
+    /**
+     * Constructs a buffer over memory managed by a subclass. The destructor
+     * of the subclass releases the memory.
+     */
+    ByteBuffer();
+
+private:
+
+    bool m_heap;    /// True if the memory was allocated by this class
+
+    ByteBuffer(const ByteBuffer&);
+    ByteBuffer& operator=(const ByteBuffer&);
+} ;
+
+/**
+ * A read-only view over a range of a <code>ByteBuffer</code>.
+ * <p>
+ * Slices hold a strong reference to their buffer, so the bytes they point to
+ * remain valid as long as the slice does. Taking a slice, copying it or
+ * narrowing it never copies bytes.
+ *
+ * @author J. Marrero
+ */
+class ByteSlice
+{
+public:
+
+    /**
+     * Constructs an empty slice, not backed by any buffer.
+     */
+    ByteSlice() : m_data(NULL), m_size(0) { }
+
+    /**
+     * Constructs a slice over a range of a buffer. The buffer must be owned
+     * by strong references (or by none yet); the slice grabs one.
+     *
+     * @param buffer
+     * @param offset
+     * @param length
+     */
+    ByteSlice(ByteBuffer* buffer, std::size_t offset, std::size_t length)
+    :
+    m_buffer(buffer),
+    m_data(NULL),
+    m_size(length)
+    {
+        checkRange(buffer != NULL ? buffer->size() : 0, offset, length);
+        m_data = buffer != NULL ? buffer->data() + offset : NULL;
+    }
+
+    /**
+     * Returns the byte at <code>index</code>, checking the bounds.
+     *
+     * @param index
+     * @return
+     */
+    inline unsigned char at(std::size_t index) const
+    {
+        if (index >= m_size)
+            throw core::IndexOutOfBoundsException("index past the end of the slice.", (long long) index);
+        return m_data[index];
+    }
+
+    inline const unsigned char* begin() const
+    {
+        return m_data;
+    }
+
+    inline const unsigned char* data() const
+    {
+        return m_data;
+    }
+
+    inline const unsigned char* end() const
+    {
+        return m_data + m_size;
+    }
+
+    /**
+     * Returns true if this slice holds the same bytes as <code>rhs</code>.
+     *
+     * @param rhs
+     * @return
+     */
+    inline bool equals(const ByteSlice& rhs) const
+    {
+        return m_size == rhs.m_size && (m_data == rhs.m_data || std::memcmp(m_data, rhs.m_data, m_size) == 0);
+    }
+
+    /**
+     * Returns the buffer this slice views.
+     *
+     * @return
+     */
+    inline const core::strong_ref<ByteBuffer>& getBuffer() const
+    {
+        return m_buffer;
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Returns a narrower slice, relative to this one.
+     *
+     * @param offset
+     * @param length
+     * @return
+     */
+    inline ByteSlice slice(std::size_t offset, std::size_t length) const
+    {
+        checkRange(m_size, offset, length);
+        return ByteSlice(m_buffer, m_data + offset, length);
+    }
+
+    /**
+     * Returns the byte at <code>index</code>, without checking the bounds.
+     *
+     * @param index
+     * @return
+     */
+    inline unsigned char operator[](std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+private:
+
+    core::strong_ref<ByteBuffer>    m_buffer;   /// The buffer that owns the bytes
+    const unsigned char*            m_data;     /// The first byte of the slice
+    std::size_t                     m_size;     /// The size of the slice
+
+    ByteSlice(const core::strong_ref<ByteBuffer>& buffer, const unsigned char* data, std::size_t size)
+    :
+    m_buffer(buffer),
+    m_data(data),
+    m_size(size)
+    {
+    }
+
+    static inline void checkRange(std::size_t size, std::size_t offset, std::size_t length)
+    {
+        if (offset > size || length > size - offset)
+            throw core::IndexOutOfBoundsException("slice range past the end of the buffer.", (long long) (offset + length));
+    }
+} ;
+
+inline ByteSlice ByteBuffer::slice()
+{
+    return ByteSlice(this, 0, m_size);
+}
+
+inline ByteSlice ByteBuffer::slice(std::size_t offset, std::size_t length)
+{
+    return ByteSlice(this, offset, length);
+}
+
+}
+}
+
+#endif /* AXF_BYTEBUFFER_H */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   FileStream.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:10 AM
+ */
+
+#ifndef AXF_FILESTREAM_H
+#define AXF_FILESTREAM_H
+
+// API
+#include <Axf/Core/String.h>
+#include <Axf/IO/InputStream.h>
+#include <Axf/IO/OutputStream.h>
+
+namespace axf
+{
+namespace io
+{
+
+/**
+ * An input stream reading from a file descriptor.
+ * <p>
+ * The stream either opens the file itself, and closes it when destroyed, or
+ * reads from a descriptor owned by someone else (such as the standard input).
+ *
+ * @author J. Marrero
+ */
+class FileInputStream : public InputStream
+{
+    AXF_CLASS_TYPE(axf::io::FileInputStream, AXF_TYPE(axf::io::InputStream))
+public:
+
+    /**
+     * Opens a file for reading. Throws <code>IOException</code> if the file
+     * can not be opened.
+     *
+     * @param path
+     * @param bufferSize
+     */
+    explicit FileInputStream(const char* path, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Reads from an open file descriptor.
+     *
+     * @param descriptor
+     * @param owned if true, the descriptor is closed with the stream
+     * @param bufferSize
+     */
+    explicit FileInputStream(int descriptor, bool owned = false, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    virtual ~FileInputStream();
+
+    /**
+     * Closes the descriptor, if owned. Reads after closing fail.
+     */
+    void close();
+
+    inline int getDescriptor() const
+    {
+        return m_descriptor;
+    }
+
+protected:
+
+    virtual std::size_t readSome(void* destination, std::size_t capacity);
+
+private:
+
+    int             m_descriptor;   /// The file descriptor
+    bool            m_owned;        /// True if the descriptor is closed with the stream
+    core::string    m_path;         /// The path, for error messages
+} ;
+
+/**
+ * An output stream writing to a file descriptor. Gather writes are carried
+ * out with <code>writev</code>.
+ * <p>
+ * Buffered bytes are flushed when the stream is closed or destroyed; errors
+ * at destruction time can not be reported, so streams whose errors matter
+ * should be closed explicitly.
+ *
+ * @author J. Marrero
+ */
+class FileOutputStream : public OutputStream
+{
+    AXF_CLASS_TYPE(axf::io::FileOutputStream, AXF_TYPE(axf::io::OutputStream))
+public:
+
+    /**
+     * Opens a file for writing, creating it if needed. Throws
+     * <code>IOException</code> if the file can not be opened.
+     *
+     * @param path
+     * @param append if false, the file is truncated
+     * @param bufferSize
+     * @param policy
+     */
+    explicit FileOutputStream(const char* path, bool append = false, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                              FlushPolicy policy = FLUSH_WHEN_FULL);
+
+    /**
+     * Writes to an open file descriptor.
+     *
+     * @param descriptor
+     * @param owned if true, the descriptor is closed with the stream
+     * @param bufferSize
+     * @param policy
+     */
+    explicit FileOutputStream(int descriptor, bool owned = false, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                              FlushPolicy policy = FLUSH_WHEN_FULL);
+
+    virtual ~FileOutputStream();
+
+    /**
+     * Flushes the stream and closes the descriptor, if owned.
+     */
+    void close();
+
+    inline int getDescriptor() const
+    {
+        return m_descriptor;
+    }
+
+protected:
+
+    virtual std::size_t writeSome(const IoVector* vectors, std::size_t count);
+
+private:
+
+    int             m_descriptor;   /// The file descriptor
+    bool            m_owned;        /// True if the descriptor is closed with the stream
+    core::string    m_path;         /// The path, for error messages
+} ;
+
+}
+}
+
+#endif /* AXF_FILESTREAM_H */
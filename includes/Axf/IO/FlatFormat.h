@@ -0,0 +1,744 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   FlatFormat.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#ifndef AXF_FLATFORMAT_H
+#define AXF_FLATFORMAT_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Core/Object.h>
+#include <Axf/Core/String.h>
+#include <Axf/IO/ByteBuffer.h>
+
+// C++
+#include <cstddef>
+#include <cstring>
+
+namespace axf
+{
+namespace io
+{
+
+class FlatBuilder;
+class FlatVerifier;
+
+namespace bits
+{
+
+/**
+ * Computes the alignment of a type without <code>alignof</code>.
+ */
+template <typename T>
+struct FlatAlignment
+{
+
+    struct Probe
+    {
+        char    first;
+        T       second;
+    } ;
+
+    static const std::size_t value = sizeof (Probe) - sizeof (T);
+} ;
+
+/**
+ * True for the scalar types, whose arrays need no verification beyond their
+ * bounds.
+ */
+template <typename T>
+struct FlatScalar
+{
+    static const bool value = false;
+} ;
+
+#define AXF_FLAT_SCALAR(_Type) \
+    template <> \
+    struct FlatScalar<_Type> \
+    { \
+        static const bool value = true; \
+    } ;
+
+AXF_FLAT_SCALAR(bool)
+AXF_FLAT_SCALAR(char)
+AXF_FLAT_SCALAR(signed char)
+AXF_FLAT_SCALAR(unsigned char)
+AXF_FLAT_SCALAR(short)
+AXF_FLAT_SCALAR(unsigned short)
+AXF_FLAT_SCALAR(int)
+AXF_FLAT_SCALAR(unsigned int)
+AXF_FLAT_SCALAR(long)
+AXF_FLAT_SCALAR(unsigned long)
+AXF_FLAT_SCALAR(long long)
+AXF_FLAT_SCALAR(unsigned long long)
+AXF_FLAT_SCALAR(float)
+AXF_FLAT_SCALAR(double)
+
+#undef AXF_FLAT_SCALAR
+
+void throwFlatIndex(std::size_t index, std::size_t size);
+void throwFlatNull(const void* reference);
+
+/**
+ * Resolves a self relative offset. Zero is the null reference.
+ */
+inline const unsigned char* resolveFlatOffset(const void* field, int offset)
+{
+    return offset != 0 ? static_cast<const unsigned char*> (field) + offset : NULL;
+}
+
+/**
+ * Reads the size stored in the four bytes before the target of a string or
+ * array reference.
+ */
+inline std::size_t flatSizeBefore(const unsigned char* target)
+{
+    unsigned size;
+    std::memcpy(&size, target - sizeof (unsigned), sizeof (unsigned));
+    return size;
+}
+
+}
+
+/*
+ * The flat format lays out records, strings and arrays in one block of
+ * memory, with references stored as signed 32 bit offsets from the
+ * reference itself to its target. The block can thus be written to a file,
+ * mapped at any address, and read in place: there is nothing to decode, and
+ * a table is ready as soon as it is mapped.
+ * <p>
+ * Records are plain structures of scalars and of the reference types below,
+ * which double as read only views of their targets. The format uses the byte
+ * order and the scalar sizes of the machine that wrote it; the header records
+ * the byte order and readers reject a foreign one.
+ */
+
+/**
+ * A reference to a string, and a view of it. The string is stored as its
+ * size, its bytes, and a terminating null.
+ *
+ * @author J. Marrero
+ */
+class FlatString
+{
+    friend class FlatBuilder;
+    friend class FlatVerifier;
+
+public:
+
+    /**
+     * Returns the bytes of the string, null terminated, or <code>NULL</code>
+     * for a null reference.
+     *
+     * @return
+     */
+    inline const char* data() const
+    {
+        return reinterpret_cast<const char*> (bits::resolveFlatOffset(this, m_offset));
+    }
+
+    /**
+     * Compares the string with a sequence of bytes.
+     *
+     * @param bytes
+     * @param size
+     * @return
+     */
+    inline bool equals(const char* bytes, std::size_t size) const
+    {
+        return this->size() == size && (size == 0 || std::memcmp(data(), bytes, size) == 0);
+    }
+
+    inline bool equals(const char* cstr) const
+    {
+        return equals(cstr, std::strlen(cstr));
+    }
+
+    inline bool isNull() const
+    {
+        return m_offset == 0;
+    }
+
+    /**
+     * Returns the size of the string in bytes, zero for a null reference.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_offset != 0 ? bits::flatSizeBefore(bits::resolveFlatOffset(this, m_offset)) : 0;
+    }
+
+    /**
+     * Copies the string.
+     *
+     * @return
+     */
+    inline core::string toString() const
+    {
+        return m_offset != 0 ? core::string(data(), size()) : core::string();
+    }
+
+private:
+
+    int m_offset;   /// From this reference to the bytes, zero if null
+} ;
+
+/**
+ * A reference to an array, and a view of it in the manner of
+ * <code>axf::core::Array</code>. Elements may be scalars, records or
+ * references. The array is stored as its length followed by its elements,
+ * which are aligned for their type.
+ *
+ * @author J. Marrero
+ */
+template <typename T>
+class FlatArray
+{
+    friend class FlatBuilder;
+    friend class FlatVerifier;
+
+public:
+
+    typedef T type;
+
+    /**
+     * Returns the i<sup>th</sup> element, raising an
+     * <code>IndexOutOfBoundsException</code> if there is no such element.
+     *
+     * @param index
+     * @return
+     */
+    inline const T& at(std::size_t index) const
+    {
+        std::size_t size = this->size();
+        if (ARTEMIS_UNLIKELY(index >= size))
+            bits::throwFlatIndex(index, size);
+        return data()[index];
+    }
+
+    inline const T* begin() const
+    {
+        return data();
+    }
+
+    /**
+     * Returns the elements, or <code>NULL</code> for a null reference.
+     *
+     * @return
+     */
+    inline const T* data() const
+    {
+        return reinterpret_cast<const T*> (bits::resolveFlatOffset(this, m_offset));
+    }
+
+    inline const T* end() const
+    {
+        return data() + size();
+    }
+
+    inline bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    inline bool isNull() const
+    {
+        return m_offset == 0;
+    }
+
+    /**
+     * Returns the number of elements, zero for a null reference.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return m_offset != 0 ? bits::flatSizeBefore(bits::resolveFlatOffset(this, m_offset)) : 0;
+    }
+
+    inline const T& operator[](std::size_t index) const
+    {
+        return at(index);
+    }
+
+private:
+
+    int m_offset;   /// From this reference to the first element, zero if null
+} ;
+
+/**
+ * A reference to a record.
+ *
+ * @author J. Marrero
+ */
+template <typename T>
+class FlatRef
+{
+    friend class FlatBuilder;
+    friend class FlatVerifier;
+
+public:
+
+    /**
+     * Returns the record, or <code>NULL</code> for a null reference.
+     *
+     * @return
+     */
+    inline const T* get() const
+    {
+        return reinterpret_cast<const T*> (bits::resolveFlatOffset(this, m_offset));
+    }
+
+    inline bool isNull() const
+    {
+        return m_offset == 0;
+    }
+
+    inline const T& operator*() const
+    {
+        if (ARTEMIS_UNLIKELY(m_offset == 0))
+            bits::throwFlatNull(this);
+        return *get();
+    }
+
+    inline const T* operator->() const
+    {
+        return &**this;
+    }
+
+private:
+
+    int m_offset;   /// From this reference to the record, zero if null
+} ;
+
+/**
+ * The header at the start of every flat block.
+ */
+struct FlatHeader
+{
+    char                magic[4];   /// "AXFL"
+    unsigned            version;    /// The version of the format
+    unsigned            byteOrder;  /// 0x01020304, as written by the producer
+    unsigned            reserved;
+    unsigned long long  size;       /// The size of the block, header included
+    unsigned long long  root;       /// The offset of the root record
+} ;
+
+/**
+ * Builds a flat block.
+ * <p>
+ * Blocks are built bottom up: the strings, arrays and records a record
+ * refers to are added before the record itself, and linked into it once it
+ * is added. Adding returns the offset of the new item in the block, and the
+ * <code>add</code> methods of records and arrays also return a pointer to the
+ * new, zeroed, item, for it to be filled. Since the block grows as items are
+ * added, the pointer is only valid until the next item is added;
+ * <code>at</code> returns a fresh one.
+ *
+ * @author J. Marrero
+ */
+class FlatBuilder
+{
+public:
+
+    static const unsigned VERSION = 1;      /// The version of the format written
+
+    /**
+     * Creates a builder.
+     *
+     * @param capacity the initial size of the block
+     */
+    explicit FlatBuilder(std::size_t capacity = 4096);
+
+    ~FlatBuilder();
+
+    /**
+     * Adds an array of <code>count</code> zeroed elements.
+     *
+     * @param count
+     * @param offset receives the offset of the array
+     * @return the elements
+     */
+    template <typename T>
+    T* addArray(std::size_t count, std::size_t& offset)
+    {
+        offset = allocate(count * sizeof (T), bits::FlatAlignment<T>::value, true);
+        unsigned size = (unsigned) count;
+        std::memcpy(m_begin + offset - sizeof (unsigned), &size, sizeof (unsigned));
+        return reinterpret_cast<T*> (m_begin + offset);
+    }
+
+    /**
+     * Adds a zeroed record.
+     *
+     * @param offset receives the offset of the record
+     * @return the record
+     */
+    template <typename T>
+    T* addRecord(std::size_t& offset)
+    {
+        offset = allocate(sizeof (T), bits::FlatAlignment<T>::value, false);
+        return reinterpret_cast<T*> (m_begin + offset);
+    }
+
+    /**
+     * Adds a string.
+     *
+     * @param bytes
+     * @param size
+     * @return the offset of the string
+     */
+    std::size_t addString(const char* bytes, std::size_t size);
+
+    inline std::size_t addString(const char* cstr)
+    {
+        return addString(cstr, std::strlen(cstr));
+    }
+
+    inline std::size_t addString(const core::string& str)
+    {
+        return addString(str.bytes(), str.size());
+    }
+
+    /**
+     * Returns the item at an offset.
+     *
+     * @param offset
+     * @return
+     */
+    template <typename T>
+    inline T* at(std::size_t offset)
+    {
+        return reinterpret_cast<T*> (m_begin + offset);
+    }
+
+    /**
+     * Completes the block, making the record at <code>root</code> its root,
+     * and returns it. The builder may not be used afterwards.
+     *
+     * @param root
+     * @return
+     */
+    ByteSlice finish(std::size_t root);
+
+    /**
+     * Makes a reference point to the item at <code>target</code>. The
+     * reference must be a field of an item of this builder.
+     *
+     * @param reference
+     * @param target
+     */
+    inline void link(FlatString& reference, std::size_t target)
+    {
+        reference.m_offset = relativeOffset(&reference, target);
+    }
+
+    template <typename T>
+    inline void link(FlatArray<T>& reference, std::size_t target)
+    {
+        reference.m_offset = relativeOffset(&reference, target);
+    }
+
+    template <typename T>
+    inline void link(FlatRef<T>& reference, std::size_t target)
+    {
+        reference.m_offset = relativeOffset(&reference, target);
+    }
+
+    /**
+     * Returns the size of the block so far.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return (std::size_t) (m_position - m_begin);
+    }
+
+private:
+
+    core::strong_ref<ByteBuffer>    m_buffer;       /// The block
+    unsigned char*                  m_begin;        /// The start of the block
+    unsigned char*                  m_position;     /// The end of the items
+    unsigned char*                  m_end;          /// The end of the buffer
+
+    std::size_t allocate(std::size_t size, std::size_t alignment, bool sized);
+    int relativeOffset(const void* reference, std::size_t target) const;
+
+    FlatBuilder(const FlatBuilder&);
+    FlatBuilder& operator=(const FlatBuilder&);
+} ;
+
+/**
+ * Checks that the references of a block stay within it, so that a damaged
+ * or hostile file can be read safely. The types reachable from the root must
+ * list their references with <code>AXF_FLAT_REFERENCES</code>, or declare
+ * that they have none with <code>AXF_FLAT_SCALARS</code>.
+ * <p>
+ * Records may be shared, so the walk follows every path through the block,
+ * and a small hostile block can make the number of paths exponential. Every
+ * reference followed and every element of an array of records therefore
+ * spends one unit of a budget equal to the size of the block in bytes. A
+ * block without shared records spends less than its size, since each unit
+ * stands for at least one distinct byte; blocks that run out of budget are
+ * rejected.
+ *
+ * @author J. Marrero
+ */
+class FlatVerifier
+{
+public:
+
+    static const unsigned MAX_DEPTH = 64;   /// Deepest chain of records, which also stops cycles
+
+    FlatVerifier(const unsigned char* begin, std::size_t size);
+
+    void verify(const FlatString& reference);
+
+    template <typename T>
+    void verify(const FlatArray<T>& reference)
+    {
+        if (reference.m_offset == 0)
+            return;
+
+        const unsigned char* target = checkSized(&reference, reference.m_offset, bits::FlatAlignment<T>::value);
+        std::size_t count = bits::flatSizeBefore(target);
+        if (count > (std::size_t) (m_end - target) / sizeof (T))
+            fail("array out of bounds", target);
+
+        if (bits::FlatScalar<T>::value)
+        {
+            spend(1, target);
+            return;
+        }
+
+        enter(target, 1 + count);
+        const T* elements = reinterpret_cast<const T*> (target);
+        for (std::size_t i = 0; i < count; ++i)
+            verifyValue(elements[i]);
+        --m_depth;
+    }
+
+    template <typename T>
+    void verify(const FlatRef<T>& reference)
+    {
+        if (reference.m_offset == 0)
+            return;
+
+        const unsigned char* target = checkTarget(&reference, reference.m_offset, bits::FlatAlignment<T>::value);
+        if (sizeof (T) > (std::size_t) (m_end - target))
+            fail("record out of bounds", target);
+
+        enter(target, 1);
+        reinterpret_cast<const T*> (target)->verifyReferences(*this);
+        --m_depth;
+    }
+
+    template <typename T>
+    inline void verifyValue(const T& value)
+    {
+        value.verifyReferences(*this);
+    }
+
+    inline void verifyValue(const FlatString& value)
+    {
+        verify(value);
+    }
+
+    template <typename T>
+    inline void verifyValue(const FlatArray<T>& value)
+    {
+        verify(value);
+    }
+
+    template <typename T>
+    inline void verifyValue(const FlatRef<T>& value)
+    {
+        verify(value);
+    }
+
+#define AXF_FLAT_SCALAR(_Type) \
+    inline void verifyValue(_Type) { }
+
+    AXF_FLAT_SCALAR(bool)
+    AXF_FLAT_SCALAR(char)
+    AXF_FLAT_SCALAR(signed char)
+    AXF_FLAT_SCALAR(unsigned char)
+    AXF_FLAT_SCALAR(short)
+    AXF_FLAT_SCALAR(unsigned short)
+    AXF_FLAT_SCALAR(int)
+    AXF_FLAT_SCALAR(unsigned int)
+    AXF_FLAT_SCALAR(long)
+    AXF_FLAT_SCALAR(unsigned long)
+    AXF_FLAT_SCALAR(long long)
+    AXF_FLAT_SCALAR(unsigned long long)
+    AXF_FLAT_SCALAR(float)
+    AXF_FLAT_SCALAR(double)
+
+#undef AXF_FLAT_SCALAR
+
+private:
+
+    const unsigned char*    m_begin;    /// The start of the block
+    const unsigned char*    m_end;      /// The end of the block
+    unsigned                m_depth;    /// The current depth
+    std::size_t             m_budget;   /// The visits left before the block is rejected
+
+    inline void spend(std::size_t units, const unsigned char* target)
+    {
+        if (ARTEMIS_UNLIKELY(units > m_budget))
+            fail("references shared too many times", target);
+        m_budget -= units;
+    }
+
+    const unsigned char* checkSized(const void* reference, int offset, std::size_t alignment);
+    const unsigned char* checkTarget(const void* reference, int offset, std::size_t alignment);
+    void enter(const unsigned char* target, std::size_t units);
+    void fail(const char* reason, const void* where) const;
+} ;
+
+namespace bits
+{
+
+/**
+ * Verifies the references listed in <code>AXF_FLAT_REFERENCES</code>.
+ */
+class FlatReferenceChecker
+{
+public:
+
+    explicit FlatReferenceChecker(FlatVerifier& verifier) : m_verifier(verifier) { }
+
+    template <typename T>
+    inline FlatReferenceChecker& operator,(const T& field)
+    {
+        m_verifier.verifyValue(field);
+        return *this;
+    }
+
+private:
+
+    FlatVerifier& m_verifier;
+} ;
+
+}
+
+/**
+ * Lists the fields of a flat record that hold references, or records with
+ * references, for <code>FlatVerifier</code>. Scalar fields need not be
+ * listed.
+ */
+#define AXF_FLAT_REFERENCES(...) \
+    void verifyReferences(axf::io::FlatVerifier& verifier) const \
+    { \
+        (void) (axf::io::bits::FlatReferenceChecker(verifier), __VA_ARGS__); \
+    }
+
+/**
+ * Declares that a flat record holds scalars only.
+ */
+#define AXF_FLAT_SCALARS() \
+    void verifyReferences(axf::io::FlatVerifier&) const { }
+
+/**
+ * Reads a flat block in place, from a mapped file or from memory.
+ * <p>
+ * Opening a block only checks its header: the block is not read, so a
+ * mapped table is ready immediately and its pages are loaded as they are
+ * used. Blocks from untrusted sources should be checked once with
+ * <code>verify</code>, which walks every reference.
+ *
+ * @author J. Marrero
+ */
+class FlatReader : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::FlatReader, AXF_TYPE(axf::core::Object))
+public:
+
+    /**
+     * Maps a file and checks its header. Throws <code>IOException</code> if
+     * the file can not be mapped or is not a valid block.
+     *
+     * @param path
+     */
+    explicit FlatReader(const char* path);
+
+    /**
+     * Reads a block from memory, which must be aligned to eight bytes.
+     *
+     * @param block
+     */
+    explicit FlatReader(const ByteSlice& block);
+
+    virtual ~FlatReader();
+
+    /**
+     * Returns the root record, which must be of type <code>T</code>.
+     *
+     * @return
+     */
+    template <typename T>
+    inline const T& root() const
+    {
+        checkRoot(sizeof (T), bits::FlatAlignment<T>::value);
+        return *reinterpret_cast<const T*> (m_block.data() + m_header->root);
+    }
+
+    /**
+     * Returns the block.
+     *
+     * @return
+     */
+    inline const ByteSlice& getBlock() const
+    {
+        return m_block;
+    }
+
+    /**
+     * Checks every reference reachable from the root, throwing
+     * <code>IOException</code> on the first one out of bounds.
+     */
+    template <typename T>
+    void verify() const
+    {
+        const T& record = root<T>();
+        FlatVerifier verifier(m_block.data(), m_block.size());
+        record.verifyReferences(verifier);
+    }
+
+private:
+
+    ByteSlice           m_block;    /// The block, which keeps its buffer alive
+    const FlatHeader*   m_header;   /// The header of the block
+
+    void checkHeader();
+    void checkRoot(std::size_t size, std::size_t alignment) const;
+} ;
+
+}
+}
+
+#endif /* AXF_FLATFORMAT_H */
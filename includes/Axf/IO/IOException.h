@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   IOException.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:05 PM
+ */
+
+#ifndef AXF_IOEXCEPTION_H
+#define AXF_IOEXCEPTION_H
+
+// API
+#include <Axf/Core/Exception.h>
+
+namespace axf
+{
+namespace io
+{
+
+/**
+ * Signals that an input or output operation failed.
+ * <p>
+ * When the failure comes from the operating system, the exception keeps the
+ * error code reported by it (<code>errno</code> on POSIX systems, the value of
+ * <code>GetLastError</code> on Windows), and the message includes its
+ * description.
+ *
+ * @ref Exception "Exception class"
+ * @author J. Marrero
+ */
+class IOException : public core::Exception
+{
+    AXF_EXCEPTION_TYPE(axf::io::IOException, axf::core::Exception)
+
+public:
+
+    IOException(const char* message, int errorCode = 0);
+
+    /**
+     * Constructs an exception for a failed system call on a file. The
+     * message names the operation and the file, followed by the description
+     * of the error code.
+     *
+     * @param operation
+     * @param path
+     * @param errorCode
+     */
+    IOException(const char* operation, const char* path, int errorCode);
+
+    ~IOException();
+
+    /**
+     * Returns the operating system error code of the failure, or zero if the
+     * failure was not reported by the operating system.
+     *
+     * @return
+     */
+    inline int getErrorCode() const
+    {
+        return m_errorCode;
+    }
+
+private:
+
+    int m_errorCode;    /// The operating system error code
+} ;
+
+}
+}
+
+#endif /* AXF_IOEXCEPTION_H */
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   InputStream.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:30 AM
+ */
+
+#ifndef AXF_INPUTSTREAM_H
+#define AXF_INPUTSTREAM_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/IO/ByteBuffer.h>
+
+namespace axf
+{
+namespace io
+{
+
+/**
+ * A buffered source of bytes.
+ * <p>
+ * Subclasses provide the bytes through <code>readSome</code>; this class
+ * keeps them in a large, page aligned buffer and serves every read from it.
+ * Only refills are virtual: reading a byte, peeking and consuming are inline
+ * operations on the buffer.
+ * <p>
+ * Parsers look at the buffered bytes without copying them through
+ * <code>peek</code>, and advance with <code>consume</code>. Peeked slices
+ * (and lines returned by <code>readLine</code>) share the buffer and stay
+ * valid after later reads: if a slice is still alive when the buffer is
+ * refilled, the stream moves on to a new buffer instead of overwriting it.
+ * Release slices promptly to let the stream reuse its buffer.
+ *
+ * @author J. Marrero
+ */
+class InputStream : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::InputStream, AXF_TYPE(axf::core::Object))
+public:
+
+    static const std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;  /// Default buffer capacity
+    static const std::size_t BUFFER_ALIGNMENT = 4096;          /// Alignment of the buffer
+
+    virtual ~InputStream();
+
+    /**
+     * Returns the number of bytes that can be read without going to the
+     * source.
+     *
+     * @return
+     */
+    inline std::size_t available() const
+    {
+        return m_end - m_position;
+    }
+
+    /**
+     * Skips <code>count</code> bytes, which must have been peeked first.
+     *
+     * @param count
+     */
+    inline void consume(std::size_t count)
+    {
+        if (ARTEMIS_UNLIKELY(count > available()))
+            throw core::IllegalStateException("attempted to consume more bytes than were peeked.");
+        m_position += count;
+    }
+
+    /**
+     * Returns true if every byte of the stream has been read. This may read
+     * from the source to find out.
+     *
+     * @return
+     */
+    inline bool isEndOfStream()
+    {
+        return available() == 0 && fill(1) == 0;
+    }
+
+    /**
+     * Returns a view of the next <code>count</code> bytes, without consuming
+     * them. The view is shorter only if the stream ends first. Peeking more
+     * than the capacity of the buffer grows it.
+     *
+     * @param count
+     * @return
+     */
+    inline ByteSlice peek(std::size_t count)
+    {
+        if (ARTEMIS_UNLIKELY(count > available()))
+            fill(count);
+        return ByteSlice(m_buffer.get(), m_position, count < available() ? count : available());
+    }
+
+    /**
+     * Returns the next byte without consuming it, or -1 at the end of the
+     * stream.
+     *
+     * @return
+     */
+    inline int peekByte()
+    {
+        if (ARTEMIS_UNLIKELY(m_position == m_end) && fill(1) == 0)
+            return -1;
+        return m_data[m_position];
+    }
+
+    /**
+     * Reads up to <code>count</code> bytes into <code>destination</code>.
+     * Reads larger than the buffer go straight from the source to the
+     * destination.
+     *
+     * @param destination
+     * @param count
+     * @return the number of bytes read, less than <code>count</code> only at
+     *         the end of the stream
+     */
+    std::size_t read(void* destination, std::size_t count);
+
+    /**
+     * Reads a byte, returning -1 at the end of the stream.
+     *
+     * @return
+     */
+    inline int readByte()
+    {
+        if (ARTEMIS_UNLIKELY(m_position == m_end) && fill(1) == 0)
+            return -1;
+        return m_data[m_position++];
+    }
+
+    /**
+     * Reads the next line, without its terminating new line. The last line
+     * of the stream need not be terminated. Lines longer than the buffer
+     * grow it.
+     *
+     * @param line receives a view of the line
+     * @return false at the end of the stream
+     */
+    bool readLine(ByteSlice& line);
+
+protected:
+
+    /**
+     * Constructs a stream with a buffer of the given capacity.
+     *
+     * @param bufferSize
+     */
+    explicit InputStream(std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Reads at most <code>capacity</code> bytes from the source. Blocks until
+     * at least one byte is read or the source ends.
+     *
+     * @param destination
+     * @param capacity
+     * @return the number of bytes read, zero at the end of the source
+     */
+    virtual std::size_t readSome(void* destination, std::size_t capacity) = 0;
+
+private:
+
+    core::strong_ref<ByteBuffer>    m_buffer;       /// The buffer
+    unsigned char*                  m_data;         /// The bytes of the buffer
+    std::size_t                     m_position;     /// The next byte to read
+    std::size_t                     m_end;          /// One past the last buffered byte
+    bool                            m_endOfSource;  /// True once the source is exhausted
+
+    /**
+     * Buffers at least <code>required</code> bytes, unless the source ends
+     * first, and returns the number of buffered bytes.
+     *
+     * @param required
+     * @return
+     */
+    std::size_t fill(std::size_t required);
+} ;
+
+}
+}
+
+#endif /* AXF_INPUTSTREAM_H */
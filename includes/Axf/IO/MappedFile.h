@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   MappedFile.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:30 PM
+ */
+
+#ifndef AXF_MAPPEDFILE_H
+#define AXF_MAPPEDFILE_H
+
+// API
+#include <Axf/API/Platform.h>
+#include <Axf/Core/String.h>
+#include <Axf/IO/ByteBuffer.h>
+
+namespace axf
+{
+namespace io
+{
+
+/**
+ * A file mapped into memory.
+ * <p>
+ * The whole file is mapped when the object is constructed, and the mapping is
+ * a <code>ByteBuffer</code>: its bytes are the contents of the file, paged in
+ * on demand by the operating system, and slices of the file reference the
+ * mapping without copying. The file is unmapped when the last reference (or
+ * slice) goes away.
+ * <p>
+ * The expected access pattern can be declared with <code>advise</code>, which
+ * lets the kernel read ahead aggressively for sequential scans, disable read
+ * ahead for random access, or start paging a range in before it is touched.
+ * <p>
+ * If the file is truncated by another process while mapped, touching the
+ * pages past the new end raises <code>SIGBUS</code>; mapped files are meant
+ * for data that is not modified while in use.
+ *
+ * @author J. Marrero
+ */
+class MappedFile : public ByteBuffer
+{
+    AXF_CLASS_TYPE(axf::io::MappedFile, AXF_TYPE(axf::io::ByteBuffer))
+public:
+
+    /**
+     * The access granted to the mapping.
+     */
+    typedef enum Mode
+    {
+        READ_ONLY,      /// The mapping may only be read
+        READ_WRITE      /// Writes to the mapping are carried to the file
+    } Mode;
+
+    /**
+     * Hints about the way the mapping will be accessed.
+     */
+    typedef enum Advice
+    {
+        NORMAL,         /// No particular pattern
+        SEQUENTIAL,     /// Accessed in increasing order, read ahead aggressively
+        RANDOM,         /// Accessed in no particular order, do not read ahead
+        WILL_NEED,      /// Accessed soon, start paging in
+        DONT_NEED       /// Not accessed soon, pages may be dropped
+    } Advice;
+
+    /**
+     * Opens and maps a file. An <code>IOException</code> is thrown if the
+     * file can not be opened or mapped.
+     *
+     * @param path
+     * @param mode
+     * @param advice the initial advice for the whole mapping
+     */
+    MappedFile(const char* path, Mode mode = READ_ONLY, Advice advice = NORMAL);
+
+    /**
+     * Unmaps and closes the file.
+     */
+    virtual ~MappedFile();
+
+    /**
+     * Declares the access pattern of the whole mapping.
+     *
+     * @param advice
+     */
+    inline void advise(Advice advice)
+    {
+        advise(advice, 0, m_size);
+    }
+
+    /**
+     * Declares the access pattern of a range of the mapping. The range is
+     * widened to whole pages. Advice is only a hint; platforms that can not
+     * honor it ignore it.
+     *
+     * @param advice
+     * @param offset
+     * @param length
+     */
+    void advise(Advice advice, std::size_t offset, std::size_t length);
+
+    /**
+     * Returns the access mode of the mapping.
+     *
+     * @return
+     */
+    inline Mode getMode() const
+    {
+        return m_mode;
+    }
+
+    /**
+     * Returns the path of the mapped file.
+     *
+     * @return
+     */
+    inline const core::string& getPath() const
+    {
+        return m_path;
+    }
+
+    /**
+     * Writes the modified pages of a read-write mapping back to the file,
+     * waiting for the writes to complete.
+     */
+    void sync();
+
+private:
+
+    core::string    m_path;     /// The path of the file
+    Mode            m_mode;     /// The access mode
+#ifdef ARTEMIS_PLATFORM_W32
+    void*           m_file;     /// The file handle
+    void*           m_mapping;  /// The file mapping handle
+#else
+    int             m_file;     /// The file descriptor
+#endif
+
+    void close();
+} ;
+
+}
+}
+
+#endif /* AXF_MAPPEDFILE_H */
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   OutputStream.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:50 AM
+ */
+
+#ifndef AXF_OUTPUTSTREAM_H
+#define AXF_OUTPUTSTREAM_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/IO/ByteBuffer.h>
+
+// C++
+#include <cstring>
+
+namespace axf
+{
+namespace io
+{
+
+/**
+ * A piece of a gather write: <code>size</code> bytes at <code>data</code>.
+ */
+typedef struct IoVector
+{
+    const void*     data;
+    std::size_t     size;
+} IoVector;
+
+/**
+ * A buffered sink of bytes.
+ * <p>
+ * Writes are collected in a large, page aligned buffer and handed to the
+ * subclass through <code>writeSome</code> when the buffer fills up, when the
+ * stream is flushed, or as the flush policy dictates. Only those hand-overs
+ * are virtual: writing bytes into the buffer is inline.
+ * <p>
+ * Several slices can be written at once with <code>write(const ByteSlice*,
+ * std::size_t)</code>. Unless they fit in the buffer, the buffered bytes and
+ * the slices are handed over together as a single gather write, so large
+ * payloads are never copied.
+ * <p>
+ * Since the subclass is gone by the time this class is destroyed, subclasses
+ * must flush in their own destructors.
+ *
+ * @author J. Marrero
+ */
+class OutputStream : public core::Object
+{
+    AXF_CLASS_TYPE(axf::io::OutputStream, AXF_TYPE(axf::core::Object))
+public:
+
+    static const std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;  /// Default buffer capacity
+    static const std::size_t BUFFER_ALIGNMENT = 4096;          /// Alignment of the buffer
+
+    /**
+     * When buffered bytes are handed to the sink, besides on explicit calls
+     * to <code>flush</code>.
+     */
+    typedef enum FlushPolicy
+    {
+        FLUSH_WHEN_FULL,    /// Only when the buffer is full
+        FLUSH_ON_NEWLINE,   /// After every write that contains a new line
+        FLUSH_ON_WRITE      /// After every write
+    } FlushPolicy;
+
+    virtual ~OutputStream();
+
+    /**
+     * Returns the number of bytes written but not yet handed to the sink.
+     *
+     * @return
+     */
+    inline std::size_t buffered() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Hands every buffered byte to the sink.
+     */
+    void flush();
+
+    inline FlushPolicy getFlushPolicy() const
+    {
+        return m_policy;
+    }
+
+    inline void setFlushPolicy(FlushPolicy policy)
+    {
+        m_policy = policy;
+    }
+
+    /**
+     * Writes <code>size</code> bytes.
+     *
+     * @param bytes
+     * @param size
+     */
+    inline void write(const void* bytes, std::size_t size)
+    {
+        if (ARTEMIS_LIKELY(size <= m_capacity - m_size))
+        {
+            std::memcpy(m_data + m_size, bytes, size);
+            m_size += size;
+            if (m_policy != FLUSH_WHEN_FULL)
+                applyPolicy(bytes, size);
+        }
+        else
+        {
+            writeSlow(bytes, size);
+        }
+    }
+
+    inline void write(const ByteSlice& slice)
+    {
+        write(slice.data(), slice.size());
+    }
+
+    /**
+     * Writes several slices, in order.
+     *
+     * @param slices
+     * @param count
+     */
+    void write(const ByteSlice* slices, std::size_t count);
+
+    /**
+     * Writes a single byte.
+     *
+     * @param byte
+     */
+    inline void writeByte(unsigned char byte)
+    {
+        if (ARTEMIS_UNLIKELY(m_size == m_capacity))
+            flush();
+        m_data[m_size++] = byte;
+        if (m_policy != FLUSH_WHEN_FULL)
+            applyPolicy(&byte, 1);
+    }
+
+protected:
+
+    /**
+     * Constructs a stream with a buffer of the given capacity.
+     *
+     * @param bufferSize
+     * @param policy
+     */
+    explicit OutputStream(std::size_t bufferSize = DEFAULT_BUFFER_SIZE, FlushPolicy policy = FLUSH_WHEN_FULL);
+
+    /**
+     * Writes the bytes of the vectors, in order, to the sink. Partial writes
+     * are allowed, but at least one byte must be written; failures are
+     * reported by throwing <code>IOException</code>.
+     *
+     * @param vectors
+     * @param count
+     * @return the number of bytes written
+     */
+    virtual std::size_t writeSome(const IoVector* vectors, std::size_t count) = 0;
+
+private:
+
+    static const std::size_t MAX_VECTORS = 64;  /// Vectors per gather write
+
+    core::strong_ref<ByteBuffer>    m_buffer;   /// The buffer
+    unsigned char*                  m_data;     /// The bytes of the buffer
+    std::size_t                     m_capacity; /// The capacity of the buffer
+    std::size_t                     m_size;     /// The buffered bytes
+    FlushPolicy                     m_policy;   /// The flush policy
+
+    void applyPolicy(const void* bytes, std::size_t size);
+    void writeAll(IoVector* vectors, std::size_t count);
+    void writeSlow(const void* bytes, std::size_t size);
+} ;
+
+}
+}
+
+#endif /* AXF_OUTPUTSTREAM_H */
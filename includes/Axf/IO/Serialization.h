@@ -0,0 +1,818 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   Serialization.h
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:30 AM
+ */
+
+#ifndef AXF_SERIALIZATION_H
+#define AXF_SERIALIZATION_H
+
+// API
+#include <Axf/API/Compiler.h>
+#include <Axf/Core/Object.h>
+#include <Axf/Core/String.h>
+#include <Axf/IO/ByteBuffer.h>
+
+// C++
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace axf
+{
+namespace io
+{
+
+class Deserializer;
+class Serializer;
+
+namespace bits
+{
+
+template <typename T>
+struct FieldCodec;
+
+}
+
+/**
+ * A class that may be created while decoding, given the tag written before
+ * an object. Classes are registered with <code>AXF_SERIALIZABLE</code>.
+ * <p>
+ * The tag of a class is the 32 bit FNV-1a hash of the bytes of its name,
+ * which, unlike the type hash, is the same on every platform and in every
+ * build, so it can be stored. Two registered classes whose names have the
+ * same tag could not be told apart when reading, so the second registration
+ * throws an <code>IllegalStateException</code>; since registrations are
+ * static objects, the program then fails during its initialization.
+ * <p>
+ * Registrations are static objects linked into a fixed table on
+ * construction; look-ups take no lock.
+ *
+ * @author J. Marrero
+ */
+class SerializableType
+{
+public:
+
+    typedef core::Object* (*Factory)();
+
+    SerializableType(const core::bits::Type& type, Factory factory);
+
+    /**
+     * Creates an empty instance of the class.
+     *
+     * @return
+     */
+    inline core::Object* create() const
+    {
+        return m_factory();
+    }
+
+    /**
+     * Returns the registered class with the given tag, or <code>NULL</code>.
+     *
+     * @param tag
+     * @return
+     */
+    static const SerializableType* find(unsigned tag);
+
+    /**
+     * Returns the tag written before the objects of a class.
+     *
+     * @param type
+     * @return
+     */
+    static unsigned tagOf(const core::bits::Type& type);
+
+    inline const core::bits::Type& getType() const
+    {
+        return *m_type;
+    }
+
+private:
+
+    const core::bits::Type*     m_type;     /// The class
+    unsigned                    m_tag;      /// The tag of the class
+    Factory                     m_factory;  /// Creates empty instances
+    const SerializableType*     m_next;     /// The next registration in the bucket
+} ;
+
+/**
+ * Encodes values into a compact binary form.
+ * <p>
+ * The encoding is not self describing: values are written one after the
+ * other, and must be read back in the same order and with the same types.
+ * Integers are written as variable length integers (signed ones zig-zag
+ * encoded first, so small negative numbers stay short), floating point
+ * numbers as little endian IEEE 754 values, strings and byte slices as their
+ * size followed by their bytes. Classes describe their fields with
+ * <code>AXF_FIELDS</code>; objects held by <code>strong_ref</code> are
+ * preceded by the tag of their class, so fields may hold subclasses of
+ * their declared type.
+ * <p>
+ * The bytes are written directly into a <code>ByteBuffer</code>, which grows
+ * geometrically when full. <code>data</code> returns them without a copy.
+ *
+ * @author J. Marrero
+ */
+class Serializer
+{
+public:
+
+    /**
+     * Creates a serializer writing into a new buffer.
+     *
+     * @param capacity the initial size of the buffer
+     */
+    explicit Serializer(std::size_t capacity = 256);
+
+    /**
+     * Creates a serializer writing into an existing buffer, from its start.
+     * If the buffer fills up, the serializer moves on to a larger one.
+     *
+     * @param buffer
+     */
+    explicit Serializer(ByteBuffer* buffer);
+
+    ~Serializer();
+
+    /**
+     * Returns the bytes written so far, as a slice of the current buffer.
+     *
+     * @return
+     */
+    ByteSlice data() const;
+
+    /**
+     * Discards the bytes written, keeping the buffer for new ones. Slices
+     * returned by <code>data</code> see their bytes overwritten.
+     */
+    inline void reset()
+    {
+        m_position = m_begin;
+    }
+
+    /**
+     * Returns the number of bytes written.
+     *
+     * @return
+     */
+    inline std::size_t size() const
+    {
+        return (std::size_t) (m_position - m_begin);
+    }
+
+    /**
+     * Encodes a value: an integer, a floating point number, a string, a
+     * vector, a <code>strong_ref</code> or an instance of a class with
+     * <code>AXF_FIELDS</code>.
+     *
+     * @param value
+     * @return
+     */
+    template <typename T>
+    inline Serializer& write(const T& value)
+    {
+        bits::FieldCodec<T>::write(*this, value);
+        return *this;
+    }
+
+    inline void writeByte(unsigned char value)
+    {
+        reserve(1);
+        *m_position++ = value;
+    }
+
+    inline void writeBytes(const void* bytes, std::size_t size)
+    {
+        reserve(size);
+
+        // Empty strings may have no storage at all
+        if (size != 0)
+            std::memcpy(m_position, bytes, size);
+        m_position += size;
+    }
+
+    inline void writeFixed32(unsigned value)
+    {
+        reserve(4);
+        m_position = putFixed32(m_position, value);
+    }
+
+    inline void writeFixed64(unsigned long long value)
+    {
+        reserve(8);
+        m_position = putFixed32(putFixed32(m_position, (unsigned) value), (unsigned) (value >> 32));
+    }
+
+    /**
+     * Writes an object, preceded by the tag of its class, or a null
+     * marker. The class of the object must be registered with
+     * <code>AXF_SERIALIZABLE</code> to be read back.
+     *
+     * @param object
+     */
+    template <typename T>
+    void writeObject(const T* object)
+    {
+        if (object == NULL)
+        {
+            writeByte(0);
+            return;
+        }
+
+        writeByte(1);
+        writeFixed32(SerializableType::tagOf(object->template getClass<core::Object>()));
+        object->writeFields(*this);
+    }
+
+    inline void writeSignedVarint(long long value)
+    {
+        writeVarint(((unsigned long long) value << 1) ^ (unsigned long long) (value >> 63));
+    }
+
+    /**
+     * Writes a size followed by that many bytes.
+     *
+     * @param bytes
+     * @param size
+     */
+    inline void writeString(const void* bytes, std::size_t size)
+    {
+        writeVarint(size);
+        writeBytes(bytes, size);
+    }
+
+    inline void writeVarint(unsigned long long value)
+    {
+        reserve(10);
+
+        // Stores through a local cursor, the member would be reloaded after
+        // every byte since the bytes may alias it
+        unsigned char* position = m_position;
+        while (value >= 0x80)
+        {
+            *position++ = (unsigned char) (value | 0x80);
+            value >>= 7;
+        }
+        *position++ = (unsigned char) value;
+        m_position = position;
+    }
+
+private:
+
+    core::strong_ref<ByteBuffer>    m_buffer;       /// The buffer written into
+    unsigned char*                  m_begin;        /// The start of the buffer
+    unsigned char*                  m_position;     /// The next byte to write
+    unsigned char*                  m_end;          /// The end of the buffer
+
+    inline void reserve(std::size_t size)
+    {
+        if (ARTEMIS_UNLIKELY((std::size_t) (m_end - m_position) < size))
+            grow(size);
+    }
+
+    static inline unsigned char* putFixed32(unsigned char* position, unsigned value)
+    {
+        position[0] = (unsigned char) value;
+        position[1] = (unsigned char) (value >> 8);
+        position[2] = (unsigned char) (value >> 16);
+        position[3] = (unsigned char) (value >> 24);
+        return position + 4;
+    }
+
+    void grow(std::size_t size);
+
+    Serializer(const Serializer&);
+    Serializer& operator=(const Serializer&);
+} ;
+
+/**
+ * Decodes values written by a <code>Serializer</code>.
+ * <p>
+ * Byte slices are decoded without copying: they share the buffer of the
+ * input. Truncated or malformed input raises an <code>IOException</code>.
+ *
+ * @author J. Marrero
+ */
+class Deserializer
+{
+public:
+
+    static const unsigned MAX_DEPTH = 256;  /// Deepest nesting of objects, which bounds the recursion
+
+    explicit Deserializer(const ByteSlice& input);
+
+    ~Deserializer();
+
+    /**
+     * Returns true once every byte of the input was read.
+     *
+     * @return
+     */
+    inline bool isAtEnd() const
+    {
+        return m_position == m_end;
+    }
+
+    /**
+     * Decodes a value into <code>value</code>.
+     *
+     * @param value
+     * @return
+     */
+    template <typename T>
+    inline Deserializer& read(T& value)
+    {
+        bits::FieldCodec<T>::read(*this, value);
+        return *this;
+    }
+
+    inline unsigned char readByte()
+    {
+        require(1);
+        return *m_position++;
+    }
+
+    inline void readBytes(void* destination, std::size_t size)
+    {
+        require(size);
+        std::memcpy(destination, m_position, size);
+        m_position += size;
+    }
+
+    inline unsigned readFixed32()
+    {
+        require(4);
+        unsigned value = (unsigned) m_position[0] | ((unsigned) m_position[1] << 8)
+                | ((unsigned) m_position[2] << 16) | ((unsigned) m_position[3] << 24);
+        m_position += 4;
+        return value;
+    }
+
+    inline unsigned long long readFixed64()
+    {
+        unsigned long long low = readFixed32();
+        return low | ((unsigned long long) readFixed32() << 32);
+    }
+
+    /**
+     * Reads an object written by <code>Serializer::writeObject</code>.
+     * Throws <code>IOException</code> if its class is not registered, or is
+     * not a subclass of <code>T</code>, or if objects are nested more than
+     * <code>MAX_DEPTH</code> levels deep.
+     *
+     * @return
+     */
+    template <typename T>
+    core::strong_ref<T> readObject()
+    {
+        unsigned char marker = readByte();
+        if (marker == 0)
+            return core::strong_ref<T>();
+        if (marker != 1)
+            throwMalformed("invalid object marker");
+
+        const core::Class<T>& expected = T::getCompileTimeClass();
+        const SerializableType* type = SerializableType::find(readFixed32());
+        if (type == NULL || !(type->getType().equals(expected)
+                              || core::reflection::asClassUnsafe<core::Object>(type->getType()).isKindOf(expected)))
+        {
+            throwUnexpectedType(type, expected);
+        }
+
+        core::strong_ref<T> object(static_cast<T*> (type->create()));
+        enter();
+        object->readFields(*this);
+        --m_depth;
+        return object;
+    }
+
+    inline long long readSignedVarint()
+    {
+        unsigned long long value = readVarint();
+        return (long long) (value >> 1) ^ -(long long) (value & 1);
+    }
+
+    /**
+     * Reads <code>size</code> bytes as a slice of the input, without copying.
+     *
+     * @param size
+     * @return
+     */
+    ByteSlice readSlice(std::size_t size);
+
+    /**
+     * Reads the size written by <code>Serializer::writeString</code>, and
+     * checks that that many bytes follow.
+     *
+     * @return
+     */
+    inline std::size_t readStringSize()
+    {
+        unsigned long long size = readVarint();
+        if (ARTEMIS_UNLIKELY(size > (unsigned long long) (m_end - m_position)))
+            throwTruncated();
+        return (std::size_t) size;
+    }
+
+    inline unsigned long long readVarint()
+    {
+        // Away from the end of the input, no byte needs a bounds check
+        const unsigned char* position = m_position;
+        if (ARTEMIS_LIKELY(m_end - position >= 10))
+        {
+            unsigned long long value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                unsigned char byte = *position++;
+                value |= (unsigned long long) (byte & 0x7f) << shift;
+                if (byte < 0x80)
+                {
+                    m_position = position;
+                    return value;
+                }
+            }
+        }
+        return readVarintSlow();
+    }
+
+    /**
+     * Returns the bytes of a string whose size was just read, and skips
+     * them.
+     *
+     * @param size
+     * @return
+     */
+    inline const char* skipString(std::size_t size)
+    {
+        const char* bytes = reinterpret_cast<const char*> (m_position);
+        m_position += size;
+        return bytes;
+    }
+
+    void throwMalformed(const char* reason) const;
+
+private:
+
+    ByteSlice               m_input;        /// The input, kept alive while decoding
+    const unsigned char*    m_position;     /// The next byte to read
+    const unsigned char*    m_end;          /// The end of the input
+    unsigned                m_depth;        /// The nesting of the object being read
+
+    inline void enter()
+    {
+        if (ARTEMIS_UNLIKELY(++m_depth > MAX_DEPTH))
+            throwMalformed("objects nested too deeply");
+    }
+
+    inline void require(std::size_t size)
+    {
+        if (ARTEMIS_UNLIKELY((std::size_t) (m_end - m_position) < size))
+            throwTruncated();
+    }
+
+    unsigned long long readVarintSlow();
+    void throwTruncated() const;
+    void throwUnexpectedType(const SerializableType* type, const core::bits::Type& expected) const;
+
+    Deserializer(const Deserializer&);
+    Deserializer& operator=(const Deserializer&);
+} ;
+
+namespace bits
+{
+
+/**
+ * Encodes and decodes values of a type. The primary template handles
+ * classes with <code>AXF_FIELDS</code>, which are written field by field
+ * without any header; the specializations below handle the other supported
+ * types.
+ */
+template <typename T>
+struct FieldCodec
+{
+    static inline void write(Serializer& serializer, const T& value)
+    {
+        value.writeFields(serializer);
+    }
+
+    static inline void read(Deserializer& deserializer, T& value)
+    {
+        value.readFields(deserializer);
+    }
+} ;
+
+#define AXF_UNSIGNED_FIELD_CODEC(_Type) \
+    template <> \
+    struct FieldCodec<_Type> \
+    { \
+        static inline void write(Serializer& serializer, _Type value) \
+        { \
+            serializer.writeVarint(value); \
+        } \
+        static inline void read(Deserializer& deserializer, _Type& value) \
+        { \
+            unsigned long long decoded = deserializer.readVarint(); \
+            value = (_Type) decoded; \
+            if (ARTEMIS_UNLIKELY((unsigned long long) value != decoded)) \
+                deserializer.throwMalformed("integer out of range"); \
+        } \
+    } ;
+
+#define AXF_SIGNED_FIELD_CODEC(_Type) \
+    template <> \
+    struct FieldCodec<_Type> \
+    { \
+        static inline void write(Serializer& serializer, _Type value) \
+        { \
+            serializer.writeSignedVarint(value); \
+        } \
+        static inline void read(Deserializer& deserializer, _Type& value) \
+        { \
+            long long decoded = deserializer.readSignedVarint(); \
+            value = (_Type) decoded; \
+            if (ARTEMIS_UNLIKELY((long long) value != decoded)) \
+                deserializer.throwMalformed("integer out of range"); \
+        } \
+    } ;
+
+AXF_UNSIGNED_FIELD_CODEC(unsigned short)
+AXF_UNSIGNED_FIELD_CODEC(unsigned int)
+AXF_UNSIGNED_FIELD_CODEC(unsigned long)
+AXF_UNSIGNED_FIELD_CODEC(unsigned long long)
+AXF_SIGNED_FIELD_CODEC(short)
+AXF_SIGNED_FIELD_CODEC(int)
+AXF_SIGNED_FIELD_CODEC(long)
+AXF_SIGNED_FIELD_CODEC(long long)
+
+#undef AXF_UNSIGNED_FIELD_CODEC
+#undef AXF_SIGNED_FIELD_CODEC
+
+/**
+ * Single byte values are written as they are.
+ */
+#define AXF_BYTE_FIELD_CODEC(_Type) \
+    template <> \
+    struct FieldCodec<_Type> \
+    { \
+        static inline void write(Serializer& serializer, _Type value) \
+        { \
+            serializer.writeByte((unsigned char) value); \
+        } \
+        static inline void read(Deserializer& deserializer, _Type& value) \
+        { \
+            value = (_Type) deserializer.readByte(); \
+        } \
+    } ;
+
+AXF_BYTE_FIELD_CODEC(bool)
+AXF_BYTE_FIELD_CODEC(char)
+AXF_BYTE_FIELD_CODEC(signed char)
+AXF_BYTE_FIELD_CODEC(unsigned char)
+
+#undef AXF_BYTE_FIELD_CODEC
+
+template <>
+struct FieldCodec<float>
+{
+    static inline void write(Serializer& serializer, float value)
+    {
+        unsigned bits;
+        std::memcpy(&bits, &value, sizeof (bits));
+        serializer.writeFixed32(bits);
+    }
+
+    static inline void read(Deserializer& deserializer, float& value)
+    {
+        unsigned bits = deserializer.readFixed32();
+        std::memcpy(&value, &bits, sizeof (bits));
+    }
+} ;
+
+template <>
+struct FieldCodec<double>
+{
+    static inline void write(Serializer& serializer, double value)
+    {
+        unsigned long long bits;
+        std::memcpy(&bits, &value, sizeof (bits));
+        serializer.writeFixed64(bits);
+    }
+
+    static inline void read(Deserializer& deserializer, double& value)
+    {
+        unsigned long long bits = deserializer.readFixed64();
+        std::memcpy(&value, &bits, sizeof (bits));
+    }
+} ;
+
+template <>
+struct FieldCodec<core::string>
+{
+    static inline void write(Serializer& serializer, const core::string& value)
+    {
+        serializer.writeString(value.bytes(), value.size());
+    }
+
+    static inline void read(Deserializer& deserializer, core::string& value)
+    {
+        std::size_t size = deserializer.readStringSize();
+        value.assign(deserializer.skipString(size), size);
+    }
+} ;
+
+template <>
+struct FieldCodec<std::string>
+{
+    static inline void write(Serializer& serializer, const std::string& value)
+    {
+        serializer.writeString(value.data(), value.size());
+    }
+
+    static inline void read(Deserializer& deserializer, std::string& value)
+    {
+        std::size_t size = deserializer.readStringSize();
+        value.assign(deserializer.skipString(size), size);
+    }
+} ;
+
+template <>
+struct FieldCodec<ByteSlice>
+{
+    static inline void write(Serializer& serializer, const ByteSlice& value)
+    {
+        serializer.writeString(value.data(), value.size());
+    }
+
+    static inline void read(Deserializer& deserializer, ByteSlice& value)
+    {
+        value = deserializer.readSlice(deserializer.readStringSize());
+    }
+} ;
+
+template <typename T>
+struct FieldCodec<std::vector<T> >
+{
+    static inline void write(Serializer& serializer, const std::vector<T>& value)
+    {
+        serializer.writeVarint(value.size());
+        for (typename std::vector<T>::const_iterator it = value.begin(); it != value.end(); ++it)
+            FieldCodec<T>::write(serializer, *it);
+    }
+
+    static inline void read(Deserializer& deserializer, std::vector<T>& value)
+    {
+        // Every element takes at least a byte, which bounds the size
+        std::size_t size = deserializer.readStringSize();
+        value.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+            FieldCodec<T>::read(deserializer, value[i]);
+    }
+} ;
+
+template <typename T>
+struct FieldCodec<core::strong_ref<T> >
+{
+    static inline void write(Serializer& serializer, const core::strong_ref<T>& value)
+    {
+        serializer.writeObject(value.get());
+    }
+
+    static inline void read(Deserializer& deserializer, core::strong_ref<T>& value)
+    {
+        value = deserializer.readObject<T>();
+    }
+} ;
+
+/**
+ * Writes the fields listed in <code>AXF_FIELDS</code>, through the comma
+ * operator, the same way <code>AXF_HASH_FIELDS</code> hashes them.
+ */
+class FieldWriter
+{
+public:
+
+    explicit FieldWriter(Serializer& serializer) : m_serializer(serializer) { }
+
+    template <typename T>
+    inline FieldWriter& operator,(const T& field)
+    {
+        FieldCodec<T>::write(m_serializer, field);
+        return *this;
+    }
+
+private:
+
+    Serializer& m_serializer;
+} ;
+
+/**
+ * Reads the fields listed in <code>AXF_FIELDS</code>.
+ */
+class FieldReader
+{
+public:
+
+    explicit FieldReader(Deserializer& deserializer) : m_deserializer(deserializer) { }
+
+    template <typename T>
+    inline FieldReader& operator,(T& field)
+    {
+        FieldCodec<T>::read(m_deserializer, field);
+        return *this;
+    }
+
+private:
+
+    Deserializer& m_deserializer;
+} ;
+
+template <typename T>
+core::Object* createInstance()
+{
+    return new T();
+}
+
+}
+
+/**
+ * Lists the fields serialized for a class. It must be placed after
+ * <code>AXF_CLASS_TYPE</code>, and generates the virtual methods
+ * <code>writeFields</code> and <code>readFields</code>, which encode the
+ * fields in the order given. Every field type must be supported by the
+ * <code>Serializer</code>.
+ */
+#define AXF_FIELDS(...) \
+    public: \
+    \
+    virtual void writeFields(axf::io::Serializer& serializer) const \
+    { \
+        (void) (axf::io::bits::FieldWriter(serializer), __VA_ARGS__); \
+    } \
+    \
+    virtual void readFields(axf::io::Deserializer& deserializer) \
+    { \
+        (void) (axf::io::bits::FieldReader(deserializer), __VA_ARGS__); \
+    } \
+    \
+    private:
+
+/**
+ * Same as <code>AXF_FIELDS</code>, for a class whose base class also has
+ * serialized fields. The fields of the base are written first.
+ */
+#define AXF_DERIVED_FIELDS(_Base, ...) \
+    public: \
+    \
+    virtual void writeFields(axf::io::Serializer& serializer) const \
+    { \
+        _Base::writeFields(serializer); \
+        (void) (axf::io::bits::FieldWriter(serializer), __VA_ARGS__); \
+    } \
+    \
+    virtual void readFields(axf::io::Deserializer& deserializer) \
+    { \
+        _Base::readFields(deserializer); \
+        (void) (axf::io::bits::FieldReader(deserializer), __VA_ARGS__); \
+    } \
+    \
+    private:
+
+#define AXF_SERIALIZABLE_CONCAT(_A, _B) _A##_B
+#define AXF_SERIALIZABLE_NAME(_Line) AXF_SERIALIZABLE_CONCAT(axfSerializableType, _Line)
+
+/**
+ * Registers a class, so that objects of the class can be read from
+ * <code>strong_ref</code> fields. Place it at namespace scope in a source
+ * file; the class must be default constructible.
+ */
+#define AXF_SERIALIZABLE(_Type) \
+    static const axf::io::SerializableType AXF_SERIALIZABLE_NAME(__LINE__)( \
+            _Type::getCompileTimeClass(), &axf::io::bits::createInstance<_Type >)
+
+}
+}
+
+#endif /* AXF_SERIALIZATION_H */
@@ -30,6 +30,10 @@
 // API
 #include <Axf/Core/Object.h>
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <utility>
+#endif
+
 namespace axf
 {
 namespace utils
@@ -61,6 +65,36 @@ public:
      */
     Pair(const K& first, const V& second) : m_first(first), m_second(second) { }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Constructs a new pair object, forwarding each argument to the
+     * constructor of the corresponding element. Temporaries are moved into
+     * the pair rather than copied.
+     *
+     * @param first
+     * @param second
+     */
+    template <typename _K, typename _V>
+    Pair(_K&& first, _V&& second) : m_first(std::forward<_K>(first)), m_second(std::forward<_V>(second)) { }
+
+    /**
+     * Copy constructor. The copy is a new object, so reference counts are
+     * not shared with <code>rhs</code>.
+     *
+     * @param rhs
+     */
+    Pair(const Pair<K, V>& rhs) : core::Object(), m_first(rhs.m_first), m_second(rhs.m_second) { }
+
+    /**
+     * Move constructor. The elements of <code>rhs</code> are moved into the
+     * new pair.
+     *
+     * @param rhs
+     */
+    Pair(Pair<K, V>&& rhs) : core::Object(), m_first(std::move(rhs.m_first)), m_second(std::move(rhs.m_second)) { }
+#endif
+
     /**
      * Default destructor
      */
@@ -106,6 +140,35 @@ public:
         return m_second;
     }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+    /**
+     * Copy assignment operator.
+     *
+     * @param rhs
+     * @return
+     */
+    Pair<K, V>& operator=(const Pair<K, V>& rhs)
+    {
+        m_first = rhs.m_first;
+        m_second = rhs.m_second;
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param rhs
+     * @return
+     */
+    Pair<K, V>& operator=(Pair<K, V>&& rhs)
+    {
+        m_first = std::move(rhs.m_first);
+        m_second = std::move(rhs.m_second);
+        return *this;
+    }
+#endif
+
 private:
 
     K   m_first;    /// The first element
@@ -0,0 +1,679 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   AllocationProfiler.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:30 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Collections/AllocationProfiler.h>
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Concurrent/SpinLock.h>
+#include <Axf/Core/Hash.h>
+#include <Axf/Core/InternPool.h>
+#include <Axf/Core/ReferenceCounted.h>
+
+// C++
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#define AXF_PROFILER_EXECINFO
+#include <execinfo.h>
+#endif
+
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+#include <cxxabi.h>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::concurrent;
+
+namespace
+{
+
+/**
+ * A slot of the profile table. A slot is claimed by setting its hash, then
+ * filled, then published by setting <code>ready</code>; it is never freed
+ * while the profile lasts. Threads that find a slot being filled with the
+ * hash they look for move on, so a stack may occasionally take two slots.
+ */
+struct Bucket
+{
+    volatile core::hash_t       hash;
+    volatile int                ready;
+    const std::type_info*       type;
+    int                         depth;
+    void*                       frames[AllocationSample::MAX_DEPTH];
+    volatile long long          samples;
+    volatile long long          sampledBytes;
+    volatile long long          inUseSamples;
+    volatile long long          inUseBytes;
+    volatile long long          estimatedCount;
+    volatile long long          estimatedBytes;
+} ;
+
+/**
+ * A slot of the table of sampled allocations not released yet. A slot is
+ * claimed by setting its address, which goes back to <code>RELEASED</code>
+ * once the memory is released; lookups stop at the first slot never used.
+ */
+struct LiveBlock
+{
+    void* volatile              memory;
+    Bucket* volatile            bucket;
+    volatile std::size_t        bytes;
+} ;
+
+const long long     DISABLED_PERIOD = 1 << 20;  /// Bytes between checks while stopped
+const int           MAX_PROBES = 64;            /// Slots visited before a sample is dropped
+const int           SKIPPED_FRAMES = 1;         /// The frame of the profiler itself
+
+/**
+ * An object allocation sampled before its type could be told, waiting for
+ * its first strong reference. A slot is claimed by setting its address to
+ * <code>BUSY</code> while it is filled or emptied; lookups visit every slot
+ * a claim may have taken.
+ */
+struct PendingObject
+{
+    void* volatile              memory;
+    std::size_t                 bytes;
+    std::size_t                 interval;
+    int                         depth;
+    void*                       frames[AllocationSample::MAX_DEPTH];
+} ;
+
+const std::size_t   PENDING_TABLE_SIZE = 256;   /// Objects waiting for their type
+const int           PENDING_PROBES = 8;         /// Slots a pending object may take
+
+char                releasedMark;
+char                busyMark;
+void* const         RELEASED = &releasedMark;   /// The address of released live blocks
+void* const         BUSY = &busyMark;           /// The address of pending objects being moved
+
+SpinLock            controlLock;
+Bucket*             table = NULL;
+LiveBlock*          liveTable = NULL;
+PendingObject*      pendingTable = NULL;
+volatile int        running = 0;
+volatile int        generation = 0;
+volatile int        inFlight = 0;
+volatile std::size_t samplingInterval = AllocationProfiler::DEFAULT_SAMPLING_INTERVAL;
+volatile long long  droppedSamples = 0;
+
+ARTEMIS_THREAD_LOCAL int                    threadGeneration = 0;
+ARTEMIS_THREAD_LOCAL unsigned long long     threadRandom = 0;
+
+/**
+ * Draws the distance to the next sample from an exponential distribution
+ * whose mean is the sampling interval.
+ */
+long long nextDistance(std::size_t interval)
+{
+    if (threadRandom == 0)
+    {
+        threadRandom = core::hashMix((core::hash_t) (std::size_t) &threadRandom ^ (core::hash_t) std::clock()) | 1;
+    }
+
+    // xorshift64*
+    threadRandom ^= threadRandom >> 12;
+    threadRandom ^= threadRandom << 25;
+    threadRandom ^= threadRandom >> 27;
+    unsigned long long bits = threadRandom * 2685821657736338717ULL;
+
+    double uniform = ((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+    return (long long) (-std::log(uniform) * (double) interval) + 1;
+}
+
+/**
+ * Captures the call stack of the caller, less <code>skip</code> frames.
+ */
+ARTEMIS_NOINLINE int captureStack(void** frames, int skip)
+{
+    void* buffer[AllocationSample::MAX_DEPTH + SKIPPED_FRAMES + 2];
+    int depth = 0;
+#if defined(ARTEMIS_PLATFORM_W32)
+    depth = CaptureStackBackTrace(0, AllocationSample::MAX_DEPTH + skip + 1, buffer, NULL);
+#elif defined(AXF_PROFILER_EXECINFO)
+    depth = backtrace(buffer, AllocationSample::MAX_DEPTH + skip + 1);
+#endif
+
+    // Our own frame goes as well
+    skip++;
+    if (depth <= skip)
+    {
+        return 0;
+    }
+    depth -= skip;
+    if (depth > AllocationSample::MAX_DEPTH)
+    {
+        depth = AllocationSample::MAX_DEPTH;
+    }
+    std::memcpy(frames, buffer + skip, depth * sizeof (void*));
+    return depth;
+}
+
+std::size_t liveSlot(void* memory)
+{
+    return (std::size_t) core::hashMix((core::hash_t) (std::size_t) memory) & (AllocationProfiler::LIVE_TABLE_SIZE - 1);
+}
+
+/**
+ * Tracks a sampled allocation until it is released, unless too many are
+ * tracked already.
+ */
+void track(void* memory, Bucket& bucket, std::size_t bytes, volatile unsigned short* filter)
+{
+    std::size_t index = liveSlot(memory);
+    for (int probe = 0; probe < MAX_PROBES; ++probe, index = (index + 1) & (AllocationProfiler::LIVE_TABLE_SIZE - 1))
+    {
+        LiveBlock& block = liveTable[index];
+        void* found = atomicLoad(&block.memory, RELAXED);
+        if ((found == NULL || found == RELEASED) && atomicCompareExchange(&block.memory, found, memory))
+        {
+            atomicStore(&block.bucket, &bucket, RELAXED);
+            atomicStore(&block.bytes, bytes, RELAXED);
+            atomicFetchAdd(&bucket.inUseSamples, 1LL, RELAXED);
+            atomicFetchAdd(&bucket.inUseBytes, (long long) bytes, RELAXED);
+            atomicFetchAdd(filter, (unsigned short) 1, RELEASE);
+            return;
+        }
+    }
+}
+
+bool sameStack(const Bucket& bucket, const std::type_info& type, void* const* frames, int depth)
+{
+    return bucket.type == &type && bucket.depth == depth &&
+            std::memcmp(bucket.frames, frames, depth * sizeof (void*)) == 0;
+}
+
+void addSample(Bucket& bucket, std::size_t bytes, double scale)
+{
+    atomicFetchAdd(&bucket.samples, 1LL, RELAXED);
+    atomicFetchAdd(&bucket.sampledBytes, (long long) bytes, RELAXED);
+    atomicFetchAdd(&bucket.estimatedCount, (long long) (scale + 0.5), RELAXED);
+    atomicFetchAdd(&bucket.estimatedBytes, (long long) (scale * bytes + 0.5), RELAXED);
+}
+
+/**
+ * Adds a sample to the profile, and tracks its memory until it is released
+ * unless it is <code>NULL</code>. Samples that find no slot are dropped.
+ */
+void addToProfile(void* memory, std::size_t bytes, const std::type_info& type, void* const* frames, int depth,
+                  std::size_t interval, volatile unsigned short* filter)
+{
+    core::hash_t hash = core::hash(frames, depth * sizeof (void*), core::hashValue((unsigned long long) (std::size_t) &type));
+    if (hash == 0)
+    {
+        hash = 1;
+    }
+
+    double scale = 1.0 / (1.0 - std::exp(-(double) bytes / (double) interval));
+    std::size_t index = (std::size_t) hash & (AllocationProfiler::TABLE_SIZE - 1);
+    for (int probe = 0; probe < MAX_PROBES; ++probe, index = (index + 1) & (AllocationProfiler::TABLE_SIZE - 1))
+    {
+        Bucket& bucket = table[index];
+        core::hash_t found = atomicLoad(&bucket.hash, ACQUIRE);
+        if (found == 0)
+        {
+            core::hash_t expected = 0;
+            if (atomicCompareExchange(&bucket.hash, expected, hash))
+            {
+                bucket.type = &type;
+                bucket.depth = depth;
+                std::memcpy(bucket.frames, frames, depth * sizeof (void*));
+                atomicStore(&bucket.ready, 1, RELEASE);
+
+                addSample(bucket, bytes, scale);
+                if (memory != NULL)
+                    track(memory, bucket, bytes, filter);
+                return;
+            }
+            found = expected;
+        }
+
+        if (found == hash && atomicLoad(&bucket.ready, ACQUIRE) && sameStack(bucket, type, frames, depth))
+        {
+            addSample(bucket, bytes, scale);
+            if (memory != NULL)
+                track(memory, bucket, bytes, filter);
+            return;
+        }
+    }
+
+    atomicFetchAdd(&droppedSamples, 1LL, RELAXED);
+}
+
+std::size_t pendingSlot(const void* memory)
+{
+    return (std::size_t) core::hashMix((core::hash_t) (std::size_t) memory) & (PENDING_TABLE_SIZE - 1);
+}
+
+/**
+ * Keeps the sample of an object allocation until its type is told, unless
+ * too many are kept already.
+ */
+bool park(void* memory, std::size_t bytes, std::size_t interval, void* const* frames, int depth,
+          volatile unsigned short* filter)
+{
+    std::size_t index = pendingSlot(memory);
+    for (int probe = 0; probe < PENDING_PROBES; ++probe, index = (index + 1) & (PENDING_TABLE_SIZE - 1))
+    {
+        PendingObject& pending = pendingTable[index];
+        void* expected = NULL;
+        if (atomicLoad(&pending.memory, RELAXED) == NULL && atomicCompareExchange(&pending.memory, expected, BUSY))
+        {
+            pending.bytes = bytes;
+            pending.interval = interval;
+            pending.depth = depth;
+            std::memcpy(pending.frames, frames, depth * sizeof (void*));
+            atomicStore(&pending.memory, memory, RELEASE);
+
+            atomicFetchAdd(filter, (unsigned short) 1, RELEASE);
+            atomicFetchAdd(&core::bits::untypedObjectSamples, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Takes the pending sample of an object allocation, if there is one.
+ */
+bool unpark(const void* memory, PendingObject& result, volatile unsigned short* filter)
+{
+    std::size_t index = pendingSlot(memory);
+    for (int probe = 0; probe < PENDING_PROBES; ++probe, index = (index + 1) & (PENDING_TABLE_SIZE - 1))
+    {
+        PendingObject& pending = pendingTable[index];
+        void* expected = const_cast<void*> (memory);
+        if (atomicLoad(&pending.memory, RELAXED) == memory && atomicCompareExchange(&pending.memory, expected, BUSY))
+        {
+            result.bytes = pending.bytes;
+            result.interval = pending.interval;
+            result.depth = pending.depth;
+            std::memcpy(result.frames, pending.frames, pending.depth * sizeof (void*));
+            atomicStore(&pending.memory, (void*) NULL, RELEASE);
+
+            atomicFetchSub(filter, (unsigned short) 1, RELAXED);
+            atomicFetchSub(&core::bits::untypedObjectSamples, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the readable name of a type, interned so it lives forever.
+ */
+const char* typeNameOf(const std::type_info& type)
+{
+    const char* name = type.name();
+    char* demangled = NULL;
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+    int status = 0;
+    demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+    if (status == 0 && demangled != NULL)
+    {
+        name = demangled;
+    }
+#endif
+
+    const char* interned = core::InternPool::global().intern(name).bytes();
+    std::free(demangled);
+    return interned;
+}
+
+/**
+ * Writes the name of a frame: the demangled function when the platform can
+ * tell it, the address otherwise.
+ */
+void writeFrame(std::FILE* out, void* address, const char* symbol)
+{
+    if (symbol != NULL)
+    {
+        const char* begin = std::strchr(symbol, '(');
+        const char* end = begin != NULL ? std::strpbrk(begin, "+)") : NULL;
+        if (begin != NULL && end != NULL && end > begin + 1)
+        {
+            std::size_t length = end - begin - 1;
+            char* mangled = static_cast<char*> (std::malloc(length + 1));
+            if (mangled != NULL)
+            {
+                std::memcpy(mangled, begin + 1, length);
+                mangled[length] = '\0';
+
+                char* demangled = NULL;
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+                int status = 0;
+                demangled = abi::__cxa_demangle(mangled, NULL, NULL, &status);
+#endif
+                std::fputs(demangled != NULL ? demangled : mangled, out);
+                std::free(demangled);
+                std::free(mangled);
+                return;
+            }
+        }
+    }
+    std::fprintf(out, "%p", address);
+}
+
+}
+
+volatile int axf::core::bits::untypedObjectSamples = 0;
+
+ARTEMIS_THREAD_LOCAL long long AllocationProfiler::bytesUntilSample = 0;
+volatile unsigned short AllocationProfiler::liveFilter[AllocationProfiler::FILTER_SIZE];
+
+bool AllocationProfiler::beginSample(std::size_t& interval)
+{
+    // Announce the sample before looking at the state, so stop can wait for it
+    atomicFetchAdd(&inFlight, 1);
+    if (!atomicLoad(&running))
+    {
+        bytesUntilSample = DISABLED_PERIOD;
+        atomicFetchSub(&inFlight, 1, RELEASE);
+        return false;
+    }
+
+    interval = atomicLoad(&samplingInterval, RELAXED);
+    bytesUntilSample = nextDistance(interval);
+
+    // A thread joining a profile starts its countdown without sampling
+    int current = atomicLoad(&generation, RELAXED);
+    if (threadGeneration != current)
+    {
+        threadGeneration = current;
+        atomicFetchSub(&inFlight, 1, RELEASE);
+        return false;
+    }
+    return true;
+}
+
+void AllocationProfiler::sample(void* memory, std::size_t bytes, const std::type_info& type)
+{
+    std::size_t interval;
+    if (!beginSample(interval))
+    {
+        return;
+    }
+
+    void* frames[AllocationSample::MAX_DEPTH];
+    int depth = captureStack(frames, SKIPPED_FRAMES);
+
+    addToProfile(memory, bytes, type, frames, depth, interval, memory != NULL ? &liveFilter[filterSlot(memory)] : NULL);
+    atomicFetchSub(&inFlight, 1, RELEASE);
+}
+
+void AllocationProfiler::sampleObject(void* memory, std::size_t bytes)
+{
+    std::size_t interval;
+    if (!beginSample(interval))
+    {
+        return;
+    }
+
+    // The operator new of the object goes as well; the stack buffer leaves room for it
+    void* frames[AllocationSample::MAX_DEPTH];
+    int depth = captureStack(frames, SKIPPED_FRAMES + 1);
+
+    if (memory == NULL)
+    {
+        addToProfile(NULL, bytes, typeid (core::ReferenceCounted), frames, depth, interval, NULL);
+    }
+    else if (!park(memory, bytes, interval, frames, depth, &liveFilter[filterSlot(memory)]))
+    {
+        addToProfile(memory, bytes, typeid (core::ReferenceCounted), frames, depth, interval, &liveFilter[filterSlot(memory)]);
+    }
+    atomicFetchSub(&inFlight, 1, RELEASE);
+}
+
+void AllocationProfiler::recordObjectType(const void* memory, const std::type_info& type)
+{
+    atomicFetchAdd(&inFlight, 1);
+    PendingObject pending;
+    if (atomicLoad(&running) && unpark(memory, pending, &liveFilter[filterSlot(memory)]))
+    {
+        addToProfile(const_cast<void*> (memory), pending.bytes, type, pending.frames, pending.depth, pending.interval,
+                     &liveFilter[filterSlot(memory)]);
+    }
+    atomicFetchSub(&inFlight, 1, RELEASE);
+}
+
+void AllocationProfiler::forget(void* memory)
+{
+    // Tables are only cleared while no sample or release is in flight
+    atomicFetchAdd(&inFlight, 1);
+    PendingObject pending;
+    if (memory != NULL && atomicLoad(&core::bits::untypedObjectSamples, RELAXED) != 0 && atomicLoad(&running)
+        && unpark(memory, pending, &liveFilter[filterSlot(memory)]))
+    {
+        // Released before its type was told
+        addToProfile(NULL, pending.bytes, typeid (core::ReferenceCounted), pending.frames, pending.depth,
+                     pending.interval, NULL);
+    }
+    else if (atomicLoad(&running))
+    {
+        std::size_t index = liveSlot(memory);
+        for (int probe = 0; probe < MAX_PROBES; ++probe, index = (index + 1) & (LIVE_TABLE_SIZE - 1))
+        {
+            LiveBlock& block = liveTable[index];
+            void* found = atomicLoad(&block.memory, ACQUIRE);
+            if (found == NULL)
+            {
+                break;
+            }
+            if (found != memory)
+            {
+                continue;
+            }
+
+            // The slot may be reused as soon as it is released
+            Bucket* bucket = atomicLoad(&block.bucket, RELAXED);
+            std::size_t bytes = atomicLoad(&block.bytes, RELAXED);
+            if (atomicCompareExchange(&block.memory, found, RELEASED))
+            {
+                atomicFetchSub(&bucket->inUseSamples, 1LL, RELAXED);
+                atomicFetchSub(&bucket->inUseBytes, (long long) bytes, RELAXED);
+                atomicFetchSub(&liveFilter[filterSlot(memory)], (unsigned short) 1, RELAXED);
+            }
+            break;
+        }
+    }
+    atomicFetchSub(&inFlight, 1, RELEASE);
+}
+
+void AllocationProfiler::start(std::size_t interval)
+{
+    ScopedLock<SpinLock> guard(controlLock);
+    stop();
+
+    if (table == NULL)
+    {
+        table = static_cast<Bucket*> (std::calloc(TABLE_SIZE, sizeof (Bucket)));
+        liveTable = static_cast<LiveBlock*> (std::calloc(LIVE_TABLE_SIZE, sizeof (LiveBlock)));
+        pendingTable = static_cast<PendingObject*> (std::calloc(PENDING_TABLE_SIZE, sizeof (PendingObject)));
+        if (table == NULL || liveTable == NULL || pendingTable == NULL)
+        {
+            std::free(table);
+            std::free(liveTable);
+            std::free(pendingTable);
+            table = NULL;
+            liveTable = NULL;
+            pendingTable = NULL;
+            return;
+        }
+    }
+    else
+    {
+        std::memset(table, 0, TABLE_SIZE * sizeof (Bucket));
+        std::memset(liveTable, 0, LIVE_TABLE_SIZE * sizeof (LiveBlock));
+        std::memset(pendingTable, 0, PENDING_TABLE_SIZE * sizeof (PendingObject));
+    }
+    for (std::size_t i = 0; i < FILTER_SIZE; ++i)
+    {
+        atomicStore(&liveFilter[i], (unsigned short) 0, RELAXED);
+    }
+
+    atomicStore(&droppedSamples, 0LL, RELAXED);
+    atomicStore(&samplingInterval, interval > 0 ? interval : (std::size_t) 1, RELAXED);
+    atomicFetchAdd(&generation, 1, RELAXED);
+    atomicStore(&running, 1);
+
+    // The calling thread joins right away
+    bytesUntilSample = 0;
+}
+
+void AllocationProfiler::stop()
+{
+    atomicStore(&running, 0);
+    while (atomicLoad(&inFlight) != 0)
+    {
+        cpuRelax();
+    }
+
+    // Objects still waiting for their type stay attributed to no one
+    atomicStore(&core::bits::untypedObjectSamples, 0);
+}
+
+bool AllocationProfiler::isRunning()
+{
+    return atomicLoad(&running, RELAXED) != 0;
+}
+
+std::size_t AllocationProfiler::getSamplingInterval()
+{
+    return atomicLoad(&samplingInterval, RELAXED);
+}
+
+long long AllocationProfiler::getDroppedSamples()
+{
+    return atomicLoad(&droppedSamples, RELAXED);
+}
+
+std::vector<AllocationSample> AllocationProfiler::snapshot()
+{
+    std::vector<AllocationSample> result;
+
+    ScopedLock<SpinLock> guard(controlLock);
+    if (table == NULL)
+    {
+        return result;
+    }
+
+    for (std::size_t i = 0; i < TABLE_SIZE; ++i)
+    {
+        const Bucket& bucket = table[i];
+        if (!atomicLoad(&bucket.ready, ACQUIRE))
+        {
+            continue;
+        }
+
+        AllocationSample sample;
+        sample.typeName = typeNameOf(*bucket.type);
+        sample.depth = bucket.depth;
+        std::memcpy(sample.frames, bucket.frames, bucket.depth * sizeof (void*));
+        sample.samples = atomicLoad(&bucket.samples, RELAXED);
+        sample.sampledBytes = atomicLoad(&bucket.sampledBytes, RELAXED);
+        sample.inUseSamples = atomicLoad(&bucket.inUseSamples, RELAXED);
+        sample.inUseBytes = atomicLoad(&bucket.inUseBytes, RELAXED);
+        sample.estimatedCount = atomicLoad(&bucket.estimatedCount, RELAXED);
+        sample.estimatedBytes = atomicLoad(&bucket.estimatedBytes, RELAXED);
+        result.push_back(sample);
+    }
+    return result;
+}
+
+void AllocationProfiler::dumpFolded(std::FILE* out)
+{
+    std::vector<AllocationSample> samples = snapshot();
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const AllocationSample& sample = samples[i];
+
+        char** symbols = NULL;
+#ifdef AXF_PROFILER_EXECINFO
+        symbols = backtrace_symbols(const_cast<void* const*> (sample.frames), sample.depth);
+#endif
+        for (int f = sample.depth - 1; f >= 0; --f)
+        {
+            writeFrame(out, sample.frames[f], symbols != NULL ? symbols[f] : NULL);
+            std::fputc(';', out);
+        }
+        std::fprintf(out, "%s %lld\n", sample.typeName, sample.estimatedBytes);
+        std::free(symbols);
+    }
+}
+
+void AllocationProfiler::dumpHeapProfile(std::FILE* out)
+{
+    std::vector<AllocationSample> samples = snapshot();
+
+    long long inUseCount = 0;
+    long long inUseBytes = 0;
+    long long count = 0;
+    long long bytes = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        inUseCount += samples[i].inUseSamples;
+        inUseBytes += samples[i].inUseBytes;
+        count += samples[i].samples;
+        bytes += samples[i].sampledBytes;
+    }
+
+    // heap_v2 profiles hold the raw samples; pprof scales them itself
+    std::fprintf(out, "heap profile: %lld: %lld [%lld: %lld] @ heap_v2/%lu\n",
+                 inUseCount, inUseBytes, count, bytes, (unsigned long) getSamplingInterval());
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const AllocationSample& sample = samples[i];
+        std::fprintf(out, "%lld: %lld [%lld: %lld] @", sample.inUseSamples, sample.inUseBytes,
+                     sample.samples, sample.sampledBytes);
+        for (int f = 0; f < sample.depth; ++f)
+        {
+            std::fprintf(out, " %p", sample.frames[f]);
+        }
+        std::fputc('\n', out);
+    }
+
+#ifdef __linux__
+    std::FILE* maps = std::fopen("/proc/self/maps", "r");
+    if (maps != NULL)
+    {
+        std::fputs("\nMAPPED_LIBRARIES:\n", out);
+
+        char buffer[4096];
+        std::size_t read;
+        while ((read = std::fread(buffer, 1, sizeof (buffer), maps)) > 0)
+        {
+            std::fwrite(buffer, 1, read, out);
+        }
+        std::fclose(maps);
+    }
+#endif
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   AllocationRegistry.cpp
+ * Author: Javier Marrero
+ * 
+ * Created on October 18, 2026, 4:35 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Collections/AllocationRegistry.h>
+#include <Axf/Concurrent/SpinLock.h>
+
+// C++
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+#include <cxxabi.h>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::concurrent;
+
+namespace
+{
+
+SpinLock        registryLock;
+AllocationSite* registryHead = NULL;
+AllocationSite* registryTail = NULL;
+volatile int    nextShard = 0;
+
+ARTEMIS_THREAD_LOCAL int threadShard = -1;
+
+double monotonicSeconds()
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    return GetTickCount64() / 1000.0;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+bool byLiveBytes(const AllocationSnapshot& a, const AllocationSnapshot& b)
+{
+    return a.liveBytes > b.liveBytes;
+}
+
+/**
+ * Formats a byte count with a binary unit. The buffer must hold at least 32
+ * characters.
+ */
+void formatBytes(char* buffer, long long bytes)
+{
+    static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+
+    double value = (double) bytes;
+    int unit = 0;
+    while ((value >= 1024.0 || value <= -1024.0) && unit < 4)
+    {
+        value /= 1024.0;
+        ++unit;
+    }
+    if (unit == 0)
+    {
+        std::sprintf(buffer, "%lld %s", bytes, units[0]);
+    }
+    else
+    {
+        std::sprintf(buffer, "%.1f %s", value, units[unit]);
+    }
+}
+
+extern "C" void reportLeaks()
+{
+    std::vector<AllocationSnapshot> snapshots = AllocationRegistry::snapshot();
+    for (std::size_t i = 0; i < snapshots.size(); ++i)
+    {
+        const AllocationSnapshot& s = snapshots[i];
+        if (s.liveObjects != 0)
+        {
+            std::fprintf(stderr, "leak: %lld objects (%lld bytes) of type '%s' still allocated at exit\n",
+                         s.liveObjects, s.liveBytes, s.typeName);
+        }
+    }
+}
+
+}
+
+AllocationSite::AllocationSite(const char* typeName)
+:
+m_typeName(NULL),
+m_created(monotonicSeconds()),
+m_sampledPeakBytes(0),
+m_next(NULL)
+{
+    std::memset(m_shards, 0, sizeof (m_shards));
+
+    std::size_t length = std::strlen(typeName);
+    m_typeName = new char[length + 1];
+    std::memcpy(m_typeName, typeName, length + 1);
+}
+
+AllocationSite::~AllocationSite()
+{
+    delete[] m_typeName;
+}
+
+int AllocationSite::shardIndex()
+{
+    if (ARTEMIS_UNLIKELY(threadShard < 0))
+    {
+        threadShard = atomicFetchAdd(&nextShard, 1, RELAXED) % SHARD_COUNT;
+    }
+    return threadShard;
+}
+
+long long AllocationSite::sumLiveBytes() const
+{
+    long long live = 0;
+    for (int i = 0; i < SHARD_COUNT; ++i)
+    {
+        live += atomicLoad(&m_shards[i].liveBytes, RELAXED);
+    }
+    return live;
+}
+
+void AllocationSite::samplePeak()
+{
+    long long live = sumLiveBytes();
+    long long peak = atomicLoad(&m_sampledPeakBytes, RELAXED);
+    while (live > peak && !atomicCompareExchange(&m_sampledPeakBytes, peak, live, true, RELAXED, RELAXED))
+    {
+    }
+}
+
+void AllocationSite::snapshot(AllocationSnapshot& snapshot)
+{
+    samplePeak();
+
+    std::memset(&snapshot, 0, sizeof (snapshot));
+    snapshot.typeName = m_typeName;
+    for (int i = 0; i < SHARD_COUNT; ++i)
+    {
+        const Shard& shard = m_shards[i];
+        snapshot.liveBytes += atomicLoad(&shard.liveBytes, RELAXED);
+        snapshot.liveObjects += atomicLoad(&shard.liveObjects, RELAXED);
+        snapshot.allocations += atomicLoad(&shard.allocations, RELAXED);
+        snapshot.deallocations += atomicLoad(&shard.deallocations, RELAXED);
+        snapshot.allocatedBytes += atomicLoad(&shard.allocatedBytes, RELAXED);
+        for (int b = 0; b < AllocationSnapshot::HISTOGRAM_BUCKETS; ++b)
+        {
+            snapshot.histogram[b] += atomicLoad(&shard.histogram[b], RELAXED);
+        }
+    }
+    snapshot.sampledPeakBytes = std::max(atomicLoad(&m_sampledPeakBytes, RELAXED), snapshot.liveBytes);
+
+    double elapsed = monotonicSeconds() - m_created;
+    snapshot.allocationRate = elapsed > 0 ? snapshot.allocations / elapsed : 0.0;
+}
+
+AllocationSite* AllocationRegistry::getSite(const char* typeName, bool mangled)
+{
+    char* demangled = NULL;
+#ifdef ARTEMIS_COMPILER_GCC_COMPATIBLE
+    if (mangled)
+    {
+        int status = 0;
+        demangled = abi::__cxa_demangle(typeName, NULL, NULL, &status);
+        if (status == 0 && demangled != NULL)
+        {
+            typeName = demangled;
+        }
+    }
+#endif
+
+    AllocationSite* site;
+    {
+        ScopedLock<SpinLock> guard(registryLock);
+        for (site = registryHead; site != NULL; site = site->m_next)
+        {
+            if (std::strcmp(site->m_typeName, typeName) == 0)
+            {
+                break;
+            }
+        }
+
+        if (site == NULL)
+        {
+            site = new AllocationSite(typeName);
+            if (registryTail == NULL)
+            {
+                registryHead = site;
+            }
+            else
+            {
+                atomicStore(&registryTail->m_next, site, RELEASE);
+            }
+            registryTail = site;
+        }
+    }
+
+    std::free(demangled);
+    return site;
+}
+
+std::vector<AllocationSnapshot> AllocationRegistry::snapshot()
+{
+    AllocationSite* head;
+    {
+        ScopedLock<SpinLock> guard(registryLock);
+        head = registryHead;
+    }
+
+    // Sites are never removed and are appended at the tail, so the chain can
+    // be walked without holding the lock
+    std::vector<AllocationSnapshot> snapshots;
+    for (AllocationSite* site = head; site != NULL; site = atomicLoad(&site->m_next, ACQUIRE))
+    {
+        snapshots.push_back(AllocationSnapshot());
+        site->snapshot(snapshots.back());
+    }
+    return snapshots;
+}
+
+void AllocationRegistry::dump(std::FILE* out, bool histograms)
+{
+    std::vector<AllocationSnapshot> snapshots = snapshot();
+    std::sort(snapshots.begin(), snapshots.end(), byLiveBytes);
+
+    std::fprintf(out, "%-48s %12s %12s %12s %14s %14s\n",
+                 "type", "live", "objects", "sampled peak", "allocations", "allocs/s");
+    for (std::size_t i = 0; i < snapshots.size(); ++i)
+    {
+        const AllocationSnapshot& s = snapshots[i];
+
+        char live[32];
+        char peak[32];
+        formatBytes(live, s.liveBytes);
+        formatBytes(peak, s.sampledPeakBytes);
+        std::fprintf(out, "%-48s %12s %12lld %12s %14lld %14.1f\n",
+                     s.typeName, live, s.liveObjects, peak, s.allocations, s.allocationRate);
+
+        if (histograms)
+        {
+            for (int b = 0; b < AllocationSnapshot::HISTOGRAM_BUCKETS; ++b)
+            {
+                if (s.histogram[b] == 0)
+                {
+                    continue;
+                }
+                if (b == AllocationSnapshot::HISTOGRAM_BUCKETS - 1)
+                {
+                    std::fprintf(out, "    > %-10lu %14lld\n", 16UL << (b - 1), s.histogram[b]);
+                }
+                else
+                {
+                    std::fprintf(out, "    <= %-9lu %14lld\n", 16UL << b, s.histogram[b]);
+                }
+            }
+        }
+    }
+}
+
+void AllocationRegistry::reportLeaksAtExit()
+{
+    static volatile int registered = 0;
+    if (atomicExchange(&registered, 1) == 0)
+    {
+        std::atexit(reportLeaks);
+    }
+}
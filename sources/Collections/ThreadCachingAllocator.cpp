@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   ThreadCachingAllocator.cpp
+ * Author: Javier Marrero
+ * 
+ * Created on October 18, 2026, 2:05 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Collections/ThreadCachingAllocator.h>
+#include <Axf/Collections/VirtualRegion.h>
+#include <Axf/Concurrent/SpinLock.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/OutOfMemoryError.h>
+
+// C++
+#include <new>
+
+#if !defined(ARTEMIS_CXX11_SUPPORTED) && !defined(ARTEMIS_PLATFORM_W32)
+#include <pthread.h>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::concurrent;
+
+namespace
+{
+
+const std::size_t CLASS_COUNT = 20;                 /// Number of size classes
+const std::size_t MAX_LOCAL_BLOCKS = 2 * ThreadCache::MAGAZINE_SIZE;
+const std::size_t MAX_DEPOT_MAGAZINES = 64;         /// Per size class
+
+/**
+ * The size of the blocks of each size class. Classes are 16 bytes apart up to
+ * 128 bytes, and then four classes per power of two, which bounds the internal
+ * fragmentation to 25%.
+ */
+const std::size_t classSizes[CLASS_COUNT] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256,
+    320, 384, 448, 512,
+    640, 768, 896, 1024
+};
+
+/**
+ * Maps a request size, in 16 bytes granules, to its size class.
+ */
+const unsigned char classIndex[ThreadCache::MAX_CACHED_SIZE / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 5, 6, 7,
+    8, 8, 9, 9, 10, 10, 11, 11,
+    12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+    16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+    18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19
+};
+
+/**
+ * Free blocks are linked through their first word. The first block of a
+ * magazine held by the depot also links to the next magazine.
+ */
+struct FreeBlock
+{
+    FreeBlock* next;
+    FreeBlock* nextMagazine;
+} ;
+
+struct FreeList
+{
+    FreeBlock*  head;
+    std::size_t count;
+} ;
+
+/**
+ * The per-thread cache. It is plain old data, so it is zero initialized
+ * without any per-thread constructor.
+ */
+struct LocalCache
+{
+    FreeList lists[CLASS_COUNT];
+} ;
+
+/**
+ * A stack of full magazines for one size class, padded to its own cache line
+ * so threads working on different classes do not contend. With a backing
+ * region, it also keeps the slab the blocks of the class are carved from,
+ * and the blocks of the region given back by the caches.
+ */
+struct Depot
+{
+    SpinLock    lock;
+    FreeBlock*  magazines;
+    std::size_t count;
+    FreeBlock*  retained;   /// Blocks of the backing region, which never go back to the system
+    char*       cursor;     /// The next block to carve
+    char*       end;        /// The end of the blocks of the current slab
+    char        padding[64 - sizeof (SpinLock) - 4 * sizeof (FreeBlock*) - sizeof (std::size_t)];
+} ;
+
+Depot depots[CLASS_COUNT];
+
+VirtualRegion* volatile backingRegion = NULL;
+
+typedef enum ThreadState
+{
+    THREAD_UNREGISTERED = 0,
+    THREAD_ACTIVE,
+    THREAD_RETIRED
+} ThreadState;
+
+#if defined(ARTEMIS_CXX11_SUPPORTED) || !defined(ARTEMIS_PLATFORM_W32)
+#define AXF_THREAD_CACHE_ENABLED 1
+
+ARTEMIS_THREAD_LOCAL LocalCache localCache;
+ARTEMIS_THREAD_LOCAL int        threadState;
+
+/**
+ * Returns the cached blocks of the calling thread to the depot and stops
+ * caching for it; blocks released afterwards go straight to the system.
+ */
+void retireThread()
+{
+    ThreadCache::flush();
+    threadState = THREAD_RETIRED;
+}
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+/**
+ * A thread local object whose only purpose is to run
+ * <code>retireThread</code> when the thread exits.
+ */
+struct ThreadReaper
+{
+
+    void arm() { }
+
+    ~ThreadReaper()
+    {
+        retireThread();
+    }
+} ;
+
+void registerThread()
+{
+    static thread_local ThreadReaper reaper;
+    reaper.arm();
+}
+#else
+
+pthread_key_t   reaperKey;
+pthread_once_t  reaperOnce = PTHREAD_ONCE_INIT;
+
+extern "C" void reapThread(void*)
+{
+    retireThread();
+}
+
+extern "C" void createReaperKey()
+{
+    pthread_key_create(&reaperKey, reapThread);
+}
+
+void registerThread()
+{
+    pthread_once(&reaperOnce, createReaperKey);
+    pthread_setspecific(reaperKey, &localCache);
+}
+#endif
+
+/**
+ * Returns the cache of the calling thread, or NULL if the thread is exiting
+ * and its cache has already been retired.
+ */
+inline LocalCache* getLocalCache()
+{
+    if (ARTEMIS_LIKELY(threadState == THREAD_ACTIVE))
+    {
+        return &localCache;
+    }
+    if (threadState == THREAD_RETIRED)
+    {
+        return NULL;
+    }
+
+    threadState = THREAD_ACTIVE;
+    registerThread();
+    return &localCache;
+}
+#else
+
+/* Without C++11 there is no portable way to flush a cache on thread exit
+ * under Windows, so caching is disabled there. */
+inline LocalCache* getLocalCache()
+{
+    return NULL;
+}
+#endif
+
+inline std::size_t sizeClassOf(std::size_t size)
+{
+    return classIndex[(size + 15) >> 4];
+}
+
+/**
+ * Returns a chain of blocks to the system, except the ones carved from the
+ * backing region, which are retained by the depot.
+ */
+void releaseChain(std::size_t sizeClass, FreeBlock* block)
+{
+    VirtualRegion* region = atomicLoad(&backingRegion, ACQUIRE);
+    while (block != NULL)
+    {
+        FreeBlock* next = block->next;
+        if (region != NULL && region->contains(block))
+        {
+            Depot& depot = depots[sizeClass];
+            ScopedLock<SpinLock> guard(depot.lock);
+            block->next = depot.retained;
+            depot.retained = block;
+        }
+        else
+        {
+            ::operator delete(block);
+        }
+        block = next;
+    }
+}
+
+/**
+ * Builds a magazine out of the backing region: the blocks retained first,
+ * then blocks carved from slabs. A magazine may fall short when the region
+ * is exhausted.
+ *
+ * @return the number of blocks of the magazine
+ */
+std::size_t carveMagazine(std::size_t sizeClass, VirtualRegion& region, FreeBlock*& magazine)
+{
+    Depot& depot = depots[sizeClass];
+    ScopedLock<SpinLock> guard(depot.lock);
+
+    std::size_t size = classSizes[sizeClass];
+    std::size_t count = 0;
+    magazine = NULL;
+    while (count < ThreadCache::MAGAZINE_SIZE)
+    {
+        FreeBlock* block = depot.retained;
+        if (block != NULL)
+        {
+            depot.retained = block->next;
+        }
+        else
+        {
+            if (depot.cursor == depot.end)
+            {
+                try
+                {
+                    depot.cursor = static_cast<char*> (region.allocateSlab());
+                }
+                catch (core::OutOfMemoryError&)
+                {
+                    break;
+                }
+                depot.end = depot.cursor + VirtualRegion::SLAB_SIZE / size * size;
+            }
+            block = reinterpret_cast<FreeBlock*> (depot.cursor);
+            depot.cursor += size;
+        }
+        block->next = magazine;
+        magazine = block;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Detaches the first <code>MAGAZINE_SIZE</code> blocks of a free list, which
+ * must hold at least that many blocks.
+ */
+FreeBlock* detachMagazine(FreeList& list)
+{
+    FreeBlock* magazine = list.head;
+    FreeBlock* last = magazine;
+    for (std::size_t i = 1; i < ThreadCache::MAGAZINE_SIZE; ++i)
+    {
+        last = last->next;
+    }
+    list.head = last->next;
+    list.count -= ThreadCache::MAGAZINE_SIZE;
+    last->next = NULL;
+    return magazine;
+}
+
+/**
+ * Hands a full magazine to the depot. If the depot is full, the magazine is
+ * returned to the system instead, bounding the memory retained by the caches.
+ */
+void pushMagazine(std::size_t sizeClass, FreeBlock* magazine)
+{
+    Depot& depot = depots[sizeClass];
+    {
+        ScopedLock<SpinLock> guard(depot.lock);
+        if (depot.count < MAX_DEPOT_MAGAZINES)
+        {
+            magazine->nextMagazine = depot.magazines;
+            atomicStore(&depot.magazines, magazine, RELAXED);
+            depot.count++;
+            return;
+        }
+    }
+    releaseChain(sizeClass, magazine);
+}
+
+FreeBlock* popMagazine(std::size_t sizeClass)
+{
+    Depot& depot = depots[sizeClass];
+    if (atomicLoad(&depot.magazines, RELAXED) == NULL)
+    {
+        return NULL;
+    }
+
+    ScopedLock<SpinLock> guard(depot.lock);
+    FreeBlock* magazine = depot.magazines;
+    if (magazine != NULL)
+    {
+        atomicStore(&depot.magazines, magazine->nextMagazine, RELAXED);
+        depot.count--;
+    }
+    return magazine;
+}
+
+}
+
+void* ThreadCache::allocate(std::size_t size)
+{
+    if (size > MAX_CACHED_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    std::size_t sizeClass = sizeClassOf(size);
+    LocalCache* cache = getLocalCache();
+    if (ARTEMIS_UNLIKELY(cache == NULL))
+    {
+        return ::operator new(classSizes[sizeClass]);
+    }
+
+    FreeList& list = cache->lists[sizeClass];
+    if (ARTEMIS_UNLIKELY(list.head == NULL))
+    {
+        list.head = popMagazine(sizeClass);
+        list.count = MAGAZINE_SIZE;
+        if (list.head == NULL)
+        {
+            VirtualRegion* region = atomicLoad(&backingRegion, ACQUIRE);
+            list.count = region != NULL ? carveMagazine(sizeClass, *region, list.head) : 0;
+            if (list.count == 0)
+            {
+                return ::operator new(classSizes[sizeClass]);
+            }
+        }
+    }
+
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    list.count--;
+    return block;
+}
+
+void ThreadCache::deallocate(void* p, std::size_t size)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+    if (size > MAX_CACHED_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    std::size_t sizeClass = sizeClassOf(size);
+    LocalCache* cache = getLocalCache();
+    if (ARTEMIS_UNLIKELY(cache == NULL))
+    {
+        FreeBlock* block = static_cast<FreeBlock*> (p);
+        block->next = NULL;
+        releaseChain(sizeClass, block);
+        return;
+    }
+
+    FreeList& list = cache->lists[sizeClass];
+    if (ARTEMIS_UNLIKELY(list.count == MAX_LOCAL_BLOCKS))
+    {
+        // Hand the most recently freed magazine to the depot
+        pushMagazine(sizeClass, detachMagazine(list));
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*> (p);
+    block->next = list.head;
+    list.head = block;
+    list.count++;
+}
+
+void ThreadCache::flush()
+{
+#ifdef AXF_THREAD_CACHE_ENABLED
+    if (threadState != THREAD_ACTIVE)
+    {
+        return;
+    }
+
+    for (std::size_t sizeClass = 0; sizeClass < CLASS_COUNT; ++sizeClass)
+    {
+        FreeList& list = localCache.lists[sizeClass];
+        while (list.count >= MAGAZINE_SIZE)
+        {
+            pushMagazine(sizeClass, detachMagazine(list));
+        }
+
+        // Partial magazines are not accepted by the depot
+        releaseChain(sizeClass, list.head);
+        list.head = NULL;
+        list.count = 0;
+    }
+#endif
+}
+
+void ThreadCache::trim()
+{
+#ifdef AXF_THREAD_CACHE_ENABLED
+    if (threadState == THREAD_ACTIVE)
+    {
+        for (std::size_t sizeClass = 0; sizeClass < CLASS_COUNT; ++sizeClass)
+        {
+            FreeList& list = localCache.lists[sizeClass];
+            releaseChain(sizeClass, list.head);
+            list.head = NULL;
+            list.count = 0;
+        }
+    }
+#endif
+
+    for (std::size_t sizeClass = 0; sizeClass < CLASS_COUNT; ++sizeClass)
+    {
+        FreeBlock* magazine;
+        while ((magazine = popMagazine(sizeClass)) != NULL)
+        {
+            releaseChain(sizeClass, magazine);
+        }
+    }
+}
+
+void ThreadCache::setBackingRegion(VirtualRegion& region)
+{
+    VirtualRegion* expected = NULL;
+    if (!atomicCompareExchange(&backingRegion, expected, &region) && expected != &region)
+    {
+        throw core::IllegalStateException("the thread caches are backed by another region already.");
+    }
+}
+
+VirtualRegion* ThreadCache::getBackingRegion()
+{
+    return atomicLoad(&backingRegion, ACQUIRE);
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   VirtualRegion.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:45 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Collections/VirtualRegion.h>
+#include <Axf/Core/OutOfMemoryError.h>
+
+// C++
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#if !defined(ARTEMIS_PLATFORM_W32) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::concurrent;
+
+namespace
+{
+
+/**
+ * Reserves a range of addresses without backing it with memory.
+ */
+void* reserveRange(std::size_t size)
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* address = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return address != MAP_FAILED ? address : NULL;
+#endif
+}
+
+void releaseRange(void* address, std::size_t size)
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, size);
+#endif
+}
+
+bool commitRange(void* address, std::size_t size)
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+    return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+/**
+ * Gives the memory behind a range back to the system. On POSIX systems the
+ * range stays accessible, and reads as zeros until it is written again.
+ */
+void decommitRange(void* address, std::size_t size)
+{
+#ifdef ARTEMIS_PLATFORM_W32
+    VirtualFree(address, size, MEM_DECOMMIT);
+#else
+    madvise(address, size, MADV_DONTNEED);
+#endif
+}
+
+/**
+ * Returns true unless transparent huge pages are disabled system wide.
+ */
+bool hugePagesEnabled()
+{
+#ifdef __linux__
+    std::FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    char mode[128] = { 0 };
+    bool enabled = std::fgets(mode, sizeof (mode), file) != NULL && std::strstr(mode, "[never]") == NULL;
+    std::fclose(file);
+    return enabled;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Asks for a range to be backed by transparent huge pages, or by regular
+ * pages only. Returns true if huge pages were requested and granted.
+ * Windows only gives large pages to privileged processes, and never lazily,
+ * so regions there always use regular pages.
+ */
+bool adviseHugePages(void* address, std::size_t size, bool hugePages)
+{
+#if !defined(ARTEMIS_PLATFORM_W32) && defined(MADV_HUGEPAGE)
+    if (!hugePages)
+    {
+        madvise(address, size, MADV_NOHUGEPAGE);
+        return false;
+    }
+    return madvise(address, size, MADV_HUGEPAGE) == 0 && hugePagesEnabled();
+#else
+    return false;
+#endif
+}
+
+inline std::size_t roundToSlabs(std::size_t size)
+{
+    return (size + VirtualRegion::SLAB_SIZE - 1) / VirtualRegion::SLAB_SIZE * VirtualRegion::SLAB_SIZE;
+}
+
+}
+
+VirtualRegion::VirtualRegion(std::size_t capacity, bool hugePages, std::size_t commitChunk)
+:
+m_reservation(NULL),
+m_reserved(0),
+m_base(NULL),
+m_capacity(roundToSlabs(capacity > 0 ? capacity : 1)),
+m_commitChunk(roundToSlabs(commitChunk > 0 ? commitChunk : 1)),
+m_cursor(NULL),
+m_committedEnd(NULL),
+m_released(NULL),
+m_freeCount(0),
+m_trimmedCount(0),
+m_committed(0),
+m_slabsInUse(0),
+m_hugePages(false)
+{
+    // One more slab, to align the base
+    m_reserved = m_capacity + SLAB_SIZE;
+    m_reservation = m_reserved > m_capacity ? reserveRange(m_reserved) : NULL;
+    if (m_reservation == NULL)
+    {
+        throw core::OutOfMemoryError("unable to reserve the addresses of a virtual region.");
+    }
+
+    m_released = new (std::nothrow) unsigned[m_capacity / SLAB_SIZE];
+    if (m_released == NULL)
+    {
+        releaseRange(m_reservation, m_reserved);
+        throw core::OutOfMemoryError("unable to allocate the bookkeeping of a virtual region.");
+    }
+
+    std::size_t misalignment = (std::size_t) m_reservation % SLAB_SIZE;
+    m_base = static_cast<char*> (m_reservation) + (misalignment != 0 ? SLAB_SIZE - misalignment : 0);
+    m_cursor = m_base;
+    m_committedEnd = m_base;
+    m_hugePages = adviseHugePages(m_base, m_capacity, hugePages);
+}
+
+VirtualRegion::~VirtualRegion()
+{
+    releaseRange(m_reservation, m_reserved);
+    delete[] m_released;
+}
+
+VirtualRegion& VirtualRegion::global()
+{
+    // Never destroyed, since allocators may outlive static destruction
+    static VirtualRegion* region = new VirtualRegion((std::size_t) 1 << (sizeof (void*) >= 8 ? 36 : 29));
+    return *region;
+}
+
+void* VirtualRegion::allocateSlab()
+{
+    ScopedLock<SpinLock> guard(m_lock);
+
+    char* slab;
+    if (m_freeCount > 0)
+    {
+        slab = m_base + (std::size_t) m_released[--m_freeCount] * SLAB_SIZE;
+    }
+    else if (m_trimmedCount > 0)
+    {
+        slab = m_base + (std::size_t) m_released[m_capacity / SLAB_SIZE - m_trimmedCount] * SLAB_SIZE;
+        if (!commitRange(slab, SLAB_SIZE))
+        {
+            throw core::OutOfMemoryError("unable to commit memory for a virtual region.");
+        }
+        m_trimmedCount--;
+        atomicStore(&m_committed, m_committed + SLAB_SIZE, RELAXED);
+    }
+    else
+    {
+        if (m_cursor == m_base + m_capacity)
+        {
+            throw core::OutOfMemoryError("the virtual region is exhausted.");
+        }
+
+        if (m_cursor == m_committedEnd)
+        {
+            std::size_t chunk = m_commitChunk;
+            if (chunk > (std::size_t) (m_base + m_capacity - m_committedEnd))
+            {
+                chunk = m_base + m_capacity - m_committedEnd;
+            }
+            if (!commitRange(m_committedEnd, chunk))
+            {
+                throw core::OutOfMemoryError("unable to commit memory for a virtual region.");
+            }
+            m_committedEnd += chunk;
+            atomicStore(&m_committed, m_committed + chunk, RELAXED);
+        }
+
+        slab = m_cursor;
+        m_cursor += SLAB_SIZE;
+    }
+
+    atomicStore(&m_slabsInUse, m_slabsInUse + 1, RELAXED);
+    return slab;
+}
+
+void VirtualRegion::releaseSlab(void* slab)
+{
+    ScopedLock<SpinLock> guard(m_lock);
+
+    m_released[m_freeCount++] = (unsigned) ((static_cast<char*> (slab) - m_base) / SLAB_SIZE);
+    atomicStore(&m_slabsInUse, m_slabsInUse - 1, RELAXED);
+
+    // Keep a chunk of slabs around for reuse, past two
+    if (m_freeCount * SLAB_SIZE > 2 * m_commitChunk)
+    {
+        decommitFree(m_commitChunk / SLAB_SIZE);
+    }
+}
+
+void VirtualRegion::trim()
+{
+    ScopedLock<SpinLock> guard(m_lock);
+    decommitFree(0);
+
+    if (m_committedEnd > m_cursor)
+    {
+        decommitRange(m_cursor, m_committedEnd - m_cursor);
+        atomicStore(&m_committed, m_committed - (m_committedEnd - m_cursor), RELAXED);
+        m_committedEnd = m_cursor;
+    }
+}
+
+void VirtualRegion::decommitFree(std::size_t keep)
+{
+    while (m_freeCount > keep)
+    {
+        unsigned index = m_released[--m_freeCount];
+        decommitRange(m_base + (std::size_t) index * SLAB_SIZE, SLAB_SIZE);
+
+        m_released[m_capacity / SLAB_SIZE - ++m_trimmedCount] = index;
+        atomicStore(&m_committed, m_committed - SLAB_SIZE, RELAXED);
+    }
+}
@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   EpochManager.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:00 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Concurrent/EpochManager.h>
+#include <Axf/Concurrent/LazyStatic.h>
+
+// C++
+#include <new>
+
+#if !defined(ARTEMIS_CXX11_SUPPORTED) && !defined(ARTEMIS_PLATFORM_W32)
+#include <pthread.h>
+#endif
+
+using namespace axf;
+using namespace axf::concurrent;
+
+namespace axf
+{
+namespace concurrent
+{
+
+/**
+ * A pointer waiting to be disposed of, and how.
+ */
+struct Retired
+{
+    void*   pointer;
+    void    (*dispose)(void* pointer);
+} ;
+
+/**
+ * A batch of retired pointers. Once sealed, it is stamped with the global
+ * epoch and may be disposed of two epochs later. A bag fits in a kilobyte.
+ */
+struct RetiredBag
+{
+    static const std::size_t CAPACITY = 62;
+
+    RetiredBag*     next;
+    unsigned long   epoch;
+    std::size_t     count;
+    Retired         items[CAPACITY];
+} ;
+
+/**
+ * The state of a thread with respect to a manager. Records are never
+ * freed: when a thread finishes or a manager is destroyed they are recycled.
+ */
+struct EpochRecord
+{
+    volatile unsigned long      epoch;      /// The epoch pinned, shifted left, with the low bit set; zero if not pinned
+    unsigned                    depth;      /// Nesting of the pins
+    const void* volatile        owner;      /// The thread, or NULL if the record is free
+    EpochManager*               manager;    /// The manager, or NULL if the record is free
+    unsigned long long          managerId;  /// The serial number of the manager
+    RetiredBag*                 open;       /// The bag being filled
+    EpochRecord*                nextInManager;
+    EpochRecord*                nextFree;
+    EpochRecord*                nextGlobal;
+} ;
+
+}
+}
+
+namespace
+{
+
+const std::size_t CACHE_SLOTS = 4;      /// Managers whose records a thread finds without a search
+
+/**
+ * A record of the calling thread, by the serial number of its manager.
+ * Serial numbers are never reused, so a slot left behind by a destroyed
+ * manager never matches again.
+ */
+struct LocalSlot
+{
+    unsigned long long  managerId;
+    EpochRecord*        record;
+} ;
+
+typedef enum ThreadState
+{
+    THREAD_UNREGISTERED = 0,
+    THREAD_ACTIVE,
+    THREAD_FINISHED
+} ThreadState;
+
+ARTEMIS_THREAD_LOCAL LocalSlot  localSlots[CACHE_SLOTS];
+ARTEMIS_THREAD_LOCAL unsigned   nextSlot;
+ARTEMIS_THREAD_LOCAL int        threadState;
+
+/**
+ * Only the address of this variable is used, it identifies the thread.
+ */
+ARTEMIS_THREAD_LOCAL char       threadToken;
+
+/**
+ * Every record ever created, linked through <code>nextGlobal</code>, and
+ * the free ones, linked through <code>nextFree</code>.
+ */
+SpinLock                    registryLock;
+EpochRecord* volatile       allRecords = NULL;
+EpochRecord*                freeRecords = NULL;
+
+volatile unsigned long long managerSerial = 0;
+
+inline void disposeBag(RetiredBag* bag)
+{
+    for (std::size_t i = 0; i < bag->count; ++i)
+    {
+        bag->items[i].dispose(bag->items[i].pointer);
+    }
+    delete bag;
+}
+
+}
+
+namespace axf
+{
+namespace concurrent
+{
+
+struct EpochReaper
+{
+
+    /**
+     * Hands the bags of the records of the calling thread to their managers,
+     * and frees the records.
+     */
+    static void finishThread()
+    {
+        const void* token = &threadToken;
+        for (EpochRecord* record = atomicLoad(&allRecords, ACQUIRE); record != NULL; record = record->nextGlobal)
+        {
+            if (atomicLoad(&record->owner, RELAXED) == token)
+            {
+                record->manager->seal(record);
+                record->depth = 0;
+                atomicStore(&record->epoch, 0UL, RELEASE);
+                atomicStore(&record->owner, (const void*) NULL, RELEASE);
+            }
+        }
+
+        for (std::size_t i = 0; i < CACHE_SLOTS; ++i)
+        {
+            localSlots[i].managerId = 0;
+            localSlots[i].record = NULL;
+        }
+        threadState = THREAD_FINISHED;
+    }
+} ;
+
+}
+}
+
+namespace
+{
+
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+
+/**
+ * A thread local object whose only purpose is to release the records of the
+ * thread when it exits.
+ */
+struct RecordReaper
+{
+
+    void arm() { }
+
+    ~RecordReaper()
+    {
+        EpochReaper::finishThread();
+    }
+} ;
+
+void registerThread()
+{
+    static thread_local RecordReaper reaper;
+    reaper.arm();
+}
+#elif !defined(ARTEMIS_PLATFORM_W32)
+
+pthread_key_t   epochReaperKey;
+pthread_once_t  epochReaperOnce = PTHREAD_ONCE_INIT;
+
+extern "C" void reapEpochRecords(void*)
+{
+    EpochReaper::finishThread();
+}
+
+extern "C" void createEpochReaperKey()
+{
+    pthread_key_create(&epochReaperKey, reapEpochRecords);
+}
+
+void registerThread()
+{
+    pthread_once(&epochReaperOnce, createEpochReaperKey);
+    pthread_setspecific(epochReaperKey, &threadToken);
+}
+#else
+
+/* Without C++11 there is no portable way to run code on thread exit under
+ * Windows: the records of finished threads are never reused, and what they
+ * retired last is disposed of with their manager. */
+void registerThread()
+{
+}
+#endif
+
+}
+
+EpochManager::EpochManager()
+:
+m_epoch(0),
+m_garbage(NULL),
+m_pending(0),
+m_records(NULL),
+m_id(atomicFetchAdd(&managerSerial, 1ULL) + 1)
+{
+}
+
+EpochManager::~EpochManager()
+{
+    EpochRecord* record = m_records;
+    while (record != NULL)
+    {
+        EpochRecord* next = record->nextInManager;
+        if (record->open != NULL)
+        {
+            disposeBag(record->open);
+            record->open = NULL;
+        }
+
+        record->depth = 0;
+        record->epoch = 0;
+        record->manager = NULL;
+        record->managerId = 0;
+        atomicStore(&record->owner, (const void*) NULL, RELEASE);
+        {
+            ScopedLock<SpinLock> guard(registryLock);
+            record->nextFree = freeRecords;
+            freeRecords = record;
+        }
+        record = next;
+    }
+
+    RetiredBag* bag = m_garbage;
+    while (bag != NULL)
+    {
+        RetiredBag* next = bag->next;
+        disposeBag(bag);
+        bag = next;
+    }
+}
+
+EpochManager& EpochManager::global()
+{
+
+    struct Factory
+    {
+
+        static void* create(void* storage)
+        {
+            return new (storage) EpochManager();
+        }
+    } ;
+    static LazyStatic<EpochManager> manager;
+
+    return manager.get(&Factory::create);
+}
+
+void EpochManager::unpin()
+{
+    leave(localRecord());
+}
+
+std::size_t EpochManager::collect()
+{
+    tryAdvance();
+
+    RetiredBag* bags = atomicExchange(&m_garbage, (RetiredBag*) NULL, ACQUIRE);
+    if (bags == NULL)
+    {
+        return 0;
+    }
+
+    unsigned long epoch = atomicLoad(&m_epoch, ACQUIRE);
+    std::size_t disposed = 0;
+    RetiredBag* kept = NULL;
+    RetiredBag* lastKept = NULL;
+    while (bags != NULL)
+    {
+        RetiredBag* next = bags->next;
+        if (epoch - bags->epoch >= 2)
+        {
+            disposed += bags->count;
+            disposeBag(bags);
+        }
+        else
+        {
+            bags->next = kept;
+            kept = bags;
+            if (lastKept == NULL)
+            {
+                lastKept = bags;
+            }
+        }
+        bags = next;
+    }
+
+    if (kept != NULL)
+    {
+        // Bags too young go back, along with those sealed meanwhile
+        lastKept->next = atomicLoad(&m_garbage, RELAXED);
+        while (!atomicCompareExchange(&m_garbage, lastKept->next, kept, true, RELEASE, RELAXED))
+        {
+        }
+    }
+
+    atomicFetchSub(&m_pending, disposed, RELAXED);
+    return disposed;
+}
+
+std::size_t EpochManager::flush()
+{
+    seal(localRecord());
+    return collect();
+}
+
+EpochRecord* EpochManager::enter()
+{
+    EpochRecord* record = localRecord();
+    if (record->depth++ == 0)
+    {
+        // Publish the epoch observed before reading any shared pointer
+        unsigned long epoch = atomicLoad(&m_epoch, RELAXED);
+        atomicStore(&record->epoch, (epoch << 1) | 1, RELAXED);
+        atomicThreadFence(SEQ_CST);
+    }
+    return record;
+}
+
+void EpochManager::leave(EpochRecord* record)
+{
+    if (--record->depth == 0)
+    {
+        atomicStore(&record->epoch, 0UL, RELEASE);
+    }
+}
+
+EpochRecord* EpochManager::localRecord()
+{
+    for (std::size_t i = 0; i < CACHE_SLOTS; ++i)
+    {
+        if (localSlots[i].managerId == m_id)
+        {
+            return localSlots[i].record;
+        }
+    }
+    return joinRecord();
+}
+
+EpochRecord* EpochManager::joinRecord()
+{
+    if (threadState == THREAD_UNREGISTERED)
+    {
+        threadState = THREAD_ACTIVE;
+        registerThread();
+    }
+
+    const void* token = &threadToken;
+    EpochRecord* record = NULL;
+
+    // The record of this thread may just have been evicted from the cache,
+    // or a finished thread may have left one behind
+    for (EpochRecord* candidate = atomicLoad(&m_records, ACQUIRE); candidate != NULL;
+         candidate = candidate->nextInManager)
+    {
+        if (atomicLoad(&candidate->owner, RELAXED) == token)
+        {
+            record = candidate;
+            break;
+        }
+    }
+    for (EpochRecord* candidate = atomicLoad(&m_records, ACQUIRE); record == NULL && candidate != NULL;
+         candidate = candidate->nextInManager)
+    {
+        const void* expected = NULL;
+        if (atomicLoad(&candidate->owner, RELAXED) == NULL
+            && atomicCompareExchange(&candidate->owner, expected, token, false, ACQUIRE, RELAXED))
+        {
+            record = candidate;
+        }
+    }
+
+    if (record == NULL)
+    {
+        {
+            ScopedLock<SpinLock> guard(registryLock);
+            record = freeRecords;
+            if (record != NULL)
+            {
+                freeRecords = record->nextFree;
+            }
+        }
+        if (record == NULL)
+        {
+            record = new EpochRecord();
+
+            ScopedLock<SpinLock> guard(registryLock);
+            record->nextGlobal = allRecords;
+            atomicStore(&allRecords, record, RELEASE);
+        }
+
+        record->epoch = 0;
+        record->depth = 0;
+        record->open = NULL;
+        record->manager = this;
+        record->managerId = m_id;
+        atomicStore(&record->owner, token, RELAXED);
+
+        record->nextInManager = atomicLoad(&m_records, RELAXED);
+        while (!atomicCompareExchange(&m_records, record->nextInManager, record, true, RELEASE, RELAXED))
+        {
+        }
+    }
+
+    LocalSlot& slot = localSlots[nextSlot++ % CACHE_SLOTS];
+    slot.managerId = m_id;
+    slot.record = record;
+    return record;
+}
+
+void EpochManager::retireErased(void* pointer, void (*dispose)(void*))
+{
+    EpochRecord* record = localRecord();
+
+    RetiredBag* bag = record->open;
+    if (bag == NULL)
+    {
+        bag = new RetiredBag;
+        bag->count = 0;
+        record->open = bag;
+    }
+
+    bag->items[bag->count].pointer = pointer;
+    bag->items[bag->count].dispose = dispose;
+    if (++bag->count == RetiredBag::CAPACITY)
+    {
+        seal(record);
+        collect();
+    }
+}
+
+void EpochManager::seal(EpochRecord* record)
+{
+    RetiredBag* bag = record->open;
+    if (bag == NULL)
+    {
+        return;
+    }
+    record->open = NULL;
+    if (bag->count == 0)
+    {
+        delete bag;
+        return;
+    }
+
+    // The epoch is read after the pointers in the bag were unlinked
+    atomicThreadFence(SEQ_CST);
+    bag->epoch = atomicLoad(&m_epoch, RELAXED);
+
+    atomicFetchAdd(&m_pending, bag->count, RELAXED);
+    bag->next = atomicLoad(&m_garbage, RELAXED);
+    while (!atomicCompareExchange(&m_garbage, bag->next, bag, true, RELEASE, RELAXED))
+    {
+    }
+}
+
+bool EpochManager::tryAdvance()
+{
+    unsigned long epoch = atomicLoad(&m_epoch, SEQ_CST);
+    unsigned long current = (epoch << 1) | 1;
+
+    atomicThreadFence(SEQ_CST);
+    for (EpochRecord* record = atomicLoad(&m_records, ACQUIRE); record != NULL; record = record->nextInManager)
+    {
+        unsigned long pinned = atomicLoad(&record->epoch, RELAXED);
+        if ((pinned & 1) != 0 && pinned != current)
+        {
+            // A thread is still pinned in the previous epoch
+            return false;
+        }
+    }
+    atomicThreadFence(ACQUIRE);
+
+    return atomicCompareExchange(&m_epoch, epoch, epoch + 1, false, SEQ_CST, RELAXED);
+}
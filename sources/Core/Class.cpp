@@ -18,9 +18,13 @@
  */
 
 #include <Axf/Core/Class.h>
+#include <Axf/Core/Hash.h>
+#include <Axf/Core/Object.h>
 
 // C++
+#include <cstdio>
 #include <cstring>
+#include <new>
 
 using namespace axf;
 using namespace axf::core;
@@ -28,21 +32,7 @@ using namespace axf::core::bits;
 
 int bits::Type::encodeTypeName(const char* str)
 {
-    size_t len = std::strlen(str);
-    int hash = 0;
-
-    for (unsigned i = 0; i < len; ++i)
-    {
-        hash += str[i];
-        hash += hash << 10;
-        hash ^= hash >> 6;
-    }
-
-    hash += hash << 3;
-    hash ^= hash >> 11;
-    hash += hash << 15;
-
-    return hash;
+    return foldHash(hash(str));
 }
 
 const char* Type::getSimpleName() const
@@ -57,3 +47,85 @@ const char* Type::getSimpleName() const
 
     return result + i;
 }
+
+namespace
+{
+
+const std::size_t CAST_CACHE_SIZE   = 4096;     /// Slots of the cast cache, a power of two
+const std::size_t CAST_CACHE_PROBES = 8;        /// Slots probed before giving up
+
+/**
+ * A memoized answer of the cast cache. Entries are immutable once published
+ * and are never freed, so readers need no lock.
+ */
+struct CastEntry
+{
+    const char* source;     /// The interned name of the source class
+    const char* target;     /// The interned name of the target class
+    bool        castable;
+} ;
+
+CastEntry* castCache[CAST_CACHE_SIZE];
+
+inline std::size_t castSlotOf(const char* source, const char* target)
+{
+    hash_t key = ((hash_t) (std::size_t) source * 0x9E3779B97F4A7C15ULL) ^ (hash_t) (std::size_t) target;
+    return (std::size_t) ((key * 0xFF51AFD7ED558CCDULL) >> 32) & (CAST_CACHE_SIZE - 1);
+}
+
+}
+
+bool reflection::bits::isCastable(const Type& source, const Type& target)
+{
+    // Interned names are unique, so their addresses identify classes
+    const char* sourceName = source.getInternedName().bytes();
+    const char* targetName = target.getInternedName().bytes();
+
+    std::size_t slot = castSlotOf(sourceName, targetName);
+    for (std::size_t probe = 0; probe < CAST_CACHE_PROBES; ++probe)
+    {
+        const CastEntry* entry = concurrent::atomicLoad(&castCache[(slot + probe) & (CAST_CACHE_SIZE - 1)],
+                                                        concurrent::ACQUIRE);
+        if (entry == NULL)
+            break;
+        if (entry->source == sourceName && entry->target == targetName)
+            return entry->castable;
+    }
+
+    bool castable = sourceName == targetName ||
+            asClassUnsafe<Object>(source).isKindOf(asClassUnsafe<Object>(target));
+
+    CastEntry* entry = new (std::nothrow) CastEntry;
+    if (entry == NULL)
+        return castable;
+
+    entry->source = sourceName;
+    entry->target = targetName;
+    entry->castable = castable;
+    for (std::size_t probe = 0; probe < CAST_CACHE_PROBES; ++probe)
+    {
+        CastEntry** address = &castCache[(slot + probe) & (CAST_CACHE_SIZE - 1)];
+        CastEntry* expected = NULL;
+        if (concurrent::atomicCompareExchange(address, expected, entry, false,
+                                              concurrent::ACQ_REL, concurrent::ACQUIRE))
+            return castable;
+
+        // Another thread may have published the same pair meanwhile
+        if (expected->source == sourceName && expected->target == targetName)
+            break;
+    }
+
+    // The pair was published by another thread or the neighbourhood is full
+    delete entry;
+    return castable;
+}
+
+void reflection::bits::throwInvalidCast(const Type& source, const Type& target)
+{
+    char exceptionMessage[1024] = {0};
+    std::sprintf(exceptionMessage,
+                 "invalid dynamic cast, '%s' is not a polymorphic covariant of '%s'.",
+                 source.getName(), target.getName());
+
+    throw ClassCastException(exceptionMessage);
+}
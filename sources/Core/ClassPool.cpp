@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   ClassPool.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 10:20 AM
+ */
+
+#include <Axf/Core/ClassPool.h>
+
+// C++
+#include <vector>
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+using namespace axf::core::bits;
+
+namespace
+{
+
+const std::size_t RECENT_ATTEMPTS = 8;
+
+/**
+ * The last blocks allocated by <code>tryAllocate</code> on a thread, in a
+ * ring. Constructors that throw do so right after the allocation, or after
+ * a few nested ones at most.
+ */
+struct RecentAttempts
+{
+    void*       memory[RECENT_ATTEMPTS];
+    std::size_t size[RECENT_ATTEMPTS];
+    std::size_t next;
+} ;
+
+ARTEMIS_THREAD_LOCAL RecentAttempts recentAttempts;
+
+}
+
+void* ClassPoolEngine::allocate(std::size_t size)
+{
+    try
+    {
+        return ThreadCache::allocate(size);
+    }
+    catch (std::bad_alloc&)
+    {
+        // The memory cached by the pools may be enough
+        ThreadCache::trim();
+    }
+    return ThreadCache::allocate(size);
+}
+
+void* ClassPoolEngine::tryAllocate(std::size_t size)
+{
+    void* memory;
+    try
+    {
+        memory = allocate(size);
+    }
+    catch (std::bad_alloc&)
+    {
+        return NULL;
+    }
+
+    RecentAttempts& recent = recentAttempts;
+    std::size_t slot = recent.next++ % RECENT_ATTEMPTS;
+    recent.memory[slot] = memory;
+    recent.size[slot] = size;
+    return memory;
+}
+
+std::size_t ClassPoolEngine::takeAttemptSize(void* memory)
+{
+    RecentAttempts& recent = recentAttempts;
+    for (std::size_t i = 1; i <= RECENT_ATTEMPTS; ++i)
+    {
+        std::size_t slot = (recent.next - i) % RECENT_ATTEMPTS;
+        if (recent.memory[slot] == memory)
+        {
+            recent.memory[slot] = NULL;
+            return recent.size[slot];
+        }
+    }
+    return 0;
+}
+
+void ClassPoolEngine::reserve(std::size_t size, std::size_t count)
+{
+    if (size > ThreadCache::MAX_CACHED_SIZE)
+    {
+        return;
+    }
+
+    std::vector<void*> blocks;
+    blocks.reserve(count);
+    try
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            blocks.push_back(ThreadCache::allocate(size));
+        }
+    }
+    catch (std::bad_alloc&)
+    {
+        // Reserving is only a hint, keep what could be allocated
+    }
+    for (std::size_t i = blocks.size(); i > 0; --i)
+    {
+        ThreadCache::deallocate(blocks[i - 1], size);
+    }
+}
@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   CycleCollector.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 8:20 AM
+ */
+
+#include <Axf/Core/CycleCollector.h>
+#include <Axf/Concurrent/LazyStatic.h>
+#include <Axf/Concurrent/SpinLock.h>
+
+// C++
+#include <new>
+#include <vector>
+
+using namespace axf;
+using namespace axf::concurrent;
+using namespace axf::core;
+using namespace axf::core::bits;
+
+#ifdef AXF_CYCLE_COLLECTION
+
+namespace
+{
+
+typedef std::vector<WeakControl*> RootVector;
+
+/**
+ * The possible roots, each holding a weak reference to its object so that
+ * the collector can tell whether it is still alive when it is examined.
+ * Never destroyed, objects may be released during static destruction.
+ */
+LazyStatic<RootVector> rootStorage;
+SpinLock rootLock;
+
+/**
+ * Collections run one at a time.
+ */
+SpinLock collectionLock;
+
+void* createRoots(void* storage)
+{
+    return new (storage) RootVector();
+}
+
+inline RootVector& roots()
+{
+    return rootStorage.get(&createRoots);
+}
+
+/**
+ * The largest index of an object in a collection.
+ */
+const std::size_t MAX_INDEX = (1u << (32 - CYCLE_INDEX_SHIFT)) - 1;
+
+/**
+ * Clears the references of the garbage found.
+ */
+class Clearer : public ReferenceVisitor
+{
+public:
+
+    Clearer() : ReferenceVisitor(true) { }
+
+protected:
+
+    virtual void visitObject(const Object*) { }
+} ;
+
+}
+
+/**
+ * The state of a collection: the objects examined, with their counts of
+ * references from outside the subgraph examined, and the phase of the trial
+ * deletion under way. Graphs are walked with explicit stacks, never
+ * recursively.
+ */
+class CycleCollector::Tracer : public ReferenceVisitor
+{
+public:
+
+    Tracer() : ReferenceVisitor(false), m_phase(MARK) { }
+
+    /**
+     * Returns the count of objects examined.
+     *
+     * @return
+     */
+    inline std::size_t examined() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * Returns the objects found to be garbage.
+     *
+     * @return
+     */
+    inline const std::vector<const Object*>& garbage() const
+    {
+        return m_garbage;
+    }
+
+    /**
+     * Marks a root as no longer recorded.
+     *
+     * @param object
+     */
+    static inline void clearBuffered(const ReferenceCounted* object)
+    {
+        volatile unsigned& state = stateOf(object);
+        state = state & ~(unsigned) CYCLE_BUFFERED;
+    }
+
+    /**
+     * Returns true if a root must be examined, that is, if it is purple and
+     * no other root reached it in this collection.
+     *
+     * @param root
+     * @return
+     */
+    static inline bool isPurpleRoot(const Object* root)
+    {
+        unsigned state = stateOf(root);
+        return (state & CYCLE_COLOR) == CYCLE_PURPLE && (state & CYCLE_TRACED) == 0;
+    }
+
+    /**
+     * Colors gray every object reachable from a root, subtracting the
+     * references among them from their counts.
+     *
+     * @param root
+     */
+    void markGray(const Object* root)
+    {
+        m_phase = MARK;
+        trace(root);
+        while (!m_stack.empty())
+        {
+            const Object* object = m_stack.back();
+            m_stack.pop_back();
+            object->traverseReferences(*this);
+        }
+    }
+
+    /**
+     * Colors white the gray objects left without references, and black
+     * again those still referenced from outside, and what they reach.
+     *
+     * @param root
+     */
+    void scan(const Object* root)
+    {
+        m_phase = SCAN;
+        m_stack.push_back(root);
+        while (!m_stack.empty())
+        {
+            const Object* object = m_stack.back();
+            m_stack.pop_back();
+            if (colorOf(object) != CYCLE_GRAY)
+            {
+                continue;
+            }
+
+            if (entryOf(object).count > 0)
+            {
+                scanBlack(object);
+            }
+            else
+            {
+                setColor(object, CYCLE_WHITE);
+                object->traverseReferences(*this);
+            }
+        }
+    }
+
+    /**
+     * Gathers the white objects reachable from a root as garbage.
+     *
+     * @param root
+     */
+    void collectWhite(const Object* root)
+    {
+        m_phase = COLLECT;
+        if (colorOf(root) == CYCLE_WHITE)
+        {
+            addGarbage(root);
+        }
+        while (!m_stack.empty())
+        {
+            const Object* object = m_stack.back();
+            m_stack.pop_back();
+            object->traverseReferences(*this);
+        }
+    }
+
+    /**
+     * Forgets the objects examined, leaving the live ones black. Garbage is
+     * left purple, so releasing references to it records no candidate.
+     */
+    void finish()
+    {
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            volatile unsigned& state = stateOf(m_entries[i].object);
+            unsigned color = (state & CYCLE_COLOR) == CYCLE_PURPLE ? CYCLE_PURPLE : CYCLE_BLACK;
+            state = (state & (CYCLE_BUFFERED | CYCLE_COLLECTABLE)) | color;
+        }
+    }
+
+protected:
+
+    virtual void visitObject(const Object* object)
+    {
+        unsigned state = stateOf(object);
+        switch (m_phase)
+        {
+            case MARK:
+                if ((state & CYCLE_TRACED) == 0)
+                {
+                    if (!participates(object))
+                    {
+                        return;
+                    }
+                    trace(object);
+                }
+                entryOf(object).count--;
+                break;
+            case SCAN:
+                if ((state & CYCLE_TRACED) != 0 && (state & CYCLE_COLOR) == CYCLE_GRAY)
+                {
+                    m_stack.push_back(object);
+                }
+                break;
+            case SCAN_BLACK:
+                if ((state & CYCLE_TRACED) != 0)
+                {
+                    entryOf(object).count++;
+                    if ((state & CYCLE_COLOR) != CYCLE_BLACK)
+                    {
+                        setColor(object, CYCLE_BLACK);
+                        m_blackStack.push_back(object);
+                    }
+                }
+                break;
+            case COLLECT:
+                if ((state & CYCLE_TRACED) != 0 && (state & CYCLE_COLOR) == CYCLE_WHITE)
+                {
+                    addGarbage(object);
+                }
+                break;
+        }
+    }
+
+private:
+
+    typedef enum Phase
+    {
+        MARK,
+        SCAN,
+        SCAN_BLACK,
+        COLLECT
+    } Phase;
+
+    /**
+     * An object examined, and its count of references once those from the
+     * objects examined are subtracted.
+     */
+    struct Entry
+    {
+        const Object*   object;
+        long            count;
+    } ;
+
+    Phase                       m_phase;
+    std::vector<Entry>          m_entries;
+    std::vector<const Object*>  m_stack;
+    std::vector<const Object*>  m_blackStack;
+    std::vector<const Object*>  m_garbage;
+
+    static inline unsigned colorOf(const Object* object)
+    {
+        return stateOf(object) & CYCLE_COLOR;
+    }
+
+    static inline void setColor(const Object* object, unsigned color)
+    {
+        volatile unsigned& state = stateOf(object);
+        state = (state & ~(unsigned) CYCLE_COLOR) | color;
+    }
+
+    inline Entry& entryOf(const Object* object)
+    {
+        return m_entries[stateOf(object) >> CYCLE_INDEX_SHIFT];
+    }
+
+    /**
+     * Returns true if the collector may examine an object reached from
+     * another one.
+     *
+     * @param object
+     * @return
+     */
+    inline bool participates(const Object* object) const
+    {
+        return (stateOf(object) & CYCLE_COLLECTABLE) != 0
+                && !object->isBiased()
+                && m_entries.size() < MAX_INDEX;
+    }
+
+    /**
+     * Starts examining an object: colors it gray and records its count.
+     *
+     * @param object
+     */
+    void trace(const Object* object)
+    {
+        Entry entry;
+        entry.object = object;
+        entry.count = object->queryStrongReferences();
+
+        unsigned index = (unsigned) m_entries.size();
+        m_entries.push_back(entry);
+
+        volatile unsigned& state = stateOf(object);
+        state = (state & (CYCLE_BUFFERED | CYCLE_COLLECTABLE)) | CYCLE_GRAY | CYCLE_TRACED
+                | (index << CYCLE_INDEX_SHIFT);
+        m_stack.push_back(object);
+    }
+
+    void scanBlack(const Object* object)
+    {
+        m_phase = SCAN_BLACK;
+        setColor(object, CYCLE_BLACK);
+        m_blackStack.push_back(object);
+        while (!m_blackStack.empty())
+        {
+            const Object* next = m_blackStack.back();
+            m_blackStack.pop_back();
+            next->traverseReferences(*this);
+        }
+        m_phase = SCAN;
+    }
+
+    void addGarbage(const Object* object)
+    {
+        setColor(object, CYCLE_PURPLE);
+        m_garbage.push_back(object);
+        m_stack.push_back(object);
+    }
+} ;
+
+std::size_t CycleCollector::collect(std::size_t budget)
+{
+    ScopedLock<SpinLock> guard(collectionLock);
+
+    // Every root taken holds a weak reference until the collection is over
+    std::vector<WeakControl*> taken;
+    std::vector<const Object*> batch;
+    Tracer tracer;
+
+    while (tracer.examined() < budget)
+    {
+        WeakControl* control;
+        {
+            ScopedLock<SpinLock> rootGuard(rootLock);
+            if (roots().empty())
+            {
+                break;
+            }
+            control = roots().back();
+            roots().pop_back();
+        }
+
+        taken.push_back(control);
+        const ReferenceCounted* candidate = atomicLoad(&control->object, ACQUIRE);
+        if (candidate == NULL)
+        {
+            // Released meanwhile
+            continue;
+        }
+
+        const Object* root = dynamic_cast<const Object*> (candidate);
+        if (root != NULL && !root->isBiased() && Tracer::isPurpleRoot(root))
+        {
+            tracer.markGray(root);
+            batch.push_back(root);
+        }
+        else
+        {
+            Tracer::clearBuffered(candidate);
+        }
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        tracer.scan(batch[i]);
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        Tracer::clearBuffered(batch[i]);
+        tracer.collectWhite(batch[i]);
+    }
+    tracer.finish();
+
+    // Keep every garbage object alive while the references among them are
+    // cleared, then release them
+    const std::vector<const Object*>& garbage = tracer.garbage();
+    for (std::size_t i = 0; i < garbage.size(); ++i)
+    {
+        garbage[i]->grabStrongReference();
+    }
+
+    Clearer clearer;
+    for (std::size_t i = 0; i < garbage.size(); ++i)
+    {
+        garbage[i]->traverseReferences(clearer);
+    }
+    for (std::size_t i = 0; i < garbage.size(); ++i)
+    {
+        garbage[i]->releaseStrongReference();
+    }
+
+    for (std::size_t i = 0; i < taken.size(); ++i)
+    {
+        taken[i]->release();
+    }
+    return garbage.size();
+}
+
+std::size_t CycleCollector::candidates()
+{
+    ScopedLock<SpinLock> guard(rootLock);
+    return roots().size();
+}
+
+void CycleCollector::addCandidate(const ReferenceCounted* object)
+{
+    volatile unsigned& state = stateOf(object);
+
+    unsigned previous = atomicLoad(&state, RELAXED);
+    unsigned desired;
+    do
+    {
+        if ((previous & CYCLE_COLOR) == CYCLE_PURPLE)
+        {
+            return;
+        }
+        desired = (previous & ~(unsigned) CYCLE_COLOR) | CYCLE_PURPLE | CYCLE_BUFFERED;
+    }
+    while (!atomicCompareExchange(&state, previous, desired, true, RELAXED, RELAXED));
+
+    if ((previous & CYCLE_BUFFERED) == 0)
+    {
+        WeakControl* held = NULL;
+        try
+        {
+            WeakControl* control = object->queryWeakControl();
+            control->grab();
+            held = control;
+
+            ScopedLock<SpinLock> guard(rootLock);
+            roots().push_back(control);
+        }
+        catch (...)
+        {
+            // Releases must not fail: the object is not recorded, and stays
+            // black until it is released again
+            previous = desired;
+            while (!atomicCompareExchange(&state, previous, previous & ~(unsigned) (CYCLE_COLOR | CYCLE_BUFFERED),
+                                          true, RELAXED, RELAXED))
+            {
+            }
+            if (held != NULL)
+            {
+                held->release();
+            }
+        }
+    }
+}
+#else
+
+/* Objects carry no cycle state, so no root is ever recorded. */
+std::size_t CycleCollector::collect(std::size_t)
+{
+    return 0;
+}
+
+std::size_t CycleCollector::candidates()
+{
+    return 0;
+}
+#endif
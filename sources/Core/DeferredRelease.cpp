@@ -0,0 +1,439 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   DeferredRelease.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#include <Axf/Core/DeferredRelease.h>
+#include <Axf/Core/IllegalStateException.h>
+
+#ifndef ARTEMIS_PLATFORM_W32
+#include <pthread.h>
+#endif
+
+using namespace axf;
+using namespace axf::concurrent;
+using namespace axf::core;
+
+namespace
+{
+
+typedef enum ReleaseMode
+{
+    RELEASE_INLINE = 0,
+    RELEASE_DEFERRED,
+    RELEASE_RECLAIMED
+} ReleaseMode;
+
+/**
+ * The objects a thread has queued, linked through the objects themselves.
+ */
+struct LocalQueue
+{
+    const ReferenceCounted* head;
+    std::size_t             count;
+    int                     mode;
+    Reclaimer*              reclaimer;
+    int                     registered;
+} ;
+
+ARTEMIS_THREAD_LOCAL LocalQueue localQueue;
+
+/**
+ * Destroys what the calling thread left queued, and releases right away
+ * from then on, since nobody would drain the queue anymore.
+ */
+void finishThread()
+{
+    DeferredRelease::disable();
+}
+
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+
+/**
+ * A thread local object whose only purpose is to run
+ * <code>finishThread</code> when the thread exits.
+ */
+struct QueueReaper
+{
+
+    void arm() { }
+
+    ~QueueReaper()
+    {
+        finishThread();
+    }
+} ;
+
+void registerThread()
+{
+    static thread_local QueueReaper reaper;
+    reaper.arm();
+}
+#elif !defined(ARTEMIS_PLATFORM_W32)
+
+pthread_key_t   queueReaperKey;
+pthread_once_t  queueReaperOnce = PTHREAD_ONCE_INIT;
+
+extern "C" void reapReleaseQueue(void*)
+{
+    finishThread();
+}
+
+extern "C" void createQueueReaperKey()
+{
+    pthread_key_create(&queueReaperKey, reapReleaseQueue);
+}
+
+void registerThread()
+{
+    pthread_once(&queueReaperOnce, createQueueReaperKey);
+    pthread_setspecific(queueReaperKey, &localQueue);
+}
+#else
+
+/* Without C++11 there is no portable way to run code on thread exit under
+ * Windows: objects a thread leaves queued are never destroyed. */
+void registerThread()
+{
+}
+#endif
+
+/**
+ * Sets the release mode of the calling thread.
+ *
+ * @param mode
+ * @param reclaimer
+ */
+void setMode(int mode, Reclaimer* reclaimer)
+{
+    LocalQueue& queue = localQueue;
+    if (!queue.registered)
+    {
+        queue.registered = 1;
+        registerThread();
+    }
+    queue.mode = mode;
+    queue.reclaimer = reclaimer;
+}
+
+}
+
+namespace axf
+{
+namespace core
+{
+namespace bits
+{
+
+struct ReclaimerState
+{
+    const ReferenceCounted* volatile    incoming;   /// Objects handed over, linked through themselves
+    volatile std::size_t                handedOver; /// Count of objects ever handed over
+    volatile std::size_t                processed;  /// Count of objects handed over and destroyed
+    volatile std::size_t                reclaimed;  /// Count of objects destroyed, with cascades
+#ifndef ARTEMIS_PLATFORM_W32
+    pthread_mutex_t                     mutex;
+    pthread_cond_t                      work;       /// Signaled when objects arrive, or to stop
+    pthread_cond_t                      done;       /// Signaled when a batch is destroyed
+    pthread_t                           thread;
+    bool                                stopping;
+#endif
+
+    /**
+     * Takes every object handed over so far, and destroys them along with
+     * the objects they were the last to reference.
+     *
+     * @return the count of objects handed over that were destroyed
+     */
+    std::size_t reclaim()
+    {
+        const ReferenceCounted* object = atomicExchange(&incoming, (const ReferenceCounted*) NULL, ACQUIRE);
+
+        std::size_t count = 0;
+        std::size_t destroyed = 0;
+        while (object != NULL)
+        {
+            const ReferenceCounted* next = DeferredRelease::next(object);
+            DeferredRelease::destroy(object);
+            destroyed += DeferredRelease::drain() + 1;
+
+            object = next;
+            count++;
+        }
+        atomicFetchAdd(&reclaimed, destroyed, RELAXED);
+        return count;
+    }
+
+#ifndef ARTEMIS_PLATFORM_W32
+
+    static void* run(void* argument)
+    {
+        ReclaimerState& state = *static_cast<ReclaimerState*> (argument);
+        DeferredRelease::enable();
+
+        for (;;)
+        {
+            std::size_t count = state.reclaim();
+
+            pthread_mutex_lock(&state.mutex);
+            state.processed += count;
+            pthread_cond_broadcast(&state.done);
+            while (atomicLoad(&state.incoming, RELAXED) == NULL && !state.stopping)
+            {
+                pthread_cond_wait(&state.work, &state.mutex);
+            }
+            bool stop = state.stopping && atomicLoad(&state.incoming, RELAXED) == NULL;
+            pthread_mutex_unlock(&state.mutex);
+
+            if (stop)
+            {
+                break;
+            }
+        }
+
+        DeferredRelease::disable();
+        return NULL;
+    }
+#endif
+} ;
+
+}
+}
+}
+
+#ifndef ARTEMIS_PLATFORM_W32
+
+Reclaimer::Reclaimer() : m_state(new bits::ReclaimerState)
+{
+    m_state->incoming = NULL;
+    m_state->handedOver = 0;
+    m_state->processed = 0;
+    m_state->reclaimed = 0;
+    m_state->stopping = false;
+
+    pthread_mutex_init(&m_state->mutex, NULL);
+    pthread_cond_init(&m_state->work, NULL);
+    pthread_cond_init(&m_state->done, NULL);
+    if (pthread_create(&m_state->thread, NULL, &bits::ReclaimerState::run, m_state) != 0)
+    {
+        pthread_cond_destroy(&m_state->done);
+        pthread_cond_destroy(&m_state->work);
+        pthread_mutex_destroy(&m_state->mutex);
+        delete m_state;
+        throw IllegalStateException("unable to start the thread of a reclaimer.");
+    }
+}
+
+Reclaimer::~Reclaimer()
+{
+    pthread_mutex_lock(&m_state->mutex);
+    m_state->stopping = true;
+    pthread_cond_signal(&m_state->work);
+    pthread_mutex_unlock(&m_state->mutex);
+    pthread_join(m_state->thread, NULL);
+
+    pthread_cond_destroy(&m_state->done);
+    pthread_cond_destroy(&m_state->work);
+    pthread_mutex_destroy(&m_state->mutex);
+    delete m_state;
+}
+
+void Reclaimer::flush()
+{
+    std::size_t target = atomicLoad(&m_state->handedOver, ACQUIRE);
+
+    pthread_mutex_lock(&m_state->mutex);
+    while (m_state->processed < target)
+    {
+        pthread_cond_wait(&m_state->done, &m_state->mutex);
+    }
+    pthread_mutex_unlock(&m_state->mutex);
+}
+
+void Reclaimer::handOver(const ReferenceCounted* object)
+{
+    const ReferenceCounted* head = atomicLoad(&m_state->incoming, RELAXED);
+    do
+    {
+        DeferredRelease::link(object, head);
+    }
+    while (!atomicCompareExchange(&m_state->incoming, head, object, true, RELEASE, RELAXED));
+    atomicFetchAdd(&m_state->handedOver, (std::size_t) 1, RELEASE);
+
+    // The reclaimer only sleeps once it took everything
+    if (head == NULL)
+    {
+        pthread_mutex_lock(&m_state->mutex);
+        pthread_cond_signal(&m_state->work);
+        pthread_mutex_unlock(&m_state->mutex);
+    }
+}
+#else
+
+/* Without threads, the thread handing an object over destroys it, still
+ * queueing the cascading releases. */
+
+Reclaimer::Reclaimer() : m_state(new bits::ReclaimerState)
+{
+    m_state->incoming = NULL;
+    m_state->handedOver = 0;
+    m_state->processed = 0;
+    m_state->reclaimed = 0;
+}
+
+Reclaimer::~Reclaimer()
+{
+    delete m_state;
+}
+
+void Reclaimer::flush()
+{
+}
+
+void Reclaimer::handOver(const ReferenceCounted* object)
+{
+    DeferredRelease::link(object, NULL);
+    m_state->incoming = object;
+    m_state->handedOver++;
+
+    DeferredRelease::enable();
+    m_state->processed += m_state->reclaim();
+    DeferredRelease::enable(*this);
+}
+#endif
+
+std::size_t Reclaimer::reclaimed() const
+{
+    return atomicLoad(&m_state->reclaimed, ACQUIRE);
+}
+
+void DeferredRelease::enable()
+{
+    setMode(RELEASE_DEFERRED, NULL);
+}
+
+void DeferredRelease::enable(Reclaimer& reclaimer)
+{
+    // What is queued already goes to the reclaimer too
+    LocalQueue& queue = localQueue;
+    while (queue.head != NULL)
+    {
+        const ReferenceCounted* object = queue.head;
+        queue.head = next(object);
+        queue.count--;
+        reclaimer.handOver(object);
+    }
+    setMode(RELEASE_RECLAIMED, &reclaimer);
+}
+
+void DeferredRelease::disable()
+{
+    LocalQueue& queue = localQueue;
+    if (queue.mode == RELEASE_DEFERRED)
+    {
+        drain();
+    }
+    queue.mode = RELEASE_INLINE;
+    queue.reclaimer = NULL;
+}
+
+bool DeferredRelease::isEnabled()
+{
+    return localQueue.mode != RELEASE_INLINE;
+}
+
+std::size_t DeferredRelease::drain(std::size_t budget)
+{
+    LocalQueue& queue = localQueue;
+
+    std::size_t destroyed = 0;
+    while (destroyed < budget && queue.head != NULL)
+    {
+        const ReferenceCounted* object = queue.head;
+        queue.head = next(object);
+        queue.count--;
+
+        destroy(object);
+        destroyed++;
+    }
+    return destroyed;
+}
+
+std::size_t DeferredRelease::pending()
+{
+    return localQueue.count;
+}
+
+bool DeferredRelease::defer(const ReferenceCounted* object)
+{
+    LocalQueue& queue = localQueue;
+    if (ARTEMIS_LIKELY(queue.mode == RELEASE_INLINE))
+    {
+        return false;
+    }
+    if (queue.mode == RELEASE_RECLAIMED)
+    {
+        queue.reclaimer->handOver(object);
+        return true;
+    }
+
+    link(object, queue.head);
+    queue.head = object;
+    queue.count++;
+    return true;
+}
+
+/* Dead objects are no longer counted, and their weak references are
+ * detached already, so the links go into their counts. Counts narrower than a
+ * pointer take its low half in the weak count and its high half in the
+ * strong one. */
+const ReferenceCounted* DeferredRelease::next(const ReferenceCounted* object)
+{
+    if (sizeof (refcount_value_t) >= sizeof (void*))
+    {
+        return (const ReferenceCounted*) (std::size_t) atomicLoad(&object->m_references.m_weak, RELAXED);
+    }
+
+    unsigned long long address = (unsigned) atomicLoad(&object->m_references.m_weak, RELAXED)
+            | (unsigned long long) (unsigned) atomicLoad(&object->m_references.m_strong, RELAXED) << 32;
+    return (const ReferenceCounted*) (std::size_t) address;
+}
+
+void DeferredRelease::link(const ReferenceCounted* object, const ReferenceCounted* next)
+{
+    if (sizeof (refcount_value_t) >= sizeof (void*))
+    {
+        atomicStore(&object->m_references.m_weak, (refcount_value_t) (std::size_t) next, RELAXED);
+        return;
+    }
+
+    unsigned long long address = (std::size_t) next;
+    atomicStore(&object->m_references.m_weak, (refcount_value_t) (address & 0xFFFFFFFFu), RELAXED);
+    atomicStore(&object->m_references.m_strong, (refcount_value_t) (address >> 32), RELAXED);
+}
+
+void DeferredRelease::destroy(const ReferenceCounted* object)
+{
+    object->destroy();
+}
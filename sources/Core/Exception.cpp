@@ -71,12 +71,22 @@ const ExceptionTypeDescriptor& ExceptionTypeDescriptor::super() const
     return *m_super;
 }
 
+namespace
+{
+
+void* createExceptionDescriptor(void* storage)
+{
+    return new (storage) ExceptionTypeDescriptor("axf::core::Exception", NULL);
+}
+
+}
+
 const ExceptionTypeDescriptor& Exception::getCompileTimeClass()
 {
-    static ExceptionTypeDescriptor descriptor("axf::core::Exception", NULL);
+    static concurrent::LazyStatic<ExceptionTypeDescriptor> descriptor;
 
-    // Return a reference to the newly allocated constructor
-    return descriptor;
+    // Return a reference to the lazily constructed descriptor
+    return descriptor.get(&createExceptionDescriptor);
 }
 
 Exception::Exception(const char* message)
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   Hash.cpp
+ * Author: Javier Marrero
+ * 
+ * Created on October 18, 2026, 7:45 PM
+ */
+
+#include <Axf/Core/Hash.h>
+
+// C++
+#include <cstring>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::core::bits;
+
+namespace
+{
+
+const hash_t SECRET0 = 0xa0761d6478bd642fULL;
+const hash_t SECRET1 = 0xe7037ed1a0b428dbULL;
+const hash_t SECRET2 = 0x8ebc6af09c88c6e3ULL;
+const hash_t SECRET3 = 0x589965cc75374cc3ULL;
+
+/*
+ * Unaligned reads. The copies compile to single loads; the byte order of the
+ * platform is used as is, since hashes are never persisted.
+ */
+
+inline hash_t read64(const unsigned char* p)
+{
+    hash_t value;
+    std::memcpy(&value, p, sizeof (value));
+    return value;
+}
+
+inline hash_t read32(const unsigned char* p)
+{
+    unsigned int value;
+    std::memcpy(&value, p, sizeof (value));
+    return value;
+}
+
+/** Reads 1 to 3 bytes, touching each byte at least once */
+inline hash_t readSmall(const unsigned char* p, std::size_t length)
+{
+    return (((hash_t) p[0]) << 16) | (((hash_t) p[length >> 1]) << 8) | p[length - 1];
+}
+
+}
+
+hash_t core::hash(const void* bytes, std::size_t length, hash_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*> (bytes);
+    hash_t a;
+    hash_t b;
+
+    seed ^= multiplyFold(seed ^ SECRET0, SECRET1);
+    if (ARTEMIS_LIKELY(length <= 16))
+    {
+        if (ARTEMIS_LIKELY(length >= 4))
+        {
+            std::size_t middle = (length >> 3) << 2;
+            a = (read32(p) << 32) | read32(p + middle);
+            b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+        }
+        else if (ARTEMIS_LIKELY(length > 0))
+        {
+            a = readSmall(p, length);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        std::size_t i = length;
+        if (ARTEMIS_UNLIKELY(i > 48))
+        {
+            // Three independent lanes let the multiplications overlap
+            hash_t seed1 = seed;
+            hash_t seed2 = seed;
+            do
+            {
+                seed = multiplyFold(read64(p) ^ SECRET1, read64(p + 8) ^ seed);
+                seed1 = multiplyFold(read64(p + 16) ^ SECRET2, read64(p + 24) ^ seed1);
+                seed2 = multiplyFold(read64(p + 32) ^ SECRET3, read64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            }
+            while (ARTEMIS_LIKELY(i > 48));
+            seed ^= seed1 ^ seed2;
+        }
+        while (ARTEMIS_UNLIKELY(i > 16))
+        {
+            seed = multiplyFold(read64(p) ^ SECRET1, read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+
+    a ^= SECRET1;
+    b ^= seed;
+    multiplyFull(a, b);
+    return multiplyFold(a ^ SECRET0 ^ length, b ^ SECRET1);
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   InternPool.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 9:40 PM
+ */
+
+#include <Axf/Core/InternPool.h>
+#include <Axf/Core/OutOfMemoryError.h>
+
+// C
+#include <cstdlib>
+
+using namespace axf;
+using namespace axf::concurrent;
+using namespace axf::core;
+using bits::InternEntry;
+
+namespace
+{
+
+const std::size_t CHUNK_SIZE = 16384;           /// Size of the chunks entries are carved from
+const std::size_t LARGE_ENTRY = CHUNK_SIZE / 4; /// Entries above this size get their own chunk
+const std::size_t INITIAL_BUCKETS = 64;         /// Initial buckets per shard
+
+/**
+ * The header of every chunk, linking it to the previously allocated one.
+ */
+struct Chunk
+{
+    Chunk* previous;
+    hash_t alignment;
+} ;
+
+inline std::size_t entrySize(std::size_t size)
+{
+    // Header plus the bytes and their null, rounded to keep entries aligned
+    std::size_t bytes = offsetof(InternEntry, bytes) + size + 1;
+    return (bytes + sizeof (hash_t) - 1) & ~(sizeof (hash_t) - 1);
+}
+
+inline Chunk* newChunk(std::size_t size, Chunk* previous)
+{
+    Chunk* chunk = static_cast<Chunk*> (std::malloc(sizeof (Chunk) + size));
+    if (chunk == NULL)
+    {
+        throw OutOfMemoryError("unable to allocate memory for interned strings.");
+    }
+    chunk->previous = previous;
+    return chunk;
+}
+
+}
+
+InternPool::InternPool()
+{
+    for (unsigned i = 0; i < SHARD_COUNT; ++i)
+    {
+        Shard& shard = m_shards[i];
+        shard.buckets = NULL;
+        shard.bucketCount = 0;
+        shard.count = 0;
+        shard.chunks = NULL;
+        shard.cursor = NULL;
+        shard.chunkLeft = 0;
+    }
+}
+
+InternPool::~InternPool()
+{
+    for (unsigned i = 0; i < SHARD_COUNT; ++i)
+    {
+        Shard& shard = m_shards[i];
+        Chunk* chunk = static_cast<Chunk*> (shard.chunks);
+        while (chunk != NULL)
+        {
+            Chunk* previous = chunk->previous;
+            std::free(chunk);
+            chunk = previous;
+        }
+        delete[] shard.buckets;
+    }
+}
+
+InternPool& InternPool::global()
+{
+    // Never destroyed, so that type names stay valid during static destruction
+    static InternPool* pool = new InternPool();
+    return *pool;
+}
+
+const InternEntry* InternPool::lookup(const Shard& shard, hash_t hash, const char* bytes, std::size_t size)
+{
+    if (shard.bucketCount == 0)
+        return NULL;
+
+    for (const InternEntry* entry = shard.buckets[hash & (shard.bucketCount - 1)]; entry != NULL; entry = entry->next)
+    {
+        if (entry->hash == hash && entry->size == size && std::memcmp(entry->bytes, bytes, size) == 0)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+InternedString InternPool::find(const char* bytes, std::size_t size) const
+{
+    hash_t hash = core::hash(bytes, size);
+    const Shard& shard = m_shards[shardOf(hash)];
+
+    ScopedLock<SpinLock> guard(shard.lock);
+    return InternedString(lookup(shard, hash, bytes, size));
+}
+
+InternedString InternPool::intern(const char* bytes, std::size_t size)
+{
+    hash_t hash = core::hash(bytes, size);
+    Shard& shard = m_shards[shardOf(hash)];
+
+    ScopedLock<SpinLock> guard(shard.lock);
+    const InternEntry* found = lookup(shard, hash, bytes, size);
+    if (found != NULL)
+    {
+        return InternedString(found);
+    }
+
+    if (shard.count >= shard.bucketCount)
+    {
+        rehash(shard);
+    }
+
+    InternEntry* entry = static_cast<InternEntry*> (allocate(shard, entrySize(size)));
+    entry->hash = hash;
+    entry->size = size;
+    entry->hashCode = foldHash(hash) != 0 ? foldHash(hash) : 1;
+    std::memcpy(entry->bytes, bytes, size);
+    entry->bytes[size] = 0;
+
+    InternEntry*& bucket = shard.buckets[hash & (shard.bucketCount - 1)];
+    entry->next = bucket;
+    bucket = entry;
+    shard.count++;
+
+    return InternedString(entry);
+}
+
+std::size_t InternPool::size() const
+{
+    std::size_t count = 0;
+    for (unsigned i = 0; i < SHARD_COUNT; ++i)
+    {
+        ScopedLock<SpinLock> guard(m_shards[i].lock);
+        count += m_shards[i].count;
+    }
+    return count;
+}
+
+void* InternPool::allocate(Shard& shard, std::size_t size)
+{
+    if (size > LARGE_ENTRY)
+    {
+        // Large entries get a chunk of their own, linked behind the current one
+        Chunk* current = static_cast<Chunk*> (shard.chunks);
+        Chunk* chunk = newChunk(size, current != NULL ? current->previous : NULL);
+        if (current != NULL)
+            current->previous = chunk;
+        else
+            shard.chunks = chunk;
+        return chunk + 1;
+    }
+
+    if (size > shard.chunkLeft)
+    {
+        Chunk* chunk = newChunk(CHUNK_SIZE, static_cast<Chunk*> (shard.chunks));
+        shard.chunks = chunk;
+        shard.cursor = reinterpret_cast<char*> (chunk + 1);
+        shard.chunkLeft = CHUNK_SIZE;
+    }
+
+    void* block = shard.cursor;
+    shard.cursor += size;
+    shard.chunkLeft -= size;
+    return block;
+}
+
+void InternPool::rehash(Shard& shard)
+{
+    std::size_t bucketCount = shard.bucketCount != 0 ? shard.bucketCount * 2 : INITIAL_BUCKETS;
+    InternEntry** buckets = new InternEntry*[bucketCount];
+    std::memset(buckets, 0, bucketCount * sizeof (InternEntry*));
+
+    for (std::size_t i = 0; i < shard.bucketCount; ++i)
+    {
+        InternEntry* entry = shard.buckets[i];
+        while (entry != NULL)
+        {
+            InternEntry* next = entry->next;
+            InternEntry*& bucket = buckets[entry->hash & (bucketCount - 1)];
+            entry->next = bucket;
+            bucket = entry;
+            entry = next;
+        }
+    }
+
+    delete[] shard.buckets;
+    shard.buckets = buckets;
+    shard.bucketCount = bucketCount;
+}
@@ -24,20 +24,28 @@
  * Created on November 27, 2022, 1:18 AM
  */
 
+#include <Axf/Core/Hash.h>
 #include <Axf/Core/Object.h>
 
 using namespace axf;
 using namespace axf::core;
 
-#define FNV_OFFSET_BASIS_32B    2166136261u
-#define FNV_PRIME_32B           16777619u
+namespace
+{
+
+void* createObjectClass(void* storage)
+{
+    return new (storage) Class<Object>("axf::core::Object", NULL, NULL);
+}
+
+}
 
 const axf::core::Class<Object>& Object::getCompileTimeClass()
 {
-    static Class<Object> classVariable("axf::core::Object", NULL);
+    static concurrent::LazyStatic<Class<Object> > classVariable;
 
-    // Return the statically allocated class object
-    return classVariable;
+    // Return the lazily constructed class object
+    return classVariable.get(&createObjectClass);
 }
 
 Object::Object()
@@ -60,23 +68,17 @@ const bits::Type* Object::getRuntimeType() const
 
 int Object::hashCode() const
 {
-    int hash = FNV_OFFSET_BASIS_32B;
-    const char* memory = reinterpret_cast<const char*> (this);
-
-    // TODO: replace sizeof with something more descriptive (use rtti)
-    for (unsigned int i = 0; i < sizeof (*this); ++i)
-    {
-        char octet = *(memory + i);
-
-        // FNV hashing
-        hash ^= octet;
-        hash *= FNV_PRIME_32B;
-    }
-
-    return hash;
+    // Objects are only equal to themselves unless equals is overridden, so the
+    // identity of the object is hashed. Hashing the memory of the object would
+    // include the vtable and the reference counts, which change over time.
+    return foldHash(hashValue(this));
 }
 
 string Object::toString() const
 {
     return string("<");
 }
+
+void Object::traverseReferences(ReferenceVisitor&) const
+{
+}
@@ -25,7 +25,21 @@
  */
 
 #include <Axf/Core/ReferenceCounted.h>
+#include <Axf/Collections/AllocationProfiler.h>
+#include <Axf/Core/CycleCollector.h>
+#include <Axf/Core/DeferredRelease.h>
 #include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/OutOfMemoryError.h>
+#include <Axf/Concurrent/SpinLock.h>
+
+// C++
+#include <cstddef>
+#include <new>
+#include <typeinfo>
+
+#if !defined(ARTEMIS_CXX11_SUPPORTED) && !defined(ARTEMIS_PLATFORM_W32)
+#include <pthread.h>
+#endif
 
 using namespace axf;
 using namespace axf::core;
@@ -38,30 +52,677 @@ refcount_t& axf::core::init_refcount(refcount_t& rc)
     return rc;
 }
 
+void axf::core::refcount_overflow(volatile refcount_value_t& count, refcount_value_t taken)
+{
+    concurrent::atomicFetchSub(&count, taken, concurrent::RELAXED);
+    throw IllegalStateException("reference count overflow.");
+}
+
+#ifdef AXF_BIASED_REFERENCES
+
+namespace
+{
+
+/**
+ * Records of owners whose threads have finished, and no object is biased
+ * towards anymore.
+ */
+bits::BiasedOwner*      freeOwners = NULL;
+concurrent::SpinLock    ownerLock;
+
+#ifdef AXF_COMPACT_OBJECT_HEADER
+
+/**
+ * The owners by token. Tokens are handed out in order, from one, and stay
+ * with their records when they are recycled.
+ */
+const bits::bias_t MAX_OWNERS = 1u << 12;
+
+bits::BiasedOwner* volatile ownerTable[MAX_OWNERS];
+volatile bits::bias_t       ownerCount = 0;
+
+/**
+ * Assigns a token to a new owner.
+ *
+ * @param owner
+ * @return false if every token is taken
+ */
+bool assignToken(bits::BiasedOwner* owner)
+{
+    bits::bias_t token = concurrent::atomicFetchAdd(&ownerCount, 1u, concurrent::RELAXED) + 1;
+    if (token >= MAX_OWNERS)
+    {
+        return false;
+    }
+
+    owner->token = token;
+    concurrent::atomicStore(&ownerTable[token], owner, concurrent::RELEASE);
+    return true;
+}
+
+inline bits::BiasedOwner* ownerOf(bits::bias_t token)
+{
+    return concurrent::atomicLoad(&ownerTable[token], concurrent::ACQUIRE);
+}
+#else
+
+bool assignToken(bits::BiasedOwner* owner)
+{
+    owner->token = (bits::bias_t) (std::size_t) owner;
+    return true;
+}
+
+inline bits::BiasedOwner* ownerOf(bits::bias_t token)
+{
+    return (bits::BiasedOwner*) (std::size_t) token;
+}
+#endif
+
+/**
+ * Drops one of the holds on an owner record: an object biased towards it, or
+ * its running thread. The last one recycles it.
+ *
+ * @param owner
+ */
+void releaseOwner(bits::BiasedOwner* owner)
+{
+    if (concurrent::atomicFetchSub(&owner->biased, 1L, concurrent::ACQ_REL) == 1)
+    {
+        concurrent::ScopedLock<concurrent::SpinLock> guard(ownerLock);
+        owner->nextFree = freeOwners;
+        freeOwners = owner;
+    }
+}
+
+}
+
+namespace axf
+{
+namespace core
+{
+namespace bits
+{
+
+ARTEMIS_THREAD_LOCAL BiasedOwner* currentBiasedOwner = NULL;
+ARTEMIS_THREAD_LOCAL bias_t currentBiasedToken = 0;
+
+struct BiasedHandoff
+{
+
+    /**
+     * Hands a reference to an object over to its owner, linking the object
+     * into the list of the owner. The owner must merge it, so if it has
+     * finished already, the calling thread merges it.
+     *
+     * @param object
+     * @param owner
+     * @return false if the object waits for its owner already
+     */
+    static bool handOver(const ReferenceCounted* object, BiasedOwner* owner)
+    {
+        const ReferenceCounted* expected = NULL;
+        if (!concurrent::atomicCompareExchange(&object->m_handoff, expected, object, false,
+                                               concurrent::ACQUIRE, concurrent::RELAXED))
+        {
+            return false;
+        }
+
+        const ReferenceCounted* head = concurrent::atomicLoad(&owner->handoffs, concurrent::RELAXED);
+        do
+        {
+            concurrent::atomicStore(&object->m_handoff, head != NULL ? head : object, concurrent::RELAXED);
+        }
+        while (!concurrent::atomicCompareExchange(&owner->handoffs, head, object, true,
+                                                  concurrent::SEQ_CST, concurrent::RELAXED));
+
+        if (concurrent::atomicLoad(&owner->finished, concurrent::SEQ_CST) != 0)
+        {
+            mergeAll(owner);
+        }
+        return true;
+    }
+
+    /**
+     * Merges every reference handed over to an owner. Unless the owner has
+     * finished, this must be called from the thread of the owner, the only
+     * one that writes the local counts.
+     *
+     * @param owner
+     */
+    static void mergeAll(BiasedOwner* owner)
+    {
+        const ReferenceCounted* object = concurrent::atomicExchange(&owner->handoffs, (const ReferenceCounted*) NULL,
+                                                                    concurrent::SEQ_CST);
+        while (object != NULL)
+        {
+            const ReferenceCounted* next = concurrent::atomicLoad(&object->m_handoff, concurrent::RELAXED);
+            concurrent::atomicStore(&object->m_handoff, (const ReferenceCounted*) NULL, concurrent::RELEASE);
+            merge(object);
+
+            object = next != object ? next : NULL;
+        }
+    }
+
+    /**
+     * Merges the local references of an object, if it is still biased, and
+     * releases the reference that was handed over.
+     *
+     * @param object
+     */
+    static void merge(const ReferenceCounted* object)
+    {
+        bias_t bias = concurrent::atomicExchange(&object->m_bias, (bias_t) 0, concurrent::ACQ_REL);
+        if (bias != 0)
+        {
+            refcount_value_t delta = (refcount_value_t) (bias >> ReferenceCounted::BIAS_SHIFT) - ReferenceCounted::BIASED_SHARED;
+            concurrent::atomicFetchAdd(&object->m_references.m_strong, delta, concurrent::ACQ_REL);
+            releaseOwner(ownerOf(bias & ReferenceCounted::BIAS_OWNER_MASK));
+        }
+        object->releaseSharedReference();
+    }
+} ;
+
+}
+}
+}
+
+namespace
+{
+
+typedef enum OwnerState
+{
+    OWNER_NONE = 0,
+    OWNER_ACTIVE,
+    OWNER_FINISHED
+} OwnerState;
+
+ARTEMIS_THREAD_LOCAL int ownerState;
+
+
+/**
+ * Stops treating the calling thread as the owner of its biased objects, and
+ * merges what was handed over to it. References handed over afterwards are
+ * merged by the threads that hand them over.
+ */
+void finishOwner()
+{
+    bits::BiasedOwner* owner = bits::currentBiasedOwner;
+
+    bits::currentBiasedOwner = NULL;
+    bits::currentBiasedToken = 0;
+    ownerState = OWNER_FINISHED;
+
+    concurrent::atomicStore(&owner->finished, 1, concurrent::SEQ_CST);
+    bits::BiasedHandoff::mergeAll(owner);
+    releaseOwner(owner);
+}
+
+#if defined(ARTEMIS_CXX11_SUPPORTED)
+
+/**
+ * A thread local object whose only purpose is to run
+ * <code>finishOwner</code> when the thread exits.
+ */
+struct OwnerReaper
+{
+
+    void arm() { }
+
+    ~OwnerReaper()
+    {
+        finishOwner();
+    }
+} ;
+
+bool registerOwner()
+{
+    static thread_local OwnerReaper reaper;
+    reaper.arm();
+    return true;
+}
+#elif !defined(ARTEMIS_PLATFORM_W32)
+
+pthread_key_t   ownerReaperKey;
+pthread_once_t  ownerReaperOnce = PTHREAD_ONCE_INIT;
+
+extern "C" void reapOwner(void*)
+{
+    finishOwner();
+}
+
+extern "C" void createOwnerReaperKey()
+{
+    pthread_key_create(&ownerReaperKey, reapOwner);
+}
+
+bool registerOwner()
+{
+    pthread_once(&ownerReaperOnce, createOwnerReaperKey);
+    return pthread_setspecific(ownerReaperKey, bits::currentBiasedOwner) == 0;
+}
+#else
+
+/* Without C++11 there is no portable way to run code on thread exit under
+ * Windows, and references handed over to a thread that finished would never
+ * be merged: threads never own biased objects there. */
+bool registerOwner()
+{
+    return false;
+}
+#endif
+
+/**
+ * Returns the owner of the calling thread, taking a record for it if needed,
+ * or NULL if the thread does not bias objects.
+ *
+ * @return
+ */
+bits::BiasedOwner* acquireOwner()
+{
+    if (ARTEMIS_LIKELY(ownerState == OWNER_ACTIVE))
+    {
+        return bits::currentBiasedOwner;
+    }
+    if (ownerState == OWNER_FINISHED)
+    {
+        return NULL;
+    }
+
+    bits::BiasedOwner* owner;
+    {
+        concurrent::ScopedLock<concurrent::SpinLock> guard(ownerLock);
+        owner = freeOwners;
+        if (owner != NULL)
+        {
+            freeOwners = owner->nextFree;
+        }
+    }
+    if (owner == NULL)
+    {
+        owner = new (std::nothrow) bits::BiasedOwner;
+        if (owner == NULL)
+        {
+            return NULL;
+        }
+
+        owner->handoffs = NULL;
+        if (!assignToken(owner))
+        {
+            // Out of tokens: this thread never biases objects
+            delete owner;
+            ownerState = OWNER_FINISHED;
+            return NULL;
+        }
+    }
+
+    // References may still be handed over to a recycled record; they are
+    // merged by whoever sees it running again
+    owner->nextFree = NULL;
+    concurrent::atomicStore(&owner->biased, 1L, concurrent::RELAXED);
+    concurrent::atomicStore(&owner->finished, 0, concurrent::SEQ_CST);
+
+    bits::currentBiasedOwner = owner;
+    bits::currentBiasedToken = owner->token;
+    ownerState = OWNER_ACTIVE;
+    if (!registerOwner())
+    {
+        finishOwner();
+        return NULL;
+    }
+
+    return owner;
+}
+
+}
+#endif
+
+namespace
+{
+
+/**
+ * The blocks of weak references, allocated in chunks that are never freed, so
+ * that an index always names the same block. Index zero names none.
+ */
+const std::size_t CONTROL_CHUNK_SIZE = 1024;
+const std::size_t MAX_CONTROL_CHUNKS = 1 << 16;
+
+bits::WeakControl* volatile controlChunks[MAX_CONTROL_CHUNKS];
+std::size_t                 controlCount = 0;
+bits::WeakControl*          freeControls = NULL;
+concurrent::SpinLock        controlLock;
+
+inline bits::WeakControl* controlAt(refcount_value_t index)
+{
+    std::size_t slot = (std::size_t) index - 1;
+    return concurrent::atomicLoad(&controlChunks[slot / CONTROL_CHUNK_SIZE], concurrent::ACQUIRE)
+            + slot % CONTROL_CHUNK_SIZE;
+}
+
+/**
+ * Takes a free block of weak references, for an object that holds the only
+ * reference to it.
+ *
+ * @param object
+ * @return
+ */
+bits::WeakControl* allocateControl(const ReferenceCounted* object)
+{
+    bits::WeakControl* control;
+    {
+        concurrent::ScopedLock<concurrent::SpinLock> guard(controlLock);
+        if (freeControls != NULL)
+        {
+            control = freeControls;
+            freeControls = control->nextFree;
+        }
+        else
+        {
+            std::size_t chunk = controlCount / CONTROL_CHUNK_SIZE;
+            if (controlCount % CONTROL_CHUNK_SIZE == 0)
+            {
+                if (chunk == MAX_CONTROL_CHUNKS)
+                    throw OutOfMemoryError("too many weakly referenced objects.");
+
+                bits::WeakControl* blocks = new (std::nothrow) bits::WeakControl[CONTROL_CHUNK_SIZE];
+                if (blocks == NULL)
+                    throw OutOfMemoryError("no memory left for weak references.");
+                concurrent::atomicStore(&controlChunks[chunk], blocks, concurrent::RELEASE);
+            }
+
+            control = controlChunks[chunk] + controlCount % CONTROL_CHUNK_SIZE;
+            control->index = (refcount_value_t) ++controlCount;
+        }
+    }
+
+    control->object = object;
+    control->references = 1;
+    control->upgrading = 0;
+    control->nextFree = NULL;
+    return control;
+}
+
+void freeControl(bits::WeakControl* control)
+{
+    concurrent::ScopedLock<concurrent::SpinLock> guard(controlLock);
+    control->nextFree = freeControls;
+    freeControls = control;
+}
+
+}
+
 ReferenceCounted::~ReferenceCounted()
 {
-    m_references.m_strong = -1;
-    m_references.m_weak = -1;
 }
 
-void ReferenceCounted::releaseStrongReference() const
+void* ReferenceCounted::operator new(std::size_t size)
+{
+    void* memory = ::operator new(size);
+    collections::AllocationProfiler::recordObjectAllocation(memory, size);
+    return memory;
+}
+
+void* ReferenceCounted::operator new(std::size_t size, const std::nothrow_t&) throw()
+{
+    void* memory = ::operator new(size, std::nothrow);
+    collections::AllocationProfiler::recordObjectAllocation(memory, size);
+    return memory;
+}
+
+void ReferenceCounted::operator delete(void* memory)
+{
+    collections::AllocationProfiler::recordDeallocation(memory);
+    ::operator delete(memory);
+}
+
+void ReferenceCounted::operator delete(void* memory, const std::nothrow_t&) throw()
+{
+    collections::AllocationProfiler::recordDeallocation(memory);
+    ::operator delete(memory);
+}
+
+void ReferenceCounted::typeAllocation() const
+{
+    collections::AllocationProfiler::recordObjectType(dynamic_cast<const void*> (this), typeid (*this));
+}
+
+void ReferenceCounted::releaseSharedReference() const
+{
+#ifdef AXF_BIASED_REFERENCES
+    bits::bias_t bias = concurrent::atomicLoad(&m_bias, concurrent::RELAXED);
+    if (bias != 0 && isOwnedLocally(bias))
+    {
+        // The owner drops its last local reference: merge the local count
+        // into the shared one, which is the only one from now on
+        refcount_value_t delta = (refcount_value_t) (bias >> BIAS_SHIFT) - 1 - BIASED_SHARED;
+
+        concurrent::atomicStore(&m_bias, (bits::bias_t) 0, concurrent::RELAXED);
+        releaseOwner(bits::currentBiasedOwner);
+        if (concurrent::atomicFetchAdd(&m_references.m_strong, delta, concurrent::ACQ_REL) + delta == 0)
+        {
+            dispose();
+        }
+        mergeBiasedReferences();
+        return;
+    }
+#endif
+
+    refcount_value_t strong = concurrent::atomicLoad(&m_references.m_strong, concurrent::RELAXED);
+    for (;;)
+    {
+#ifdef AXF_BIASED_REFERENCES
+        if (strong < BIASED_SHARED / 2)
+#endif
+        {
+            if (strong <= 0)
+                throw IllegalStateException("attempted to release a reference of an already deleted object.");
+
+#ifdef AXF_CYCLE_COLLECTION
+            // An object left referenced may be held by a garbage cycle. It
+            // is recorded while this reference still keeps it alive, since
+            // it may be gone right after the release
+            unsigned cycle = concurrent::atomicLoad(&m_cycle, concurrent::RELAXED);
+            if (ARTEMIS_UNLIKELY((cycle & bits::CYCLE_COLLECTABLE) != 0) && strong > 1
+                && (cycle & bits::CYCLE_COLOR) != bits::CYCLE_PURPLE)
+            {
+                CycleCollector::addCandidate(this);
+            }
+#endif
+
+            if (refcount_release_strong(m_references))
+            {
+                dispose();
+            }
+            return;
+        }
+
+#ifdef AXF_BIASED_REFERENCES
+        if (strong > BIASED_SHARED)
+        {
+            if (concurrent::atomicCompareExchange(&m_references.m_strong, strong, strong - 1, true,
+                                                  concurrent::RELEASE, concurrent::RELAXED))
+                return;
+            continue;
+        }
+
+        // Every reference the shared count knows of may be gone, only the
+        // owner can tell whether this one was the last
+        bias = concurrent::atomicLoad(&m_bias, concurrent::ACQUIRE);
+        if (bias == 0)
+        {
+            // The object is being biased or merged right now
+            concurrent::cpuRelax();
+            strong = concurrent::atomicLoad(&m_references.m_strong, concurrent::RELAXED);
+            continue;
+        }
+        if (bits::BiasedHandoff::handOver(this, ownerOf(bias & BIAS_OWNER_MASK)))
+        {
+            return;
+        }
+
+        // Another reference waits for the owner already, and keeps the
+        // object alive until it is merged: this one may go into the shared
+        // count, even below the offset. Merging changes the count, so the
+        // exchange fails if it happens meanwhile
+        if (concurrent::atomicCompareExchange(&m_references.m_strong, strong, strong - 1, true,
+                                              concurrent::RELEASE, concurrent::RELAXED))
+            return;
+#endif
+    }
+}
+
+bool ReferenceCounted::biasToCurrentThread() const
+{
+#ifdef AXF_BIASED_REFERENCES
+    bits::BiasedOwner* owner = acquireOwner();
+    if (owner == NULL)
+    {
+        return false;
+    }
+
+    refcount_value_t expected = 1;
+    if (!concurrent::atomicCompareExchange(&m_references.m_strong, expected, BIASED_SHARED, false,
+                                           concurrent::ACQ_REL, concurrent::RELAXED))
+    {
+        return false;
+    }
+
+    // The only reference becomes the first local one
+    concurrent::atomicFetchAdd(&owner->biased, 1L, concurrent::RELAXED);
+    concurrent::atomicStore(&m_bias, owner->token | BIAS_LOCAL_ONE, concurrent::RELEASE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ReferenceCounted::mergeBiasedReferences()
 {
-    if (m_references.m_strong == 0)
-        throw IllegalStateException("attempted to release a reference of an already deleted object.");
+#ifdef AXF_BIASED_REFERENCES
+    bits::BiasedOwner* owner = bits::currentBiasedOwner;
+    if (owner != NULL && concurrent::atomicLoad(&owner->handoffs, concurrent::RELAXED) != NULL)
+    {
+        bits::BiasedHandoff::mergeAll(owner);
+    }
+#endif
+}
 
-    if (--m_references.m_strong <= 0)
+bits::WeakControl* ReferenceCounted::queryWeakControl() const
+{
+    refcount_value_t index = concurrent::atomicLoad(&m_references.m_weak, concurrent::ACQUIRE);
+    if (index != 0)
     {
-        delete this;
+        return controlAt(index);
     }
+
+    bits::WeakControl* control = allocateControl(this);
+    if (!concurrent::atomicCompareExchange(&m_references.m_weak, index, control->index, false,
+                                           concurrent::ACQ_REL, concurrent::ACQUIRE))
+    {
+        // Another thread gave this object its block first
+        freeControl(control);
+        control = controlAt(index);
+    }
+    return control;
+}
+
+void ReferenceCounted::grabWeakReference() const
+{
+    queryWeakControl()->grab();
 }
 
 void ReferenceCounted::releaseWeakReference() const
 {
-    if (m_references.m_weak == 0)
-        throw IllegalStateException("attempted to release a reference of an already deleted object.");
+    refcount_value_t index = concurrent::atomicLoad(&m_references.m_weak, concurrent::ACQUIRE);
+    if (index == 0 || concurrent::atomicLoad(&controlAt(index)->references, concurrent::RELAXED) <= 1)
+        throw IllegalStateException("attempted to release a weak reference the object does not have.");
+
+    controlAt(index)->release();
+}
+
+long ReferenceCounted::queryWeakReferences() const
+{
+    refcount_value_t index = concurrent::atomicLoad(&m_references.m_weak, concurrent::ACQUIRE);
+    return index != 0 ? controlAt(index)->users() : 0;
+}
 
-    if (--m_references.m_weak <= 0 && (m_references.m_strong == 0))
+void ReferenceCounted::dispose() const
+{
+    refcount_value_t index = concurrent::atomicLoad(&m_references.m_weak, concurrent::ACQUIRE);
+    if (index != 0)
     {
-        delete this;
+        bits::WeakControl* control = controlAt(index);
+        if (!control->claim(this))
+        {
+            // The last weak reference is destroying this object already
+            return;
+        }
+        control->retire(this);
     }
+    reclaim();
+}
+
+void ReferenceCounted::reclaim() const
+{
+    if (!DeferredRelease::defer(this))
+    {
+        destroy();
+    }
+}
+
+void ReferenceCounted::destroy() const
+{
+    delete this;
+}
+
+void bits::WeakControl::release()
+{
+    refcount_value_t left = concurrent::atomicFetchSub(&references, 1, concurrent::ACQ_REL) - 1;
+    if (left == 0)
+    {
+        freeControl(this);
+        return;
+    }
+    if (left != 1)
+    {
+        return;
+    }
+
+    // Only the reference of the object may be left. An object that was never
+    // strongly referenced belongs to its weak references, so it goes now
+    concurrent::atomicFetchAdd(&upgrading, 1);
+    const ReferenceCounted* owner = concurrent::atomicLoad(&object);
+    bool orphan = owner != NULL && concurrent::atomicLoad(&owner->m_references.m_strong, concurrent::ACQUIRE) == 0;
+    concurrent::atomicFetchSub(&upgrading, 1, concurrent::RELEASE);
+
+    if (orphan && claim(owner))
+    {
+        retire(owner);
+        owner->reclaim();
+    }
+}
+
+bool bits::WeakControl::expired()
+{
+    concurrent::atomicFetchAdd(&upgrading, 1);
+    const ReferenceCounted* owner = concurrent::atomicLoad(&object);
+    bool dead = owner == NULL || owner->queryStrongReferences() <= 0;
+    concurrent::atomicFetchSub(&upgrading, 1, concurrent::RELEASE);
+    return dead;
+}
+
+bool bits::WeakControl::claim(const ReferenceCounted* owner)
+{
+    const ReferenceCounted* expected = owner;
+    return concurrent::atomicCompareExchange(&object, expected, (const ReferenceCounted*) NULL);
+}
+
+void bits::WeakControl::retire(const ReferenceCounted* owner)
+{
+    while (concurrent::atomicLoad(&upgrading) != 0)
+    {
+        concurrent::cpuRelax();
+    }
+
+    concurrent::atomicStore(&owner->m_references.m_weak, (refcount_value_t) 0, concurrent::RELAXED);
+    release();
 }
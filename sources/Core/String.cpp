@@ -25,17 +25,45 @@
  */
 
 #include <Axf/Core/String.h>
+#include <Axf/Core/Hash.h>
 #include <Axf/Core/IndexOutOfBoundsException.h>
 #include <Axf/Core/IllegalStateException.h>
 
+// C
+#include <cstring>
+
 using namespace axf;
 using namespace axf::core;
 
+namespace
+{
+
+/**
+ * Counts the UTF-8 encoded characters in a buffer of the given size. Every
+ * byte that is not a continuation byte starts a new character.
+ */
+size_t countCharacters(const unsigned char* buffer, size_t size)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if ((buffer[i] & 0xC0) != 0x80)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}
+
 string::string()
 :
 m_buffer(NULL),
 m_capacity(0),
-m_size(0)
+m_length(0),
+m_size(0),
+m_hash(0)
 {
 }
 
@@ -43,18 +71,69 @@ string::string(const char* cstr)
 :
 m_buffer(NULL),
 m_capacity(0),
-m_size(0)
+m_length(0),
+m_size(0),
+m_hash(0)
+{
+    if (cstr != NULL)
+    {
+        assign(reinterpret_cast<const utf8_char*> (cstr), std::strlen(cstr));
+    }
+}
+
+string::string(const char* bytes, size_t size)
+:
+m_buffer(NULL),
+m_capacity(0),
+m_length(0),
+m_size(0),
+m_hash(0)
 {
+    assign(reinterpret_cast<const utf8_char*> (bytes), size);
 }
 
 string::string(const wchar_t* wstr)
 :
 m_buffer(NULL),
 m_capacity(0),
-m_size(0)
+m_length(0),
+m_size(0),
+m_hash(0)
 {
 }
 
+string::string(const string& rhs)
+:
+ReferenceCounted(),
+m_buffer(NULL),
+m_capacity(0),
+m_length(0),
+m_size(0),
+m_hash(0)
+{
+    assign(rhs.m_buffer, rhs.m_size);
+    m_hash = concurrent::atomicLoad(&rhs.m_hash, concurrent::RELAXED);
+}
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+string::string(string&& rhs)
+:
+ReferenceCounted(),
+m_buffer(rhs.m_buffer),
+m_capacity(rhs.m_capacity),
+m_length(rhs.m_length),
+m_size(rhs.m_size),
+m_hash(rhs.m_hash)
+{
+    rhs.m_buffer = NULL;
+    rhs.m_capacity = 0;
+    rhs.m_length = 0;
+    rhs.m_size = 0;
+    rhs.m_hash = 0;
+}
+#endif
+
 string::~string()
 {
     clear();
@@ -62,9 +141,87 @@ string::~string()
 
 string& string::append(const string& str)
 {
+    if (str.m_size > 0)
+    {
+        if (m_size + str.m_size + 1 > m_capacity)
+        {
+            // Grow geometrically to keep repeated appends amortized constant
+            size_t required = m_size + str.m_size + 1;
+            size_t grown = m_capacity * 2;
+
+            resize((int) (((grown > required) ? grown : required) - m_capacity));
+        }
+
+        std::memcpy(m_buffer + m_size, str.m_buffer, str.m_size);
+        m_size += str.m_size;
+        m_length += str.m_length;
+        m_buffer[m_size] = 0;
+        m_hash = 0;
+    }
+    return *this;
+}
+
+void string::assign(const utf8_char* bytes, size_t size)
+{
+    m_hash = 0;
+    if (size == 0)
+    {
+        m_length = 0;
+        m_size = 0;
+        if (m_buffer != NULL)
+            m_buffer[0] = 0;
+        return;
+    }
+
+    if (size + 1 > m_capacity)
+    {
+        clear();
+
+        m_buffer = new utf8_char[size + 1];
+        m_capacity = size + 1;
+    }
+
+    std::memcpy(m_buffer, bytes, size);
+    m_buffer[size] = 0;
+
+    m_length = countCharacters(m_buffer, size);
+    m_size = size;
+}
+
+string& string::operator=(const string& rhs)
+{
+    if (this != &rhs)
+    {
+        assign(rhs.m_buffer, rhs.m_size);
+        m_hash = concurrent::atomicLoad(&rhs.m_hash, concurrent::RELAXED);
+    }
     return *this;
 }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+string& string::operator=(string&& rhs)
+{
+    if (this != &rhs)
+    {
+        clear();
+
+        m_buffer = rhs.m_buffer;
+        m_capacity = rhs.m_capacity;
+        m_length = rhs.m_length;
+        m_size = rhs.m_size;
+        m_hash = rhs.m_hash;
+
+        rhs.m_buffer = NULL;
+        rhs.m_capacity = 0;
+        rhs.m_length = 0;
+        rhs.m_size = 0;
+        rhs.m_hash = 0;
+    }
+    return *this;
+}
+#endif
+
 string::utf8_char* string::arrayCopy(int startIndex, int endIndex, utf8_char* newArray) const
 {
     if (startIndex < 0)
@@ -92,16 +249,56 @@ void string::clear()
 {
     if (m_buffer != NULL)
     {
-        delete m_buffer;
+        delete[] m_buffer;
+        m_buffer = NULL;
     }
     m_capacity = 0;
     m_length = 0;
     m_size = 0;
+    m_hash = 0;
+}
+
+int string::computeHashCode() const
+{
+    int hash = foldHash(axf::core::hash(m_buffer, m_size));
+
+    // Zero marks an empty cache, a string hashing to zero takes another value
+    return hash != 0 ? hash : 1;
+}
+
+bool string::equals(const string& rhs) const
+{
+    if (m_size != rhs.m_size)
+        return false;
+    if (m_size == 0 || m_buffer == rhs.m_buffer)
+        return true;
+
+    // Different hashes, if both are known, answer without comparing bytes
+    int lhsHash = concurrent::atomicLoad(&m_hash, concurrent::RELAXED);
+    int rhsHash = concurrent::atomicLoad(&rhs.m_hash, concurrent::RELAXED);
+    if (lhsHash != 0 && rhsHash != 0 && lhsHash != rhsHash)
+        return false;
+
+    return std::memcmp(m_buffer, rhs.m_buffer, m_size) == 0;
 }
 
 void string::resize(int delta)
 {
-    if (((int) m_capacity) - delta < 0)
+    if (((int) m_capacity) + delta < 0)
         throw IllegalStateException("attempted to resize a string below zero capacity.");
 
+    size_t capacity = m_capacity + delta;
+    if (capacity <= m_size)
+        throw IllegalStateException("attempted to resize a string below its size.");
+
+    utf8_char* buffer = new utf8_char[capacity];
+    if (m_buffer != NULL)
+    {
+        std::memcpy(buffer, m_buffer, m_size);
+        delete[] m_buffer;
+    }
+    buffer[m_size] = 0;
+
+    m_buffer = buffer;
+    m_capacity = capacity;
 }
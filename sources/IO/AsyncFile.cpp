@@ -0,0 +1,679 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   AsyncFile.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:30 AM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Core/IllegalOperationException.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/IO/AsyncFile.h>
+#include <Axf/IO/IOException.h>
+
+// C
+#include <cerrno>
+#include <cstring>
+
+#ifndef ARTEMIS_PLATFORM_W32
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// io_uring is used through raw system calls, there is no dependency on liburing
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define AXF_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+namespace axf
+{
+namespace io
+{
+namespace bits
+{
+
+/**
+ * A backend of <code>AsyncFile</code>. Backends only deal with operations,
+ * and are driven from the thread owning the file.
+ */
+class AsyncEngine
+{
+public:
+
+    virtual ~AsyncEngine() { }
+
+    /**
+     * Starts <code>count</code> operations, then waits until at least
+     * <code>minimum</code> operations complete, and appends every operation
+     * that completed to <code>completed</code>.
+     *
+     * @param operations
+     * @param count
+     * @param minimum
+     * @param completed
+     */
+    virtual void enter(AsyncOperation* const* operations, std::size_t count, std::size_t minimum,
+                       std::vector<AsyncOperation*>& completed) = 0;
+} ;
+
+}
+}
+}
+
+#ifndef ARTEMIS_PLATFORM_W32
+
+namespace
+{
+
+/**
+ * Clamps transfers to what a single system call accepts.
+ */
+const std::size_t MAX_TRANSFER = 0x7ffff000;
+
+/**
+ * Carries out an operation with blocking calls, retrying interrupted and
+ * short transfers. Reads stop at the end of the file.
+ *
+ * @param operation
+ */
+void perform(axf::io::bits::AsyncOperation* operation)
+{
+    std::size_t done = 0;
+    while (done < operation->length)
+    {
+        std::size_t length = operation->length - done;
+        if (length > MAX_TRANSFER)
+            length = MAX_TRANSFER;
+
+        off_t offset = (off_t) (operation->offset + done);
+        ssize_t transferred = operation->write
+                ? ::pwrite(operation->descriptor, operation->data + done, length, offset)
+                : ::pread(operation->descriptor, operation->data + done, length, offset);
+        if (transferred < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            // Report the error only if nothing was transferred
+            if (done == 0)
+            {
+                operation->result = -errno;
+                return;
+            }
+            break;
+        }
+        if (transferred == 0)
+            break;
+        done += (std::size_t) transferred;
+    }
+    operation->result = (long) done;
+}
+
+/**
+ * Carries out operations on a pool of threads, each one blocking on
+ * <code>pread</code> or <code>pwrite</code>.
+ */
+class ThreadPoolEngine : public axf::io::bits::AsyncEngine
+{
+public:
+
+    static const unsigned MAX_THREADS = 16;
+
+    explicit ThreadPoolEngine(unsigned queueDepth)
+    :
+    m_head(NULL),
+    m_tail(NULL),
+    m_wanted(0),
+    m_stop(false),
+    m_threadCount(0)
+    {
+        pthread_mutex_init(&m_mutex, NULL);
+        pthread_cond_init(&m_work, NULL);
+        pthread_cond_init(&m_done, NULL);
+
+        unsigned threads = queueDepth < MAX_THREADS ? queueDepth : MAX_THREADS;
+        for (; m_threadCount < threads; ++m_threadCount)
+        {
+            int error = pthread_create(&m_threads[m_threadCount], NULL, run, this);
+            if (error != 0)
+            {
+                if (m_threadCount != 0)
+                    break;
+
+                destroy();
+                throw IOException("unable to start the threads of an asynchronous file", error);
+            }
+        }
+    }
+
+    ~ThreadPoolEngine()
+    {
+        destroy();
+    }
+
+    void enter(axf::io::bits::AsyncOperation* const* operations, std::size_t count, std::size_t minimum,
+               std::vector<axf::io::bits::AsyncOperation*>& completed)
+    {
+        pthread_mutex_lock(&m_mutex);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            operations[i]->next = NULL;
+            if (m_tail != NULL)
+                m_tail->next = operations[i];
+            else
+                m_head = operations[i];
+            m_tail = operations[i];
+        }
+        if (count == 1)
+            pthread_cond_signal(&m_work);
+        else if (count > 1)
+            pthread_cond_broadcast(&m_work);
+
+        m_wanted = minimum;
+        while (m_completed.size() < m_wanted)
+            pthread_cond_wait(&m_done, &m_mutex);
+        m_wanted = 0;
+
+        completed.insert(completed.end(), m_completed.begin(), m_completed.end());
+        m_completed.clear();
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+private:
+
+    pthread_mutex_t                                 m_mutex;
+    pthread_cond_t                                  m_work;         /// Signaled when operations arrive
+    pthread_cond_t                                  m_done;         /// Signaled when enough operations complete
+    axf::io::bits::AsyncOperation*                  m_head;         /// The first operation not started
+    axf::io::bits::AsyncOperation*                  m_tail;         /// The last operation not started
+    std::vector<axf::io::bits::AsyncOperation*>     m_completed;    /// Completions not delivered yet
+    std::size_t                                     m_wanted;       /// Completions the owner waits for
+    bool                                            m_stop;
+    unsigned                                        m_threadCount;
+    pthread_t                                       m_threads[MAX_THREADS];
+
+    void destroy()
+    {
+        pthread_mutex_lock(&m_mutex);
+        m_stop = true;
+        pthread_cond_broadcast(&m_work);
+        pthread_mutex_unlock(&m_mutex);
+
+        for (unsigned i = 0; i < m_threadCount; ++i)
+            pthread_join(m_threads[i], NULL);
+
+        pthread_cond_destroy(&m_done);
+        pthread_cond_destroy(&m_work);
+        pthread_mutex_destroy(&m_mutex);
+    }
+
+    static void* run(void* argument)
+    {
+        ThreadPoolEngine* engine = static_cast<ThreadPoolEngine*> (argument);
+
+        pthread_mutex_lock(&engine->m_mutex);
+        for (;;)
+        {
+            while (engine->m_head == NULL && !engine->m_stop)
+                pthread_cond_wait(&engine->m_work, &engine->m_mutex);
+            if (engine->m_head == NULL)
+                break;
+
+            axf::io::bits::AsyncOperation* operation = engine->m_head;
+            engine->m_head = operation->next;
+            if (engine->m_head == NULL)
+                engine->m_tail = NULL;
+            pthread_mutex_unlock(&engine->m_mutex);
+
+            perform(operation);
+
+            pthread_mutex_lock(&engine->m_mutex);
+            engine->m_completed.push_back(operation);
+            if (engine->m_completed.size() == engine->m_wanted)
+                pthread_cond_signal(&engine->m_done);
+        }
+        pthread_mutex_unlock(&engine->m_mutex);
+        return NULL;
+    }
+} ;
+
+#ifdef AXF_HAVE_IO_URING
+
+/**
+ * Carries out operations through an io_uring instance. Submitting a batch
+ * and waiting for completions takes a single system call, and the
+ * completions are read from memory shared with the kernel.
+ */
+class UringEngine : public axf::io::bits::AsyncEngine
+{
+public:
+
+    explicit UringEngine(unsigned queueDepth)
+    :
+    m_ring(-1),
+    m_submissionRing(MAP_FAILED),
+    m_submissionRingSize(0),
+    m_completionRing(MAP_FAILED),
+    m_completionRingSize(0),
+    m_entries(static_cast<io_uring_sqe*> (MAP_FAILED)),
+    m_entriesSize(0),
+    m_unsubmitted(0)
+    {
+        io_uring_params parameters;
+        std::memset(&parameters, 0, sizeof (parameters));
+
+        m_ring = (int) syscall(__NR_io_uring_setup, queueDepth, &parameters);
+        if (m_ring < 0)
+            throw IOException("io_uring_setup", "<io_uring>", errno);
+
+        // The read and write operations appeared along with this feature
+        if ((parameters.features & IORING_FEAT_RW_CUR_POS) == 0)
+        {
+            destroy();
+            throw IOException("io_uring_setup", "<io_uring>", EOPNOTSUPP);
+        }
+
+        m_submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof (unsigned);
+        m_completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof (io_uring_cqe);
+        if (parameters.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if (m_completionRingSize > m_submissionRingSize)
+                m_submissionRingSize = m_completionRingSize;
+            m_completionRingSize = 0;
+        }
+
+        m_submissionRing = mmap(NULL, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                m_ring, IORING_OFF_SQ_RING);
+        if (m_submissionRing != MAP_FAILED && m_completionRingSize != 0)
+        {
+            m_completionRing = mmap(NULL, m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    m_ring, IORING_OFF_CQ_RING);
+        }
+        m_entriesSize = parameters.sq_entries * sizeof (io_uring_sqe);
+        m_entries = static_cast<io_uring_sqe*> (mmap(NULL, m_entriesSize, PROT_READ | PROT_WRITE,
+                                                     MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES));
+        if (m_submissionRing == MAP_FAILED || m_entries == MAP_FAILED
+            || (m_completionRingSize != 0 && m_completionRing == MAP_FAILED))
+        {
+            int error = errno;
+            destroy();
+            throw IOException("mmap", "<io_uring>", error);
+        }
+
+        unsigned char* submission = static_cast<unsigned char*> (m_submissionRing);
+        unsigned char* completion = static_cast<unsigned char*> (m_completionRingSize != 0 ? m_completionRing
+                                                                                          : m_submissionRing);
+        m_submissionHead = reinterpret_cast<unsigned*> (submission + parameters.sq_off.head);
+        m_submissionTail = reinterpret_cast<unsigned*> (submission + parameters.sq_off.tail);
+        m_submissionMask = *reinterpret_cast<unsigned*> (submission + parameters.sq_off.ring_mask);
+        m_submissionArray = reinterpret_cast<unsigned*> (submission + parameters.sq_off.array);
+        m_completionHead = reinterpret_cast<unsigned*> (completion + parameters.cq_off.head);
+        m_completionTail = reinterpret_cast<unsigned*> (completion + parameters.cq_off.tail);
+        m_completionMask = *reinterpret_cast<unsigned*> (completion + parameters.cq_off.ring_mask);
+        m_completions = reinterpret_cast<io_uring_cqe*> (completion + parameters.cq_off.cqes);
+    }
+
+    ~UringEngine()
+    {
+        destroy();
+    }
+
+    void enter(axf::io::bits::AsyncOperation* const* operations, std::size_t count, std::size_t minimum,
+               std::vector<axf::io::bits::AsyncOperation*>& completed)
+    {
+        // Only this thread produces submissions, the tail may be read plainly
+        unsigned tail = *m_submissionTail;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const axf::io::bits::AsyncOperation* operation = operations[i];
+            unsigned index = tail & m_submissionMask;
+
+            io_uring_sqe* entry = &m_entries[index];
+            std::memset(entry, 0, sizeof (io_uring_sqe));
+            entry->opcode = operation->write ? IORING_OP_WRITE : IORING_OP_READ;
+            entry->fd = operation->descriptor;
+            entry->addr = (unsigned long long) (std::size_t) operation->data;
+            entry->len = (unsigned) (operation->length < MAX_TRANSFER ? operation->length : MAX_TRANSFER);
+            entry->off = operation->offset;
+            entry->user_data = (unsigned long long) (std::size_t) operation;
+
+            m_submissionArray[index] = index;
+            ++tail;
+        }
+        concurrent::atomicStore(m_submissionTail, tail, concurrent::RELEASE);
+        m_unsubmitted += (unsigned) count;
+
+        std::size_t before = completed.size();
+        harvest(completed);
+
+        std::size_t ready = completed.size() - before;
+        unsigned waitFor = minimum > ready ? (unsigned) (minimum - ready) : 0;
+        if (m_unsubmitted != 0 || waitFor != 0)
+        {
+            int submitted;
+            do
+            {
+                submitted = (int) syscall(__NR_io_uring_enter, m_ring, m_unsubmitted, waitFor,
+                                          waitFor != 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+            }
+            while (submitted < 0 && errno == EINTR);
+
+            if (submitted < 0)
+                throw IOException("io_uring_enter", "<io_uring>", errno);
+            m_unsubmitted -= (unsigned) submitted;
+
+            harvest(completed);
+        }
+    }
+
+private:
+
+    int                 m_ring;
+    void*               m_submissionRing;
+    std::size_t         m_submissionRingSize;
+    void*               m_completionRing;       /// MAP_FAILED if shared with the submission ring
+    std::size_t         m_completionRingSize;
+    io_uring_sqe*       m_entries;
+    std::size_t         m_entriesSize;
+    unsigned*           m_submissionHead;
+    unsigned*           m_submissionTail;
+    unsigned            m_submissionMask;
+    unsigned*           m_submissionArray;
+    unsigned*           m_completionHead;
+    unsigned*           m_completionTail;
+    unsigned            m_completionMask;
+    io_uring_cqe*       m_completions;
+    unsigned            m_unsubmitted;          /// Entries in the ring the kernel did not consume
+
+    void destroy()
+    {
+        if (m_entries != MAP_FAILED)
+            munmap(m_entries, m_entriesSize);
+        if (m_completionRing != MAP_FAILED)
+            munmap(m_completionRing, m_completionRingSize);
+        if (m_submissionRing != MAP_FAILED)
+            munmap(m_submissionRing, m_submissionRingSize);
+        if (m_ring >= 0)
+            ::close(m_ring);
+    }
+
+    void harvest(std::vector<axf::io::bits::AsyncOperation*>& completed)
+    {
+        unsigned head = *m_completionHead;
+        unsigned tail = concurrent::atomicLoad(m_completionTail, concurrent::ACQUIRE);
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe* entry = &m_completions[head & m_completionMask];
+            axf::io::bits::AsyncOperation* operation =
+                    reinterpret_cast<axf::io::bits::AsyncOperation*> ((std::size_t) entry->user_data);
+            operation->result = entry->res;
+            completed.push_back(operation);
+        }
+        concurrent::atomicStore(m_completionHead, head, concurrent::RELEASE);
+    }
+} ;
+
+#endif
+
+}
+
+#endif
+
+AsyncRequest::AsyncRequest(AsyncFile* file, bool write, unsigned long long offset, ByteBuffer* buffer,
+                           unsigned char* data, std::size_t length, CompletionHandler handler, void* context)
+:
+m_file(file),
+m_buffer(buffer),
+m_handler(handler),
+m_context(context),
+m_done(false)
+{
+    m_operation.next = NULL;
+    m_operation.request = this;
+    m_operation.descriptor = file->m_descriptor;
+    m_operation.write = write;
+    m_operation.data = data;
+    m_operation.length = length;
+    m_operation.offset = offset;
+    m_operation.result = 0;
+}
+
+AsyncRequest::~AsyncRequest()
+{
+}
+
+std::size_t AsyncRequest::getBytesTransferred() const
+{
+    if (!m_done)
+        throw IllegalStateException("the asynchronous request has not completed");
+    if (m_operation.result < 0)
+    {
+        throw IOException(m_operation.write ? "asynchronous write failed" : "asynchronous read failed",
+                          (int) -m_operation.result);
+    }
+    return (std::size_t) m_operation.result;
+}
+
+ByteSlice AsyncRequest::getResult() const
+{
+    std::size_t transferred = getBytesTransferred();
+    core::strong_ref<ByteBuffer> buffer = m_buffer;
+    if (buffer.isNull())
+        return ByteSlice();
+    return buffer->slice((std::size_t) (m_operation.data - buffer->data()), transferred);
+}
+
+void AsyncRequest::wait()
+{
+    while (!m_done)
+        m_file->wait(1);
+}
+
+#ifdef ARTEMIS_PLATFORM_W32
+
+AsyncFile::AsyncFile(const char* path, Mode mode, Backend backend, unsigned queueDepth)
+:
+m_path(path),
+m_descriptor(-1),
+m_backend(backend),
+m_queueDepth(queueDepth),
+m_engine(NULL),
+m_inFlight(0)
+{
+    throw IllegalOperationException("asynchronous files are not supported on this platform", "AsyncFile");
+}
+
+AsyncFile::~AsyncFile()
+{
+}
+
+#else
+
+AsyncFile::AsyncFile(const char* path, Mode mode, Backend backend, unsigned queueDepth)
+:
+m_path(path),
+m_descriptor(-1),
+m_backend(backend),
+m_queueDepth(queueDepth != 0 ? queueDepth : 1),
+m_engine(NULL),
+m_inFlight(0)
+{
+    m_descriptor = ::open(path, mode == READ_WRITE ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (m_descriptor < 0)
+        throw IOException("open", path, errno);
+
+    try
+    {
+#ifdef AXF_HAVE_IO_URING
+        if (backend != THREAD_POOL)
+        {
+            try
+            {
+                m_engine = new UringEngine(m_queueDepth);
+                m_backend = IO_URING;
+            }
+            catch (IOException&)
+            {
+                if (backend == IO_URING)
+                    throw;
+            }
+        }
+#else
+        if (backend == IO_URING)
+            throw IOException("io_uring is not available on this platform", ENOSYS);
+#endif
+        if (m_engine == NULL)
+        {
+            m_engine = new ThreadPoolEngine(m_queueDepth);
+            m_backend = THREAD_POOL;
+        }
+    }
+    catch (...)
+    {
+        ::close(m_descriptor);
+        throw;
+    }
+
+    m_queued.reserve(m_queueDepth);
+    m_completed.reserve(m_queueDepth);
+}
+
+AsyncFile::~AsyncFile()
+{
+    while (pending() != 0)
+        wait(pending());
+
+    delete m_engine;
+    ::close(m_descriptor);
+}
+
+#endif
+
+std::size_t AsyncFile::complete()
+{
+    std::size_t count = 0;
+
+    // Handlers may wait on the file again, so each completion is removed
+    // from the list before its handler runs
+    while (!m_completed.empty())
+    {
+        AsyncRequest* request = m_completed.back()->request;
+        m_completed.pop_back();
+
+        --m_inFlight;
+        ++count;
+        request->m_done = true;
+
+        // The reference taken when the request was issued is dropped even if
+        // the handler throws
+        core::strong_ref<AsyncRequest> guard(request);
+        request->releaseStrongReference();
+        if (request->m_handler != NULL)
+            request->m_handler(*request, request->m_context);
+    }
+    return count;
+}
+
+core::strong_ref<AsyncRequest> AsyncFile::enqueue(AsyncRequest* request)
+{
+    core::strong_ref<AsyncRequest> handle(request);
+
+    request->grabStrongReference();
+    m_queued.push_back(&request->m_operation);
+    if (m_inFlight + m_queued.size() >= m_queueDepth)
+        submit();
+
+    return handle;
+}
+
+std::size_t AsyncFile::poll()
+{
+    submit();
+    m_engine->enter(NULL, 0, 0, m_completed);
+    return complete();
+}
+
+core::strong_ref<AsyncRequest> AsyncFile::read(unsigned long long offset, std::size_t length,
+                                               CompletionHandler handler, void* context)
+{
+    ByteBuffer* buffer = new ByteBuffer(length, 4096);
+    return enqueue(new AsyncRequest(this, false, offset, buffer, buffer->data(), length, handler, context));
+}
+
+core::strong_ref<AsyncRequest> AsyncFile::read(unsigned long long offset, ByteBuffer* buffer, std::size_t bufferOffset,
+                                               std::size_t length, CompletionHandler handler, void* context)
+{
+    buffer->slice(bufferOffset, length);
+    return enqueue(new AsyncRequest(this, false, offset, buffer, buffer->data() + bufferOffset, length,
+                                    handler, context));
+}
+
+void AsyncFile::submit()
+{
+    std::size_t room = m_queueDepth > m_inFlight ? m_queueDepth - m_inFlight : 0;
+    std::size_t count = m_queued.size() < room ? m_queued.size() : room;
+    if (count == 0)
+        return;
+
+    m_engine->enter(&m_queued[0], count, 0, m_completed);
+    m_queued.erase(m_queued.begin(), m_queued.begin() + count);
+    m_inFlight += count;
+}
+
+std::size_t AsyncFile::wait(std::size_t minimum)
+{
+    std::size_t count = 0;
+    submit();
+    while (count < minimum && m_inFlight != 0)
+    {
+        // Completions already harvested count towards the minimum
+        std::size_t ready = m_completed.size();
+        std::size_t outstanding = m_inFlight - ready;
+        std::size_t wanted = minimum - count > ready ? minimum - count - ready : 0;
+        if (wanted > outstanding)
+            wanted = outstanding;
+
+        m_engine->enter(NULL, 0, wanted, m_completed);
+        count += complete();
+        submit();
+    }
+    return count;
+}
+
+core::strong_ref<AsyncRequest> AsyncFile::write(unsigned long long offset, const ByteSlice& data,
+                                                CompletionHandler handler, void* context)
+{
+    core::strong_ref<ByteBuffer> buffer = data.getBuffer();
+    return enqueue(new AsyncRequest(this, true, offset, buffer.get(),
+                                    const_cast<unsigned char*> (data.data()), data.size(), handler, context));
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   ByteBuffer.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:10 PM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/Core/OutOfMemoryError.h>
+#include <Axf/IO/ByteBuffer.h>
+
+// C
+#include <cstdlib>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <malloc.h>
+#endif
+
+using namespace axf;
+using namespace axf::io;
+
+ByteBuffer::ByteBuffer(std::size_t size, std::size_t alignment)
+:
+m_data(NULL),
+m_size(size),
+m_heap(true)
+{
+    if (alignment < sizeof (void*))
+        alignment = sizeof (void*);
+
+    void* memory = NULL;
+#ifdef ARTEMIS_PLATFORM_W32
+    memory = _aligned_malloc(size != 0 ? size : 1, alignment);
+#else
+    if (posix_memalign(&memory, alignment, size != 0 ? size : 1) != 0)
+        memory = NULL;
+#endif
+
+    if (memory == NULL)
+    {
+        throw core::OutOfMemoryError("unable to allocate the bytes of a buffer.");
+    }
+    m_data = static_cast<unsigned char*> (memory);
+}
+
+ByteBuffer::ByteBuffer()
+:
+m_data(NULL),
+m_size(0),
+m_heap(false)
+{
+}
+
+ByteBuffer::~ByteBuffer()
+{
+    if (m_heap)
+    {
+#ifdef ARTEMIS_PLATFORM_W32
+        _aligned_free(m_data);
+#else
+        std::free(m_data);
+#endif
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   FileStream.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:10 AM
+ */
+
+#include <Axf/API/Platform.h>
+#include <Axf/IO/FileStream.h>
+#include <Axf/IO/IOException.h>
+
+// C
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+namespace
+{
+
+/**
+ * Names a descriptor that was not opened from a path.
+ */
+string describeDescriptor(int descriptor)
+{
+    char name[32];
+    std::sprintf(name, "<descriptor %d>", descriptor);
+    return string(name);
+}
+
+#ifdef ARTEMIS_PLATFORM_W32
+
+inline int openFile(const char* path, int flags)
+{
+    return _open(path, flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+inline long readFile(int descriptor, void* destination, std::size_t capacity)
+{
+    return _read(descriptor, destination, (unsigned) (capacity < INT_MAX ? capacity : INT_MAX));
+}
+
+inline long writeVectors(int descriptor, const IoVector* vectors, std::size_t count)
+{
+    // There is no gather write for CRT descriptors, write the first vector
+    return _write(descriptor, vectors->data, (unsigned) (vectors->size < INT_MAX ? vectors->size : INT_MAX));
+}
+
+inline void closeFile(int descriptor)
+{
+    _close(descriptor);
+}
+
+#else
+
+inline int openFile(const char* path, int flags)
+{
+    return ::open(path, flags, 0644);
+}
+
+inline long readFile(int descriptor, void* destination, std::size_t capacity)
+{
+    return ::read(descriptor, destination, capacity);
+}
+
+inline long writeVectors(int descriptor, const IoVector* vectors, std::size_t count)
+{
+    struct iovec iov[64];
+    int used = 0;
+    for (; used < 64 && (std::size_t) used < count; ++used)
+    {
+        iov[used].iov_base = const_cast<void*> (vectors[used].data);
+        iov[used].iov_len = vectors[used].size;
+    }
+    return ::writev(descriptor, iov, used);
+}
+
+inline void closeFile(int descriptor)
+{
+    ::close(descriptor);
+}
+
+#endif
+
+}
+
+FileInputStream::FileInputStream(const char* path, std::size_t bufferSize)
+:
+InputStream(bufferSize),
+m_descriptor(openFile(path, O_RDONLY)),
+m_owned(true),
+m_path(path)
+{
+    if (m_descriptor < 0)
+        throw IOException("open", path, errno);
+}
+
+FileInputStream::FileInputStream(int descriptor, bool owned, std::size_t bufferSize)
+:
+InputStream(bufferSize),
+m_descriptor(descriptor),
+m_owned(owned),
+m_path(describeDescriptor(descriptor))
+{
+}
+
+FileInputStream::~FileInputStream()
+{
+    close();
+}
+
+void FileInputStream::close()
+{
+    if (m_owned && m_descriptor >= 0)
+        closeFile(m_descriptor);
+    m_descriptor = -1;
+}
+
+std::size_t FileInputStream::readSome(void* destination, std::size_t capacity)
+{
+    for (;;)
+    {
+        long count = readFile(m_descriptor, destination, capacity);
+        if (count >= 0)
+            return (std::size_t) count;
+        if (errno != EINTR)
+            throw IOException("read", m_path, errno);
+    }
+}
+
+FileOutputStream::FileOutputStream(const char* path, bool append, std::size_t bufferSize, FlushPolicy policy)
+:
+OutputStream(bufferSize, policy),
+m_descriptor(openFile(path, O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC))),
+m_owned(true),
+m_path(path)
+{
+    if (m_descriptor < 0)
+        throw IOException("open", path, errno);
+}
+
+FileOutputStream::FileOutputStream(int descriptor, bool owned, std::size_t bufferSize, FlushPolicy policy)
+:
+OutputStream(bufferSize, policy),
+m_descriptor(descriptor),
+m_owned(owned),
+m_path(describeDescriptor(descriptor))
+{
+}
+
+FileOutputStream::~FileOutputStream()
+{
+    try
+    {
+        close();
+    }
+    catch (IOException&)
+    {
+        // Nobody is left to report the error to
+    }
+}
+
+void FileOutputStream::close()
+{
+    if (m_descriptor >= 0)
+    {
+        flush();
+        if (m_owned)
+            closeFile(m_descriptor);
+        m_descriptor = -1;
+    }
+}
+
+std::size_t FileOutputStream::writeSome(const IoVector* vectors, std::size_t count)
+{
+    for (;;)
+    {
+        long written = writeVectors(m_descriptor, vectors, count);
+        if (written > 0)
+            return (std::size_t) written;
+        if (written < 0 && errno != EINTR)
+            throw IOException("write", m_path, errno);
+    }
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   FlatFormat.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 6:30 AM
+ */
+
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/Core/IndexOutOfBoundsException.h>
+#include <Axf/Core/NullPointerException.h>
+#include <Axf/IO/FlatFormat.h>
+#include <Axf/IO/IOException.h>
+#include <Axf/IO/MappedFile.h>
+
+// C
+#include <cstdio>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+namespace
+{
+
+const char          MAGIC[4] = { 'A', 'X', 'F', 'L' };
+const unsigned      BYTE_ORDER_MARK = 0x01020304;
+
+inline std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}
+
+void axf::io::bits::throwFlatIndex(std::size_t index, std::size_t size)
+{
+    char message[96];
+    std::sprintf(message, "index out of bounds of a flat array of %lu elements", (unsigned long) size);
+    throw IndexOutOfBoundsException(message, (long long) index);
+}
+
+void axf::io::bits::throwFlatNull(const void* reference)
+{
+    char message[64];
+    std::sprintf(message, "null dereferencing from flat reference at 0x%p", reference);
+    throw NullPointerException(message);
+}
+
+FlatBuilder::FlatBuilder(std::size_t capacity)
+:
+m_buffer(new ByteBuffer(capacity > sizeof (FlatHeader) ? capacity : sizeof (FlatHeader))),
+m_begin(m_buffer->data()),
+m_position(m_begin + sizeof (FlatHeader)),
+m_end(m_begin + m_buffer->size())
+{
+    std::memset(m_begin, 0, sizeof (FlatHeader));
+}
+
+FlatBuilder::~FlatBuilder()
+{
+}
+
+std::size_t FlatBuilder::addString(const char* bytes, std::size_t size)
+{
+    std::size_t offset = allocate(size + 1, 1, true);
+    unsigned stored = (unsigned) size;
+    std::memcpy(m_begin + offset - sizeof (unsigned), &stored, sizeof (unsigned));
+    if (size != 0)
+        std::memcpy(m_begin + offset, bytes, size);
+    return offset;
+}
+
+std::size_t FlatBuilder::allocate(std::size_t size, std::size_t alignment, bool sized)
+{
+    if (sized && size > 0xffffffffu)
+        throw IllegalStateException("flat strings and arrays hold at most 2^32 - 1 elements");
+
+    // Sized items keep their size in the four bytes before them
+    std::size_t used = this->size();
+    std::size_t offset = alignUp(used + (sized ? sizeof (unsigned) : 0),
+                                 sized && alignment < sizeof (unsigned) ? sizeof (unsigned) : alignment);
+    std::size_t end = offset + size;
+
+    if (end > (std::size_t) (m_end - m_begin))
+    {
+        std::size_t capacity = (std::size_t) (m_end - m_begin) * 2;
+        if (capacity < end)
+            capacity = end;
+
+        core::strong_ref<ByteBuffer> buffer = new ByteBuffer(capacity);
+        std::memcpy(buffer->data(), m_begin, used);
+
+        m_buffer = buffer;
+        m_begin = m_buffer->data();
+        m_end = m_begin + capacity;
+    }
+
+    std::memset(m_begin + used, 0, end - used);
+    m_position = m_begin + end;
+    return offset;
+}
+
+ByteSlice FlatBuilder::finish(std::size_t root)
+{
+    FlatHeader* header = reinterpret_cast<FlatHeader*> (m_begin);
+    std::memcpy(header->magic, MAGIC, sizeof (MAGIC));
+    header->version = VERSION;
+    header->byteOrder = BYTE_ORDER_MARK;
+    header->reserved = 0;
+    header->size = size();
+    header->root = root;
+
+    return m_buffer->slice(0, size());
+}
+
+int FlatBuilder::relativeOffset(const void* reference, std::size_t target) const
+{
+    const unsigned char* field = static_cast<const unsigned char*> (reference);
+    if (field < m_begin + sizeof (FlatHeader) || field >= m_position)
+        throw IllegalStateException("flat references can only be linked within their builder");
+    if (target < sizeof (FlatHeader) || target >= size())
+        throw IllegalStateException("flat references must point to an item of their builder");
+
+    long long distance = (long long) target - (long long) (field - m_begin);
+    if (distance > 0x7fffffffLL || distance < -0x7fffffffLL)
+        throw IllegalStateException("flat references span at most 2 GiB");
+    return (int) distance;
+}
+
+FlatVerifier::FlatVerifier(const unsigned char* begin, std::size_t size)
+:
+m_begin(begin),
+m_end(begin + size),
+m_depth(0),
+m_budget(size)
+{
+}
+
+void FlatVerifier::verify(const FlatString& reference)
+{
+    if (reference.m_offset == 0)
+        return;
+
+    const unsigned char* target = checkSized(&reference, reference.m_offset, 1);
+    std::size_t size = bits::flatSizeBefore(target);
+    if (size >= (std::size_t) (m_end - target) || target[size] != 0)
+        fail("string out of bounds", target);
+    spend(1, target);
+}
+
+const unsigned char* FlatVerifier::checkSized(const void* reference, int offset, std::size_t alignment)
+{
+    const unsigned char* target = checkTarget(reference, offset, alignment);
+    if (target - m_begin < (std::ptrdiff_t) (sizeof (FlatHeader) + sizeof (unsigned)))
+        fail("reference into the header", target);
+    return target;
+}
+
+const unsigned char* FlatVerifier::checkTarget(const void* reference, int offset, std::size_t alignment)
+{
+    const unsigned char* field = static_cast<const unsigned char*> (reference);
+    std::ptrdiff_t position = (field - m_begin) + offset;
+    if (position < (std::ptrdiff_t) sizeof (FlatHeader) || position >= m_end - m_begin)
+        fail("reference out of bounds", field);
+    if ((std::size_t) position % alignment != 0)
+        fail("misaligned reference", field);
+    return m_begin + position;
+}
+
+void FlatVerifier::enter(const unsigned char* target, std::size_t units)
+{
+    spend(units, target);
+    if (++m_depth > MAX_DEPTH)
+        fail("records nested too deep", target);
+}
+
+void FlatVerifier::fail(const char* reason, const void* where) const
+{
+    char message[128];
+    std::sprintf(message, "invalid flat block, %s at byte %ld", reason,
+                 (long) (static_cast<const unsigned char*> (where) - m_begin));
+    throw IOException(message);
+}
+
+FlatReader::FlatReader(const char* path)
+:
+m_header(NULL)
+{
+    core::strong_ref<MappedFile> file = new MappedFile(path);
+    m_block = ByteSlice(file.get(), 0, file->size());
+    checkHeader();
+}
+
+FlatReader::FlatReader(const ByteSlice& block)
+:
+m_block(block),
+m_header(NULL)
+{
+    checkHeader();
+}
+
+FlatReader::~FlatReader()
+{
+}
+
+void FlatReader::checkHeader()
+{
+    const FlatHeader* header = reinterpret_cast<const FlatHeader*> (m_block.data());
+    if (m_block.size() < sizeof (FlatHeader) || std::memcmp(header->magic, MAGIC, sizeof (MAGIC)) != 0)
+        throw IOException("not a flat block");
+    if (((std::size_t) m_block.data() & 7) != 0)
+        throw IOException("flat blocks must be aligned to eight bytes");
+    if (header->byteOrder != BYTE_ORDER_MARK)
+        throw IOException("the flat block was written with a different byte order");
+    if (header->version != FlatBuilder::VERSION)
+        throw IOException("unsupported version of the flat format");
+    if (header->size != m_block.size())
+        throw IOException("the flat block is truncated or has trailing bytes");
+
+    m_header = header;
+}
+
+void FlatReader::checkRoot(std::size_t size, std::size_t alignment) const
+{
+    unsigned long long root = m_header->root;
+    if (root < sizeof (FlatHeader) || root > m_header->size || m_header->size - root < size || root % alignment != 0)
+        throw IOException("invalid root of the flat block");
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   IOException.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:05 PM
+ */
+
+#include <Axf/API/Compiler.h>
+#include <Axf/API/Platform.h>
+#include <Axf/IO/IOException.h>
+
+// C
+#include <cstdio>
+#include <cstring>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#endif
+
+using namespace axf;
+using namespace axf::io;
+
+namespace
+{
+
+/**
+ * Formats the message of a failed system call. The buffer is per thread, and
+ * the base class copies the message right away.
+ */
+const char* describe(const char* operation, const char* path, int errorCode)
+{
+    static ARTEMIS_THREAD_LOCAL char message[1024];
+    char description[256] = {0};
+
+#ifdef ARTEMIS_PLATFORM_W32
+    FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, NULL, errorCode, 0,
+                   description, sizeof (description), NULL);
+#else
+    std::strncpy(description, std::strerror(errorCode), sizeof (description) - 1);
+#endif
+
+    std::sprintf(message, "%.32s '%.512s': %.255s", operation, path, description);
+    return message;
+}
+
+}
+
+IOException::IOException(const char* message, int errorCode)
+:
+Exception(message),
+m_errorCode(errorCode)
+{
+}
+
+IOException::IOException(const char* operation, const char* path, int errorCode)
+:
+Exception(describe(operation, path, errorCode)),
+m_errorCode(errorCode)
+{
+}
+
+IOException::~IOException()
+{
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   InputStream.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:30 AM
+ */
+
+#include <Axf/IO/InputStream.h>
+
+// C
+#include <cstring>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+InputStream::InputStream(std::size_t bufferSize)
+:
+m_buffer(new ByteBuffer(bufferSize != 0 ? bufferSize : DEFAULT_BUFFER_SIZE, BUFFER_ALIGNMENT)),
+m_data(m_buffer->data()),
+m_position(0),
+m_end(0),
+m_endOfSource(false)
+{
+}
+
+InputStream::~InputStream()
+{
+}
+
+std::size_t InputStream::fill(std::size_t required)
+{
+    std::size_t buffered = available();
+    if (buffered >= required || m_endOfSource)
+        return buffered;
+
+    std::size_t capacity = m_buffer->size();
+    if (required > capacity || m_buffer.users() > 1)
+    {
+        // Grow the buffer, or leave it to the slices still viewing it
+        if (required > capacity)
+            capacity = (required > 2 * capacity) ? required : 2 * capacity;
+
+        ByteBuffer* buffer = new ByteBuffer(capacity, BUFFER_ALIGNMENT);
+        std::memcpy(buffer->data(), m_data + m_position, buffered);
+
+        m_buffer = buffer;
+        m_data = buffer->data();
+        m_position = 0;
+        m_end = buffered;
+    }
+    else if (capacity - m_position < required)
+    {
+        // Move the unread bytes to the front to make room
+        std::memmove(m_data, m_data + m_position, buffered);
+        m_position = 0;
+        m_end = buffered;
+    }
+
+    while (m_end - m_position < required)
+    {
+        std::size_t count = readSome(m_data + m_end, capacity - m_end);
+        if (count == 0)
+        {
+            m_endOfSource = true;
+            break;
+        }
+        m_end += count;
+    }
+    return available();
+}
+
+std::size_t InputStream::read(void* destination, std::size_t count)
+{
+    unsigned char* output = static_cast<unsigned char*> (destination);
+
+    std::size_t buffered = available() < count ? available() : count;
+    std::memcpy(output, m_data + m_position, buffered);
+    m_position += buffered;
+
+    std::size_t done = buffered;
+    while (done < count && !m_endOfSource)
+    {
+        std::size_t left = count - done;
+        if (left >= m_buffer->size())
+        {
+            // Large reads bypass the buffer
+            std::size_t read = readSome(output + done, left);
+            if (read == 0)
+                m_endOfSource = true;
+            done += read;
+        }
+        else
+        {
+            std::size_t read = fill(left);
+            read = read < left ? read : left;
+            std::memcpy(output + done, m_data + m_position, read);
+            m_position += read;
+            done += read;
+            if (read < left)
+                break;
+        }
+    }
+    return done;
+}
+
+bool InputStream::readLine(ByteSlice& line)
+{
+    // Drop the previous line first, so that the buffer can be reused
+    line = ByteSlice();
+
+    std::size_t scanned = 0;
+    for (;;)
+    {
+        const unsigned char* start = m_data + m_position;
+        const void* newline = std::memchr(start + scanned, '\n', available() - scanned);
+        if (newline != NULL)
+        {
+            std::size_t length = static_cast<const unsigned char*> (newline) - start;
+            line = ByteSlice(m_buffer.get(), m_position, length);
+            m_position += length + 1;
+            return true;
+        }
+
+        scanned = available();
+        if (fill(scanned + 1) == scanned)
+        {
+            // The source ended, the rest of the stream is the last line
+            if (scanned == 0)
+                return false;
+
+            line = ByteSlice(m_buffer.get(), m_position, scanned);
+            m_position = m_end;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   MappedFile.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:30 PM
+ */
+
+#include <Axf/IO/IOException.h>
+#include <Axf/IO/MappedFile.h>
+
+#ifdef ARTEMIS_PLATFORM_W32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace axf;
+using namespace axf::io;
+
+#ifdef ARTEMIS_PLATFORM_W32
+
+MappedFile::MappedFile(const char* path, Mode mode, Advice advice)
+:
+ByteBuffer(),
+m_path(path),
+m_mode(mode),
+m_file(INVALID_HANDLE_VALUE),
+m_mapping(NULL)
+{
+    DWORD access = (mode == READ_WRITE) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+    DWORD hint = (advice == SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN
+            : (advice == RANDOM) ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+
+    m_file = CreateFileA(path, access, FILE_SHARE_READ, NULL, OPEN_EXISTING, hint, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw IOException("open", path, (int) GetLastError());
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+    {
+        int error = (int) GetLastError();
+        close();
+        throw IOException("stat", path, error);
+    }
+    m_size = (std::size_t) size.QuadPart;
+
+    // Empty files can not be mapped, they are represented by an empty buffer
+    if (m_size != 0)
+    {
+        m_mapping = CreateFileMappingA(m_file, NULL, mode == READ_WRITE ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+        if (m_mapping != NULL)
+        {
+            m_data = static_cast<unsigned char*> (MapViewOfFile(m_mapping,
+                                                                mode == READ_WRITE ? FILE_MAP_WRITE : FILE_MAP_READ,
+                                                                0, 0, 0));
+        }
+        if (m_data == NULL)
+        {
+            int error = (int) GetLastError();
+            close();
+            throw IOException("map", path, error);
+        }
+    }
+}
+
+void MappedFile::advise(Advice advice, std::size_t offset, std::size_t length)
+{
+    // Windows only takes the pattern when the file is opened
+}
+
+void MappedFile::close()
+{
+    if (m_data != NULL)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = NULL;
+    }
+    if (m_mapping != NULL)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+}
+
+void MappedFile::sync()
+{
+    if (m_data != NULL && (!FlushViewOfFile(m_data, 0) || !FlushFileBuffers(m_file)))
+        throw IOException("sync", m_path, (int) GetLastError());
+}
+
+#else
+
+namespace
+{
+
+int toAdvice(MappedFile::Advice advice)
+{
+    switch (advice)
+    {
+        case MappedFile::SEQUENTIAL:
+            return MADV_SEQUENTIAL;
+        case MappedFile::RANDOM:
+            return MADV_RANDOM;
+        case MappedFile::WILL_NEED:
+            return MADV_WILLNEED;
+        case MappedFile::DONT_NEED:
+            return MADV_DONTNEED;
+        default:
+            return MADV_NORMAL;
+    }
+}
+
+}
+
+MappedFile::MappedFile(const char* path, Mode mode, Advice advice)
+:
+ByteBuffer(),
+m_path(path),
+m_mode(mode),
+m_file(-1)
+{
+    m_file = ::open(path, mode == READ_WRITE ? O_RDWR : O_RDONLY);
+    if (m_file < 0)
+        throw IOException("open", path, errno);
+
+    struct stat status;
+    if (fstat(m_file, &status) != 0)
+    {
+        int error = errno;
+        close();
+        throw IOException("stat", path, error);
+    }
+    m_size = (std::size_t) status.st_size;
+
+    // Empty files can not be mapped, they are represented by an empty buffer
+    if (m_size != 0)
+    {
+        void* address = mmap(NULL, m_size, mode == READ_WRITE ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                             MAP_SHARED, m_file, 0);
+        if (address == MAP_FAILED)
+        {
+            int error = errno;
+            close();
+            throw IOException("map", path, error);
+        }
+        m_data = static_cast<unsigned char*> (address);
+
+        if (advice != NORMAL)
+            this->advise(advice);
+    }
+}
+
+void MappedFile::advise(Advice advice, std::size_t offset, std::size_t length)
+{
+    if (m_data == NULL || offset >= m_size)
+        return;
+    if (length > m_size - offset)
+        length = m_size - offset;
+
+    // The range must start at a page boundary
+    std::size_t page = (std::size_t) sysconf(_SC_PAGESIZE);
+    std::size_t start = offset & ~(page - 1);
+
+    madvise(m_data + start, length + (offset - start), toAdvice(advice));
+}
+
+void MappedFile::close()
+{
+    if (m_data != NULL)
+    {
+        munmap(m_data, m_size);
+        m_data = NULL;
+    }
+    if (m_file >= 0)
+    {
+        ::close(m_file);
+        m_file = -1;
+    }
+}
+
+void MappedFile::sync()
+{
+    if (m_data != NULL && m_mode == READ_WRITE && msync(m_data, m_size, MS_SYNC) != 0)
+        throw IOException("sync", m_path, errno);
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   OutputStream.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:50 AM
+ */
+
+#include <Axf/IO/OutputStream.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+OutputStream::OutputStream(std::size_t bufferSize, FlushPolicy policy)
+:
+m_buffer(new ByteBuffer(bufferSize != 0 ? bufferSize : DEFAULT_BUFFER_SIZE, BUFFER_ALIGNMENT)),
+m_data(m_buffer->data()),
+m_capacity(m_buffer->size()),
+m_size(0),
+m_policy(policy)
+{
+}
+
+OutputStream::~OutputStream()
+{
+}
+
+void OutputStream::applyPolicy(const void* bytes, std::size_t size)
+{
+    if (m_policy == FLUSH_ON_WRITE || std::memchr(bytes, '\n', size) != NULL)
+    {
+        flush();
+    }
+}
+
+void OutputStream::flush()
+{
+    if (m_size > 0)
+    {
+        IoVector vector = {m_data, m_size};
+        writeAll(&vector, 1);
+        m_size = 0;
+    }
+}
+
+void OutputStream::write(const ByteSlice* slices, std::size_t count)
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        total += slices[i].size();
+    }
+
+    if (total <= m_capacity - m_size)
+    {
+        // Small writes are cheaper to copy than to hand over separately
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(m_data + m_size, slices[i].data(), slices[i].size());
+            m_size += slices[i].size();
+        }
+    }
+    else
+    {
+        // The buffered bytes go first, then the slices, in batches
+        IoVector vectors[MAX_VECTORS];
+        std::size_t used = 0;
+        if (m_size > 0)
+        {
+            vectors[used].data = m_data;
+            vectors[used].size = m_size;
+            ++used;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (slices[i].isEmpty())
+                continue;
+
+            vectors[used].data = slices[i].data();
+            vectors[used].size = slices[i].size();
+            if (++used == MAX_VECTORS)
+            {
+                writeAll(vectors, used);
+                used = 0;
+            }
+        }
+        if (used > 0)
+            writeAll(vectors, used);
+        m_size = 0;
+        return;
+    }
+
+    if (m_policy == FLUSH_ON_WRITE)
+    {
+        flush();
+    }
+    else if (m_policy == FLUSH_ON_NEWLINE)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (std::memchr(slices[i].data(), '\n', slices[i].size()) != NULL)
+            {
+                flush();
+                break;
+            }
+        }
+    }
+}
+
+void OutputStream::writeAll(IoVector* vectors, std::size_t count)
+{
+    while (count > 0 && vectors->size == 0)
+    {
+        ++vectors;
+        --count;
+    }
+
+    while (count > 0)
+    {
+        std::size_t written = writeSome(vectors, count);
+
+        // Skip the vectors that were written in full, and trim a partial one
+        while (count > 0 && written >= vectors->size)
+        {
+            written -= vectors->size;
+            ++vectors;
+            --count;
+        }
+        if (count > 0)
+        {
+            vectors->data = static_cast<const unsigned char*> (vectors->data) + written;
+            vectors->size -= written;
+        }
+    }
+}
+
+void OutputStream::writeSlow(const void* bytes, std::size_t size)
+{
+    if (size < m_capacity)
+    {
+        // Top the buffer up, so that it is handed over full
+        std::size_t head = m_capacity - m_size;
+        std::memcpy(m_data + m_size, bytes, head);
+        m_size = m_capacity;
+        flush();
+
+        std::memcpy(m_data, static_cast<const unsigned char*> (bytes) + head, size - head);
+        m_size = size - head;
+    }
+    else
+    {
+        // Large writes go straight to the sink, along with the buffered bytes
+        IoVector vectors[2] = {
+            {m_data, m_size},
+            {bytes, size}
+        };
+        if (m_size > 0)
+            writeAll(vectors, 2);
+        else
+            writeAll(vectors + 1, 1);
+        m_size = 0;
+        return;
+    }
+
+    if (m_policy != FLUSH_WHEN_FULL)
+        applyPolicy(bytes, size);
+}
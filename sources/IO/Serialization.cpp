@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   Serialization.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:30 AM
+ */
+
+#include <Axf/Concurrent/Atomic.h>
+#include <Axf/Concurrent/SpinLock.h>
+#include <Axf/Core/IllegalStateException.h>
+#include <Axf/IO/IOException.h>
+#include <Axf/IO/Serialization.h>
+
+// C
+#include <cstdio>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+namespace
+{
+
+const unsigned REGISTRY_BUCKETS = 256;  /// Buckets of the type registry, a power of two
+
+/**
+ * The registered types, chained by tag. Buckets are only ever prepended
+ * to, under the lock, and published with release stores, so readers need no
+ * lock. The table is constant initialized, before any registration runs.
+ */
+const SerializableType* registry[REGISTRY_BUCKETS];
+
+concurrent::SpinLock& registryLock()
+{
+    static concurrent::SpinLock lock;
+    return lock;
+}
+
+inline unsigned bucketOf(unsigned tag)
+{
+    return (tag * 2654435761u) >> 24 & (REGISTRY_BUCKETS - 1);
+}
+
+}
+
+Serializer::Serializer(std::size_t capacity)
+:
+m_buffer(new ByteBuffer(capacity != 0 ? capacity : 1)),
+m_begin(m_buffer->data()),
+m_position(m_begin),
+m_end(m_begin + m_buffer->size())
+{
+}
+
+Serializer::Serializer(ByteBuffer* buffer)
+:
+m_buffer(buffer),
+m_begin(m_buffer->data()),
+m_position(m_begin),
+m_end(m_begin + m_buffer->size())
+{
+}
+
+Serializer::~Serializer()
+{
+}
+
+ByteSlice Serializer::data() const
+{
+    core::strong_ref<ByteBuffer> buffer = m_buffer;
+    return buffer->slice(0, size());
+}
+
+void Serializer::grow(std::size_t size)
+{
+    std::size_t used = this->size();
+    std::size_t capacity = (std::size_t) (m_end - m_begin) * 2;
+    if (capacity < used + size)
+        capacity = used + size;
+
+    core::strong_ref<ByteBuffer> buffer = new ByteBuffer(capacity);
+    std::memcpy(buffer->data(), m_begin, used);
+
+    m_buffer = buffer;
+    m_begin = m_buffer->data();
+    m_position = m_begin + used;
+    m_end = m_begin + capacity;
+}
+
+SerializableType::SerializableType(const core::bits::Type& type, Factory factory)
+:
+m_type(&type),
+m_tag(tagOf(type)),
+m_factory(factory),
+m_next(NULL)
+{
+    concurrent::ScopedLock<concurrent::SpinLock> lock(registryLock());
+
+    // A class registered twice (from several translation units) keeps its
+    // first registration
+    const SerializableType* registered = find(m_tag);
+    if (registered != NULL)
+    {
+        if (std::strcmp(registered->m_type->getName(), type.getName()) == 0)
+            return;
+
+        char message[640];
+        std::sprintf(message, "serializable classes '%.250s' and '%.250s' have the same tag %08x",
+                     registered->m_type->getName(), type.getName(), m_tag);
+        throw IllegalStateException(message);
+    }
+
+    const SerializableType** bucket = &registry[bucketOf(m_tag)];
+    m_next = *bucket;
+    concurrent::atomicStore(bucket, (const SerializableType*) this, concurrent::RELEASE);
+}
+
+const SerializableType* SerializableType::find(unsigned tag)
+{
+    const SerializableType* current = concurrent::atomicLoad(&registry[bucketOf(tag)], concurrent::ACQUIRE);
+    while (current != NULL && current->m_tag != tag)
+        current = current->m_next;
+    return current;
+}
+
+unsigned SerializableType::tagOf(const core::bits::Type& type)
+{
+    // FNV-1a, one byte at a time so the tag does not depend on the platform
+    unsigned tag = 2166136261u;
+    for (const unsigned char* c = reinterpret_cast<const unsigned char*> (type.getName()); *c != 0; ++c)
+    {
+        tag = (tag ^ *c) * 16777619u;
+    }
+    return tag & 0xffffffffu;
+}
+
+Deserializer::Deserializer(const ByteSlice& input)
+:
+m_input(input),
+m_position(input.data()),
+m_end(input.data() + input.size()),
+m_depth(0)
+{
+}
+
+Deserializer::~Deserializer()
+{
+}
+
+ByteSlice Deserializer::readSlice(std::size_t size)
+{
+    require(size);
+    std::size_t offset = (std::size_t) (m_position - m_input.data());
+    m_position += size;
+    return m_input.slice(offset, size);
+}
+
+unsigned long long Deserializer::readVarintSlow()
+{
+    unsigned long long value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        unsigned char byte = readByte();
+        value |= (unsigned long long) (byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return value;
+    }
+    throwMalformed("variable length integer too long");
+    return 0;
+}
+
+void Deserializer::throwMalformed(const char* reason) const
+{
+    char message[640];
+    std::sprintf(message, "malformed input at byte %lu: %.600s",
+                 (unsigned long) (m_position - m_input.data()), reason);
+    throw IOException(message);
+}
+
+void Deserializer::throwTruncated() const
+{
+    throwMalformed("unexpected end of input");
+}
+
+void Deserializer::throwUnexpectedType(const SerializableType* type, const core::bits::Type& expected) const
+{
+    char message[512];
+    if (type == NULL)
+        std::sprintf(message, "unknown class, expected a '%.200s'", expected.getName());
+    else
+        std::sprintf(message, "'%.200s' is not a '%.200s'", type->getType().getName(), expected.getName());
+    throwMalformed(message);
+}
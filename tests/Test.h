@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   Test.h
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 12:25 PM
+ */
+
+#ifndef AXF_TEST_H
+#define AXF_TEST_H
+
+// C++
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * A minimal test harness shared by the unit tests.
+ * <p>
+ * Each test is a program that reports its checks with <code>check</code>,
+ * one line per check, and ends by returning <code>testResult()</code> from
+ * <code>main</code>, which prints the verdict and turns it into the process
+ * exit code.
+ */
+
+/// The number of failed checks so far
+static int g_failures = 0;
+
+/**
+ * Reports a check, counting it as a failure if the condition does not hold.
+ *
+ * @param condition
+ * @param what a short description of the checked property
+ */
+static inline void check(bool condition, const char* what)
+{
+    std::cout << (condition ? "[ ok ] " : "[FAIL] ") << what << std::endl;
+    if (!condition)
+    {
+        g_failures++;
+    }
+}
+
+/**
+ * Prints the verdict of the test and returns the exit code of the program.
+ *
+ * @return
+ */
+static inline int testResult()
+{
+    std::cout << (g_failures == 0 ? "all tests passed" : "some tests failed") << std::endl;
+    return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* AXF_TEST_H */
@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   allocation_profiler.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 3:10 PM
+ */
+
+#include <stdlib.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <thread>
+#include <vector>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+
+struct Particle
+{
+    double  position[3];
+    double  velocity[3];
+} ;
+
+struct Spark
+{
+    double  position[3];
+    double  velocity[3];
+} ;
+
+class Message : public Object
+{
+    AXF_CLASS_TYPE(Message, AXF_TYPE(axf::core::Object))
+    AXF_CLASS_POOL(Message)
+public:
+
+    char m_payload[40];
+} ;
+
+class Note : public Object
+{
+    AXF_CLASS_TYPE(Note, AXF_TYPE(axf::core::Object))
+public:
+
+    char m_payload[40];
+} ;
+
+static bool find(const char* typeName, AllocationSample& result)
+{
+    std::vector<AllocationSample> samples = AllocationProfiler::snapshot();
+    bool found = false;
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        if (std::strcmp(samples[i].typeName, typeName) == 0)
+        {
+            if (!found)
+            {
+                result = samples[i];
+                found = true;
+            }
+            else
+            {
+                result.samples += samples[i].samples;
+                result.sampledBytes += samples[i].sampledBytes;
+                result.inUseSamples += samples[i].inUseSamples;
+                result.inUseBytes += samples[i].inUseBytes;
+                result.estimatedCount += samples[i].estimatedCount;
+                result.estimatedBytes += samples[i].estimatedBytes;
+            }
+        }
+    }
+    return found;
+}
+
+template <typename A>
+static void churn(A& allocator, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        allocator.deallocate(allocator.allocate(1), 1);
+    }
+}
+
+static std::string readAll(std::FILE* file)
+{
+    std::string contents;
+    char buffer[4096];
+    std::size_t read;
+
+    std::rewind(file);
+    while ((read = std::fread(buffer, 1, sizeof (buffer), file)) > 0)
+    {
+        contents.append(buffer, read);
+    }
+    return contents;
+}
+
+int main(int argc, char** argv)
+{
+    const int COUNT = 200000;
+    const long long TOTAL = (long long) COUNT * sizeof (Particle);
+
+    // Nothing is sampled until the profiler is started
+    DefaultAllocator<Particle> particles;
+    churn(particles, COUNT);
+    check(!AllocationProfiler::isRunning(), "the profiler starts stopped");
+    check(AllocationProfiler::snapshot().empty(), "nothing is sampled before starting");
+
+    // Sampling estimates the traffic
+    AllocationProfiler::start(4096);
+    check(AllocationProfiler::isRunning(), "the profiler runs once started");
+    check(AllocationProfiler::getSamplingInterval() == 4096, "the sampling interval is kept");
+
+    churn(particles, COUNT);
+
+    AllocationSample sample;
+    check(find("Particle", sample), "allocations are attributed to their type");
+    check(sample.samples > TOTAL / 4096 / 2 && sample.samples < TOTAL / 4096 * 2, "about one allocation per interval is sampled");
+    check(sample.sampledBytes == sample.samples * (long long) sizeof (Particle), "sampled bytes add up");
+    check(sample.estimatedBytes > TOTAL * 8 / 10 && sample.estimatedBytes < TOTAL * 12 / 10, "estimated bytes are close to the allocated bytes");
+    check(sample.estimatedCount > COUNT * 8 / 10 && sample.estimatedCount < COUNT * 12 / 10, "estimated allocations are close to the allocations");
+#if defined(__GLIBC__) || defined(ARTEMIS_PLATFORM_W32)
+    check(sample.depth > 0, "samples carry a call stack");
+#endif
+
+    // Other allocators and the class pools are sampled too
+    ThreadCachingAllocator<Spark> sparks;
+    churn(sparks, COUNT);
+    check(find("Spark", sample) && sample.samples > 0, "the thread caching allocator is sampled");
+
+    for (int i = 0; i < COUNT; ++i)
+    {
+        strong_ref<Message> message(new Message());
+    }
+    check(find("Message", sample) && sample.samples > 0, "pooled objects are sampled under their class");
+
+    for (int i = 0; i < COUNT; ++i)
+    {
+        strong_ref<Note> note(new Note());
+    }
+    check(find("Note", sample) && sample.samples > 0, "objects are sampled under their class once referenced");
+    check(sample.inUseSamples == 0, "released objects are not in use");
+
+    for (int i = 0; i < COUNT; ++i)
+    {
+        delete new Note();
+    }
+    check(find("axf::core::ReferenceCounted", sample) && sample.samples > 0, "objects never referenced are sampled as reference counted");
+    check(sample.inUseSamples == 0, "and are not in use once released");
+
+    // Large allocations are always sampled
+    AllocationSample before;
+    find("Particle", before);
+    particles.deallocate(particles.allocate(4096), 4096);
+    check(find("Particle", sample) && sample.samples == before.samples + 1, "allocations larger than the interval are sampled");
+
+    // Sampled allocations are in use until released
+    check(find("Particle", sample) && sample.inUseSamples == 0 && sample.inUseBytes == 0, "released allocations are not in use");
+    check(find("Message", sample) && sample.inUseSamples == 0, "released pooled objects are not in use");
+    {
+        std::vector<Particle*> held;
+        for (int i = 0; i < COUNT / 10; ++i)
+        {
+            held.push_back(particles.allocate(1));
+        }
+        check(find("Particle", sample) && sample.inUseSamples > 0 && sample.inUseBytes == sample.inUseSamples * (long long) sizeof (Particle),
+              "held allocations are in use");
+
+        for (std::size_t i = 0; i < held.size(); ++i)
+        {
+            particles.deallocate(held[i], 1);
+        }
+        check(find("Particle", sample) && sample.inUseSamples == 0, "until they are released");
+    }
+
+    // Profiles
+    std::FILE* file = std::tmpfile();
+    AllocationProfiler::dumpFolded(file);
+    std::string folded = readAll(file);
+    std::fclose(file);
+    check(folded.find(";Particle ") != std::string::npos, "folded stacks end with the type");
+    check(folded.find("Message ") != std::string::npos, "folded stacks include pooled classes");
+
+    file = std::tmpfile();
+    AllocationProfiler::dumpHeapProfile(file);
+    std::string heap = readAll(file);
+    std::fclose(file);
+    check(heap.compare(0, 14, "heap profile: ") == 0, "heap profiles have the legacy header");
+    check(heap.find("@ heap_v2/4096\n") != std::string::npos, "heap profiles carry the interval");
+#ifdef __linux__
+    check(heap.find("MAPPED_LIBRARIES:") != std::string::npos, "heap profiles list the mapped libraries");
+#endif
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    {
+        // Threads sample into the same table
+        AllocationProfiler::start(1024);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.push_back(std::thread([]()
+            {
+                DefaultAllocator<Particle> local;
+                churn(local, 50000);
+            }));
+        }
+        for (std::size_t t = 0; t < threads.size(); ++t)
+        {
+            threads[t].join();
+        }
+
+        long long total = 4LL * 50000 * sizeof (Particle);
+        check(find("Particle", sample) && sample.estimatedBytes > total * 8 / 10 && sample.estimatedBytes < total * 12 / 10,
+              "threads are sampled concurrently");
+        check(AllocationProfiler::getDroppedSamples() == 0, "no sample is dropped");
+    }
+#endif
+
+    // Stopping keeps the profile, starting discards it
+    AllocationProfiler::stop();
+    find("Particle", before);
+    churn(particles, COUNT);
+    check(find("Particle", sample) && sample.samples == before.samples, "nothing is sampled once stopped");
+
+    AllocationProfiler::start();
+    check(AllocationProfiler::snapshot().empty(), "starting discards the previous profile");
+    check(AllocationProfiler::getSamplingInterval() == AllocationProfiler::DEFAULT_SAMPLING_INTERVAL, "the default interval is restored");
+    AllocationProfiler::stop();
+
+    return testResult();
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   allocation_statistics.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 5:20 PM
+ */
+
+#include <stdlib.h>
+#include <cstring>
+#include <iostream>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <thread>
+#include <vector>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+
+class Widget : public Object
+{
+    AXF_CLASS_TYPE(Widget, AXF_TYPE(axf::core::Object))
+public:
+
+    Widget(int id) : m_id(id) { }
+
+    int m_id;
+} ;
+
+static bool find(const char* typeName, AllocationSnapshot& result)
+{
+    std::vector<AllocationSnapshot> snapshots = AllocationRegistry::snapshot();
+    for (std::size_t i = 0; i < snapshots.size(); ++i)
+    {
+        if (std::strcmp(snapshots[i].typeName, typeName) == 0)
+        {
+            result = snapshots[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    AllocationSnapshot s;
+
+    // Library objects are keyed by their reflection name
+    InstrumentedAllocator<Widget> widgets;
+    Widget* w[10];
+    for (int i = 0; i < 10; ++i)
+    {
+        w[i] = widgets.newObject(Widget(i));
+    }
+    check(find("Widget", s), "site registered under the class name");
+    check(s.liveObjects == 10 && s.liveBytes == (long long) (10 * sizeof (Widget)), "live objects and bytes are counted");
+
+    for (int i = 0; i < 5; ++i)
+    {
+        widgets.deleteObject(w[i]);
+    }
+    find("Widget", s);
+    check(s.liveObjects == 5 && s.allocations == 10 && s.deallocations == 5, "deallocations are counted");
+    check(s.sampledPeakBytes == (long long) (10 * sizeof (Widget)), "peak usage is kept after deallocations");
+    for (int i = 5; i < 10; ++i)
+    {
+        widgets.deleteObject(w[i]);
+    }
+
+    // Other types are keyed by their demangled type name
+    InstrumentedAllocator<double> doubles;
+    double* array = doubles.allocate(100);
+    check(find("double", s), "site registered under the demangled type name");
+    check(s.histogram[6] == 1, "size histogram classifies an 800 bytes request");
+    doubles.deallocate(array, 100);
+
+    // Explicitly named sites and containers
+    {
+        LinkedList<int, InstrumentedAllocator<Node<int> > > list;
+        for (int i = 0; i < 100; ++i)
+        {
+            list.add(i);
+        }
+        AllocationSite* site = InstrumentedAllocator<Node<int> >().getSite();
+        site->snapshot(s);
+        check(s.liveObjects == 100, "linked list nodes are tracked");
+    }
+    AllocationSite* site = InstrumentedAllocator<Node<int> >().getSite();
+    site->snapshot(s);
+    check(s.liveObjects == 0, "linked list nodes are released");
+
+    InstrumentedAllocator<int> named("request buffers");
+    int* buffer = named.allocate(4);
+    check(find("request buffers", s) && s.liveObjects == 4, "explicitly named site");
+    named.deallocate(buffer, 4);
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.push_back(std::thread([]() {
+            InstrumentedAllocator<Widget> allocator;
+            for (int i = 0; i < 10000; ++i)
+            {
+                allocator.deleteObject(allocator.newObject(Widget(i)));
+            }
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    find("Widget", s);
+    check(s.allocations == 40010 && s.liveObjects == 0, "counters are exact under concurrent updates");
+#endif
+
+    AllocationRegistry::dump(stdout, true);
+
+    return testResult();
+}
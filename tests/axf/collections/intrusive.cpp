@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   intrusive.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 12:15 PM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+
+#include <Axf.h>
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+
+static int g_alive = 0;
+static int g_hashes = 0;
+
+class Entry : public Object, public IntrusiveListHook<>, public IntrusiveHashHook<>
+{
+    AXF_CLASS_TYPE(Entry, AXF_TYPE(axf::core::Object))
+public:
+
+    Entry(int key) : m_key(key)
+    {
+        ++g_alive;
+    }
+
+    ~Entry()
+    {
+        --g_alive;
+    }
+
+    virtual bool equals(const Object& object) const
+    {
+        return m_key == static_cast<const Entry&> (object).m_key;
+    }
+
+    virtual int hashCode() const
+    {
+        ++g_hashes;
+        return m_key * 31;
+    }
+
+    int m_key;
+} ;
+
+static void print(const IntrusiveList<Entry>& list)
+{
+    std::cout << "list (" << list.size() << "): ";
+    for (Entry* e = list.front(); e != NULL; e = list.next(*e))
+    {
+        std::cout << e->m_key << " ";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int failures = 0;
+
+    // Non owning list over stack objects
+    {
+        Entry a(1), b(2), c(3), d(4);
+        IntrusiveList<Entry> list;
+
+        list.pushBack(a);
+        list.pushBack(b);
+        list.pushBack(c);
+        list.pushFront(d);
+        print(list);
+
+        list.remove(b);
+        std::cout << "removed 2, linked? " << static_cast<IntrusiveListHook<>&> (b).isLinked() << std::endl;
+        list.moveToFront(c);
+        list.moveToBack(d);
+        print(list);
+
+        if (list.size() != 3 || list.front() != &c || list.back() != &d)
+        {
+            std::cout << "FAILED: unexpected list order" << std::endl;
+            ++failures;
+        }
+
+        try
+        {
+            list.pushBack(a);
+            std::cout << "FAILED: linking twice must throw" << std::endl;
+            ++failures;
+        }
+        catch (IllegalStateException& ex)
+        {
+            std::cout << ex.getClassName() << ": " << ex.getMessage() << std::endl;
+        }
+    }
+
+    // Owning list: the list keeps the elements alive
+    {
+        IntrusiveList<Entry, DefaultHookTag, true> list;
+        {
+            strong_ref<Entry> e1 = new Entry(10);
+            strong_ref<Entry> e2 = new Entry(20);
+            list.pushBack(*e1);
+            list.pushBack(*e2);
+            std::cout << "strong references of 10: " << e1.users() << std::endl;
+        }
+        std::cout << "alive after dropping the strong_refs: " << g_alive << std::endl;
+        if (g_alive != 2)
+            ++failures;
+
+        list.remove(*list.front());
+        std::cout << "alive after removing one: " << g_alive << std::endl;
+        if (g_alive != 1)
+            ++failures;
+    }
+    std::cout << "alive after destroying the list: " << g_alive << std::endl;
+    if (g_alive != 0)
+        ++failures;
+
+    // Hash set, linked at the same time as the list
+    {
+        IntrusiveHashSet<Entry> set(4);
+        IntrusiveList<Entry> list;
+        Entry* entries[100];
+        for (int i = 0; i < 100; ++i)
+        {
+            entries[i] = new Entry(i);
+            set.insert(*entries[i]);
+            list.pushBack(*entries[i]);
+        }
+
+        // Inserting hashes the element only once
+        Entry extra(1000);
+        g_hashes = 0;
+        set.insert(extra);
+        std::cout << "hashes per insert: " << g_hashes << std::endl;
+        if (g_hashes != 1)
+            ++failures;
+        set.remove(extra);
+
+        Entry probe(42);
+        Entry* found = set.find(probe);
+        std::cout << "set size: " << set.size() << ", found 42? " << (found == entries[42]) << std::endl;
+        std::cout << "duplicate inserted? " << set.insert(probe) << std::endl;
+        if (found != entries[42] || set.size() != 100)
+            ++failures;
+
+        set.remove(*entries[42]);
+        list.remove(*entries[42]);
+        std::cout << "found 42 after removal? " << set.contains(probe) << std::endl;
+        if (set.contains(probe) || list.size() != 99)
+            ++failures;
+
+        set.clear();
+        list.clear();
+        for (int i = 0; i < 100; ++i)
+        {
+            delete entries[i];
+        }
+    }
+
+    std::cout << (failures == 0 ? "all checks passed" : "some checks FAILED") << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/*
+ * File:   region_allocator.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:40 PM
+ */
+
+#include <stdlib.h>
+#include <cstring>
+#include <iostream>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+
+struct Triple
+{
+    double x;
+    double y;
+    double z;
+} ;
+
+typedef LinkedList<long, RegionAllocator<Node<long> > > RegionList;
+
+int main(int argc, char** argv)
+{
+    const std::size_t SLAB = VirtualRegion::SLAB_SIZE;
+
+    {
+        // Slabs, commitment and reuse
+        VirtualRegion region(16 * SLAB, true, 4 * SLAB);
+        std::cout << "huge pages: " << (region.isHugePageBacked() ? "yes" : "no") << std::endl;
+
+        check(region.getCapacity() == 16 * SLAB, "the capacity is kept");
+        check(region.getCommittedBytes() == 0, "nothing is committed up front");
+
+        void* first = region.allocateSlab();
+        check((std::size_t) first % SLAB == 0, "slabs are aligned to their size");
+        check(region.contains(first) && region.contains((char*) first + SLAB - 1), "slabs lie within the region");
+        check(region.getCommittedBytes() == 4 * SLAB, "memory is committed a chunk at a time");
+        std::memset(first, 0xab, SLAB);
+
+        void* slabs[16];
+        slabs[0] = first;
+        for (int i = 1; i < 16; ++i)
+        {
+            slabs[i] = region.allocateSlab();
+            check(slabs[i] != slabs[i - 1], "slabs are distinct") ;
+        }
+        check(region.getSlabsInUse() == 16, "slabs in use are counted");
+        check(region.getCommittedBytes() == 16 * SLAB, "the whole region is committed once taken");
+
+        bool exhausted = false;
+        try
+        {
+            region.allocateSlab();
+        }
+        catch (OutOfMemoryError&)
+        {
+            exhausted = true;
+        }
+        check(exhausted, "an exhausted region throws");
+
+        region.releaseSlab(slabs[3]);
+        check(region.allocateSlab() == slabs[3], "released slabs are reused");
+
+        for (int i = 0; i < 16; ++i)
+        {
+            region.releaseSlab(slabs[i]);
+        }
+        check(region.getSlabsInUse() == 0, "every slab is back");
+        check(region.getCommittedBytes() >= 4 * SLAB && region.getCommittedBytes() <= 8 * SLAB, "free slabs past two chunks are decommitted");
+
+        region.trim();
+        check(region.getCommittedBytes() == 0, "trimming decommits every free slab");
+
+        void* reused = region.allocateSlab();
+        std::memset(reused, 0x5a, SLAB);
+        check(region.getCommittedBytes() == SLAB && ((unsigned char*) reused)[SLAB - 1] == 0x5a, "decommitted slabs are committed again");
+        region.releaseSlab(reused);
+    }
+
+    {
+        // Pool allocation
+        VirtualRegion region(8 * SLAB, false);
+        check(!region.isHugePageBacked(), "regions may use regular pages");
+
+        {
+            RegionAllocator<Triple> allocator(region);
+            Triple* a = allocator.allocate();
+            Triple* b = allocator.allocate();
+            check(region.contains(a) && region.contains(b), "objects come from the region");
+            check(b == a + 1, "objects are packed");
+            check((std::size_t) a % sizeof (double) == 0, "objects are aligned");
+
+            allocator.deallocate(a);
+            check(allocator.allocate() == a, "released objects are reused");
+
+            Triple* array = allocator.allocate(10);
+            allocator.deallocate(array, 10);
+            check(allocator.allocate() == array + 9 && allocator.allocate() == array + 8, "arrays are reused for single objects");
+
+            bool tooLarge = false;
+            try
+            {
+                allocator.allocate(allocator.maxSize() + 1);
+            }
+            catch (OutOfMemoryError&)
+            {
+                tooLarge = true;
+            }
+            check(tooLarge, "requests larger than a slab throw");
+
+            for (int i = 0; i < 200000; ++i)
+            {
+                allocator.allocate();
+            }
+            check(region.getSlabsInUse() == (200000 * sizeof (Triple)) / SLAB + 1, "slabs are taken as needed");
+        }
+        check(region.getSlabsInUse() == 0, "destroying an allocator releases its slabs");
+    }
+
+    {
+        // Collections
+        RegionList list;
+        long expected = 0;
+        for (long i = 0; i < 100000; ++i)
+        {
+            list.add(i);
+            expected += i;
+        }
+
+        RegionList copy(list);
+        long sum = 0;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            sum += copy.get(i);
+        }
+        check(copy.size() == 100000 && sum == 999 * 1000 / 2, "lists copy across region allocators");
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+        RegionList moved(std::move(list));
+        check(moved.size() == 100000 && list.size() == 0, "lists move with their allocator");
+
+        list = std::move(moved);
+        check(list.size() == 100000 && list.get(99999) == 99999, "lists move assign with their allocator");
+#endif
+        check(VirtualRegion::global().getSlabsInUse() > 0, "allocators without a region use the global one");
+    }
+    check(VirtualRegion::global().getSlabsInUse() == 0, "the global region gets its slabs back");
+
+    return testResult();
+}
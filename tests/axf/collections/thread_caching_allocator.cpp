@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   thread_caching_allocator.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 2:40 PM
+ */
+
+#include <stdlib.h>
+#include <cstring>
+#include <iostream>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <thread>
+#include <vector>
+#endif
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+
+typedef LinkedList<int, ThreadCachingAllocator<Node<int> > > CachedList;
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+/**
+ * Allocates blocks on one thread and releases them on another, so every
+ * block crosses threads and goes through the depot.
+ */
+static bool crossThreadFrees()
+{
+    const int rounds = 200;
+    const int blocks = 500;
+
+    std::vector<char*> handoff(blocks);
+    bool ok = true;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::thread producer([&]() {
+            for (int i = 0; i < blocks; ++i)
+            {
+                std::size_t size = 1 + (i * 37) % 1024;
+                handoff[i] = static_cast<char*> (ThreadCache::allocate(size));
+                std::memset(handoff[i], round & 0xFF, size);
+            }
+        });
+        producer.join();
+
+        std::thread consumer([&]() {
+            for (int i = 0; i < blocks; ++i)
+            {
+                std::size_t size = 1 + (i * 37) % 1024;
+                if (handoff[i][size - 1] != (char) (round & 0xFF))
+                {
+                    ok = false;
+                }
+                ThreadCache::deallocate(handoff[i], size);
+            }
+        });
+        consumer.join();
+    }
+    return ok;
+}
+
+/**
+ * Several threads building and destroying lists concurrently.
+ */
+static bool concurrentLists()
+{
+    const int threadCount = 4;
+    std::vector<std::thread> threads;
+    std::vector<int> results(threadCount, 0);
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([t, &results]() {
+            long sum = 0;
+            for (int round = 0; round < 50; ++round)
+            {
+                CachedList list;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    list.add(i);
+                }
+                while (!list.isEmpty())
+                {
+                    sum += list.get(0);
+                    list.removeAt(0);
+                }
+            }
+            results[t] = (sum == 50L * 999 * 1000 / 2);
+        }));
+    }
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t].join();
+    }
+    for (int t = 0; t < threadCount; ++t)
+    {
+        if (!results[t])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    // Blocks of the same size class are recycled
+    void* a = ThreadCache::allocate(40);
+    ThreadCache::deallocate(a, 40);
+    void* b = ThreadCache::allocate(48);
+    check(a == b, "freed block is reused by a request of the same size class");
+    ThreadCache::deallocate(b, 48);
+
+    // Large requests bypass the caches
+    char* large = static_cast<char*> (ThreadCache::allocate(64 * 1024));
+    std::memset(large, 0, 64 * 1024);
+    ThreadCache::deallocate(large, 64 * 1024);
+    check(true, "large requests are served by the system allocator");
+
+    // Overflowing the local cache spills magazines to the depot
+    const int count = 1000;
+    void* blocks[count];
+    for (int i = 0; i < count; ++i)
+    {
+        blocks[i] = ThreadCache::allocate(24);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        ThreadCache::deallocate(blocks[i], 24);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        blocks[i] = ThreadCache::allocate(24);
+        std::memset(blocks[i], 0xAB, 24);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        ThreadCache::deallocate(blocks[i], 24);
+    }
+    check(true, "local caches spill to and refill from the depot");
+
+    // The allocator as a drop-in replacement in a collection
+    CachedList list;
+    for (int i = 0; i < 100; ++i)
+    {
+        list.add(i);
+    }
+    list.remove(50);
+    check(list.size() == 99 && list.get(50) == 51, "linked list works with the thread caching allocator");
+
+    ThreadCachingAllocator<Node<int> > first;
+    ThreadCachingAllocator<Node<int> > second;
+    Node<int>* node = first.allocate();
+    second.deallocate(node);
+    Node<int>* reused = first.allocate();
+    check(reused == node, "allocator instances share their caches");
+    first.deallocate(reused);
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    check(crossThreadFrees(), "blocks allocated and released by different threads");
+    check(concurrentLists(), "concurrent lists on several threads");
+#endif
+
+    ThreadCache::flush();
+    ThreadCache::trim();
+    check(true, "caches flushed and trimmed");
+
+    return testResult();
+}
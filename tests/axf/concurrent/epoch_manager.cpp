@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   epoch_manager.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 12:40 PM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::concurrent;
+
+static const int LIVE = 0x11FE;
+static const int DEAD = 0xDEAD;
+
+struct Node
+{
+    volatile int    magic;
+    long            value;
+    Node*           next;
+} ;
+
+static volatile long g_disposed = 0;
+
+/**
+ * Nodes are poisoned instead of freed while threads run, so a node disposed
+ * of too early is caught by the readers.
+ */
+static SpinLock             g_graveyardLock;
+static std::vector<Node*>   g_graveyard;
+
+struct Bury
+{
+
+    void operator()(Node* node)
+    {
+        node->magic = DEAD;
+        atomicFetchAdd(&g_disposed, 1L);
+
+        ScopedLock<SpinLock> guard(g_graveyardLock);
+        g_graveyard.push_back(node);
+    }
+} ;
+
+struct Counted
+{
+    static volatile long destroyed;
+
+    ~Counted()
+    {
+        atomicFetchAdd(&destroyed, 1L);
+    }
+} ;
+
+volatile long Counted::destroyed = 0;
+
+/**
+ * A Treiber stack whose nodes are reclaimed through a manager.
+ */
+class Stack
+{
+public:
+
+    explicit Stack(EpochManager& manager) : m_head(NULL), m_manager(manager) { }
+
+    void push(long value)
+    {
+        Node* node = new Node;
+        node->magic = LIVE;
+        node->value = value;
+        node->next = atomicLoad(&m_head, RELAXED);
+        while (!atomicCompareExchange(&m_head, node->next, node, true, RELEASE, RELAXED))
+        {
+        }
+    }
+
+    bool pop(long& value)
+    {
+        EpochManager::Guard guard(m_manager);
+        Node* head = atomicLoad(&m_head, ACQUIRE);
+        while (head != NULL)
+        {
+            if (head->magic != LIVE)
+            {
+                atomicFetchAdd(&violations, 1L);
+            }
+            if (atomicCompareExchange(&m_head, head, head->next, true, ACQUIRE, ACQUIRE))
+            {
+                value = head->value;
+                m_manager.retire(head, Bury());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static volatile long violations;
+
+private:
+
+    Node* volatile  m_head;
+    EpochManager&   m_manager;
+} ;
+
+volatile long Stack::violations = 0;
+
+static const int THREADS = 4;
+static const int OPERATIONS = 200000;
+
+struct Worker
+{
+    Stack*          stack;
+    long            popped;
+} ;
+
+static void* work(void* argument)
+{
+    Worker* worker = static_cast<Worker*> (argument);
+    long value;
+    for (int i = 0; i < OPERATIONS; ++i)
+    {
+        worker->stack->push(i);
+        if (worker->stack->pop(value))
+        {
+            worker->popped++;
+        }
+        if ((i & 255) == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * A thread that stays pinned until it is told to leave.
+ */
+struct Pinner
+{
+    EpochManager*   manager;
+    volatile int    pinned;
+    volatile int    leave;
+} ;
+
+static void* stayPinned(void* argument)
+{
+    Pinner* pinner = static_cast<Pinner*> (argument);
+    {
+        EpochManager::Guard guard(*pinner->manager);
+        atomicStore(&pinner->pinned, 1);
+        while (atomicLoad(&pinner->leave) == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    // Basic retirement
+    {
+        EpochManager manager;
+        for (int i = 0; i < 10; ++i)
+        {
+            manager.retire(new Counted());
+        }
+        manager.retire(static_cast<char*> (malloc(16)), core::bits::default_free<char>());
+        check(Counted::destroyed == 0, "retired pointers wait in the bag");
+
+        manager.flush();
+        check(manager.pending() == 11, "a flushed bag waits two epochs");
+        manager.collect();
+        manager.collect();
+        check(Counted::destroyed == 10, "then it is disposed of");
+        check(manager.pending() == 0, "nothing pending");
+        check(manager.epoch() >= 2, "the epoch advanced");
+    }
+
+    // Nested pins, and retirement while pinned
+    {
+        EpochManager manager;
+        Counted::destroyed = 0;
+        {
+            EpochManager::Guard outer(manager);
+            manager.pin();
+            manager.retire(new Counted());
+            manager.flush();
+            manager.collect();
+            manager.collect();
+            manager.unpin();
+            check(Counted::destroyed == 0, "nothing is disposed of while the retiring thread is pinned");
+        }
+        manager.collect();
+        manager.collect();
+        check(Counted::destroyed == 1, "disposed of after unpinning");
+    }
+
+    // Another pinned thread holds reclamation back
+    {
+        EpochManager manager;
+        Counted::destroyed = 0;
+
+        Pinner pinner;
+        pinner.manager = &manager;
+        pinner.pinned = 0;
+        pinner.leave = 0;
+
+        pthread_t thread;
+        pthread_create(&thread, NULL, stayPinned, &pinner);
+        while (atomicLoad(&pinner.pinned) == 0)
+        {
+            sched_yield();
+        }
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            manager.retire(new Counted());
+        }
+        manager.flush();
+        for (int i = 0; i < 10; ++i)
+        {
+            manager.collect();
+        }
+        check(Counted::destroyed == 0, "a pinned thread holds reclamation back");
+
+        atomicStore(&pinner.leave, 1);
+        pthread_join(thread, NULL);
+        manager.collect();
+        manager.collect();
+        check(Counted::destroyed == 1000, "reclaimed once it unpins");
+    }
+
+    // Destroying a manager disposes of what it holds
+    {
+        Counted::destroyed = 0;
+        {
+            EpochManager manager;
+            for (int i = 0; i < 100; ++i)
+            {
+                manager.retire(new Counted());
+            }
+        }
+        check(Counted::destroyed == 100, "a destroyed manager disposes of everything");
+    }
+
+    // Stress: a lock-free stack shared by several threads
+    {
+        EpochManager manager;
+        Stack stack(manager);
+
+        Worker workers[THREADS];
+        pthread_t threads[THREADS];
+        for (int t = 0; t < THREADS; ++t)
+        {
+            workers[t].stack = &stack;
+            workers[t].popped = 0;
+            pthread_create(&threads[t], NULL, work, &workers[t]);
+        }
+
+        long popped = 0;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            pthread_join(threads[t], NULL);
+            popped += workers[t].popped;
+        }
+
+        long value;
+        while (stack.pop(value))
+        {
+            popped++;
+        }
+        manager.flush();
+        for (int i = 0; i < 4 && manager.pending() > 0; ++i)
+        {
+            manager.collect();
+        }
+
+        check(popped == (long) THREADS * OPERATIONS, "every pushed node was popped");
+        check(Stack::violations == 0, "no node was disposed of while being read");
+        check(g_disposed == popped, "every popped node was disposed of");
+        check(manager.pending() == 0, "nothing left pending");
+    }
+
+    // The global manager
+    {
+        Counted::destroyed = 0;
+        EpochManager::global().retire(new Counted());
+        EpochManager::global().flush();
+        EpochManager::global().collect();
+        EpochManager::global().collect();
+        check(Counted::destroyed == 1, "the global manager reclaims too");
+    }
+
+    for (std::size_t i = 0; i < g_graveyard.size(); ++i)
+    {
+        delete g_graveyard[i];
+    }
+
+    return testResult();
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   hash.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 8:05 PM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <set>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+
+class Point : public Object
+{
+    AXF_CLASS_TYPE(Point, AXF_TYPE(axf::core::Object))
+    AXF_HASH_FIELDS(m_x, m_y, m_label)
+public:
+
+    Point(int x, int y, const char* label) : m_x(x), m_y(y), m_label(label) { }
+
+    virtual bool equals(const Object& object) const
+    {
+        const Point& rhs = static_cast<const Point&> (object);
+        return m_x == rhs.m_x && m_y == rhs.m_y && std::strcmp(m_label, rhs.m_label) == 0;
+    }
+
+private:
+
+    int         m_x;
+    int         m_y;
+    const char* m_label;
+} ;
+
+class Vector : public Object
+{
+    AXF_CLASS_TYPE(Vector, AXF_TYPE(axf::core::Object))
+    AXF_HASH_FIELDS(m_x, m_y, m_label)
+public:
+
+    Vector(int x, int y, const char* label) : m_x(x), m_y(y), m_label(label) { }
+
+private:
+
+    int         m_x;
+    int         m_y;
+    const char* m_label;
+} ;
+
+class Counter : public Object, public CachedHash
+{
+    AXF_CLASS_TYPE(Counter, AXF_TYPE(axf::core::Object))
+    AXF_CACHED_HASH_FIELDS(m_name, m_value)
+public:
+
+    Counter(const char* name, int value) : m_name(name), m_value(value) { }
+
+    void increment()
+    {
+        m_value++;
+        invalidateHashCode();
+    }
+
+    bool isHashCached() const
+    {
+        return getCachedHashCode() != 0;
+    }
+
+private:
+
+    string  m_name;
+    int     m_value;
+} ;
+
+static int popcount(hash_t value)
+{
+    int count = 0;
+    for (; value != 0; value &= value - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * Average number of output bits that change when a single input bit is
+ * flipped. An ideal hash flips half of them.
+ */
+static double avalanche(std::size_t length)
+{
+    unsigned char buffer[256];
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        buffer[i] = (unsigned char) (i * 131 + 7);
+    }
+
+    hash_t reference = hash(buffer, length);
+    long flipped = 0;
+    for (std::size_t bit = 0; bit < length * 8; ++bit)
+    {
+        buffer[bit / 8] ^= (unsigned char) (1 << (bit % 8));
+        flipped += popcount(reference ^ hash(buffer, length));
+        buffer[bit / 8] ^= (unsigned char) (1 << (bit % 8));
+    }
+    return (double) flipped / (length * 8);
+}
+
+int main(int argc, char** argv)
+{
+    const char* text = "the quick brown fox jumps over the lazy dog, again and again and again";
+
+    check(hash(text) == hash(text, std::strlen(text)), "hash is deterministic");
+    check(hash(text, 10, 1) != hash(text, 10, 2), "seed changes the hash");
+
+    // Every prefix of a string hashes differently, including the empty one
+    std::set<hash_t> prefixes;
+    std::size_t length = std::strlen(text);
+    for (std::size_t i = 0; i <= length; ++i)
+    {
+        prefixes.insert(hash(text, i));
+    }
+    check(prefixes.size() == length + 1, "prefixes of every length hash differently");
+
+    // Small integers spread over the whole output
+    std::set<int> buckets;
+    for (int i = 0; i < 1024; ++i)
+    {
+        buckets.insert(foldHash(hashValue(i)) & 1023);
+    }
+    check(buckets.size() > 600, "consecutive integers spread across buckets");
+
+    const std::size_t lengths[] = {3, 8, 16, 33, 100, 200};
+    bool avalancheOk = true;
+    for (unsigned i = 0; i < sizeof (lengths) / sizeof (lengths[0]); ++i)
+    {
+        double bits = avalanche(lengths[i]);
+        std::cout << "       avalanche, " << lengths[i] << " bytes: " << bits << " bits" << std::endl;
+        avalancheOk = avalancheOk && bits > 28 && bits < 36;
+    }
+    check(avalancheOk, "single bit flips change about half of the output bits");
+
+    check(hashValue(0.0) == hashValue(-0.0), "positive and negative zero hash equal");
+
+    // Field hashing
+    Point a(1, 2, "origin");
+    Point b(1, 2, "origin");
+    Point c(2, 1, "origin");
+    Vector v(1, 2, "origin");
+    check(a.equals(b) && a.hashCode() == b.hashCode(), "equal objects have equal hash codes");
+    check(a.hashCode() != c.hashCode(), "field order matters");
+    check(a.hashCode() != v.hashCode(), "the class takes part in the hash");
+
+    // Cached string hashes
+    string key("server.http.timeout");
+    string same("server.http.timeout");
+    check(key == same && key.hashCode() == same.hashCode(), "equal strings have equal hash codes");
+
+    int keyHash = key.hashCode();
+    key.append(".ms");
+    string appended("server.http.timeout.ms");
+    check(key.hashCode() != keyHash && key.hashCode() == appended.hashCode(), "append invalidates the cached hash");
+
+    string copy(key);
+    check(copy == key && copy.hashCode() == key.hashCode(), "copies keep the hash");
+    copy = same;
+    check(copy.hashCode() == keyHash, "assignment replaces the hash");
+    copy.clear();
+    check(copy.hashCode() == string().hashCode() && copy == string(), "clear resets the hash");
+    check(key != same, "strings of different contents are not equal");
+
+    // Cached object hashes
+    Counter counter("requests", 1);
+    check(!counter.isHashCached(), "hash is computed lazily");
+    int counterHash = counter.hashCode();
+    check(counter.isHashCached() && counter.hashCode() == counterHash, "hash is cached after the first call");
+    counter.increment();
+    check(!counter.isHashCached() && counter.hashCode() != counterHash, "invalidating recomputes the hash");
+    counter.increment();
+    check(counter.hashCode() == Counter("requests", 3).hashCode(), "cached and fresh hashes agree");
+
+    // Identity hash does not depend on the reference counts
+    Object* object = new Object();
+    object->grabStrongReference();
+    int before = object->hashCode();
+    object->grabStrongReference();
+    int after = object->hashCode();
+    object->releaseStrongReference();
+    object->releaseStrongReference();
+    check(before == after, "identity hash is stable across reference count changes");
+
+    return testResult();
+}
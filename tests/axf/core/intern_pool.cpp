@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   intern_pool.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 10:15 PM
+ */
+
+#include <stdlib.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <thread>
+#endif
+
+using namespace axf;
+using namespace axf::core;
+
+class Animal : public Object
+{
+    AXF_CLASS_TYPE(Animal, AXF_TYPE(axf::core::Object))
+} ;
+
+class Dog : public Animal
+{
+    AXF_CLASS_TYPE(Dog, AXF_TYPE(Animal))
+} ;
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+/**
+ * Several threads intern overlapping sets of names; every thread must get
+ * the same handles.
+ */
+static bool concurrentInterning()
+{
+    const int threadCount = 4;
+    const int nameCount = 5000;
+
+    InternPool pool;
+    std::vector<std::vector<InternedString> > results(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([t, &pool, &results]() {
+            char name[64];
+            results[t].resize(nameCount);
+            for (int i = 0; i < nameCount; ++i)
+            {
+                // Each thread starts at a different name
+                int n = (i + t * 1237) % nameCount;
+                std::sprintf(name, "protocol.field.%d", n);
+                results[t][n] = pool.intern(name);
+            }
+        }));
+    }
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t].join();
+    }
+
+    for (int t = 1; t < threadCount; ++t)
+    {
+        if (results[t] != results[0])
+        {
+            return false;
+        }
+    }
+    return pool.size() == (std::size_t) nameCount;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    InternPool pool;
+
+    std::string text("log.category.network");
+    InternedString a = pool.intern("log.category.network");
+    InternedString b = pool.intern(text.c_str());
+    InternedString c = pool.intern("log.category.storage");
+    check(a == b && a.bytes() == b.bytes(), "equal contents give the same handle");
+    check(a != c, "different contents give different handles");
+    check(std::strcmp(a.bytes(), "log.category.network") == 0 && a.size() == text.size(), "contents are kept");
+    check(a.hashCode() == string("log.category.network").hashCode(), "hash code matches the string hash code");
+    check(pool.intern(string("log.category.storage")) == c, "strings intern like C strings");
+
+    check(pool.find("log.category.unknown").isNull(), "find does not intern");
+    check(pool.find("log.category.storage") == c, "find returns interned strings");
+    check(pool.size() == 2, "the pool holds each string once");
+
+    InternedString empty = pool.intern("");
+    check(!empty.isNull() && empty.size() == 0 && empty != InternedString(), "the empty string is not the null handle");
+
+    const char binary[] = {'a', 0, 'b'};
+    InternedString withNull = pool.intern(binary, sizeof (binary));
+    check(withNull.size() == 3 && withNull != pool.intern("a"), "bytes may contain nulls");
+
+    // Enough strings to grow every shard, and some larger than a chunk
+    std::vector<InternedString> many;
+    char name[64];
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::sprintf(name, "symbol_%d", i);
+        many.push_back(pool.intern(name));
+    }
+    std::string large(20000, 'x');
+    InternedString largeString = pool.intern(large.c_str());
+    bool stable = largeString == pool.intern(large.c_str());
+    for (int i = 0; i < 20000 && stable; ++i)
+    {
+        std::sprintf(name, "symbol_%d", i);
+        stable = many[i] == pool.intern(name) && std::strcmp(many[i].bytes(), name) == 0;
+    }
+    check(stable, "handles survive growth");
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    check(concurrentInterning(), "concurrent interning agrees on handles");
+#endif
+
+    // Type names live in the global pool
+    const Class<Dog>& dog = Dog::getCompileTimeClass();
+    check(dog.getInternedName() == InternPool::global().find("Dog"), "type names are interned");
+    check(dog.isKindOf(Animal::getCompileTimeClass()), "kind of walks interned names");
+
+    std::string animalName("Animal");
+    check(dog.getSuperClass(animalName.c_str()).equals(Animal::getCompileTimeClass()), "super class found by a copied name");
+
+    bool thrown = false;
+    try
+    {
+        dog.getSuperClass("NotAType");
+    }
+    catch (IllegalStateException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "unknown names are not super classes");
+
+    return testResult();
+}
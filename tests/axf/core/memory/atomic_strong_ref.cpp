@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   atomic_strong_ref.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:50 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+static volatile long g_created = 0;
+static volatile long g_destroyed = 0;
+
+class Config : public Object
+{
+    AXF_CLASS_TYPE(Config, AXF_TYPE(axf::core::Object))
+public:
+
+    const long      m_version;
+    volatile int    m_alive;
+
+    explicit Config(long version) : m_version(version), m_alive(1)
+    {
+        atomicFetchAdd(&g_created, 1);
+    }
+
+    virtual ~Config()
+    {
+        m_alive = 0;
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+static const int READER_COUNT = 4;
+static const int WRITER_COUNT = 2;
+static const long VERSIONS = 20000;
+
+static atomic_strong_ref<Config>* g_current = NULL;
+static volatile int g_writing = 0;
+
+/**
+ * Loads the current configuration until the writers are done. Versions seen
+ * by one reader never go back, and every loaded object is alive.
+ */
+static void* reader(void* argument)
+{
+    long& errors = *static_cast<long*> (argument);
+    long last = 0;
+    while (atomicLoad(&g_writing, ACQUIRE) != 0)
+    {
+        strong_ref<Config> config = g_current->load();
+        if (config.isNull() || config->m_alive != 1 || config->m_version < last)
+        {
+            errors++;
+        }
+        else
+        {
+            last = config->m_version;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Publishes new versions with compare and exchange, each one the successor
+ * of the version it replaces, so no update is ever lost.
+ */
+static void* writer(void* argument)
+{
+    long& errors = *static_cast<long*> (argument);
+    for (long i = 0; i < VERSIONS; ++i)
+    {
+        strong_ref<Config> expected = g_current->load();
+        for (;;)
+        {
+            strong_ref<Config> next(new Config(expected->m_version + 1));
+            if (g_current->compareExchange(expected, next))
+                break;
+            if (expected.isNull())
+            {
+                errors++;
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+static bool concurrentPublication()
+{
+    long created = g_created;
+    long destroyed = g_destroyed;
+    g_current = new atomic_strong_ref<Config>(strong_ref<Config>(new Config(0)));
+    g_writing = 1;
+
+    std::vector<long> errors(READER_COUNT + WRITER_COUNT, 0);
+    std::vector<pthread_t> threads(READER_COUNT + WRITER_COUNT);
+    for (int t = 0; t < READER_COUNT; ++t)
+    {
+        pthread_create(&threads[t], NULL, &reader, &errors[t]);
+    }
+    for (int t = READER_COUNT; t < READER_COUNT + WRITER_COUNT; ++t)
+    {
+        pthread_create(&threads[t], NULL, &writer, &errors[t]);
+    }
+    for (int t = READER_COUNT; t < READER_COUNT + WRITER_COUNT; ++t)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    atomicStore(&g_writing, 0, RELEASE);
+    for (int t = 0; t < READER_COUNT; ++t)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    long failures = 0;
+    for (std::size_t t = 0; t < errors.size(); ++t)
+    {
+        failures += errors[t];
+    }
+    bool allVersions = g_current->load()->m_version == VERSIONS * WRITER_COUNT;
+    delete g_current;
+    return failures == 0 && allVersions && g_created - created == g_destroyed - destroyed;
+}
+
+int main(int argc, char** argv)
+{
+    {
+        long destroyed = g_destroyed;
+        atomic_strong_ref<Config> current;
+        check(current.load().isNull() && current.isLockFree(), "a new reference is null");
+
+        strong_ref<Config> first(new Config(1));
+        current.store(first);
+        bool same = current.load().get() == first.get();
+        check(same && first.users() == 2, "store shares the object");
+
+        strong_ref<Config> second(new Config(2));
+        strong_ref<Config> previous = current.exchange(second);
+        check(previous.get() == first.get() && current.load()->m_version == 2, "exchange returns the previous object");
+        previous.reset();
+        check(first.users() == 1, "replaced objects are released");
+
+        strong_ref<Config> expected = first;
+        strong_ref<Config> third(new Config(3));
+        check(!current.compareExchange(expected, third) && expected.get() == second.get(),
+              "a failed compare exchange returns the current object");
+        check(third.users() == 1, "a failed compare exchange keeps no reference");
+        check(current.compareExchange(expected, third) && current.load().get() == third.get(),
+              "compare exchange replaces the expected object");
+
+        first.reset();
+        second.reset();
+        expected.reset();
+        check(g_destroyed - destroyed == 2, "objects die with their last reference");
+        current.store(strong_ref<Config>());
+        check(current.load().isNull() && third.users() == 1, "storing null releases the object");
+    }
+
+    check(concurrentPublication(), "readers never see a freed object while writers publish");
+
+    return testResult();
+}
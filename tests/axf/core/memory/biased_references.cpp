@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   biased_references.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:20 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+#ifdef AXF_BIASED_REFERENCES
+
+static volatile long g_destroyed = 0;
+static volatile long g_biased = 0;
+
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+public:
+
+    volatile int m_alive;
+
+    Node() : m_alive(1) { }
+
+    virtual ~Node()
+    {
+        m_alive = 0;
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+/**
+ * Takes a reference to a node and drops it from another thread.
+ */
+static void* dropper(void* argument)
+{
+    strong_ref<Node>* node = static_cast<strong_ref<Node>*> (argument);
+    node->reset();
+    return NULL;
+}
+
+/**
+ * Creates and biases a node, and lets the caller keep the only reference
+ * after this thread has finished.
+ */
+static void* creator(void* argument)
+{
+    strong_ref<Node>* result = static_cast<strong_ref<Node>*> (argument);
+    strong_ref<Node> node(new Node());
+    if (node->biasToCurrentThread())
+    {
+        atomicFetchAdd(&g_biased, 1);
+    }
+
+    strong_ref<Node> copy = node;
+    *result = copy;
+    return NULL;
+}
+
+static const int WORKER_COUNT = 4;
+static const int ITERATIONS = 200000;
+static const int OWNER_COUNT = 5000;
+
+struct Mixed
+{
+    strong_ref<Node>    node;
+    weak_ref<Node>      weak;
+    volatile int        errors;
+} ;
+
+static void* worker(void* argument)
+{
+    Mixed& mixed = *static_cast<Mixed*> (argument);
+    strong_ref<Node> mine = mixed.node;
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        strong_ref<Node> copy = mine;
+        strong_ref<Node> locked = mixed.weak.lock();
+        if (locked.isNull() || copy->m_alive != 1)
+        {
+            atomicFetchAdd(&mixed.errors, 1);
+        }
+    }
+    return NULL;
+}
+
+static bool mixedThreads()
+{
+    long destroyed = g_destroyed;
+
+    Mixed mixed;
+    mixed.node = strong_ref<Node>(new Node());
+    mixed.node->biasToCurrentThread();
+    mixed.weak = mixed.node;
+    mixed.errors = 0;
+
+    std::vector<pthread_t> threads(WORKER_COUNT);
+    for (int t = 0; t < WORKER_COUNT; ++t)
+    {
+        pthread_create(&threads[t], NULL, &worker, &mixed);
+    }
+
+    // The owner keeps counting locally meanwhile
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        strong_ref<Node> copy = mixed.node;
+        if (copy->m_alive != 1)
+        {
+            mixed.errors++;
+        }
+    }
+    for (int t = 0; t < WORKER_COUNT; ++t)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    bool counted = mixed.node.users() == 1 && mixed.node->isBiased();
+    mixed.node.reset();
+    return counted && mixed.errors == 0 && g_destroyed - destroyed == 1 && mixed.weak.expired();
+}
+
+int main(int argc, char** argv)
+{
+    // The owner alone
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Node> node(new Node());
+        check(node->biasToCurrentThread() && node->isBiased(), "an object referenced once can be biased");
+        check(!node->biasToCurrentThread(), "an object is biased only once");
+
+        strong_ref<Node> first = node;
+        strong_ref<Node> second = first;
+        check(node.users() == 3, "local references are counted");
+
+        first.reset();
+        second.reset();
+        check(node.users() == 1 && node->isBiased(), "local references are released");
+
+        weak_ref<Node> weak = node;
+        check(weak.lock().get() == node.get(), "weak references to biased objects upgrade");
+
+        node.reset();
+        check(g_destroyed - destroyed == 1 && weak.expired(), "the last local reference destroys the object");
+    }
+
+    // Objects shared when biased
+    {
+        strong_ref<Node> node(new Node());
+        strong_ref<Node> copy = node;
+        check(!node->biasToCurrentThread() && !node->isBiased(), "objects referenced twice are not biased");
+    }
+
+    // References handed over to a live owner
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Node> node(new Node());
+        node->biasToCurrentThread();
+
+        strong_ref<Node> copy = node;
+        node.reset();
+
+        pthread_t thread;
+        pthread_create(&thread, NULL, &dropper, &copy);
+        pthread_join(thread, NULL);
+        check(g_destroyed == destroyed, "a reference released by another thread is handed over");
+
+        ReferenceCounted::mergeBiasedReferences();
+        check(g_destroyed - destroyed == 1, "the owner releases handed over references when merging");
+    }
+
+    // References released while the owner keeps references
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Node> node(new Node());
+        node->biasToCurrentThread();
+
+        strong_ref<Node> copy = node;
+        pthread_t thread;
+        pthread_create(&thread, NULL, &dropper, &copy);
+        pthread_join(thread, NULL);
+
+        strong_ref<Node> other = node;
+        other.reset();
+        check(node.users() == 1 && g_destroyed == destroyed, "the owner merges while releasing its own references");
+        check(!node->isBiased(), "merged objects are no longer biased");
+        node.reset();
+        check(g_destroyed - destroyed == 1, "merged objects are destroyed by their last reference");
+    }
+
+    // Owners that finish before their objects
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Node> node;
+
+        pthread_t thread;
+        pthread_create(&thread, NULL, &creator, &node);
+        pthread_join(thread, NULL);
+        check(node.users() == 1 && g_destroyed == destroyed, "objects outlive the thread they are biased to");
+
+        node.reset();
+        check(g_destroyed - destroyed == 1, "references handed over to a finished owner are merged");
+    }
+
+    // References released while another one waits for the owner
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Node> node(new Node());
+        node->biasToCurrentThread();
+
+        strong_ref<Node> first = node;
+        strong_ref<Node> second = node;
+        pthread_t thread;
+        pthread_create(&thread, NULL, &dropper, &first);
+        pthread_join(thread, NULL);
+        pthread_create(&thread, NULL, &dropper, &second);
+        pthread_join(thread, NULL);
+        check(g_destroyed == destroyed && node->isBiased(), "references to an object waiting for its owner are released");
+
+        ReferenceCounted::mergeBiasedReferences();
+        check(node.users() == 1 && !node->isBiased(), "the owner merges an object once");
+        node.reset();
+        check(g_destroyed - destroyed == 1, "the merged object is destroyed by its last reference");
+    }
+
+    // Owners are recycled, more of them than compact bias words can name
+    {
+        long destroyed = g_destroyed;
+        long biased = g_biased;
+        for (int i = 0; i < OWNER_COUNT; ++i)
+        {
+            strong_ref<Node> node;
+            pthread_t thread;
+            pthread_create(&thread, NULL, &creator, &node);
+            pthread_join(thread, NULL);
+        }
+        check(g_biased - biased == OWNER_COUNT, "every thread biases its objects");
+        check(g_destroyed - destroyed == OWNER_COUNT, "every object is destroyed");
+    }
+
+    check(mixedThreads(), "the owner and other threads reference an object concurrently");
+
+    return testResult();
+}
+#else
+
+int main(int argc, char** argv)
+{
+    std::cout << "biased references are left out of this build" << std::endl;
+    return testResult();
+}
+#endif
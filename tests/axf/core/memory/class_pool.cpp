@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   class_pool.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 10:50 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::collections;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+static volatile long g_destroyed = 0;
+
+class Message : public Object
+{
+    AXF_CLASS_TYPE(Message, AXF_TYPE(axf::core::Object))
+    AXF_CLASS_POOL(Message)
+public:
+
+    int m_kind;
+
+    explicit Message(int kind) : m_kind(kind) { }
+
+    virtual ~Message()
+    {
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+/**
+ * A subclass larger than its pooled parent, which shares its pool.
+ */
+class Envelope : public Message
+{
+    AXF_CLASS_TYPE(Envelope, AXF_TYPE(Message))
+public:
+
+    char m_payload[200];
+
+    Envelope() : Message(2)
+    {
+        m_payload[0] = 'x';
+        m_payload[sizeof (m_payload) - 1] = 'y';
+    }
+} ;
+
+static const void* g_faulty = NULL;
+
+/**
+ * A message whose constructor always throws.
+ */
+class Faulty : public Message
+{
+    AXF_CLASS_TYPE(Faulty, AXF_TYPE(Message))
+public:
+
+    Faulty() : Message(6)
+    {
+        g_faulty = this;
+        throw IllegalStateException("faulty message.");
+    }
+} ;
+
+/**
+ * Releases the messages created by another thread.
+ */
+static void* consumer(void* argument)
+{
+    std::vector<strong_ref<Message> >* messages = static_cast<std::vector<strong_ref<Message> >*> (argument);
+    messages->clear();
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    check(ClassPool<Message>::isPooled(), "messages are small enough to be pooled");
+
+    // Memory is recycled by the same thread
+    {
+        const void* first;
+        {
+            strong_ref<Message> message(new Message(1));
+            first = message.get();
+        }
+        strong_ref<Message> message(new Message(1));
+        check(message.get() == first, "the memory of a released message is reused");
+        check(g_destroyed == 1, "the first message was destroyed");
+    }
+    g_destroyed = 0;
+
+    // Subclasses allocate with their own size
+    {
+        strong_ref<Message> envelope(new Envelope());
+        strong_ref<Message> message(new Message(1));
+        check(envelope->m_kind == 2, "an envelope is a message");
+        check(static_cast<Envelope*> (envelope.get())->m_payload[199] == 'y', "the payload is intact");
+        check(message.get() != envelope.get(), "messages and envelopes do not overlap");
+    }
+    check(g_destroyed == 2, "both were destroyed");
+    g_destroyed = 0;
+
+    // Weak references outliving a message
+    {
+        weak_ref<Message> weak;
+        {
+            strong_ref<Message> message(new Message(3));
+            weak = message;
+        }
+        check(g_destroyed == 1, "the message is destroyed");
+        check(weak.lock().get() == NULL, "and cannot be upgraded");
+    }
+    g_destroyed = 0;
+
+    // Other forms of new
+    {
+        Message* quiet = new (std::nothrow) Message(4);
+        check(quiet != NULL && quiet->m_kind == 4, "non throwing new");
+        delete quiet;
+
+        void* storage = ::operator new(sizeof (Message));
+        Message* placed = new (storage) Message(5);
+        check(placed == storage && placed->m_kind == 5, "placement new");
+        placed->~Message();
+        ::operator delete(storage);
+    }
+    check(g_destroyed == 2, "every form destroys the message");
+    g_destroyed = 0;
+
+    // Constructors that throw
+    {
+        try
+        {
+            new Faulty();
+        }
+        catch (IllegalStateException&)
+        {
+        }
+        strong_ref<Message> message(new Message(6));
+        check(message.get() == g_faulty, "the memory of a failed construction goes back to the pool");
+
+        try
+        {
+            new (std::nothrow) Faulty();
+        }
+        catch (IllegalStateException&)
+        {
+        }
+        strong_ref<Message> quiet(new Message(6));
+        check(quiet.get() == g_faulty, "also after non throwing new");
+    }
+    g_destroyed = 0;
+
+    // Messages released by another thread
+    {
+        ClassPool<Message>::reserve(1000);
+
+        std::vector<strong_ref<Message> > messages;
+        for (int i = 0; i < 1000; ++i)
+        {
+            messages.push_back(strong_ref<Message>(new Message(i)));
+        }
+
+        pthread_t thread;
+        pthread_create(&thread, NULL, consumer, &messages);
+        pthread_join(thread, NULL);
+        check(g_destroyed == 1000, "messages released by a consumer thread");
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            messages.push_back(strong_ref<Message>(new Message(i)));
+        }
+        messages.clear();
+        check(g_destroyed == 2000, "and allocated again by the producer");
+    }
+    g_destroyed = 0;
+
+    // Deferred releases return the memory too
+    {
+        DeferredRelease::enable();
+        for (int i = 0; i < 100; ++i)
+        {
+            strong_ref<Message> message(new Message(i));
+        }
+        check(g_destroyed == 0, "releases are deferred");
+        DeferredRelease::disable();
+        check(g_destroyed == 100, "and run when disabled");
+    }
+
+    ClassPool<Message>::trim();
+
+    // Pools may carve their blocks from a region
+    {
+        VirtualRegion& region = VirtualRegion::global();
+        ClassPool<Message>::setBackingRegion(region);
+        check(ThreadCache::getBackingRegion() == &region, "pools take a backing region");
+
+        std::vector<strong_ref<Message> > messages;
+        for (int i = 0; i < 1000; ++i)
+        {
+            messages.push_back(strong_ref<Message>(new Message(i)));
+        }
+        bool carved = true;
+        for (std::size_t i = 0; i < messages.size(); ++i)
+        {
+            carved = carved && region.contains(messages[i].get());
+        }
+        check(carved, "instances are carved from the region");
+        check(region.getSlabsInUse() == 1, "blocks of a size share a slab");
+
+        messages.clear();
+        ClassPool<Message>::trim();
+        messages.push_back(strong_ref<Message>(new Message(0)));
+        check(region.contains(messages[0].get()), "trimming keeps the blocks of the region for reuse");
+        check(region.getSlabsInUse() == 1, "and takes no other slab");
+
+        VirtualRegion other(VirtualRegion::SLAB_SIZE, false);
+        bool refused = false;
+        try
+        {
+            ClassPool<Message>::setBackingRegion(other);
+        }
+        catch (IllegalStateException&)
+        {
+            refused = true;
+        }
+        check(refused, "pools are backed by one region only");
+    }
+
+    return testResult();
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   cycle_collector.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 9:00 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+
+#ifdef AXF_CYCLE_COLLECTION
+
+static long g_destroyed = 0;
+
+/**
+ * A vertex of a graph, which may reference any other.
+ */
+class Vertex : public Object
+{
+    AXF_CLASS_TYPE(Vertex, AXF_TYPE(axf::core::Object))
+public:
+
+    std::vector<strong_ref<Object> > m_edges;
+
+    Vertex()
+    {
+        enableCycleCollection();
+    }
+
+    virtual ~Vertex()
+    {
+        g_destroyed++;
+    }
+
+    void connect(Vertex* to)
+    {
+        m_edges.push_back(strong_ref<Object>(to));
+    }
+
+    virtual void traverseReferences(ReferenceVisitor& visitor) const
+    {
+        for (std::size_t i = 0; i < m_edges.size(); ++i)
+        {
+            visitor.visit(m_edges[i]);
+        }
+    }
+} ;
+
+/**
+ * An object the collector does not examine.
+ */
+class Leaf : public Object
+{
+    AXF_CLASS_TYPE(Leaf, AXF_TYPE(axf::core::Object))
+public:
+
+    virtual ~Leaf()
+    {
+        g_destroyed++;
+    }
+} ;
+
+/**
+ * Builds a ring of vertices and returns a reference to one of them.
+ */
+static strong_ref<Vertex> ring(std::size_t size)
+{
+    strong_ref<Vertex> first(new Vertex());
+    Vertex* last = first.get();
+    for (std::size_t i = 1; i < size; ++i)
+    {
+        Vertex* vertex = new Vertex();
+        last->connect(vertex);
+        last = vertex;
+    }
+    last->connect(first.get());
+    return first;
+}
+
+int main(int argc, char** argv)
+{
+    // Parents and children referencing each other
+    {
+        CycleCollector::collect();
+        long destroyed = g_destroyed;
+
+        strong_ref<Vertex> parent(new Vertex());
+        Vertex* child = new Vertex();
+        parent->connect(child);
+        child->connect(parent.get());
+        weak_ref<Vertex> weak = parent;
+
+        parent.reset();
+        check(g_destroyed == destroyed && CycleCollector::candidates() > 0, "a released cycle is a candidate");
+
+        check(CycleCollector::collect() == 2 && g_destroyed - destroyed == 2, "a garbage cycle is collected");
+        check(weak.expired() && CycleCollector::candidates() == 0, "collected objects are gone");
+    }
+
+    // Cycles still referenced from outside
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Vertex> holder = ring(3);
+        strong_ref<Vertex> other = holder;
+        other.reset();
+
+        check(CycleCollector::collect() == 0 && g_destroyed == destroyed, "referenced cycles are kept");
+        check(holder.users() == 2 && holder->m_edges.size() == 1, "kept cycles are left untouched");
+
+        holder.reset();
+        check(CycleCollector::collect() == 3 && g_destroyed - destroyed == 3, "they are collected once released");
+    }
+
+    // Garbage that references live objects and objects not examined
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Vertex> survivor(new Vertex());
+        strong_ref<Vertex> cycle = ring(4);
+        cycle->connect(survivor.get());
+        cycle->m_edges.push_back(strong_ref<Object>(new Leaf()));
+
+        cycle.reset();
+        check(CycleCollector::collect() == 4 && g_destroyed - destroyed == 5, "garbage releases what it references");
+        check(survivor.users() == 1, "live objects referenced by garbage survive");
+    }
+
+    // Long cycles are traced without recursion
+    {
+        long destroyed = g_destroyed;
+        ring(200000).reset();
+        check(CycleCollector::collect() == 200000 && g_destroyed - destroyed == 200000, "long cycles are collected");
+    }
+
+    // Incremental collection
+    {
+        long destroyed = g_destroyed;
+        for (int i = 0; i < 100; ++i)
+        {
+            ring(10).reset();
+        }
+        std::size_t candidates = CycleCollector::candidates();
+        check(candidates >= 100, "every released cycle is a candidate");
+
+        // Each root reaches a whole ring, so every collection examines at
+        // least ten objects and takes a few roots only
+        std::size_t collected = CycleCollector::collect(50);
+        check(collected > 0 && collected < 1000 && CycleCollector::candidates() < candidates,
+              "collections stop at their budget");
+
+        std::size_t collections = 1;
+        while (CycleCollector::candidates() > 0)
+        {
+            collected += CycleCollector::collect(50);
+            collections++;
+        }
+        check(collected == 1000 && collections >= 20 && g_destroyed - destroyed == 1000,
+              "incremental collections collect everything");
+    }
+
+    // Objects that did not enable collection are never examined
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Leaf> leaf(new Leaf());
+        strong_ref<Leaf> copy = leaf;
+        copy.reset();
+        check(CycleCollector::candidates() == 0, "objects not collectable are not candidates");
+        leaf.reset();
+        check(g_destroyed - destroyed == 1, "they are released as usual");
+    }
+
+    return testResult();
+}
+#else
+
+int main(int argc, char** argv)
+{
+    std::cout << "cycle collection is left out of this build" << std::endl;
+    return testResult();
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   deferred_release.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 7:10 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+static volatile long g_destroyed = 0;
+static volatile long g_foreign = 0;     /// Destroyed out of the main thread
+static pthread_t g_main;
+
+class Link : public Object
+{
+    AXF_CLASS_TYPE(Link, AXF_TYPE(axf::core::Object))
+public:
+
+    strong_ref<Object> m_next;
+
+    virtual ~Link()
+    {
+        atomicFetchAdd(&g_destroyed, 1);
+        if (!pthread_equal(pthread_self(), g_main))
+        {
+            atomicFetchAdd(&g_foreign, 1);
+        }
+    }
+} ;
+
+/**
+ * Builds a chain of links, long enough to overflow the stack if it were
+ * destroyed recursively.
+ */
+static strong_ref<Object> chain(long length)
+{
+    strong_ref<Object> head;
+    for (long i = 0; i < length; ++i)
+    {
+        Link* link = new Link();
+        link->m_next = head;
+        head = strong_ref<Object>(link);
+    }
+    return head;
+}
+
+static const long CHAIN_LENGTH = 1000000;
+
+static void* finishing(void*)
+{
+    DeferredRelease::enable();
+    strong_ref<Object> head = chain(1000);
+    head.reset();
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    g_main = pthread_self();
+
+    // Objects queued until drained
+    {
+        long destroyed = g_destroyed;
+        DeferredRelease::enable();
+        check(DeferredRelease::isEnabled(), "releases can be deferred");
+
+        strong_ref<Link> link(new Link());
+        weak_ref<Link> weak = link;
+        link.reset();
+        check(g_destroyed == destroyed && DeferredRelease::pending() == 1, "released objects are queued");
+        check(weak.expired() && weak.lock().isNull(), "queued objects cannot be upgraded");
+
+        check(DeferredRelease::drain() == 1 && g_destroyed - destroyed == 1, "draining destroys queued objects");
+        check(DeferredRelease::pending() == 0, "drained objects leave the queue");
+        DeferredRelease::disable();
+    }
+
+    // Long chains, in bounded batches
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Object> head = chain(CHAIN_LENGTH);
+
+        DeferredRelease::enable();
+        head.reset();
+        check(DeferredRelease::pending() == 1, "only the head is queued");
+
+        std::size_t batch = DeferredRelease::drain(1000);
+        check(batch == 1000 && g_destroyed - destroyed == 1000, "draining stops at the budget");
+        check(DeferredRelease::pending() == 1, "destroyed objects queue what they referenced");
+
+        std::size_t batches = 1;
+        while (DeferredRelease::drain(1000) > 0)
+        {
+            batches++;
+        }
+        check(g_destroyed - destroyed == CHAIN_LENGTH && batches == CHAIN_LENGTH / 1000,
+              "long chains are destroyed iteratively");
+        DeferredRelease::disable();
+        check(!DeferredRelease::isEnabled(), "releases can be immediate again");
+    }
+
+    // Disabling drains the queue
+    {
+        long destroyed = g_destroyed;
+        DeferredRelease::enable();
+        chain(10).reset();
+        DeferredRelease::disable();
+        check(g_destroyed - destroyed == 10 && DeferredRelease::pending() == 0, "disabling destroys queued objects");
+    }
+
+    // Threads destroy what they leave queued when they finish
+    {
+        long destroyed = g_destroyed;
+        pthread_t thread;
+        pthread_create(&thread, NULL, &finishing, NULL);
+        pthread_join(thread, NULL);
+        check(g_destroyed - destroyed == 1000, "finished threads destroy their queued objects");
+    }
+
+    // A background reclaimer
+    {
+        long destroyed = g_destroyed;
+        long foreign = g_foreign;
+        strong_ref<Object> head = chain(CHAIN_LENGTH);
+        strong_ref<Object> other = chain(10);
+
+        Reclaimer reclaimer;
+        DeferredRelease::enable(reclaimer);
+        head.reset();
+        other.reset();
+        reclaimer.flush();
+
+        check(g_destroyed - destroyed == CHAIN_LENGTH + 10, "the reclaimer destroys objects handed over");
+        check(g_foreign - foreign == CHAIN_LENGTH + 10, "the reclaimer destroys them on its thread");
+        check(reclaimer.reclaimed() == (std::size_t) CHAIN_LENGTH + 10, "the reclaimer counts what it destroyed");
+        DeferredRelease::disable();
+    }
+
+#ifdef AXF_BIASED_REFERENCES
+    // Biased objects
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Link> link(new Link());
+        link->biasToCurrentThread();
+        strong_ref<Link> copy = link;
+
+        DeferredRelease::enable();
+        link.reset();
+        copy.reset();
+        check(g_destroyed == destroyed && DeferredRelease::drain() == 1, "releases of biased objects are deferred");
+        DeferredRelease::disable();
+    }
+#endif
+
+    return testResult();
+}
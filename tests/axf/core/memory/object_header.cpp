@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   object_header.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 8:10 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+
+/**
+ * A node that exposes its counts, so they can be brought close to the limit
+ * without taking that many references.
+ */
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+public:
+
+    int m_value;
+
+    Node() : m_value(0) { }
+
+    inline refcount_t& counts()
+    {
+        return queryRefcount();
+    }
+
+    inline bits::WeakControl& weakCounts()
+    {
+        return *queryWeakControl();
+    }
+} ;
+
+#ifdef AXF_COMPACT_OBJECT_HEADER
+
+/**
+ * Moves the strong count of a node by a delta, as if that many references
+ * had been taken or dropped.
+ */
+static void shiftStrong(Node* node, refcount_value_t delta)
+{
+    node->counts().m_strong = node->counts().m_strong + delta;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    std::cout << "sizeof (ReferenceCounted) = " << sizeof (ReferenceCounted) << std::endl;
+    std::cout << "sizeof (Object) = " << sizeof (Object) << std::endl;
+
+#ifdef AXF_COMPACT_OBJECT_HEADER
+    check(sizeof (refcount_t) == 8, "compact counts take 8 bytes");
+#else
+    check(sizeof (refcount_t) == 2 * sizeof (long), "standard counts are two longs");
+#endif
+#if !defined(AXF_BIASED_REFERENCES) && !defined(AXF_CYCLE_COLLECTION)
+    check(sizeof (ReferenceCounted) == sizeof (void*) + sizeof (refcount_t), "the header is a pointer and the counts");
+#endif
+    check(sizeof (Object) == sizeof (ReferenceCounted), "objects add nothing to the header");
+
+    // Plain counting is unaffected
+    {
+        strong_ref<Node> node(new Node());
+        strong_ref<Node> copy = node;
+        weak_ref<Node> weak = node;
+        check(node->queryStrongReferences() == 2, "two strong references");
+        check(node->queryWeakReferences() == 1, "one weak reference");
+        copy.reset();
+        check(node->queryStrongReferences() == 1, "one strong reference left");
+    }
+
+#ifdef AXF_COMPACT_OBJECT_HEADER
+    // A strong reference that would reach the limit is refused
+    {
+        strong_ref<Node> node(new Node());
+        shiftStrong(node.get(), REFCOUNT_LIMIT - 2);
+        check(node->queryStrongReferences() == REFCOUNT_LIMIT - 1, "count just below the limit");
+
+        bool thrown = false;
+        try
+        {
+            strong_ref<Node> copy = node;
+        }
+        catch (IllegalStateException&)
+        {
+            thrown = true;
+        }
+        check(thrown, "strong overflow throws");
+        check(node->queryStrongReferences() == REFCOUNT_LIMIT - 1, "strong count restored");
+
+        weak_ref<Node> weak = node;
+        thrown = false;
+        try
+        {
+            strong_ref<Node> upgraded = weak.lock();
+        }
+        catch (IllegalStateException&)
+        {
+            thrown = true;
+        }
+        check(thrown, "weak upgrade overflow throws");
+        check(node->queryStrongReferences() == REFCOUNT_LIMIT - 1, "strong count still restored");
+
+        shiftStrong(node.get(), -(REFCOUNT_LIMIT - 2));
+        check(node->queryStrongReferences() == 1, "back to one reference");
+    }
+
+    // So is a weak one
+    {
+        strong_ref<Node> node(new Node());
+        node->weakCounts().references = REFCOUNT_LIMIT - 1;
+
+        bool thrown = false;
+        try
+        {
+            weak_ref<Node> weak = node;
+        }
+        catch (IllegalStateException&)
+        {
+            thrown = true;
+        }
+        check(thrown, "weak overflow throws");
+        check(node->weakCounts().references == REFCOUNT_LIMIT - 1, "weak count restored");
+        node->weakCounts().references = 1;
+    }
+
+#ifdef AXF_BIASED_REFERENCES
+    // Biased counts overflow at the same distance from their offset
+    {
+        strong_ref<Node> node(new Node());
+        check(node->biasToCurrentThread(), "node biased");
+
+        shiftStrong(node.get(), REFCOUNT_LIMIT - 1);
+        bool thrown = false;
+        try
+        {
+            refcount_grab_strong(node->counts());
+        }
+        catch (IllegalStateException&)
+        {
+            thrown = true;
+        }
+        check(thrown, "shared overflow of a biased node throws");
+        shiftStrong(node.get(), -(REFCOUNT_LIMIT - 1));
+        check(node->queryStrongReferences() == 1, "biased node back to one reference");
+    }
+#endif
+#endif
+
+    return testResult();
+}
@@ -146,6 +146,73 @@ void test_weak_ptr()
     std::cout << "dropping all references" << std::endl;
 }
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+static int g_unlinked = 0;
+
+/**
+ * The links of a list that is consumed by moving its head along, so that
+ * every move assignment releases the object its argument lives in. A
+ * reference can not name the class it is a member of, which is still
+ * incomplete, so links refer to their base class.
+ */
+class IntrusiveBase : public axf::core::ReferenceCounted
+{
+public:
+
+    virtual ~IntrusiveBase()
+    {
+        g_unlinked++;
+    }
+} ;
+
+struct Base
+{
+
+    virtual ~Base()
+    {
+        g_unlinked++;
+    }
+} ;
+
+template <typename B, typename Reference>
+struct Link : public B
+{
+    Reference next;
+} ;
+
+template <typename B, typename Reference>
+void unlink_list(const char* name)
+{
+    typedef Link<B, Reference> L;
+    const int LENGTH = 100;
+
+    g_unlinked = 0;
+    Reference head;
+    for (int i = 0; i < LENGTH; ++i)
+    {
+        L* link = new L();
+        link->next = head;
+        head = Reference(link);
+    }
+    while (head)
+    {
+        head = std::move(static_cast<L*> (&*head)->next);
+    }
+    std::cout << name << ": unlinked " << g_unlinked << " of " << LENGTH << " links" << std::endl;
+}
+
+void test_move_unlinking()
+{
+    unlink_list<IntrusiveBase, axf::core::strong_ref<IntrusiveBase> >("intrusive strong references");
+    unlink_list<Base, axf::core::strong_ref<Base> >("strong references");
+
+    // Objects only weakly referenced belong to their weak references
+    unlink_list<IntrusiveBase, axf::core::weak_ref<IntrusiveBase> >("intrusive weak references");
+    unlink_list<Base, axf::core::weak_ref<Base> >("weak references");
+}
+#endif
+
 int main(int argc, char** argv)
 {
     std::printf("\ntesting unique pointers...\n");
@@ -157,6 +224,11 @@ int main(int argc, char** argv)
     std::printf("\ntesting shared weak pointers...\n");
     test_weak_ptr();
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    std::printf("\ntesting references moved out of the objects they release...\n");
+    test_move_unlinking();
+#endif
+
     std::getchar();
     return (EXIT_SUCCESS);
 }
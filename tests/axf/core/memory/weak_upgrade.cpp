@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   weak_upgrade.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 4:10 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+static volatile long g_destroyed = 0;
+
+class Entry : public Object
+{
+    AXF_CLASS_TYPE(Entry, AXF_TYPE(axf::core::Object))
+public:
+
+    volatile int m_alive;
+
+    Entry() : m_alive(1) { }
+
+    virtual ~Entry()
+    {
+        m_alive = 0;
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+/**
+ * Objects whose reference counts live in a virtual base, so converting a
+ * pointer to them needs their virtual table.
+ */
+class Shared : virtual public Object
+{
+    AXF_CLASS_TYPE(Shared, AXF_TYPE(axf::core::Object))
+public:
+
+    virtual ~Shared()
+    {
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+class Plain
+{
+public:
+
+    ~Plain()
+    {
+        atomicFetchAdd(&g_destroyed, 1);
+    }
+} ;
+
+static const int READER_COUNT = 4;
+static const int ROUNDS = 2000;
+
+/**
+ * One round of the race: readers upgrade their own copy of a weak reference
+ * while the owner drops the only strong reference.
+ */
+struct Round
+{
+    weak_ref<Entry>     weak[READER_COUNT];
+    volatile int        started;
+    int                 errors;
+} ;
+
+struct Reader
+{
+    int     index;
+    Round*  rounds;
+} ;
+
+static void* reader(void* argument)
+{
+    Reader& reader = *static_cast<Reader*> (argument);
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        Round& round = reader.rounds[r];
+        atomicFetchAdd(&round.started, 1);
+
+        // Once an upgrade fails the object is dead, and must stay dead
+        bool dead = false;
+        for (int i = 0; i < 200; ++i)
+        {
+            strong_ref<Entry> entry = round.weak[reader.index].lock();
+            if (entry.isNull())
+            {
+                dead = true;
+            }
+            else if (dead || entry->m_alive != 1)
+            {
+                round.errors++;
+            }
+        }
+        round.weak[reader.index].reset();
+    }
+    return NULL;
+}
+
+static bool concurrentUpgrades()
+{
+    std::vector<Round> rounds(ROUNDS);
+    std::vector<strong_ref<Entry> > owners(ROUNDS);
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        owners[r] = strong_ref<Entry>(new Entry());
+        for (int t = 0; t < READER_COUNT; ++t)
+        {
+            rounds[r].weak[t] = owners[r];
+        }
+        rounds[r].started = 0;
+        rounds[r].errors = 0;
+    }
+
+    long destroyed = g_destroyed;
+    std::vector<Reader> readers(READER_COUNT);
+    std::vector<pthread_t> threads(READER_COUNT);
+    for (int t = 0; t < READER_COUNT; ++t)
+    {
+        readers[t].index = t;
+        readers[t].rounds = &rounds[0];
+        pthread_create(&threads[t], NULL, &reader, &readers[t]);
+    }
+
+    // Drop each object once some reader is upgrading it
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        while (atomicLoad(&rounds[r].started, ACQUIRE) == 0)
+            cpuRelax();
+        owners[r].reset();
+    }
+    for (int t = 0; t < READER_COUNT; ++t)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    int errors = 0;
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        errors += rounds[r].errors;
+    }
+    return errors == 0 && g_destroyed - destroyed == ROUNDS;
+}
+
+int main(int argc, char** argv)
+{
+    // Intrusive references
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Entry> owner(new Entry());
+        weak_ref<Entry> weak = owner;
+
+        strong_ref<Entry> upgraded = weak.lock();
+        check(upgraded.get() == owner.get() && owner.users() == 2, "lock upgrades a live object");
+        check(weak.users() == 1 && !weak.expired(), "lock keeps the weak reference");
+
+        upgraded.reset();
+        owner.reset();
+        check(g_destroyed - destroyed == 1, "the last strong reference destroys the object");
+        check(weak.expired() && weak.lock().isNull(), "a destroyed object cannot be upgraded");
+
+        weak_ref<Entry> copy = weak;
+        check(copy.lock().isNull() && copy.users() == 2, "weak references to a destroyed object can be copied");
+        weak.reset();
+        copy.reset();
+        check(g_destroyed - destroyed == 1, "destroyed objects are not destroyed again");
+        check(weak_ref<Entry>().lock().isNull(), "a null reference cannot be upgraded");
+    }
+
+    // Counts held by a virtual base
+    {
+        long destroyed = g_destroyed;
+        weak_ref<Shared> weak;
+        {
+            strong_ref<Shared> owner(new Shared());
+            weak = owner;
+            check(!weak.lock().isNull(), "lock upgrades through a virtual base");
+        }
+        check(g_destroyed - destroyed == 1 && weak.lock().isNull(), "objects with virtual bases are destroyed");
+    }
+
+    // Objects that were never strongly referenced belong to their weak
+    // references, and cannot be upgraded
+    {
+        long destroyed = g_destroyed;
+        weak_ref<Entry> weak(new Entry());
+        check(weak.lock().isNull(), "objects never strongly referenced cannot be upgraded");
+        weak.reset();
+        check(g_destroyed - destroyed == 1, "their last weak reference destroys them");
+    }
+
+    // External reference counts
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Plain> owner(new Plain());
+        weak_ref<Plain> weak = owner;
+
+        strong_ref<Plain> upgraded = weak.lock();
+        check(upgraded.get() == owner.get() && owner.users() == 2, "lock upgrades objects with external counts");
+        check(weak.users() == 1, "the external block counts weak references");
+
+        upgraded.reset();
+        owner.reset();
+        check(g_destroyed - destroyed == 1 && weak.expired(), "the last strong reference disposes of the object");
+        check(weak.lock().isNull(), "a disposed object cannot be upgraded");
+    }
+
+    // Assigning a reference to the object it already points to
+    {
+        long destroyed = g_destroyed;
+        strong_ref<Plain> owner(new Plain());
+        strong_ref<Plain> alias = owner;
+
+        alias = owner;
+        check(owner.users() == 2, "assigning an alias of the same object keeps the count");
+
+        alias.reset();
+        owner.reset();
+        check(g_destroyed - destroyed == 1, "aliases assigned to each other release the object");
+    }
+
+    check(concurrentUpgrades(), "upgrades race safely with the final release");
+
+    return testResult();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   runtime_cast.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:10 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+#include <thread>
+#endif
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::core::reflection;
+
+class Shape : public Object
+{
+    AXF_CLASS_TYPE(Shape, AXF_TYPE(axf::core::Object))
+} ;
+
+class Circle : public Shape
+{
+    AXF_CLASS_TYPE(Circle, AXF_TYPE(Shape))
+} ;
+
+class Square : public Shape
+{
+    AXF_CLASS_TYPE(Square, AXF_TYPE(Shape))
+} ;
+
+class Triangle : public Shape
+{
+    AXF_CLASS_TYPE(Triangle, AXF_TYPE(Shape))
+} ;
+
+class Hexagon : public Shape
+{
+    AXF_CLASS_TYPE(Hexagon, AXF_TYPE(Shape))
+} ;
+
+class Pentagon : public Shape
+{
+    AXF_CLASS_TYPE(Pentagon, AXF_TYPE(Shape))
+} ;
+
+class Color : public Object
+{
+    AXF_CLASS_TYPE(Color, AXF_TYPE(axf::core::Object))
+} ;
+
+/**
+ * Casts through a single call site, so every call shares one inline cache.
+ */
+static Shape* castAtSite(Object& object)
+{
+    try
+    {
+        return &AXF_RUNTIME_CAST(Shape, object);
+    }
+    catch (ClassCastException&)
+    {
+        return NULL;
+    }
+}
+
+template <typename _T>
+static bool throwsOnCast(Object& object)
+{
+    try
+    {
+        runtime_cast<_T>(object);
+    }
+    catch (ClassCastException&)
+    {
+        return true;
+    }
+    return false;
+}
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+/**
+ * Several threads fill the global cache and the same call site at once;
+ * every cast must still be answered correctly.
+ */
+static bool concurrentCasts(std::vector<Object*>& objects)
+{
+    const int threadCount = 4;
+
+    std::vector<int> errors(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([t, &objects, &errors]() {
+            for (int i = 0; i < 20000; ++i)
+            {
+                Object& object = *objects[(i + t) % objects.size()];
+                bool isShape = !reflection::getClass(object).equals(Color::getCompileTimeClass());
+                if ((castAtSite(object) != NULL) != isShape || reflection::bits::_is_casteable<Shape>(object) != isShape)
+                {
+                    errors[t]++;
+                }
+            }
+        }));
+    }
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t].join();
+    }
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        if (errors[t] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    Circle circle;
+    Square square;
+    Triangle triangle;
+    Hexagon hexagon;
+    Pentagon pentagon;
+    Color color;
+
+    Object& object = circle;
+    check(&runtime_cast<Shape>(object) == &circle, "casts to a base class");
+    check(&runtime_cast<Circle>(object) == &circle, "casts to the exact class");
+    check(&runtime_cast<Object>(object) == &circle, "casts to the root class");
+    check(&runtime_cast<Circle>(object) == &circle, "cached answers match");
+    check(throwsOnCast<Square>(object), "a sibling class is not a target");
+    check(throwsOnCast<Shape>(color), "an unrelated class is not a target");
+    check(throwsOnCast<Shape>(color), "cached failures still throw");
+
+    Shape& shape = square;
+    check(throwsOnCast<Circle>(shape), "down casts check the dynamic class");
+
+    // A call site sees more classes than its cache holds
+    Object* objects[] = {&circle, &square, &triangle, &color, &hexagon, &pentagon, &circle};
+    bool correct = true;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (unsigned i = 0; i < sizeof (objects) / sizeof (objects[0]); ++i)
+        {
+            Shape* result = castAtSite(*objects[i]);
+            correct = correct && (objects[i] == &color ? result == NULL : result == objects[i]);
+        }
+    }
+    check(correct, "call sites answer like runtime_cast");
+
+    // A site is zero initialized static storage
+    static CastSite<Circle> site;
+    check(&site.cast(object) == &circle && &site.cast(object) == &circle, "sites cache successful casts");
+    bool thrown = false;
+    try
+    {
+        Object& other = square;
+        site.cast(other);
+    }
+    catch (ClassCastException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "sites do not cache failures");
+
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    std::vector<Object*> all(objects, objects + sizeof (objects) / sizeof (objects[0]));
+    check(concurrentCasts(all), "concurrent casts agree");
+#endif
+
+    return testResult();
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   type_initialization.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 2:40 AM
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <pthread.h>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::concurrent;
+
+static const int CLASS_COUNT = 1024;
+static const int EXCEPTION_COUNT = 256;
+static const int THREAD_COUNT = 8;
+
+class Node : public Object
+{
+    AXF_CLASS_TYPE(Node, AXF_TYPE(axf::core::Object))
+} ;
+
+template <int N>
+class Generated : public Node
+{
+    AXF_CLASS_TYPE(Generated<N>, AXF_TYPE(Node))
+} ;
+
+template <int N>
+class GeneratedException : public IllegalStateException
+{
+    AXF_EXCEPTION_TYPE(GeneratedException<N>, IllegalStateException)
+public:
+
+    GeneratedException() : IllegalStateException("generated") { }
+} ;
+
+typedef const void* (*Getter)();
+
+template <int N>
+const void* getClassObject()
+{
+    return &Generated<N>::getCompileTimeClass();
+}
+
+template <int N>
+const void* getExceptionDescriptor()
+{
+    return &GeneratedException<N>::getCompileTimeClass();
+}
+
+/**
+ * Fills a table with the getters of a range of types, splitting the range in
+ * halves so the template recursion stays shallow.
+ */
+template <int Begin, int Count>
+struct Fill
+{
+    static void run(Getter* classes, Getter* exceptions)
+    {
+        Fill<Begin, Count / 2>::run(classes, exceptions);
+        Fill<Begin + Count / 2, Count - Count / 2>::run(classes, exceptions);
+    }
+} ;
+
+template <int Begin>
+struct Fill<Begin, 1>
+{
+    static void run(Getter* classes, Getter* exceptions)
+    {
+        classes[Begin] = &getClassObject<Begin>;
+        if (Begin < EXCEPTION_COUNT)
+            exceptions[Begin] = &getExceptionDescriptor<Begin % EXCEPTION_COUNT>;
+    }
+} ;
+
+static Getter g_classes[CLASS_COUNT];
+static Getter g_exceptions[EXCEPTION_COUNT];
+static volatile int g_ready = 0;
+static volatile int g_go = 0;
+
+/**
+ * The results of one racing thread.
+ */
+struct Race
+{
+    int                         index;
+    std::vector<const void*>    classes;
+    std::vector<const void*>    exceptions;
+} ;
+
+static void* racer(void* argument)
+{
+    Race& race = *static_cast<Race*> (argument);
+    race.classes.resize(CLASS_COUNT);
+    race.exceptions.resize(EXCEPTION_COUNT);
+
+    // Start together, so that first uses overlap
+    atomicFetchAdd(&g_ready, 1);
+    while (atomicLoad(&g_go, ACQUIRE) == 0)
+        cpuRelax();
+
+    // Every thread walks the types from a different starting point, in
+    // alternating directions
+    for (int i = 0; i < CLASS_COUNT; ++i)
+    {
+        int k = (race.index % 2 == 0 ? i : CLASS_COUNT - 1 - i);
+        k = (k + race.index * (CLASS_COUNT / THREAD_COUNT)) % CLASS_COUNT;
+        race.classes[k] = g_classes[k]();
+        if (k < EXCEPTION_COUNT)
+            race.exceptions[k] = g_exceptions[k]();
+    }
+    return NULL;
+}
+
+static int g_attempts = 0;
+
+static void* createFlaky(void* storage)
+{
+    if (++g_attempts == 1)
+        throw std::runtime_error("first attempt fails");
+    return new (storage) std::vector<int>(3, 7);
+}
+
+int main(int argc, char** argv)
+{
+    Fill<0, CLASS_COUNT>::run(g_classes, g_exceptions);
+
+    std::vector<Race> races(THREAD_COUNT);
+    std::vector<pthread_t> threads(THREAD_COUNT);
+    for (int t = 0; t < THREAD_COUNT; ++t)
+    {
+        races[t].index = t;
+        pthread_create(&threads[t], NULL, &racer, &races[t]);
+    }
+    while (atomicLoad(&g_ready, ACQUIRE) != THREAD_COUNT)
+        cpuRelax();
+    atomicStore(&g_go, 1, RELEASE);
+    for (int t = 0; t < THREAD_COUNT; ++t)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    bool agree = true;
+    for (int t = 1; t < THREAD_COUNT; ++t)
+    {
+        agree = agree && races[t].classes == races[0].classes && races[t].exceptions == races[0].exceptions;
+    }
+    check(agree, "racing threads get the same descriptors");
+
+    bool consistent = true;
+    for (int i = 0; i < CLASS_COUNT; ++i)
+    {
+        const Class<Node>& type = *static_cast<const Class<Node>*> (races[0].classes[i]);
+        consistent = consistent && races[0].classes[i] == g_classes[i]() &&
+                &type.getPrimarySuperType() == &Node::getCompileTimeClass();
+    }
+    check(consistent, "descriptors are fully constructed");
+
+    bool exceptions = true;
+    for (int i = 0; i < EXCEPTION_COUNT; ++i)
+    {
+        const bits::ExceptionTypeDescriptor& type = *static_cast<const bits::ExceptionTypeDescriptor*> (races[0].exceptions[i]);
+        exceptions = exceptions && &type.super() == &IllegalStateException::getCompileTimeClass() &&
+                type.isKindOf(Exception::getCompileTimeClass());
+    }
+    check(exceptions, "exception descriptors are fully constructed");
+
+    GeneratedException<3> exception;
+    check(&exception.getClass() == races[0].exceptions[3], "instances share the descriptor");
+
+    static LazyStatic<std::vector<int> > flaky;
+    bool thrown = false;
+    try
+    {
+        flaky.get(&createFlaky);
+    }
+    catch (std::runtime_error&)
+    {
+        thrown = true;
+    }
+    check(thrown && !flaky.isInitialized(), "a throwing factory leaves the static uninitialized");
+    check(flaky.get(&createFlaky).size() == 3 && g_attempts == 2, "the next access constructs it");
+    check(flaky.get(&createFlaky).size() == 3 && g_attempts == 2, "construction happens once");
+
+    return testResult();
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   async_file.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 3:20 AM
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+static std::string temporaryPath()
+{
+    char path[] = "/tmp/axf_async_XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    return path;
+}
+
+static unsigned char patternAt(std::size_t offset)
+{
+    return (unsigned char) ((offset * 131 + (offset >> 12)) & 0xff);
+}
+
+static bool matchesPattern(const ByteSlice& slice, std::size_t offset)
+{
+    for (std::size_t i = 0; i < slice.size(); ++i)
+    {
+        if (slice[i] != patternAt(offset + i))
+            return false;
+    }
+    return true;
+}
+
+struct Counter
+{
+    int completions;
+    std::size_t bytes;
+} ;
+
+static void countCompletion(AsyncRequest& request, void* context)
+{
+    Counter* counter = static_cast<Counter*> (context);
+    counter->completions++;
+    counter->bytes += request.getBytesTransferred();
+}
+
+static void exercise(const std::string& path, std::size_t size, AsyncFile::Backend backend, const char* name)
+{
+    std::cout << "-- " << name << std::endl;
+
+    strong_ref<AsyncFile> file;
+    try
+    {
+        file = new AsyncFile(path.c_str(), AsyncFile::READ_WRITE, backend, 8);
+    }
+    catch (IOException& e)
+    {
+        std::cout << "[skip] backend not available: " << e.getMessage() << std::endl;
+        return;
+    }
+    check(file->getBackend() == backend, "the requested backend is used");
+
+    // Reads beyond the depth of the file stay queued
+    std::vector<strong_ref<AsyncRequest> > reads;
+    for (std::size_t i = 0; i < 32; ++i)
+        reads.push_back(file->read((i * 7919 % (size / 4096)) * 4096, 4096));
+    check(file->pending() == 32, "requests are pending until completion");
+
+    file->wait(reads.size());
+    check(file->pending() == 0, "waiting for every request completes them all");
+
+    bool correct = true;
+    for (std::size_t i = 0; i < reads.size(); ++i)
+    {
+        ByteSlice bytes = reads[i]->getResult();
+        correct = correct && reads[i]->isDone() && bytes.size() == 4096
+                && matchesPattern(bytes, (std::size_t) reads[i]->getOffset());
+    }
+    check(correct, "reads return the contents of the file");
+
+    // Waiting on a single request
+    strong_ref<AsyncRequest> single = file->read(12345, 100);
+    single->wait();
+    check(single->isDone() && matchesPattern(single->getResult(), 12345), "requests can be waited on");
+
+    // Reads past the end of the file are short
+    strong_ref<AsyncRequest> tail = file->read(size - 10, 4096);
+    strong_ref<AsyncRequest> beyond = file->read(size + 4096, 4096);
+    file->wait(2);
+    check(tail->getBytesTransferred() == 10 && matchesPattern(tail->getResult(), size - 10),
+          "reads stop at the end of the file");
+    check(beyond->getResult().isEmpty(), "reads past the end of the file are empty");
+
+    // Completion handlers
+    Counter counter = { 0, 0 };
+    for (int i = 0; i < 20; ++i)
+        file->read(i * 1000, 1000, countCompletion, &counter);
+    while (file->pending() != 0)
+        file->wait();
+    check(counter.completions == 20 && counter.bytes == 20000, "handlers run once per request");
+
+    // Writes, into a caller buffer too
+    strong_ref<ByteBuffer> data = new ByteBuffer(8192);
+    for (std::size_t i = 0; i < data->size(); ++i)
+        data->data()[i] = (unsigned char) (255 - (i & 0xff));
+    strong_ref<AsyncRequest> written = file->write(size, data->slice(0, 8192));
+    written->wait();
+    check(written->getBytesTransferred() == 8192, "writes report the bytes written");
+
+    strong_ref<ByteBuffer> target = new ByteBuffer(16384);
+    strong_ref<AsyncRequest> reread = file->read(size, target.get(), 4096, 8192);
+    reread->wait();
+    ByteSlice result = reread->getResult();
+    check(result.equals(data->slice()) && result.data() == target->data() + 4096,
+          "written bytes are read back into the given buffer");
+    check(::truncate(path.c_str(), (off_t) size) == 0, "the file is truncated back");
+
+    // Errors are reported by the request
+    strong_ref<AsyncFile> readOnly = new AsyncFile(path.c_str(), AsyncFile::READ_ONLY, backend);
+    strong_ref<AsyncRequest> failed = readOnly->write(0, data->slice(0, 16));
+    failed->wait();
+    bool thrown = false;
+    try
+    {
+        failed->getResult();
+    }
+    catch (IOException&)
+    {
+        thrown = true;
+    }
+    check(thrown && failed->getErrorCode() != 0, "failed requests raise an IOException");
+
+    // Destroying a file waits for its requests
+    Counter last = { 0, 0 };
+    for (int i = 0; i < 16; ++i)
+        readOnly->read(i * 4096, 4096, countCompletion, &last);
+    readOnly = NULL;
+    check(last.completions == 16, "destroying a file completes its requests");
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t SIZE = 1 << 20;
+    std::string path = temporaryPath();
+
+    {
+        std::vector<unsigned char> contents(SIZE);
+        for (std::size_t i = 0; i < SIZE; ++i)
+            contents[i] = patternAt(i);
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(&contents[0], 1, SIZE, file);
+        std::fclose(file);
+    }
+
+    exercise(path, SIZE, AsyncFile::IO_URING, "io_uring");
+    exercise(path, SIZE, AsyncFile::THREAD_POOL, "thread pool");
+
+    {
+        strong_ref<AsyncFile> file = new AsyncFile(path.c_str());
+        check(file->getBackend() != AsyncFile::AUTOMATIC, "automatic selection picks a backend");
+    }
+    std::remove(path.c_str());
+
+    bool thrown = false;
+    try
+    {
+        AsyncFile file("/nonexistent/axf/async");
+    }
+    catch (IOException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "missing files raise an IOException");
+
+    return testResult();
+}
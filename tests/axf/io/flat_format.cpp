@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   flat_format.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 7:20 AM
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+struct Coordinates
+{
+    double  latitude;
+    double  longitude;
+
+    AXF_FLAT_SCALARS()
+} ;
+
+struct City
+{
+    unsigned long long      id;
+    FlatString              name;
+    Coordinates             location;
+    unsigned                population;
+    FlatArray<FlatString>   aliases;
+    FlatRef<City>           capital;
+
+    AXF_FLAT_REFERENCES(name, aliases, capital)
+} ;
+
+struct Atlas
+{
+    FlatString          title;
+    FlatArray<City>     cities;
+    FlatArray<int>      elevations;
+
+    AXF_FLAT_REFERENCES(title, cities, elevations)
+} ;
+
+struct Node
+{
+    FlatRef<Node>   left;
+    FlatRef<Node>   right;
+
+    AXF_FLAT_REFERENCES(left, right)
+} ;
+
+/**
+ * Builds a chain of nodes whose children are both the previous node, so the
+ * number of paths from the root doubles with every node.
+ */
+static ByteSlice sharedChain(int length)
+{
+    FlatBuilder builder(64);
+    std::size_t previous;
+    builder.addRecord<Node>(previous);
+    for (int i = 1; i < length; ++i)
+    {
+        std::size_t offset;
+        builder.addRecord<Node>(offset);
+        builder.link(builder.at<Node>(offset)->left, previous);
+        builder.link(builder.at<Node>(offset)->right, previous);
+        previous = offset;
+    }
+    return builder.finish(previous);
+}
+
+template <typename T>
+static bool throwsOnVerify(const ByteSlice& block)
+{
+    try
+    {
+        strong_ref<FlatReader> reader = new FlatReader(block);
+        reader->verify<T>();
+    }
+    catch (IOException&)
+    {
+        return true;
+    }
+    return false;
+}
+
+static ByteSlice copyOf(const ByteSlice& block)
+{
+    strong_ref<ByteBuffer> copy = new ByteBuffer(block.size());
+    std::memcpy(copy->data(), block.data(), block.size());
+    return copy->slice();
+}
+
+int main(int argc, char** argv)
+{
+    // Built bottom up: strings and arrays first, then the records holding them
+    FlatBuilder builder(64);
+
+    std::size_t names[3];
+    names[0] = builder.addString("Havana");
+    names[1] = builder.addString("Santiago de Cuba");
+    names[2] = builder.addString("");
+
+    std::size_t habana = builder.addString("La Habana");
+    std::size_t cristobal = builder.addString("San Cristobal");
+
+    std::size_t aliases;
+    FlatString* aliasArray = builder.addArray<FlatString>(2, aliases);
+    builder.link(aliasArray[0], habana);
+    builder.link(aliasArray[1], cristobal);
+
+    std::size_t elevations;
+    int* heights = builder.addArray<int>(4, elevations);
+    heights[0] = 59;
+    heights[1] = -3;
+    heights[2] = 82;
+    heights[3] = 1974;
+
+    std::size_t title = builder.addString("Atlas of the Caribbean");
+
+    std::size_t cities;
+    City* city = builder.addArray<City>(3, cities);
+    for (int i = 0; i < 3; ++i)
+    {
+        city[i].id = 1000 + i;
+        city[i].location.latitude = 23.1 - i;
+        city[i].location.longitude = -82.4 + i;
+        city[i].population = 2000000u / (i + 1);
+        builder.link(city[i].name, names[i]);
+    }
+    builder.link(city[0].aliases, aliases);
+
+    std::size_t root;
+    Atlas* atlas = builder.addRecord<Atlas>(root);
+    builder.link(atlas->title, title);
+    builder.link(atlas->cities, cities);
+    builder.link(atlas->elevations, elevations);
+
+    // Items added earlier are reached again through their offsets
+    builder.link(builder.at<City>(cities)[1].capital, cities);
+
+    ByteSlice block = builder.finish(root);
+    check(block.size() == builder.size() && block.size() > sizeof (FlatHeader), "the builder produces a block");
+
+    // Read in place, from a copy at another address
+    ByteSlice moved = copyOf(block);
+    strong_ref<FlatReader> reader = new FlatReader(moved);
+    const Atlas& read = reader->root<Atlas>();
+    check(read.title.equals("Atlas of the Caribbean") && read.title.data()[read.title.size()] == 0,
+          "strings are read in place");
+    check((const unsigned char*) read.title.data() > moved.begin()
+          && (const unsigned char*) read.title.data() < moved.end(), "views point into the block");
+    check(read.cities.size() == 3 && read.cities[1].id == 1001 && read.cities[2].population == 666666,
+          "arrays of records are read in place");
+    check(read.cities[0].location.latitude == 23.1 && read.cities[1].location.longitude == -81.4,
+          "nested records are read in place");
+    check(read.cities[1].name.equals("Santiago de Cuba") && read.cities[2].name.size() == 0
+          && !read.cities[2].name.isNull(), "empty strings are not null");
+    check(read.cities[0].aliases.size() == 2 && read.cities[0].aliases[1].equals("San Cristobal")
+          && read.cities[1].aliases.isNull() && read.cities[1].aliases.isEmpty(), "arrays of strings are read");
+    check(!read.cities[1].capital.isNull() && read.cities[1].capital->id == 1000 && read.cities[0].capital.isNull(),
+          "references to records are followed");
+
+    int sum = 0;
+    for (const int* it = read.elevations.begin(); it != read.elevations.end(); ++it)
+        sum += *it;
+    check(sum == 59 - 3 + 82 + 1974, "arrays can be iterated");
+    check(read.cities[0].name.toString() == string("Havana"), "strings can be copied");
+
+    bool thrown = false;
+    try
+    {
+        read.elevations.at(4);
+    }
+    catch (IndexOutOfBoundsException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "array indices are checked");
+
+    thrown = false;
+    try
+    {
+        read.cities[0].capital->id;
+    }
+    catch (NullPointerException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "null references raise a NullPointerException");
+
+    reader->verify<Atlas>();
+    check(true, "a valid block verifies");
+
+    // Through a mapped file
+    char path[] = "/tmp/axf_flat_XXXXXX";
+    int fd = mkstemp(path);
+    check(write(fd, block.data(), block.size()) == (ssize_t) block.size(), "the block is written to a file");
+    close(fd);
+    {
+        strong_ref<FlatReader> mapped = new FlatReader(path);
+        mapped->verify<Atlas>();
+        check(mapped->root<Atlas>().cities[0].aliases[0].equals("La Habana"), "blocks are read from mapped files");
+    }
+
+    // Damaged blocks
+    check(throwsOnVerify<Atlas>(block.slice(0, 16)), "short blocks are rejected");
+    check(throwsOnVerify<Atlas>(block.slice(0, block.size() - 8)), "truncated blocks are rejected");
+
+    ByteSlice damaged = copyOf(block);
+    FlatHeader* header = reinterpret_cast<FlatHeader*> (const_cast<unsigned char*> (damaged.data()));
+    header->byteOrder = 0x04030201;
+    check(throwsOnVerify<Atlas>(damaged), "foreign byte orders are rejected");
+
+    damaged = copyOf(block);
+    header = reinterpret_cast<FlatHeader*> (const_cast<unsigned char*> (damaged.data()));
+    header->root = damaged.size() - 4;
+    check(throwsOnVerify<Atlas>(damaged), "roots out of bounds are rejected");
+
+    // Every reference pointed out of the block, in turn
+    bool rejected = true;
+    const Atlas& original = FlatReader(block).root<Atlas>();
+    const int* references[] = {
+        reinterpret_cast<const int*> (&original.title),
+        reinterpret_cast<const int*> (&original.cities),
+        reinterpret_cast<const int*> (&original.cities[1].name),
+        reinterpret_cast<const int*> (&original.cities[0].aliases),
+        reinterpret_cast<const int*> (&original.cities[0].aliases[1]),
+        reinterpret_cast<const int*> (&original.cities[1].capital)
+    };
+    for (std::size_t i = 0; i < sizeof (references) / sizeof (references[0]); ++i)
+    {
+        damaged = copyOf(block);
+        std::size_t position = (const unsigned char*) references[i] - block.data();
+        int* field = reinterpret_cast<int*> (const_cast<unsigned char*> (damaged.data()) + position);
+        *field = (int) damaged.size();
+        rejected = rejected && throwsOnVerify<Atlas>(damaged);
+    }
+    check(rejected, "references out of bounds are rejected");
+
+    damaged = copyOf(block);
+    {
+        std::size_t position = (const unsigned char*) &original.cities[1].name - block.data();
+        unsigned char* name = const_cast<unsigned char*> (damaged.data()) + position;
+        int offset;
+        std::memcpy(&offset, name, sizeof (offset));
+        name[offset + 16] = 'x';
+    }
+    check(throwsOnVerify<Atlas>(damaged), "strings without their null are rejected");
+
+    // Shared records are followed once per path, within a budget
+    check(!throwsOnVerify<Node>(sharedChain(4)), "blocks with a few shared records verify");
+    check(throwsOnVerify<Node>(sharedChain(48)), "blocks with exponentially many paths are rejected");
+
+    std::remove(path);
+    return testResult();
+}
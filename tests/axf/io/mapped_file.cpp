@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   mapped_file.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 18, 2026, 11:50 PM
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+/**
+ * Creates a temporary file with the given contents and returns its path.
+ */
+static std::string temporaryFile(const std::string& contents)
+{
+    char path[] = "/tmp/axf_mapped_file_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        if (write(fd, contents.data(), contents.size()) != (ssize_t) contents.size())
+        {
+            std::cout << "unable to write the temporary file" << std::endl;
+        }
+        close(fd);
+    }
+    return path;
+}
+
+int main(int argc, char** argv)
+{
+    // A file spanning several pages
+    std::string contents;
+    for (int i = 0; i < 10000; ++i)
+    {
+        char line[32];
+        std::sprintf(line, "line %d\n", i);
+        contents += line;
+    }
+    std::string path = temporaryFile(contents);
+
+    ByteSlice tail;
+    {
+        strong_ref<MappedFile> file = new MappedFile(path.c_str(), MappedFile::READ_ONLY, MappedFile::SEQUENTIAL);
+        check(file->size() == contents.size(), "the mapping covers the file");
+        check(std::memcmp(file->data(), contents.data(), contents.size()) == 0, "the mapping holds the contents");
+        check(std::strcmp(file->getPath(), path.c_str()) == 0, "the path is kept");
+
+        ByteSlice whole = file->slice();
+        ByteSlice line = whole.slice(7, 7);
+        check(line.data() == file->data() + 7, "slices do not copy");
+        check(std::string((const char*) line.data(), line.size()) == "line 1\n", "slices narrow relative to their parent");
+
+        file->advise(MappedFile::RANDOM);
+        file->advise(MappedFile::WILL_NEED, 5000, 100);
+        check(whole.at(contents.size() - 1) == '\n', "advice does not change the contents");
+
+        tail = whole.slice(contents.size() - 10, 10);
+        check(file.users() == 4, "slices hold references to the mapping");
+    }
+    check(tail.size() == 10 && std::memcmp(tail.data(), contents.data() + contents.size() - 10, 10) == 0,
+          "slices keep the mapping alive");
+    check(tail.getBuffer()->size() == contents.size(), "slices know their buffer");
+    tail = ByteSlice();
+
+    bool thrown = false;
+    try
+    {
+        strong_ref<MappedFile> file = new MappedFile(path.c_str());
+        file->slice(contents.size() - 1, 2);
+    }
+    catch (IndexOutOfBoundsException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "slices past the end are rejected");
+
+    // Writable mappings carry the writes to the file
+    {
+        strong_ref<MappedFile> file = new MappedFile(path.c_str(), MappedFile::READ_WRITE);
+        std::memcpy(file->data(), "LINE", 4);
+        file->sync();
+    }
+    {
+        strong_ref<MappedFile> file = new MappedFile(path.c_str());
+        check(std::memcmp(file->data(), "LINE 0\n", 7) == 0, "writes reach the file");
+    }
+    std::remove(path.c_str());
+
+    std::string emptyPath = temporaryFile("");
+    {
+        strong_ref<MappedFile> file = new MappedFile(emptyPath.c_str());
+        check(file->size() == 0 && file->slice().isEmpty(), "empty files map to empty buffers");
+    }
+    std::remove(emptyPath.c_str());
+
+    thrown = false;
+    try
+    {
+        MappedFile file("/nonexistent/axf/file");
+    }
+    catch (IOException& e)
+    {
+        thrown = e.getErrorCode() != 0;
+        std::cout << "       " << e.getMessage() << std::endl;
+    }
+    check(thrown, "missing files raise an IOException with the error code");
+
+    // Heap buffers
+    {
+        strong_ref<ByteBuffer> buffer = new ByteBuffer(4096, 4096);
+        check(((std::size_t) buffer->data() & 4095) == 0, "heap buffers are aligned");
+        std::memset(buffer->data(), 'x', buffer->size());
+        ByteSlice a = buffer->slice(0, 16);
+        ByteSlice b = buffer->slice(100, 16);
+        check(a.equals(b) && !a.equals(buffer->slice(0, 15)), "slices compare by contents");
+    }
+
+    return testResult();
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   serialization.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 5:10 AM
+ */
+
+#include <stdlib.h>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+class Point : public Object
+{
+    AXF_CLASS_TYPE(Point, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(x, y)
+public:
+
+    double x;
+    double y;
+
+    Point() : x(0), y(0) { }
+    Point(double x, double y) : x(x), y(y) { }
+} ;
+
+class Shape : public Object
+{
+    AXF_CLASS_TYPE(Shape, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(name, origin)
+public:
+
+    core::string    name;
+    Point           origin;
+
+    virtual double area() const = 0;
+} ;
+
+class Circle : public Shape
+{
+    AXF_CLASS_TYPE(Circle, AXF_TYPE(Shape))
+    AXF_DERIVED_FIELDS(Shape, radius)
+public:
+
+    float radius;
+
+    Circle() : radius(0) { }
+
+    virtual double area() const
+    {
+        return 3.0 * radius * radius;
+    }
+} ;
+
+class Rectangle : public Shape
+{
+    AXF_CLASS_TYPE(Rectangle, AXF_TYPE(Shape))
+    AXF_DERIVED_FIELDS(Shape, width, height)
+public:
+
+    unsigned width;
+    unsigned height;
+
+    Rectangle() : width(0), height(0) { }
+
+    virtual double area() const
+    {
+        return (double) width * height;
+    }
+} ;
+
+class Drawing : public Object
+{
+    AXF_CLASS_TYPE(Drawing, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(title, version, offset, visible, tags, shapes, highlighted, thumbnail)
+public:
+
+    std::string                     title;
+    unsigned long long              version;
+    long long                       offset;
+    bool                            visible;
+    std::vector<std::string>        tags;
+    std::vector<strong_ref<Shape> > shapes;
+    strong_ref<Shape>               highlighted;
+    ByteSlice                       thumbnail;
+
+    Drawing() : version(0), offset(0), visible(false) { }
+} ;
+
+class Unregistered : public Object
+{
+    AXF_CLASS_TYPE(Unregistered, AXF_TYPE(axf::core::Object))
+    AXF_FIELDS(value)
+public:
+
+    int value;
+
+    Unregistered() : value(0) { }
+} ;
+
+class Group : public Shape
+{
+    AXF_CLASS_TYPE(Group, AXF_TYPE(Shape))
+    AXF_DERIVED_FIELDS(Shape, child)
+public:
+
+    strong_ref<Shape> child;
+
+    virtual double area() const
+    {
+        return child.isNull() ? 0.0 : child->area();
+    }
+} ;
+
+// Two names with the same FNV-1a hash
+class costarring : public Object
+{
+    AXF_CLASS_TYPE(costarring, AXF_TYPE(axf::core::Object))
+} ;
+
+class liquid : public Object
+{
+    AXF_CLASS_TYPE(liquid, AXF_TYPE(axf::core::Object))
+} ;
+
+AXF_SERIALIZABLE(Circle);
+AXF_SERIALIZABLE(Rectangle);
+AXF_SERIALIZABLE(Drawing);
+AXF_SERIALIZABLE(Point);
+AXF_SERIALIZABLE(Group);
+
+template <typename T>
+static bool throwsOnRead(const ByteSlice& bytes)
+{
+    try
+    {
+        Deserializer in(bytes);
+        T value;
+        in.read(value);
+    }
+    catch (IOException&)
+    {
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    // Integers
+    {
+        Serializer out(1);
+        out.write(0u).write(127u).write(128u).write(300u).write(-1).write(1).write(-64).write(LLONG_MIN);
+        check(out.size() == 1 + 1 + 2 + 2 + 1 + 1 + 1 + 10, "integers are variable length and zig-zag encoded");
+
+        Deserializer in(out.data());
+        unsigned a, b, c, d;
+        int e, f, g;
+        long long h;
+        in.read(a).read(b).read(c).read(d).read(e).read(f).read(g).read(h);
+        check(a == 0 && b == 127 && c == 128 && d == 300 && e == -1 && f == 1 && g == -64 && h == LLONG_MIN,
+              "integers are decoded");
+        check(in.isAtEnd(), "the input is consumed exactly");
+
+        Serializer wide;
+        wide.write(70000u);
+        check(throwsOnRead<unsigned short>(wide.data()), "values out of range of the field raise an IOException");
+    }
+
+    // Objects
+    Drawing drawing;
+    drawing.title = "floor plan";
+    drawing.version = 1ULL << 40;
+    drawing.offset = -12345;
+    drawing.visible = true;
+    drawing.tags.push_back("draft");
+    drawing.tags.push_back("");
+
+    Circle* circle = new Circle();
+    circle->name = "wheel";
+    circle->origin = Point(1.5, -2.25);
+    circle->radius = 4.0f;
+    drawing.shapes.push_back(strong_ref<Shape>(circle));
+
+    Rectangle* rectangle = new Rectangle();
+    rectangle->name = "door";
+    rectangle->width = 90;
+    rectangle->height = 210;
+    drawing.shapes.push_back(strong_ref<Shape>(rectangle));
+    drawing.shapes.push_back(strong_ref<Shape>());
+    drawing.highlighted = drawing.shapes[0];
+
+    strong_ref<ByteBuffer> pixels = new ByteBuffer(16);
+    std::memset(pixels->data(), 0xab, 16);
+    drawing.thumbnail = pixels->slice();
+
+    // A small buffer of our own, outgrown along the way
+    strong_ref<ByteBuffer> target = new ByteBuffer(8);
+    Serializer out(target.get());
+    out.write(drawing);
+    ByteSlice bytes = out.data();
+    check(bytes.size() > 8 && bytes.getBuffer() != target, "the serializer outgrows its buffer");
+
+    Drawing copy;
+    Deserializer in(bytes);
+    in.read(copy);
+    check(in.isAtEnd(), "objects are read back entirely");
+    check(copy.title == "floor plan" && copy.version == drawing.version && copy.offset == -12345 && copy.visible,
+          "scalar fields round trip");
+    check(copy.tags.size() == 2 && copy.tags[0] == "draft" && copy.tags[1].empty(), "vectors of strings round trip");
+    check(copy.shapes.size() == 3 && copy.shapes[2].isNull(), "null references round trip");
+
+    const Circle* readCircle = copy.shapes.size() == 3 ? dynamic_cast<const Circle*> (copy.shapes[0].get()) : NULL;
+    check(readCircle != NULL && readCircle->name == string("wheel") && readCircle->radius == 4.0f
+          && readCircle->origin.x == 1.5 && readCircle->origin.y == -2.25,
+          "references keep the class of the object");
+
+    const Rectangle* readRectangle = copy.shapes.size() == 3
+            ? dynamic_cast<const Rectangle*> (copy.shapes[1].get()) : NULL;
+    check(readRectangle != NULL && readRectangle->name == string("door") && readRectangle->area() == 90.0 * 210.0,
+          "fields of base classes are written first");
+    check(!copy.highlighted.isNull() && dynamic_cast<const Circle*> (copy.highlighted.get()) != NULL,
+          "every reference is written");
+
+    check(copy.thumbnail.size() == 16 && copy.thumbnail.equals(pixels->slice())
+          && copy.thumbnail.getBuffer() == bytes.getBuffer(), "byte slices are read without copying");
+
+    // Reuse of the buffer
+    std::size_t size = out.size();
+    out.reset();
+    out.write(drawing);
+    check(out.size() == size, "a reset serializer writes the same bytes again");
+
+    // Malformed input
+    bool truncated = true;
+    for (std::size_t length = 0; length < bytes.size(); ++length)
+        truncated = truncated && throwsOnRead<Drawing>(bytes.slice(0, length));
+    check(truncated, "truncated input raises an IOException");
+
+    {
+        Serializer unknown;
+        strong_ref<Object> object = new Unregistered();
+        unknown.write(strong_ref<Unregistered>(static_cast<Unregistered*> (object.get())));
+        check(throwsOnRead<strong_ref<Unregistered> >(unknown.data()), "unregistered classes can not be read");
+
+        Serializer point;
+        point.write(strong_ref<Point>(new Point(1, 2)));
+        check(throwsOnRead<strong_ref<Shape> >(point.data()), "objects of the wrong class are rejected");
+
+        strong_ref<Point> readPoint;
+        Deserializer pointIn(point.data());
+        pointIn.read(readPoint);
+        check(!readPoint.isNull() && readPoint->x == 1 && readPoint->y == 2, "registered classes are created");
+
+        // The tag is the FNV-1a hash of "Point", in little endian order
+        const unsigned char* bytes = point.data().data();
+        check(bytes[0] == 1 && bytes[1] == 0x31 && bytes[2] == 0xef && bytes[3] == 0xa8 && bytes[4] == 0xea,
+              "objects are tagged with the stable hash of their class name");
+    }
+
+    // Classes whose tags collide can not both be registered. Registrations
+    // are never unlinked, so they are leaked
+    {
+        bool rejected = false;
+        new SerializableType(costarring::getCompileTimeClass(), &axf::io::bits::createInstance<costarring>);
+        try
+        {
+            new SerializableType(liquid::getCompileTimeClass(), &axf::io::bits::createInstance<liquid>);
+        }
+        catch (IllegalStateException&)
+        {
+            rejected = true;
+        }
+        check(rejected, "classes with colliding tags are rejected");
+        check(SerializableType::find(SerializableType::tagOf(liquid::getCompileTimeClass()))->getType()
+              .equals(costarring::getCompileTimeClass()), "the first registration is kept");
+    }
+
+    // Nesting is bounded, so hostile input can not exhaust the stack
+    {
+        strong_ref<Shape> shallow = new Group();
+        strong_ref<Shape> deep = new Group();
+        for (unsigned i = 1; i < Deserializer::MAX_DEPTH; ++i)
+        {
+            Group* group = new Group();
+            group->child = shallow;
+            shallow = group;
+        }
+        for (unsigned i = 1; i <= Deserializer::MAX_DEPTH; ++i)
+        {
+            Group* group = new Group();
+            group->child = deep;
+            deep = group;
+        }
+
+        Serializer out;
+        out.write(shallow);
+        strong_ref<Shape> copy;
+        Deserializer in(out.data());
+        in.read(copy);
+        check(!copy.isNull() && in.isAtEnd(), "objects nested up to the limit are read");
+
+        out.reset();
+        out.write(deep);
+        check(throwsOnRead<strong_ref<Shape> >(out.data()), "objects nested beyond the limit raise an IOException");
+    }
+
+    return testResult();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 Javier Marrero.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+/* 
+ * File:   streams.cpp
+ * Author: Javier Marrero
+ *
+ * Created on October 19, 2026, 1:40 AM
+ */
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Axf.h>
+#include <tests/Test.h>
+
+using namespace axf;
+using namespace axf::core;
+using namespace axf::io;
+
+static std::string temporaryPath()
+{
+    char path[] = "/tmp/axf_streams_XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    return path;
+}
+
+static long fileSize(const std::string& path)
+{
+    struct stat status;
+    return stat(path.c_str(), &status) == 0 ? (long) status.st_size : -1;
+}
+
+static std::string toString(const ByteSlice& slice)
+{
+    return std::string((const char*) slice.data(), slice.size());
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t BUFFER = 4096;
+    std::string path = temporaryPath();
+
+    // Expected contents, written piecewise
+    std::string expected;
+    std::string longLine(3 * BUFFER, 'L');
+    std::vector<std::string> pieces;
+    for (int i = 0; i < 2000; ++i)
+    {
+        char line[32];
+        std::sprintf(line, "record %d\n", i);
+        pieces.push_back(line);
+    }
+
+    {
+        strong_ref<FileOutputStream> out = new FileOutputStream(path.c_str(), false, BUFFER);
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            out->write(pieces[i].data(), pieces[i].size());
+            expected += pieces[i];
+        }
+
+        out->writeByte('#');
+        out->writeByte('\n');
+        expected += "#\n";
+
+        // A write larger than the buffer goes straight to the file
+        out->write(longLine.data(), longLine.size());
+        out->writeByte('\n');
+        expected += longLine + "\n";
+
+        // Gather writes, small enough to be copied and too large to be
+        strong_ref<ByteBuffer> source = new ByteBuffer(pieces.size() * 16);
+        std::vector<ByteSlice> slices;
+        std::size_t offset = 0;
+        for (std::size_t i = 1000; i < pieces.size(); ++i)
+        {
+            std::memcpy(source->data() + offset, pieces[i].data(), pieces[i].size());
+            slices.push_back(source->slice(offset, pieces[i].size()));
+            offset += pieces[i].size();
+            expected += pieces[i];
+        }
+        out->write(&slices[0], 3);
+        out->write(&slices[3], slices.size() - 3);
+
+        out->write("tail without newline", 20);
+        expected += "tail without newline";
+        out->close();
+    }
+
+    std::string written(fileSize(path), '\0');
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        check(std::fread(&written[0], 1, written.size(), file) == expected.size(), "every byte reaches the file");
+        std::fclose(file);
+    }
+    check(written == expected, "bytes are written in order");
+
+    // Lines across buffer boundaries, longer than the buffer, and unterminated
+    {
+        strong_ref<FileInputStream> in = new FileInputStream(path.c_str(), BUFFER);
+        std::string joined;
+        ByteSlice line;
+        ByteSlice first;
+        int lines = 0;
+        while (in->readLine(line))
+        {
+            if (lines++ == 0)
+                first = line;
+            joined += toString(line);
+            joined += '\n';
+        }
+        check(joined == expected + "\n", "lines are read back");
+        check(lines == 2003, "every line is returned once");
+        check(toString(first) == "record 0", "kept lines survive buffer refills");
+        check(in->isEndOfStream() && in->readByte() == -1, "the end of the stream is reported");
+    }
+
+    // Peek and consume
+    {
+        strong_ref<FileInputStream> in = new FileInputStream(path.c_str(), BUFFER);
+        ByteSlice header = in->peek(7);
+        check(toString(header) == "record " && in->available() >= 7, "peek does not consume");
+        in->consume(7);
+        check(in->readByte() == '0' && in->peekByte() == '\n', "consume advances");
+
+        ByteSlice large = in->peek(2 * BUFFER);
+        check(large.size() == 2 * BUFFER && std::memcmp(large.data(), expected.data() + 8, large.size()) == 0,
+              "peeking past the buffer grows it");
+
+        bool thrown = false;
+        try
+        {
+            in->consume(in->available() + 1);
+        }
+        catch (IllegalStateException&)
+        {
+            thrown = true;
+        }
+        check(thrown, "consuming bytes that were not peeked is rejected");
+
+        std::string rest(expected.size(), '\0');
+        std::size_t count = in->read(&rest[0], rest.size());
+        check(count == expected.size() - 8 && rest.compare(0, count, expected, 8, count) == 0, "bulk reads return the rest");
+    }
+
+    // Flush policies
+    {
+        strong_ref<FileOutputStream> out = new FileOutputStream(path.c_str(), false, BUFFER,
+                                                                OutputStream::FLUSH_ON_NEWLINE);
+        out->write("partial", 7);
+        check(fileSize(path) == 0 && out->buffered() == 7, "writes are buffered");
+        out->write(" line\n", 6);
+        check(fileSize(path) == 13 && out->buffered() == 0, "new lines flush");
+
+        out->setFlushPolicy(OutputStream::FLUSH_ON_WRITE);
+        out->writeByte('x');
+        check(fileSize(path) == 14, "every write flushes");
+
+        out->setFlushPolicy(OutputStream::FLUSH_WHEN_FULL);
+        out->write("y\n", 2);
+        check(fileSize(path) == 14, "only full buffers flush");
+        out->flush();
+        check(fileSize(path) == 16, "explicit flushes write the buffer");
+    }
+    std::remove(path.c_str());
+
+    bool thrown = false;
+    try
+    {
+        FileInputStream in("/nonexistent/axf/stream");
+    }
+    catch (IOException&)
+    {
+        thrown = true;
+    }
+    check(thrown, "missing files raise an IOException");
+
+    return testResult();
+}
@@ -31,6 +31,50 @@
 
 using namespace axf;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+
+class Tree : public core::ReferenceCounted
+{
+} ;
+
+/**
+ * A tree whose children are reachable only through its own list.
+ */
+class Branch : public Tree
+{
+public:
+
+    collections::LinkedList<core::strong_ref<Tree> > children;
+} ;
+
+/**
+ * Descends a tree by moving the children of the first element over the list
+ * that holds it, which releases the list moved from.
+ */
+void descend()
+{
+    collections::LinkedList<core::strong_ref<Tree> > level;
+    level.add(core::strong_ref<Tree>(new Branch()));
+
+    Branch* branch = static_cast<Branch*> (level.get(0).get());
+    for (int depth = 0; depth < 10; ++depth)
+    {
+        Branch* child = new Branch();
+        branch->children.add(core::strong_ref<Tree>(child));
+        branch->children.add(core::strong_ref<Tree>(new Tree()));
+        branch = child;
+    }
+
+    int depth = 0;
+    while (level.size() > 0)
+    {
+        level = std::move(static_cast<Branch*> (level.get(0).get())->children);
+        depth++;
+    }
+    std::cout << "descended " << depth << " levels" << std::endl;
+}
+#endif
+
 int main(int argc, char** argv)
 {
     collections::LinkedList<int> linkedList;
@@ -72,6 +116,10 @@ int main(int argc, char** argv)
     }
     std::cout << std::endl;
 
+#ifdef ARTEMIS_CXX11_SUPPORTED
+    descend();
+#endif
+
     std::getchar();
     return (EXIT_SUCCESS);
 }